@@ -268,6 +268,232 @@ extern int      JudyLNextEmpty(  Pcvoid_t  PArray, Word_t * PIndex,  P_JE);
 extern int      JudyLLastEmpty(  Pcvoid_t  PArray, Word_t * PIndex,  P_JE);
 extern int      JudyLPrevEmpty(  Pcvoid_t  PArray, Word_t * PIndex,  P_JE);
 
+// ****************************************************************************
+// JUDY1 AND JUDYL FINGER FUNCTIONS:
+//
+// A finger is a small caller-owned cache of the leaf last reached in one
+// Judy1 or JudyL array.  The *F functions below act like the functions
+// without the F, but an Index in the same leaf as the previous one (such as
+// Index + 1 in a sequential scan) is found without descending from the root.
+// A finger becomes stale, and is silently refreshed, whenever its array is
+// changed by any Set, Unset, Ins or Del, so it is always safe to use, but it
+// only pays off for runs of accesses that hit the same leaf.  Very small
+// arrays, which are a single root leaf anyway, never use a finger.
+//
+// Zero a finger (for example with JFINGERINIT) before its first use.  Use a
+// separate finger per array per thread; a finger is never shared between
+// threads or arrays safely, because it is updated by lookups too.
+//
+// WARNING:  As with JError_t, the fields of this struct should not be
+// referenced directly.
+
+typedef struct J_UDY_FINGER_STRUCT
+{
+        Pcvoid_t jf_PArray;             // array the finger was set in.
+        Word_t   jf_Gen;                // arrays change count when set.
+        Pvoid_t  jf_Pjp;                // leaf last reached (a JP).
+        Word_t   jf_Index;              // an Index in that leafs expanse.
+        Word_t   jf_Mask;               // Index bits that select the leaf.
+
+} JFinger_t, * PJFinger_t;
+
+#define JFINGERINIT(PFinger) ((PFinger)->jf_PArray = (Pcvoid_t) NULL)
+
+extern int      Judy1TestF(      Pcvoid_t  PArray, Word_t   Index,
+                                                 PJFinger_t PFinger, P_JE);
+extern int      Judy1SetF(       PPvoid_t PPArray, Word_t   Index,
+                                                 PJFinger_t PFinger, P_JE);
+extern int      Judy1NextF(      Pcvoid_t  PArray, Word_t * PIndex,
+                                                 PJFinger_t PFinger, P_JE);
+
+extern PPvoid_t JudyLGetF(       Pcvoid_t  PArray, Word_t    Index,
+                                                 PJFinger_t PFinger, P_JE);
+extern PPvoid_t JudyLInsF(       PPvoid_t PPArray, Word_t    Index,
+                                                 PJFinger_t PFinger, P_JE);
+extern PPvoid_t JudyLNextF(      Pcvoid_t  PArray, Word_t * PIndex,
+                                                 PJFinger_t PFinger, P_JE);
+
+// ****************************************************************************
+// JUDY1 AND JUDYL STATISTICS:
+//
+// Counters of what the Judy1 and JudyL get, insert, and delete code does,
+// for finding out why an array is slow without rebuilding the library.
+// Counting is off until JudyStatsEnable(1) is called, and costs one test of
+// a global flag per JP visited while off.  The counters are kept per thread
+// (where the compiler supports it) and summed over all arrays; to see one
+// arrays behavior, call JudyStatsReset(), operate on that array only, then
+// call JudyStatsGet().  Compile the library with -DJU_NOSTATS to omit them.
+//
+// js_Visits[] is indexed by level (the number of Index bytes a JP decodes,
+// or its leafs Index Size; cJU_ROOTSTATE for the top JP and root leaves) and
+// by a JS_* kind of JP.  js_CacheLines estimates the cache lines touched by
+// those visits (not counting JudyL value areas).
+
+#define JS_NULL         0       // null JP (empty subexpanse).
+#define JS_BRANCHL      1       // linear branch.
+#define JS_BRANCHB      2       // bitmap branch.
+#define JS_BRANCHU      3       // uncompressed branch.
+#define JS_LEAF         4       // linear leaf below a branch.
+#define JS_LEAFB1       5       // bitmap leaf.
+#define JS_FULLPOP      6       // Judy1 full population leaf.
+#define JS_IMMED        7       // immediate Indexes in a JP.
+#define JS_LEAFW        8       // root leaf (small array, no JPM).
+#define JS_KINDS        9
+#define JS_LEVELS       9       // enough for 64-bit Indexes.
+
+typedef struct J_UDY_STATS_STRUCT
+{
+        Word_t js_Visits[JS_LEVELS][JS_KINDS];  // JPs visited.
+        Word_t js_CacheLines;           // estimated, for the JPs visited.
+        Word_t js_Cascades;             // leaf overflows, into branches.
+        Word_t js_Decascades;           // underflows, into smaller nodes.
+        Word_t js_BranchBToU;           // bitmap to uncompressed branch.
+        Word_t js_LeafGrowInPlace;      // leaf inserts with room to spare.
+        Word_t js_LeafRealloc;          // leaf inserts that copied the leaf.
+
+} JStats_t, * PJStats_t;
+
+extern void     JudyStatsEnable( int       On);
+extern void     JudyStatsGet(    PJStats_t PStats);
+extern void     JudyStatsReset(  void);
+
+// ****************************************************************************
+// JUDY1 AND JUDYL BRANCH CONVERSION TUNING:
+//
+// When Judy1 and JudyL insert code converts a linear (BranchL) or bitmap
+// (BranchB) branch to an uncompressed one (BranchU), which is faster to walk
+// but takes 256 JPs of memory, is a trade-off between speed and memory fixed
+// by the thresholds below.  JudyTuneProfile() returns those of a JT_*
+// profile, JudyTuneGet() the current ones, and JudyTuneSet() makes them
+// current (NULL for JT_DEFAULT).  They are global:  one call changes them
+// for every array in every thread, usually once before building any.  Any
+// values give valid arrays; they change only when branches are converted,
+// not what is already built.  Leaf sizes are fixed by the library build.
+
+#define JT_DEFAULT      0       // compiled-in (see JudyPrivateBranch.h).
+#define JT_SPEED        1       // BranchU about 4 times sooner.
+#define JT_COMPACT      2       // BranchU only for large, dense branches.
+
+typedef struct J_UDY_TUNE_STRUCT
+{
+        Word_t jt_BranchLMaxPop;        // BranchL to BranchU above this.
+        Word_t jt_BranchBMinPop;        // BranchB to BranchU above this,
+        Word_t jt_BranchBMaxPop;        // in an array above this,
+        Word_t jt_BToUPopIncrement;     // grown this much since the last.
+
+} JTune_t, * PJTune_t;
+
+extern void     JudyTuneProfile( int       Profile, PJTune_t PTune);
+extern void     JudyTuneGet(     PJTune_t  PTune);
+extern void     JudyTuneSet(     PJTune_t  PTune);
+
+// ****************************************************************************
+// JUDY1 AND JUDYL INSPECTION:
+//
+// Judy1Inspect() and JudyLInspect() walk an array once and fill in a
+// JInspect_t describing its structure, for capacity planning and for spotting
+// pathological Index distributions.  They return the total bytes of memory
+// used (as Judy*MemUsed() would), or JERR.
+//
+// For each kind of node, jin_Count nodes occupy jin_Bytes bytes and hold
+// jin_Pop1 Indexes (leaves, immediates, value areas) or non-null JPs
+// (branches), out of jin_Slots for which there is room without allocating
+// more memory; jin_Pop1 / jin_Slots is the average fill ratio.  Branches are
+// indexed by level (2 .. sizeof(Word_t)), linear leaves by Index Size, with
+// the root leaf of a small array at [sizeof(Word_t)], and immediate JPs by
+// Index Size and population.  Immediates live in their parent branch, so
+// only JudyL value areas for 2 or more immediate Indexes count as bytes.
+// ji_Values also counts those JudyL value areas that are separate from their
+// leaf, for bitmap leaves and immediates.
+
+#define JI_LEVELS       9       // enough for 64-bit Indexes.
+#define JI_MAXIMMED     16      // more than any immediate population.
+
+typedef struct J_UDY_INSPECT_NODE
+{
+        Word_t jin_Count;               // nodes of this kind.
+        Word_t jin_Bytes;               // memory they occupy.
+        Word_t jin_Pop1;                // Indexes or JPs they hold.
+        Word_t jin_Slots;               // room they have for them.
+
+} JInspectNode_t, * PJInspectNode_t;
+
+typedef struct J_UDY_INSPECT_STRUCT
+{
+        JInspectNode_t ji_BranchL[JI_LEVELS];   // linear branches.
+        JInspectNode_t ji_BranchB[JI_LEVELS];   // bitmap branches.
+        JInspectNode_t ji_BranchU[JI_LEVELS];   // uncompressed branches.
+        JInspectNode_t ji_Leaf[JI_LEVELS];      // Leaf1..7, LeafW.
+        JInspectNode_t ji_LeafB1;               // bitmap leaves.
+        JInspectNode_t ji_FullPopu1;            // Judy1 full expanses.
+        JInspectNode_t ji_Immed[JI_LEVELS][JI_MAXIMMED];
+        JInspectNode_t ji_Values;               // separate value areas.
+        Word_t         ji_JPMBytes;             // array header, if any.
+        Word_t         ji_TotalBytes;           // all of the above.
+        Word_t         ji_Population;           // Indexes in the array.
+        Word_t         ji_MaxDepth;             // most JPs to any Index.
+
+} JInspect_t, * PJInspect_t;
+
+extern Word_t   Judy1Inspect(    Pcvoid_t  PArray, PJInspect_t PInspect, P_JE);
+extern Word_t   JudyLInspect(    Pcvoid_t  PArray, PJInspect_t PInspect, P_JE);
+
+// ****************************************************************************
+// JUDY1 AND JUDYL VALIDATION:
+//
+// Judy1Validate() and JudyLValidate() walk an array and check the redundant
+// data in it against itself:  populations (each branch JP's Pop0 and the
+// array's total) against the Indexes actually found below; Dcd bytes against
+// the digits decoded above; every Index, leaf by leaf, in strictly ascending
+// order and within its expanse; JP Types descending in level; linear branch
+// and bitmap branch and leaf counts against their lists and bitmaps; leaf
+// populations against their maximums; and the memory the Pop-to-Words tables
+// give for every object against the total words allocated to the array.
+//
+// They return 1 if all is well, otherwise JERR with JU_ERRNO_CORRUPT; if
+// PValidate is not NULL it says which check failed first and where, and in
+// any case how far the walk got.  The cost is that of a walk of the whole
+// array, like Judy*MemActive(), and nothing is written to the array, so they
+// can be run from a low priority thread under a reader lock.
+//
+// jv_Offset is the JP's digit in a bitmap or uncompressed branch, its
+// subexpanse for JV_BITMAP and JV_VALUES, and otherwise its position in its
+// list.  jv_Index has the digits decoded down to the node that failed, with
+// the Index itself for JV_ORDER.
+
+typedef enum
+{
+        JV_OK           = 0,    // no problem found.
+        JV_JPTYPE       = 1,    // unknown, null or non-descending JP Type.
+        JV_POP          = 2,    // Pop0 does not match the Indexes below.
+        JV_DCD          = 3,    // Dcd bytes do not match the digits above.
+        JV_ORDER        = 4,    // Index not above the one before it.
+        JV_BRANCHL      = 5,    // bad linear branch count or digit order.
+        JV_BITMAP       = 6,    // bitmap does not match its JPs.
+        JV_VALUES       = 7,    // JudyL value area missing or unexpected.
+        JV_LEAFSIZE     = 8,    // leaf population above its maximum.
+        JV_MEMWORDS     = 9     // object sizes do not add up to the total.
+
+} JV_Check_t;
+
+typedef struct J_UDY_VALIDATE_STRUCT
+{
+        JV_Check_t jv_Check;            // first check to fail, or JV_OK.
+        Word_t     jv_JPType;           // Type of its JP, 0 if root leaf.
+        Word_t     jv_Level;            // of its JP, or Index Size of leaf.
+        Word_t     jv_Index;            // digits decoded down to there.
+        Word_t     jv_Offset;           // of the JP or Index in its node.
+        Word_t     jv_Got;              // what the array holds,
+        Word_t     jv_Want;             // and what the walk expected.
+        Word_t     jv_Nodes;            // nodes (JPs and root leaf) walked.
+        Word_t     jv_Population;       // Indexes found in order.
+        Word_t     jv_Words;            // memory counted for the objects.
+
+} JValidate_t, * PJValidate_t;
+
+extern int      Judy1Validate(   Pcvoid_t, PJValidate_t PValidate, P_JE);
+extern int      JudyLValidate(   Pcvoid_t, PJValidate_t PValidate, P_JE);
+
 // ****************************************************************************
 // JUDYSL FUNCTIONS:
 
@@ -280,6 +506,68 @@ extern PPvoid_t JudySLNext(      Pcvoid_t,       uint8_t * Index, P_JE);
 extern PPvoid_t JudySLLast(      Pcvoid_t,       uint8_t * Index, P_JE);
 extern PPvoid_t JudySLPrev(      Pcvoid_t,       uint8_t * Index, P_JE);
 
+// JudySLCount() and JudySLByCount() are JudyLCount() and JudyLByCount() for
+// strings.  They only read the array, but are fast only after
+// JudySLCountInit(), best called on the empty array, makes JudySLIns() and
+// JudySLDel() keep subtree populations in it; until then they walk the array.
+// A counted array does not go back to NULL when its last Index is deleted;
+// only JudySLFreeArray() releases it.
+
+extern int      JudySLCountInit( PPvoid_t,                        P_JE);
+extern Word_t   JudySLCount(     Pcvoid_t, const uint8_t * Index1,
+                                           const uint8_t * Index2, P_JE);
+extern PPvoid_t JudySLByCount(   Pcvoid_t, Word_t Count,
+                                                 uint8_t * Index, P_JE);
+
+// JudySL prefix scan:  JudySLPrefixFirst() returns the value area of the
+// first Index that begins with Prefix (copying the Index to Index), and each
+// JudySLPrefixNext() the next one, or NULL after the last.  The cursor keeps
+// the path down the JudySL tree, so each call moves only as far as it must;
+// the array must not be modified until the scan is over.  Index must have
+// room for the longest Index and be left as returned between calls.  Zero a
+// cursor (for example with JSLCURSORINIT) before its first use, and free it
+// with JudySLCursorFree() when done; one cursor can be reused for many scans.
+
+typedef struct J_UDYSL_CURSOR_STRUCT
+{
+        Word_t    jslc_Depth;           // levels in the path, 0 if done.
+        Word_t    jslc_Base;            // level where the prefix ends.
+        Word_t    jslc_High;            // last index word at jslc_Base.
+        Word_t    jslc_Size;            // levels allocated in jslc_Stack.
+        PWord_t   jslc_Stack;           // each level:  node, word, place.
+
+} JSLCursor_t, * PJSLCursor_t;
+
+#define JSLCURSORINIT(PCursor)  ((PCursor)->jslc_Size = (PCursor)->jslc_Depth = 0)
+
+extern PPvoid_t JudySLPrefixFirst(Pcvoid_t, const uint8_t * Prefix,
+                                  PJSLCursor_t, uint8_t * Index, P_JE);
+extern PPvoid_t JudySLPrefixNext( PJSLCursor_t, uint8_t * Index, P_JE);
+extern Word_t   JudySLCursorFree( PJSLCursor_t);
+
+// JudySLB*() are JudySL*() for binary Indexes given as (Index, Len), which may
+// contain \0s.  Indexes are in memcmp() order, a prefix before any longer
+// Index; the empty Index is allowed.  First/Next/Last/Prev take the starting
+// Index in Index and *PLen and return the one found the same way, so Index
+// must have room for the longest Index in the array.  A JudySLB array must
+// only be passed to JudySLB*() functions.
+
+extern PPvoid_t JudySLBGet(      Pcvoid_t, const uint8_t * Index, Word_t Len,
+                                                                  P_JE);
+extern PPvoid_t JudySLBIns(      PPvoid_t, const uint8_t * Index, Word_t Len,
+                                                                  P_JE);
+extern int      JudySLBDel(      PPvoid_t, const uint8_t * Index, Word_t Len,
+                                                                  P_JE);
+extern Word_t   JudySLBFreeArray(PPvoid_t,                        P_JE);
+extern PPvoid_t JudySLBFirst(    Pcvoid_t,       uint8_t * Index, PWord_t PLen,
+                                                                  P_JE);
+extern PPvoid_t JudySLBNext(     Pcvoid_t,       uint8_t * Index, PWord_t PLen,
+                                                                  P_JE);
+extern PPvoid_t JudySLBLast(     Pcvoid_t,       uint8_t * Index, PWord_t PLen,
+                                                                  P_JE);
+extern PPvoid_t JudySLBPrev(     Pcvoid_t,       uint8_t * Index, PWord_t PLen,
+                                                                  P_JE);
+
 // ****************************************************************************
 // JUDYHSL FUNCTIONS:
 
@@ -288,6 +576,55 @@ extern PPvoid_t JudyHSIns(       PPvoid_t,  void *, Word_t, P_JE);
 extern int      JudyHSDel(       PPvoid_t,  void *, Word_t, P_JE);
 extern Word_t   JudyHSFreeArray( PPvoid_t,                  P_JE);
 
+// The 32-bit hash JudyHS uses for strings longer than a word; see JudyHS.c:
+extern uint32_t JudyHashStr(                void *, Word_t);
+
+// JudyHSGetH(), JudyHSInsH(), and JudyHSDelH() are JudyHSGet(), JudyHSIns(),
+// and JudyHSDel() for callers that already have a hash of the string, which
+// they pass last (before P_JE) and which the functions use instead of hashing
+// the string again.  If an array is ever used by the functions without H, the
+// hash must be JudyHashStr() of the string; otherwise it can be any function
+// of the string (of any width up to a Word_t), so long as every call on that
+// array uses the same one.  A wrong hash does not corrupt the array, but a
+// string stored with one hash is not found with another.  Strings of no more
+// than sizeof(Word_t) bytes are not hashed, and their hash is ignored.
+
+extern PPvoid_t JudyHSGetH(      Pcvoid_t,  void *, Word_t, Word_t);
+extern PPvoid_t JudyHSInsH(      PPvoid_t,  void *, Word_t, Word_t, P_JE);
+extern int      JudyHSDelH(      PPvoid_t,  void *, Word_t, Word_t, P_JE);
+
+// JudyHSGetBatch() looks up Count strings, setting PPValue[i] to what
+// JudyHSGet(PArray, Str[i], Len[i]) would return, and returns the number
+// found.  It overlaps the cache misses of independent lookups, so it is
+// faster than calling JudyHSGet() Count times on a large array.
+
+extern Word_t   JudyHSGetBatch(  Pcvoid_t,  Word_t, void **, Word_t *,
+                                                          PPvoid_t *);
+
+// JudyHS iteration:  JudyHSFirst() and JudyHSNext() visit every string in a
+// JudyHS array and return a pointer to its Value, or NULL after the last one.
+// The order is stable (by length, then by hash, then by the bytes of the
+// string) but not lexicographic.  The iterator holds a copy of the current
+// string, in jhsi_String[0 .. jhsi_Len - 1], so the array can be modified
+// between calls; JudyHSNext() finds the string that follows the copy.  Zero
+// an iterator (for example with JHSITERINIT) before its first use, and free
+// its copy with JudyHSIterFree() when done.
+
+typedef struct J_UDYHS_ITER_STRUCT
+{
+        uint8_t * jhsi_String;          // copy of current string.
+        Word_t    jhsi_Len;             // its length in bytes.
+        Word_t    jhsi_Hash;            // its hash, if Len > sizeof(Word_t).
+        Word_t    jhsi_Words;           // allocated for jhsi_String.
+
+} JHSIter_t, * PJHSIter_t;
+
+#define JHSITERINIT(PIter)  ((PIter)->jhsi_Words = 0)
+
+extern PPvoid_t JudyHSFirst(     Pcvoid_t,  PJHSIter_t,     P_JE);
+extern PPvoid_t JudyHSNext(      Pcvoid_t,  PJHSIter_t,     P_JE);
+extern Word_t   JudyHSIterFree(  PJHSIter_t);
+
 extern const char *Judy1MallocSizes;
 extern const char *JudyLMallocSizes;
 
@@ -598,6 +935,10 @@ extern void   JudyFreeVirtual(Pvoid_t, Word_t); // free, size in words.
         J_2I(Rc, (&(PArray)), PIndex, Count, JudyHSDel, "JudyHSDel")
 #define JHSFA(Rc,    PArray)                                            \
         J_0I(Rc, (&(PArray)), JudyHSFreeArray, "JudyHSFreeArray")
+#define JHSF( PV,    PArray,   Iter)                                    \
+        J_1P(PV,    PArray, &(Iter),  JudyHSFirst, "JudyHSFirst")
+#define JHSN( PV,    PArray,   Iter)                                    \
+        J_1P(PV,    PArray, &(Iter),  JudyHSNext,  "JudyHSNext")
 
 #define JSLG( PV,    PArray,   Index)                                   \
         J_1P( PV,    PArray,   Index, JudySLGet,   "JudySLGet")
@@ -613,9 +954,32 @@ extern void   JudyFreeVirtual(Pvoid_t, Word_t); // free, size in words.
         J_1P( PV,    PArray,   Index, JudySLLast,  "JudySLLast")
 #define JSLP( PV,    PArray,   Index)                                   \
         J_1P( PV,    PArray,   Index, JudySLPrev,  "JudySLPrev")
+#define JSLCI(Rc,    PArray)                                            \
+        J_0I( Rc, (&(PArray)), JudySLCountInit, "JudySLCountInit")
+#define JSLC( Rc,    PArray,   Index1,  Index2)                          \
+        J_2C( Rc,    PArray,   Index1,  Index2, JudySLCount,   "JudySLCount")
+#define JSLBYC(PV,   PArray,   Count,   Index)                           \
+        J_2P( PV,    PArray,   Count,   Index, JudySLByCount, "JudySLByCount")
 #define JSLFA(Rc,    PArray)                                            \
         J_0I( Rc, (&(PArray)), JudySLFreeArray, "JudySLFreeArray")
 
+#define JSLBG( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV,    PArray,   Index,   Len, JudySLBGet,   "JudySLBGet")
+#define JSLBI( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV, (&(PArray)), Index,   Len, JudySLBIns,   "JudySLBIns")
+#define JSLBD( Rc,   PArray,   Index,   Len)                            \
+        J_2I( Rc, (&(PArray)), Index,   Len, JudySLBDel,   "JudySLBDel")
+#define JSLBF( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV,    PArray,   Index, &(Len), JudySLBFirst, "JudySLBFirst")
+#define JSLBN( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV,    PArray,   Index, &(Len), JudySLBNext,  "JudySLBNext")
+#define JSLBL( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV,    PArray,   Index, &(Len), JudySLBLast,  "JudySLBLast")
+#define JSLBP( PV,   PArray,   Index,   Len)                            \
+        J_2P( PV,    PArray,   Index, &(Len), JudySLBPrev,  "JudySLBPrev")
+#define JSLBFA(Rc,   PArray)                                            \
+        J_0I( Rc, (&(PArray)), JudySLBFreeArray, "JudySLBFreeArray")
+
 #ifdef __cplusplus
 }
 #endif
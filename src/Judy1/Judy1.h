@@ -435,6 +435,7 @@ typedef struct J_UDY1_POPULATION_AND_MEMORY
 /* 7 */ char       je_Errno;            // one of the enums in Judy.h.
 /* 7/8 */ int      je_ErrID;            // often an internal source line number.
 /* 8/9 */ Word_t   jpm_TotalMemWords;   // words allocated in array.
+/* 9/10 */ Word_t  jpm_Gen;             // change count, for JFinger_t.
 } j1pm_t, *Pj1pm_t;
 
 
@@ -170,6 +170,7 @@ ContinueDelWalk:                // for modifying state without recursing.
 #ifdef TRACEJP
         JudyPrintJP(Pjp, "d", __LINE__);
 #endif
+        JU_STATJP(Pjp);
 
         switch (JU_JPTYPE(Pjp)) // entry:  Pjp, Index.
         {
@@ -249,6 +250,7 @@ ContinueDelWalk:                // for modifying state without recursing.
             Pjbl_t   Pjbl;                                              \
             Word_t   numJPs;                                            \
                                                                         \
+            JU_STAT(js_Decascades);                                     \
             if ((PjllnewRaw = Alloc(MaxPop1, Pjpm)) == 0) return(-1);   \
             Pjllnew = P_JLL(PjllnewRaw);                                \
             Pleaf   = (LeafType) Pjllnew;                               \
@@ -431,6 +433,7 @@ BranchLKeep:
             Pjp_t     Pjp2Raw;  /* one subexpanses subarray     */      \
             Pjp_t     Pjp2;                                             \
                                                                         \
+            JU_STAT(js_Decascades);                                     \
             if ((PjllnewRaw = Alloc(MaxPop1, Pjpm)) == 0) return(-1);   \
             Pjllnew = P_JLL(PjllnewRaw);                                \
             Pleaf   = (LeafType) Pjllnew;                               \
@@ -672,6 +675,7 @@ BranchBKeep:
 // this call are JU_ERRNO_NOMEM and JU_ERRNO_OVERRUN, neither of which is worth
 // forwarding from this point.  See also 4.1, 4.8, and 4.15 of this file.
 
+            JU_STAT(js_Decascades);
             (void) j__udyBranchBToBranchL(Pjp, Pjpm);
             return(1);
 
@@ -712,6 +716,7 @@ BranchBKeep:
             Pjp_t  Pjp2    = JU_JBU_PJP0(Pjp);                          \
             Word_t ldigit;      /* larger than uint8_t */               \
                                                                         \
+            JU_STAT(js_Decascades);                                     \
             if ((PjllnewRaw = Alloc(MaxPop1, Pjpm)) == 0) return(-1);   \
             Pjllnew = P_JLL(PjllnewRaw);                                \
             Pleaf   = (LeafType) Pjllnew;                               \
@@ -902,6 +907,7 @@ BranchBKeep:
          && (pop1 == (MaxPop1)))         /* hysteresis = 1       */     \
         {                                                               \
             Word_t D_cdP0;                                              \
+            JU_STAT(js_Decascades);                                     \
             if ((PjllnewRaw = Alloc(MaxPop1, Pjpm)) == 0) return(-1);   \
             Pjllnew = P_JLL(PjllnewRaw);                                \
   JUDYLCODE(Pjv     = ValueArea((LeafType) Pjllnew, MaxPop1);)          \
@@ -999,6 +1005,7 @@ JUDYLCODE(A_ddr = Pjv[offset];)                                         \
             DeleteCopy((LeafType) (Pjp->jp_1Index), Pleaf, pop1, offset, cIS); \
             DBGCODE(JudyCheckSorted((Pjll_t) (Pjp->jp_1Index),  pop1-1, cIS);) \
             Pjp->jp_Type = (BaseJPType) - 1 + (MaxPop1) - 1;    \
+            JU_STAT(js_Decascades);                             \
             FreeLeaf(PjllRaw, pop1, Pjpm);                      \
             return(1);                                          \
         }
@@ -1026,6 +1033,7 @@ JUDYLCODE(A_ddr = Pjv[offset];)                                         \
             DeleteCopy((LeafType) (Pjp->jp_LIndex), Pleaf, pop1, offset, cIS); \
             JU_DELETECOPY(Pjvnew, Pjv, pop1, offset, cIS);      \
             DBGCODE(JudyCheckSorted((Pjll_t) (Pjp->jp_LIndex),  pop1-1, cIS);) \
+            JU_STAT(js_Decascades);                             \
             FreeLeaf(PjllRaw, pop1, Pjpm);                      \
             Pjp->jp_Addr = (Word_t) PjvnewRaw;                  \
             Pjp->jp_Type = (BaseJPType) - 2 + (MaxPop1);        \
@@ -1051,6 +1059,7 @@ JUDYLCODE(A_ddr = Pjv[offset];)                                         \
         {                                                               \
             Pjll_t PjllRaw = (Pjll_t) (Pjp->jp_Addr);                   \
             ToImmed(cIS, SearchLeaf, CopyPIndex);                       \
+            JU_STAT(js_Decascades);                                     \
             FreeLeaf(PjllRaw, pop1, Pjpm);                              \
             Pjp->jp_Type = (Immed01JPType);                             \
             return(1);                                                  \
@@ -1401,6 +1410,7 @@ JUDYLCODE(A_ddr = Pjv[offset];)                                         \
 
             if (pop1 == cJU_LEAF1_MAXPOP1)      // hysteresis = 1.
             {
+                JU_STAT(js_Decascades);
                 if (j__udyLeafB1ToLeaf1(Pjp, Pjpm) == -1) return(-1);
                 goto ContinueDelWalk;   // delete Index in new Leaf1.
             }
@@ -1883,6 +1893,7 @@ JUDYLCODE(PPvoid_t PPvalue;)  // pointer from JudyLGet().
 
 // Locate Index in compressible leaf:
 
+            JU_STATLEAFW();
             offset = j__udySearchLeafW(Pjlw + 1, pop1, Index);
             assert(offset >= 0);                // Index must be valid.
 
@@ -1970,6 +1981,8 @@ JUDYLCODE(PPvoid_t PPvalue;)  // pointer from JudyLGet().
 // TBD:  Should we add a topdigit field to JPMs so they can hold narrow
 // pointers?
 
+            ++(Pjpm->jpm_Gen);  // invalidate fingers; see JudyFinger.c.
+
             if (j__udyDelWalk(Pjp, Index, cJU_ROOTSTATE, Pjpm) == -1)
             {
                 JU_COPY_ERRNO(PJError, Pjpm);
@@ -1986,6 +1999,7 @@ JUDYLCODE(PPvoid_t PPvalue;)  // pointer from JudyLGet().
 
 // COMPRESS A BRANCH[LBU] TO A LEAFW:
 //
+            JU_STAT(js_Decascades);
             Pjlwnew = j__udyAllocJLW(cJU_LEAFW_MAXPOP1);
             JU_CHECKALLOC(Pjlw_t, Pjlwnew, JERRI);
 
@@ -0,0 +1,313 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/src/JudyCommon/JudyFinger.c $
+//
+// Judy1SetF(), Judy1NextF(), JudyLInsF() and JudyLNextF() functions for
+// Judy1 and JudyL:  Versions of Judy1Set(), Judy1Next(), JudyLIns() and
+// JudyLNext() that start from a caller-owned finger, which remembers the leaf
+// JP reached last.  Judy1TestF() and JudyLGetF() come from JudyGet.c compiled
+// with -DJUDYGETFINGER; they are the only functions that set a finger.
+// Compile with one of -DJUDY1 or -DJUDYL.
+//
+// A finger is valid only while its arrays JPM change count (jpm_Gen) is the
+// same as when the finger was set.  Every successful insert or delete bumps
+// the change count, and each new JPM starts from a different count, so a
+// stale finger (even one into a freed and reallocated array) is never
+// followed.  Only leaf JPs below a JPM are remembered; immediate JPs live in
+// their parent branch, which a finger does not remember, and root leaves
+// (arrays without a JPM) need no descent anyway.
+//
+// Note:  A finger cannot help insert a new Index, because the population of
+// every branch above the leaf must be updated on the way down, so the *SetF /
+// *InsF functions use the finger only to short-cut an Index that is already
+// present, and otherwise do a normal insert (which invalidates the finger).
+
+#if (! (defined(JUDY1) || defined(JUDYL)))
+#error:  One of -DJUDY1 or -DJUDYL must be specified.
+#endif
+
+#ifdef JUDY1
+#include "Judy1.h"
+#else
+#include "JudyL.h"
+#endif
+
+#include "JudyPrivate1L.h"
+
+// IS A FINGER VALID FOR AN INDEX IN AN ARRAY:
+//
+// The root leaf check must come before the JPM is referenced, because a root
+// leaf can be allocated where a JPM used to be.  This mirrors the check in
+// Judy1TestF() / JudyLGetF().
+
+#define JU_FINGERVALID(PFINGER,PARRAY,INDEX)                    \
+        (((PFINGER) != (PJFinger_t) NULL)                       \
+      && ((PARRAY) != (Pcvoid_t) NULL)                          \
+      && ((PFINGER)->jf_PArray == (PARRAY))                     \
+      && (JU_LEAFW_POP0(PARRAY) >= cJU_LEAFW_MAXPOP1)           \
+      && ((PFINGER)->jf_Gen == P_JPM(PARRAY)->jpm_Gen)          \
+      && ((((INDEX) ^ (PFINGER)->jf_Index) & (PFINGER)->jf_Mask) == 0))
+
+
+#ifdef JUDY1
+// ****************************************************************************
+// J U D Y   1   S E T   F
+//
+// See the Judy*(3C) manual entry for details, except for the finger.
+
+FUNCTION int Judy1SetF
+#else
+// ****************************************************************************
+// J U D Y   L   I N S   F
+//
+// See the Judy*(3C) manual entry for details, except for the finger.
+
+FUNCTION PPvoid_t JudyLInsF
+#endif
+        (
+        PPvoid_t   PPArray,     // in which to insert.
+        Word_t     Index,       // to insert.
+        PJFinger_t PFinger,     // last leaf visited; null for none.
+        PJError_t  PJError      // optional, for returning error info.
+        )
+{
+#ifdef JUDYL
+        PPvoid_t   PPValue;     // from JudyLGetF().
+#endif
+
+// Only probe for an existing Index when the finger can answer without a
+// descent; otherwise the probe would double the cost of inserting a new
+// Index.  Judy1Set() / JudyLIns() check PPArray for null themselves:
+
+        if ((PPArray != (PPvoid_t) NULL)
+         && JU_FINGERVALID(PFinger, *PPArray, Index))
+        {
+#ifdef JUDY1
+            switch (Judy1TestF(*PPArray, Index, PFinger, PJError))
+            {
+            case 1:     return(0);      // already set.
+            case JERRI: return(JERRI);
+            }
+#else
+            PPValue = JudyLGetF(*PPArray, Index, PFinger, PJError);
+            if (PPValue != (PPvoid_t) NULL) return(PPValue);    // or PPJERR.
+#endif
+        }
+
+        JUDY1CODE(return(Judy1Set(PPArray, Index, PJError));)
+        JUDYLCODE(return(JudyLIns(PPArray, Index, PJError));)
+
+} // Judy1SetF() / JudyLInsF()
+
+
+// ****************************************************************************
+// LEAF INDEX COPY MACROS:
+//
+// Fetch the Index bytes at offset OFFSET in a linear leaf into a Word_t.
+
+#define JU_FINGERCOPY1(DEST,PJLL,OFFSET) \
+        (DEST) = ((uint8_t  *) (PJLL))[OFFSET]
+#define JU_FINGERCOPY2(DEST,PJLL,OFFSET) \
+        (DEST) = ((uint16_t *) (PJLL))[OFFSET]
+#define JU_FINGERCOPY3(DEST,PJLL,OFFSET) \
+        JU_COPY3_PINDEX_TO_LONG(DEST, ((uint8_t *) (PJLL)) + ((OFFSET) * 3))
+
+#ifdef JU_64BIT
+#define JU_FINGERCOPY4(DEST,PJLL,OFFSET) \
+        (DEST) = ((uint32_t *) (PJLL))[OFFSET]
+#define JU_FINGERCOPY5(DEST,PJLL,OFFSET) \
+        JU_COPY5_PINDEX_TO_LONG(DEST, ((uint8_t *) (PJLL)) + ((OFFSET) * 5))
+#define JU_FINGERCOPY6(DEST,PJLL,OFFSET) \
+        JU_COPY6_PINDEX_TO_LONG(DEST, ((uint8_t *) (PJLL)) + ((OFFSET) * 6))
+#define JU_FINGERCOPY7(DEST,PJLL,OFFSET) \
+        JU_COPY7_PINDEX_TO_LONG(DEST, ((uint8_t *) (PJLL)) + ((OFFSET) * 7))
+#endif
+
+
+// NEXT INDEX IN A LINEAR LEAF:
+//
+// Look for the first Index at or after Index (already incremented) in the
+// leaf.  If there is one, return it in *PIndex with the leading bytes from
+// Index.  If Index is outside a narrow pointers expanse or past the last Index
+// in the leaf, break out of the switch to do it the slow way.
+
+#define JU_FINGERNEXTLEAF(cLevel,SearchLeaf,CopyIndex,ValueArea)        \
+        {                                                               \
+            Pjll_t Pjll = P_JLL(Pjp->jp_Addr);                          \
+            Word_t pop1 = JU_JPLEAF_POP0(Pjp) + 1;                      \
+            Word_t leafindex;                                           \
+            int    posidx;                                              \
+                                                                        \
+            if (JU_DCDNOTMATCHINDEX(Index, Pjp, cLevel)) break;         \
+                                                                        \
+            if ((posidx = SearchLeaf(Pjll, pop1, Index)) < 0)           \
+                posidx = ~posidx;                                       \
+                                                                        \
+            if ((Word_t) posidx >= pop1) break;                         \
+                                                                        \
+            CopyIndex(leafindex, Pjll, posidx);                         \
+            *PIndex = (Index & ~JU_LEASTBYTESMASK(cLevel)) | leafindex; \
+                                                                        \
+            JUDY1CODE(return(1);)                                       \
+            JUDYLCODE(return((PPvoid_t) (ValueArea(Pjll, pop1) + posidx));) \
+        }
+
+
+#ifdef JUDY1
+// ****************************************************************************
+// J U D Y   1   N E X T   F
+//
+// See the Judy*(3C) manual entry for details, except for the finger.
+
+FUNCTION int Judy1NextF
+#else
+// ****************************************************************************
+// J U D Y   L   N E X T   F
+//
+// See the Judy*(3C) manual entry for details, except for the finger.
+
+FUNCTION PPvoid_t JudyLNextF
+#endif
+        (
+        Pcvoid_t   PArray,      // to search.
+        Word_t *   PIndex,      // starting point and result.
+        PJFinger_t PFinger,     // last leaf visited; null for none.
+        PJError_t  PJError      // optional, for returning error info.
+        )
+{
+        Pjp_t      Pjp;         // leaf JP from the finger.
+        Word_t     Index;       // first Index to look for.
+#ifdef JUDY1
+        int        retcode;     // from Judy1Next().
+#else
+        PPvoid_t   PPValue;     // from JudyLNext().
+#endif
+
+        if (PIndex == (PWord_t) NULL)
+        {
+            JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+            JUDY1CODE(return(JERRI );)
+            JUDYLCODE(return(PPJERR);)
+        }
+
+// The finger is useful only if Index + 1 is in the expanse of the leaf it
+// remembers.  Index + 1 wrapping to 0 can never be, since there is no next
+// Index, but the leading bytes would match a leaf whose expanse includes 0:
+
+        Index = *PIndex + 1;
+
+        if ((Index != 0) && JU_FINGERVALID(PFinger, PArray, Index))
+        {
+            Pjp = (Pjp_t) (PFinger->jf_Pjp);
+
+            switch (JU_JPTYPE(Pjp))
+            {
+#if (defined(JUDYL) || (! defined(JU_64BIT)))
+            case cJU_JPLEAF1:
+                JU_FINGERNEXTLEAF(1, j__udySearchLeaf1, JU_FINGERCOPY1,
+                                  JL_LEAF1VALUEAREA);
+#endif
+            case cJU_JPLEAF2:
+                JU_FINGERNEXTLEAF(2, j__udySearchLeaf2, JU_FINGERCOPY2,
+                                  JL_LEAF2VALUEAREA);
+            case cJU_JPLEAF3:
+                JU_FINGERNEXTLEAF(3, j__udySearchLeaf3, JU_FINGERCOPY3,
+                                  JL_LEAF3VALUEAREA);
+#ifdef JU_64BIT
+            case cJU_JPLEAF4:
+                JU_FINGERNEXTLEAF(4, j__udySearchLeaf4, JU_FINGERCOPY4,
+                                  JL_LEAF4VALUEAREA);
+            case cJU_JPLEAF5:
+                JU_FINGERNEXTLEAF(5, j__udySearchLeaf5, JU_FINGERCOPY5,
+                                  JL_LEAF5VALUEAREA);
+            case cJU_JPLEAF6:
+                JU_FINGERNEXTLEAF(6, j__udySearchLeaf6, JU_FINGERCOPY6,
+                                  JL_LEAF6VALUEAREA);
+            case cJU_JPLEAF7:
+                JU_FINGERNEXTLEAF(7, j__udySearchLeaf7, JU_FINGERCOPY7,
+                                  JL_LEAF7VALUEAREA);
+#endif
+
+// Bitmap leaf:  Find the lowest set bit at or above Index's digit, one
+// subexpanse at a time:
+
+            case cJU_JPLEAF_B1:
+            {
+                Pjlb_t    Pjlb = P_JLB(Pjp->jp_Addr);
+                Word_t    digit;
+                Word_t    subexp;
+                BITMAPL_t bitmap;
+                BITMAPL_t bitmask;
+
+                if (JU_DCDNOTMATCHINDEX(Index, Pjp, 1)) break;
+
+                digit  = JU_DIGITATSTATE(Index, 1);
+                subexp = digit / cJU_BITSPERSUBEXPL;
+                bitmap = JU_JLB_BITMAP(Pjlb, subexp)
+                       & ~(JU_BITPOSMASKL(digit) - 1);
+
+                while (bitmap == 0)
+                {
+                    if (++subexp >= cJU_NUMSUBEXPL) break;
+                    bitmap = JU_JLB_BITMAP(Pjlb, subexp);
+                }
+                if (bitmap == 0) break;         // no more in this leaf.
+
+                bitmask = bitmap & (~bitmap + 1);       // lowest set bit.
+                digit   = (subexp * cJU_BITSPERSUBEXPL)
+                        + j__udyCountBitsL(bitmask - 1);
+
+                *PIndex = (Index & ~JU_LEASTBYTESMASK(1)) | digit;
+
+                JUDY1CODE(return(1);)
+                JUDYLCODE(return((PPvoid_t) (P_JV(JL_JLB_PVALUE(Pjlb, subexp))
+                    + j__udyCountBitsL(JU_JLB_BITMAP(Pjlb, subexp)
+                                     & (bitmask - 1))));)
+            }
+
+#ifdef JUDY1
+// Full population leaf:  Index itself is next, if it is in the expanse:
+
+            case cJ1_JPFULLPOPU1:
+
+                if (JU_DCDNOTMATCHINDEX(Index, Pjp, 1)) break;
+
+                *PIndex = Index;
+                return(1);
+#endif
+            } // switch
+        }
+
+// Slow way:  Do a normal search from the root, then look up the result with
+// the finger to set it to that Indexs leaf, so the next call can use it:
+
+#ifdef JUDY1
+        if ((retcode = Judy1Next(PArray, PIndex, PJError)) != 1)
+            return(retcode);
+
+        return(Judy1TestF(PArray, *PIndex, PFinger, PJError));
+#else
+        PPValue = JudyLNext(PArray, PIndex, PJError);
+
+        if ((PPValue == (PPvoid_t) NULL) || (PPValue == PPJERR))
+            return(PPValue);
+
+        return(JudyLGetF(PArray, *PIndex, PFinger, PJError));
+#endif
+
+} // Judy1NextF() / JudyLNextF()
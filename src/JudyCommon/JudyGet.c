@@ -19,6 +19,9 @@
 //
 // Judy1Test() and JudyLGet() functions for Judy1 and JudyL.
 // Compile with one of -DJUDY1 or -DJUDYL.
+//
+// Compile with -DJUDYGETFINGER to get Judy1TestF() and JudyLGetF() instead,
+// which start from, and update, a caller-owned finger; see JudyFinger.c.
 
 #if (! (defined(JUDY1) || defined(JUDYL)))
 #error:  One of -DJUDY1 or -DJUDYL must be specified.
@@ -49,16 +52,24 @@
 #ifdef JUDYGETINLINE
 FUNCTION int j__udy1Test
 #else
+#ifdef JUDYGETFINGER
+FUNCTION int Judy1TestF
+#else
 FUNCTION int Judy1Test
 #endif
+#endif
 
 #else  // JUDYL
 
 #ifdef JUDYGETINLINE
 FUNCTION PPvoid_t j__udyLGet
 #else
+#ifdef JUDYGETFINGER
+FUNCTION PPvoid_t JudyLGetF
+#else
 FUNCTION PPvoid_t JudyLGet
 #endif
+#endif
 
 #endif // JUDYL
         (
@@ -68,6 +79,9 @@ FUNCTION PPvoid_t JudyLGet
 #else
         Pcvoid_t  PArray,       // from which to retrieve.
         Word_t    Index,        // to retrieve.
+#ifdef JUDYGETFINGER
+        PJFinger_t PFinger,     // last leaf visited; null for none.
+#endif
         PJError_t PJError       // optional, for returning error info.
 #endif
         )
@@ -95,6 +109,7 @@ FUNCTION PPvoid_t JudyLGet
             Pjlw_t Pjlw = P_JLW(PArray);        // first word of leaf.
             int    posidx;                      // signed offset in leaf.
 
+            JU_STATLEAFW();
             Pop1   = Pjlw[0] + 1;
             posidx = j__udySearchLeafW(Pjlw + 1, Pop1, Index);
 
@@ -112,6 +127,21 @@ FUNCTION PPvoid_t JudyLGet
         Pjpm = P_JPM(PArray);
         Pjp = &(Pjpm->jpm_JP);  // top branch is below JPM.
 
+#ifdef JUDYGETFINGER
+
+// If the finger was set in this array, the array has not changed since, and
+// Index is in the expanse of the leaf it remembers, start the walk at that
+// leaf instead of at the top branch:
+
+        if ((PFinger != (PJFinger_t) NULL)
+         && (PFinger->jf_PArray == PArray)
+         && (PFinger->jf_Gen    == Pjpm->jpm_Gen)
+         && (((Index ^ PFinger->jf_Index) & PFinger->jf_Mask) == 0))
+        {
+            Pjp = (Pjp_t) (PFinger->jf_Pjp);
+        }
+#endif
+
 // ****************************************************************************
 // WALK THE JUDY TREE USING A STATE MACHINE:
 
@@ -119,6 +149,26 @@ ContinueWalk:           // for going down one level; come here with Pjp set.
 
 #ifdef TRACEJPR
         JudyPrintJP(Pjp, "g", __LINE__);
+#endif
+        JU_STATJP(Pjp);
+
+#ifdef JUDYGETFINGER
+
+// Upon reaching any kind of leaf other than an immediate, remember it in the
+// finger.  Index, not the leafs own Decode bytes, supplies the leading bytes
+// because those are what select this JP, even if Index turns out to be
+// outside a narrow pointers expanse:
+
+        if ((JU_JPTYPE(Pjp) > cJU_JPBRANCH_U)
+         && (JU_JPTYPE(Pjp) < cJU_JPIMMED_1_01)
+         && (PFinger != (PJFinger_t) NULL))
+        {
+            PFinger->jf_PArray = PArray;
+            PFinger->jf_Gen    = Pjpm->jpm_Gen;
+            PFinger->jf_Pjp    = (Pvoid_t) Pjp;
+            PFinger->jf_Index  = Index;
+            PFinger->jf_Mask   = ~JU_LEASTBYTESMASK(JU_FINGERLEVEL(Pjp));
+        }
 #endif
         switch (JU_JPTYPE(Pjp))
         {
@@ -646,6 +696,14 @@ if (((LEAF_T *)((PJP)->jp_1Index))[(IDX) - 1] == (LEAF_T)(INDEX))       \
 
 #ifdef JUDYL
 
+// Note:  Only the *_01 immediates hold their value in the JP itself (in
+// jp_Addr, see above).  A JudyL JP is two words, and the Indexes and JP Type
+// fill the second, so a multi-Index immediate has one word left, which must
+// point to a separate value area.  The values cannot be packed smaller
+// either, because JudyLGet() and friends return a PPvoid_t to a whole Word_t
+// value.  Holding even two values in the JP would take a three-word JP, which
+// would make every branch half again as big.
+
 #define CHECKINDEXNATIVE(LEAF_T, PJP, IDX, INDEX)                       \
 if (((LEAF_T *)((PJP)->jp_LIndex))[(IDX) - 1] == (LEAF_T)(INDEX))       \
         return((PPvoid_t)(P_JV((PJP)->jp_Addr) + (IDX) - 1))
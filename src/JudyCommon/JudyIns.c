@@ -175,6 +175,7 @@ ContinueInsWalk:                // for modifying state without recursing.
 #ifdef TRACEJP
         JudyPrintJP(Pjp, "i", __LINE__);
 #endif
+        JU_STATJP(Pjp);
 
         switch (JU_JPTYPE(Pjp)) // entry:  Pjp, Index.
         {
@@ -271,7 +272,7 @@ JudyBranchL:
 
 // If population under this branch greater than:
 
-            if (exppop1 > JU_BRANCHL_MAX_POP)
+            if (exppop1 > JU_TUNE(jt_BranchLMaxPop))
                 goto ConvertBranchLtoU;
 
             numJPs = Pjbl->jbl_NumJPs;
@@ -467,20 +468,22 @@ ConvertBranchLtoU:
 
 JudyBranchB:
 
-// If population increment is greater than..  (300):
+// If population increment is greater than..  (300 by default):
 
-            if ((Pjpm->jpm_Pop0 - Pjpm->jpm_LastUPop0) > JU_BTOU_POP_INCREMENT)
+            if ((Pjpm->jpm_Pop0 - Pjpm->jpm_LastUPop0)
+              > JU_TUNE(jt_BToUPopIncrement))
             {
 
-// If total population of array is greater than..  (750):
+// If total population of array is greater than..  (750 by default):
 
-                if (Pjpm->jpm_Pop0 > JU_BRANCHB_MAX_POP)
+                if (Pjpm->jpm_Pop0 > JU_TUNE(jt_BranchBMaxPop))
                 {
 
-// If population under the branch is greater than..  (135):
+// If population under the branch is greater than..  (135 by default):
 
-                    if (exppop1 > JU_BRANCHB_MIN_POP)
+                    if (exppop1 > JU_TUNE(jt_BranchBMinPop))
                     {
+                        JU_STAT(js_BranchBToU);
                         if (j__udyCreateBranchU(Pjp, Pjpm) == -1) return(-1);
 
 // Save global population of last BranchU conversion:
@@ -737,6 +740,7 @@ JudyBranchB:
                                                                         \
         if (GrowInPlace(exppop1))       /* add to current leaf */       \
         {                                                               \
+            JU_STAT(js_LeafGrowInPlace);                                \
             InsertInPlace(Pleaf, exppop1, offset, Index);               \
             JU_LEAFGROWVALUEADD(Pjv, exppop1, offset);                  \
             DBGCODE(JudyCheckSorted((Pjll_t) Pleaf, exppop1 + 1, cIS);) \
@@ -747,6 +751,7 @@ JudyBranchB:
         {                                                               \
             Pjll_t PjllnewRaw;                                          \
             Type   Pleafnew;                                            \
+            JU_STAT(js_LeafRealloc);                                    \
             if ((PjllnewRaw = Alloc(exppop1 + 1, Pjpm)) == 0) return(-1); \
             Pleafnew = (Type) P_JLL(PjllnewRaw);                        \
             InsertCopy(Pleafnew, Pleaf, exppop1, offset, Index);        \
@@ -762,6 +767,7 @@ JudyBranchB:
 // leaves:
 
 #define JU_LEAFCASCADE(MaxPop1,Cascade,Free)            \
+        JU_STAT(js_Cascades);                           \
         if (Cascade(Pjp, Pjpm) == -1) return(-1);       \
         Free(PjllRaw, MaxPop1, Pjpm);                   \
         goto ContinueInsWalk
@@ -919,6 +925,7 @@ JudyBranchB:
 
             if (JL_LEAFVGROWINPLACE(exppop1))
             {
+                JU_STAT(js_LeafGrowInPlace);
                 JU_INSERTINPLACE(Pjv, exppop1, offset, 0);
                 JU_JLB_BITMAP(Pjlb, subexp) |= bitmask;  // set Indexs bit.
                 Pjpm->jpm_PValue = Pjv + offset;          // new value area.
@@ -927,6 +934,8 @@ JudyBranchB:
 
 // Increase size of value area:
 
+            JU_STAT(js_LeafRealloc);
+
             if ((PjvnewRaw = j__udyLAllocJV(exppop1 + 1, Pjpm))
              == (Pjv_t) NULL) return(-1);
             Pjvnew = P_JV(PjvnewRaw);
@@ -1754,6 +1763,7 @@ FUNCTION PPvoid_t JudyLIns
 #ifdef JUDYL
             Pjv = JL_LEAFWVALUEAREA(Pjlw, pop1);
 #endif
+            JU_STATLEAFW();
             offset = j__udySearchLeafW(Pjlw + 1, pop1, Index);
 
             if (offset >= 0)            // index is already valid:
@@ -1769,6 +1779,7 @@ FUNCTION PPvoid_t JudyLIns
 
             if (JU_LEAFWGROWINPLACE(pop1))
             {
+                JU_STAT(js_LeafGrowInPlace);
                 ++Pjlw[0];                      // increase population.
 
                 JU_INSERTINPLACE(Pjlw + 1, pop1, offset, Index);
@@ -1786,6 +1797,7 @@ FUNCTION PPvoid_t JudyLIns
 
             if (pop1 < cJU_LEAFW_MAXPOP1)       // can grow to a larger leaf.
             {
+                JU_STAT(js_LeafRealloc);
                 Pjlwnew = j__udyAllocJLW(pop1 + 1);
                 JUDY1CODE(JU_CHECKALLOC(Pjlw_t, Pjlwnew, JERRI );)
                 JUDYLCODE(JU_CHECKALLOC(Pjlw_t, Pjlwnew, PPJERR);)
@@ -1822,6 +1834,7 @@ FUNCTION PPvoid_t JudyLIns
             (Pjpm->jpm_Pop0)       = cJU_LEAFW_MAXPOP1 - 1;
             (Pjpm->jpm_JP.jp_Addr) = (Word_t) Pjlw;
 
+            JU_STAT(js_Cascades);
             if (j__udyCascadeL(&(Pjpm->jpm_JP), Pjpm) == -1)
             {
                 JU_COPY_ERRNO(PJError, Pjpm);
@@ -1846,6 +1859,11 @@ FUNCTION PPvoid_t JudyLIns
             Pjpm = P_JPM(*PPArray);
             retcode = j__udyInsWalk(&(Pjpm->jpm_JP), Index, Pjpm);
 
+// Any change to the tree, even a failed partial one, invalidates fingers (see
+// JudyFinger.c); an Index that was already present changes nothing:
+
+            if (retcode != 0) ++(Pjpm->jpm_Gen);
+
             if (retcode == -1)
             {
                 JU_COPY_ERRNO(PJError, Pjpm);
@@ -281,7 +281,7 @@ const   Word_t *  const PValue, // list of corresponding values.
         if (Count == 0) return(1);              // *PPArray remains null.
 
         {
-            Pjlw      = j__udyAllocJLW(Count + 1);
+            Pjlw      = j__udyAllocJLW(Count);
                         JU_CHECKALLOC(Pjlw_t, Pjlw, JERRI);
             *PPArray  = (Pvoid_t) Pjlw;
             Pjlw[0]   = Count - 1;              // set pop0.
@@ -1037,7 +1037,7 @@ ClearBranch:
             Pjbl_t PjblRaw = (Pjbl_t) NULL;     // new BranchL; init for cc.
             Pjbl_t Pjbl;
 
-            if ((*PPop1 > JU_BRANCHL_MAX_POP)   // pop too high.
+            if ((*PPop1 > JU_TUNE(jt_BranchLMaxPop)) // pop too high.
              || ((PjblRaw = j__udyAllocJBL(Pjpm)) == (Pjbl_t) NULL))
             {                                   // cant alloc BranchL.
                 goto SetParent;                 // just keep BranchU.
@@ -1085,7 +1085,7 @@ ClearBranch:
             Pjbb_t Pjbb;
             Pjp_t  Pjp2;                        // in BranchU.
 
-            if ((*PPop1 > JU_BRANCHB_MAX_POP)   // pop too high.
+            if ((*PPop1 > JU_TUNE(jt_BranchBMaxPop)) // pop too high.
              || ((PjbbRaw = j__udyAllocJBB(Pjpm)) == (Pjbb_t) NULL))
             {                                   // cant alloc BranchB.
                 goto SetParent;                 // just keep BranchU.
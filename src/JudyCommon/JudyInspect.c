@@ -0,0 +1,420 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/src/JudyCommon/JudyInspect.c $
+//
+// Judy1Inspect() and JudyLInspect() functions for Judy1 and JudyL:  Walk an
+// array once and describe its structure in a JInspect_t; see Judy.h.
+// Compile with one of -DJUDY1 or -DJUDYL.
+//
+// Memory is counted in the words actually allocated for each object (as in
+// JudyMallocIF.c), not in the words in use, so for an array with a JPM the
+// total equals Judy1MemUsed() / JudyLMemUsed().  The tree walk is modeled on
+// JudyMemActive.c.
+
+#if (! (defined(JUDY1) || defined(JUDYL)))
+#error:  One of -DJUDY1 or -DJUDYL must be specified.
+#endif
+
+#include <string.h>                     // for memset().
+
+#ifdef JUDY1
+#include "Judy1.h"
+#else
+#include "JudyL.h"
+#endif
+
+#include "JudyPrivate1L.h"
+
+FUNCTION static int j__udyInspectJP(Pjp_t, Word_t, PJInspect_t);
+
+
+// COUNT ONE NODE:
+//
+// Add a node of Words words holding Pop1 Indexes or JPs, out of Slots, to
+// JInspectNode_t NODE.
+
+#define JU_INSPECTNODE(NODE,Words,Pop1,Slots)                   \
+        {                                                       \
+            ++((NODE).jin_Count);                               \
+            (NODE).jin_Bytes += (Words) * cJU_BYTESPERWORD;     \
+            (NODE).jin_Pop1  += (Pop1);                         \
+            (NODE).jin_Slots += (Slots);                        \
+        }
+
+// ROOM IN AN OBJECT SIZED BY A POP-TO-WORDS TABLE:
+//
+// Objects grow in place (see JU_LEAF*GROWINPLACE()) as long as the next
+// larger population needs the same number of words, so that is the number
+// of Indexes the object has room for.
+
+#define JU_INSPECTSLOTS(PopToWords,Pop1,MaxPop1,Slots)          \
+        {                                                       \
+            Word_t words_ = PopToWords(Pop1);                   \
+                                                                \
+            for ((Slots) = (Pop1);                              \
+                 ((Slots) < (MaxPop1))                          \
+              && (PopToWords((Slots) + 1) == words_);           \
+                 ++(Slots));                                    \
+        }
+
+
+#ifdef JUDY1
+// ****************************************************************************
+// J U D Y   1   I N S P E C T
+//
+// Return total bytes used by PArray, or JERR.
+
+FUNCTION Word_t Judy1Inspect
+#else
+// ****************************************************************************
+// J U D Y   L   I N S P E C T
+//
+// Return total bytes used by PArray, or JERR.
+
+FUNCTION Word_t JudyLInspect
+#endif
+        (
+        Pcvoid_t    PArray,     // to inspect.
+        PJInspect_t PInspect,   // where to return the results.
+        PJError_t   PJError     // optional, for returning error info.
+        )
+{
+        Word_t      level;
+        Word_t      pop1;
+
+        if (PInspect == (PJInspect_t) NULL)
+        {
+            JU_SET_ERRNO(PJError, JU_ERRNO_NULLPVALUE);
+            return(JERR);
+        }
+
+        memset((void *) PInspect, 0, sizeof(JInspect_t));
+
+        if (PArray == (Pcvoid_t) NULL) return(0);
+
+// Root leaf (small array), counted as Leaf[cJU_ROOTSTATE]:
+
+        if (JU_LEAFW_POP0(PArray) < cJU_LEAFW_MAXPOP1)
+        {
+            Pjlw_t Pjlw = P_JLW(PArray);        // first word of leaf.
+            Word_t slots;
+
+            pop1 = Pjlw[0] + 1;
+            JU_INSPECTSLOTS(JU_LEAFWPOPTOWORDS, pop1, cJU_LEAFW_MAXPOP1, slots);
+            JU_INSPECTNODE(PInspect->ji_Leaf[cJU_ROOTSTATE],
+                           JU_LEAFWPOPTOWORDS(pop1), pop1, slots);
+        }
+        else
+        {
+            Pjpm_t Pjpm = P_JPM(PArray);
+
+            PInspect->ji_JPMBytes = sizeof(jpm_t);
+
+            if (j__udyInspectJP(&(Pjpm->jpm_JP), 1, PInspect) == -1)
+            {
+                JU_SET_ERRNO(PJError, JU_ERRNO_CORRUPT);
+                return(JERR);
+            }
+        }
+
+// Sum up the totals:
+
+        PInspect->ji_TotalBytes = PInspect->ji_JPMBytes
+                                + PInspect->ji_LeafB1.jin_Bytes
+                                + PInspect->ji_Values.jin_Bytes;
+
+        for (level = 0; level < JI_LEVELS; ++level)
+        {
+            Word_t pop;
+
+            PInspect->ji_TotalBytes += PInspect->ji_BranchL[level].jin_Bytes
+                                     + PInspect->ji_BranchB[level].jin_Bytes
+                                     + PInspect->ji_BranchU[level].jin_Bytes
+                                     + PInspect->ji_Leaf[level].jin_Bytes;
+
+            PInspect->ji_Population += PInspect->ji_Leaf[level].jin_Pop1;
+
+            for (pop = 0; pop < JI_MAXIMMED; ++pop)
+                PInspect->ji_Population += PInspect->ji_Immed[level][pop].jin_Pop1;
+        }
+
+        PInspect->ji_Population += PInspect->ji_LeafB1.jin_Pop1
+                                +  PInspect->ji_FullPopu1.jin_Pop1;
+
+        return(PInspect->ji_TotalBytes);
+
+} // Judy1Inspect() / JudyLInspect()
+
+
+// ****************************************************************************
+// __ J U D Y   I N S P E C T   J P
+//
+// Count the subtree under Pjp, which is Depth JPs down from the JPM.  Return
+// -1 for an unexpected JP Type, otherwise 0.
+
+FUNCTION static int j__udyInspectJP(
+        Pjp_t       Pjp,        // top of subtree.
+        Word_t      Depth,      // of Pjp, 1 for the JPM's JP.
+        PJInspect_t PInspect)   // to add to.
+{
+        uint8_t     type = JU_JPTYPE(Pjp);
+        Word_t      level;      // of a branch or leaf.
+        Word_t      offset;     // in a branch.
+        Word_t      pop1;       // in a leaf or immediate.
+        Word_t      slots;      // room in a leaf.
+        Word_t      words;      // in a leaf.
+
+        if (Depth > PInspect->ji_MaxDepth) PInspect->ji_MaxDepth = Depth;
+
+        switch (type)
+        {
+
+// Null JPs are counted only as empty slots in their parent branch:
+
+        case cJU_JPNULL1:
+        case cJU_JPNULL2:
+        case cJU_JPNULL3:
+#ifdef JU_64BIT
+        case cJU_JPNULL4:
+        case cJU_JPNULL5:
+        case cJU_JPNULL6:
+        case cJU_JPNULL7:
+#endif
+            return(0);
+
+// ****************************************************************************
+// BRANCHES:
+
+        case cJU_JPBRANCH_L2:
+        case cJU_JPBRANCH_L3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_L4:
+        case cJU_JPBRANCH_L5:
+        case cJU_JPBRANCH_L6:
+        case cJU_JPBRANCH_L7:
+#endif
+        case cJU_JPBRANCH_L:
+        {
+            Pjbl_t Pjbl = P_JBL(Pjp->jp_Addr);
+
+            level = type - cJU_JPBRANCH_L2 + 2;
+            JU_INSPECTNODE(PInspect->ji_BranchL[level],
+                           sizeof(jbl_t) / cJU_BYTESPERWORD,
+                           Pjbl->jbl_NumJPs, cJU_BRANCHLMAXJPS);
+
+            for (offset = 0; offset < (Pjbl->jbl_NumJPs); ++offset)
+            {
+                if (j__udyInspectJP((Pjbl->jbl_jp) + offset, Depth + 1,
+                                    PInspect) == -1) return(-1);
+            }
+            return(0);
+        }
+
+        case cJU_JPBRANCH_B2:
+        case cJU_JPBRANCH_B3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_B4:
+        case cJU_JPBRANCH_B5:
+        case cJU_JPBRANCH_B6:
+        case cJU_JPBRANCH_B7:
+#endif
+        case cJU_JPBRANCH_B:
+        {
+            Pjbb_t Pjbb = P_JBB(Pjp->jp_Addr);
+            Word_t subexp;
+            Word_t jpcount;
+            Pjp_t  Pjp2;
+
+            level = type - cJU_JPBRANCH_B2 + 2;
+            JU_INSPECTNODE(PInspect->ji_BranchB[level],
+                           sizeof(jbb_t) / cJU_BYTESPERWORD, 0, 0);
+
+// Each subexpanse with any JPs has its own JP subarray:
+
+            for (subexp = 0; subexp < cJU_NUMSUBEXPB; ++subexp)
+            {
+                if ((jpcount = j__udyCountBitsB(JU_JBB_BITMAP(Pjbb, subexp)))
+                    == 0) continue;
+
+                words = JU_BRANCHJP_NUMJPSTOWORDS(jpcount);
+
+                PInspect->ji_BranchB[level].jin_Bytes
+                    += words * cJU_BYTESPERWORD;
+                PInspect->ji_BranchB[level].jin_Pop1  += jpcount;
+                PInspect->ji_BranchB[level].jin_Slots
+                    += (words * cJU_BYTESPERWORD) / sizeof(jp_t);
+
+                Pjp2 = P_JP(JU_JBB_PJP(Pjbb, subexp));
+
+                for (offset = 0; offset < jpcount; ++offset)
+                {
+                    if (j__udyInspectJP(Pjp2 + offset, Depth + 1, PInspect)
+                        == -1) return(-1);
+                }
+            }
+            return(0);
+        }
+
+        case cJU_JPBRANCH_U2:
+        case cJU_JPBRANCH_U3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_U4:
+        case cJU_JPBRANCH_U5:
+        case cJU_JPBRANCH_U6:
+        case cJU_JPBRANCH_U7:
+#endif
+        case cJU_JPBRANCH_U:
+        {
+            Pjbu_t Pjbu = P_JBU(Pjp->jp_Addr);
+            Word_t numJPs = 0;
+
+            level = type - cJU_JPBRANCH_U2 + 2;
+
+            for (offset = 0; offset < cJU_BRANCHUNUMJPS; ++offset)
+            {
+                if (((Pjbu->jbu_jp[offset].jp_Type) >= cJU_JPNULL1)
+                 && ((Pjbu->jbu_jp[offset].jp_Type) <= cJU_JPNULLMAX))
+                {
+                    continue;           // skip null JP to save time.
+                }
+
+                ++numJPs;
+
+                if (j__udyInspectJP(Pjbu->jbu_jp + offset, Depth + 1,
+                                    PInspect) == -1) return(-1);
+            }
+
+            JU_INSPECTNODE(PInspect->ji_BranchU[level],
+                           sizeof(jbu_t) / cJU_BYTESPERWORD,
+                           numJPs, cJU_BRANCHUNUMJPS);
+            return(0);
+        }
+
+
+// ****************************************************************************
+// LINEAR LEAVES:
+
+#define JU_INSPECTLEAF(cIS,PopToWords,MaxPop1)                          \
+        pop1  = JU_JPLEAF_POP0(Pjp) + 1;                                \
+        words = PopToWords(pop1);                                       \
+        JU_INSPECTSLOTS(PopToWords, pop1, MaxPop1, slots);              \
+        JU_INSPECTNODE(PInspect->ji_Leaf[cIS], words, pop1, slots);     \
+        return(0)
+
+#if (defined(JUDYL) || (! defined(JU_64BIT)))
+        case cJU_JPLEAF1:
+            JU_INSPECTLEAF(1, JU_LEAF1POPTOWORDS, cJU_LEAF1_MAXPOP1);
+#endif
+        case cJU_JPLEAF2:
+            JU_INSPECTLEAF(2, JU_LEAF2POPTOWORDS, cJU_LEAF2_MAXPOP1);
+        case cJU_JPLEAF3:
+            JU_INSPECTLEAF(3, JU_LEAF3POPTOWORDS, cJU_LEAF3_MAXPOP1);
+#ifdef JU_64BIT
+        case cJU_JPLEAF4:
+            JU_INSPECTLEAF(4, JU_LEAF4POPTOWORDS, cJU_LEAF4_MAXPOP1);
+        case cJU_JPLEAF5:
+            JU_INSPECTLEAF(5, JU_LEAF5POPTOWORDS, cJU_LEAF5_MAXPOP1);
+        case cJU_JPLEAF6:
+            JU_INSPECTLEAF(6, JU_LEAF6POPTOWORDS, cJU_LEAF6_MAXPOP1);
+        case cJU_JPLEAF7:
+            JU_INSPECTLEAF(7, JU_LEAF7POPTOWORDS, cJU_LEAF7_MAXPOP1);
+#endif
+
+
+// ****************************************************************************
+// BITMAP LEAF:
+//
+// For JudyL, each subexpanse with any Indexes has its own value area.
+
+        case cJU_JPLEAF_B1:
+        {
+#ifdef JUDYL
+            Pjlb_t Pjlb = P_JLB(Pjp->jp_Addr);
+            Word_t subexp;
+#endif
+            pop1 = JU_JPLEAF_POP0(Pjp) + 1;
+            JU_INSPECTNODE(PInspect->ji_LeafB1,
+                           sizeof(jlb_t) / cJU_BYTESPERWORD,
+                           pop1, cJU_SUBEXPPERSTATE);
+#ifdef JUDYL
+            for (subexp = 0; subexp < cJU_NUMSUBEXPL; ++subexp)
+            {
+                if ((pop1 = j__udyCountBitsL(JU_JLB_BITMAP(Pjlb, subexp)))
+                    == 0) continue;
+
+                JU_INSPECTSLOTS(JL_LEAFVPOPTOWORDS, pop1,
+                                cJU_BITSPERSUBEXPL, slots);
+                JU_INSPECTNODE(PInspect->ji_Values,
+                               JL_LEAFVPOPTOWORDS(pop1), pop1, slots);
+            }
+#endif
+            return(0);
+        }
+
+#ifdef JUDY1
+        case cJ1_JPFULLPOPU1:
+            JU_INSPECTNODE(PInspect->ji_FullPopu1, 0,
+                           cJU_SUBEXPPERSTATE, cJU_SUBEXPPERSTATE);
+            return(0);
+#endif
+
+        } // switch
+
+
+// ****************************************************************************
+// IMMEDIATES:
+//
+// There are too many immediate Types to list, and they vary by flavor and
+// word size, but they are ordered by Index Size and then by population, and
+// JU_STATIMMEDLEVEL() gives the Index Size, so count back to the first Type
+// of that Index Size to get the population.
+
+        if ((type < cJU_JPIMMED_1_01) || (type >= cJU_JPIMMED_CAP)) return(-1);
+
+        if (type < cJU_JPIMMED_1_02)            // *_01 types.
+        {
+            level = type - cJU_JPIMMED_1_01 + 1;
+            pop1  = 1;
+        }
+        else
+        {
+            uint8_t first = type;
+
+            level = JU_STATIMMEDLEVEL(type);
+
+            while ((first > cJU_JPIMMED_1_02)
+                && ((Word_t) JU_STATIMMEDLEVEL(first - 1) == level)) --first;
+
+            pop1 = type - first + 2;
+        }
+
+        assert(pop1 < JI_MAXIMMED);
+
+        JU_INSPECTNODE(PInspect->ji_Immed[level][pop1], 0, pop1, pop1);
+
+#ifdef JUDYL
+        if (pop1 > 1)                   // separate value area.
+        {
+            JU_INSPECTSLOTS(JL_LEAFVPOPTOWORDS, pop1, cJU_BITSPERSUBEXPL, slots);
+            JU_INSPECTNODE(PInspect->ji_Values,
+                           JL_LEAFVPOPTOWORDS(pop1), pop1, slots);
+        }
+#endif
+        return(0);
+
+} // j__udyInspectJP()
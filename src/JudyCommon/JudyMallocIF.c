@@ -66,6 +66,34 @@ Word_t j__uMaxWords = ~0UL;
 #define MALLOC(MallocFunc,WordsPrev,WordsNow) \
         (((WordsPrev) > j__uMaxWords) ? 0UL : MallocFunc(WordsNow))
 
+// Starting change count (jpm_Gen) for the next JPM:
+//
+// A finger (see JudyFinger.c) is valid only while its arrays jpm_Gen is
+// unchanged.  If an array is freed and a new one gets a JPM at the same
+// address, a stale finger must not match, so each new JPM starts its count far
+// from every other one instead of at 0.
+//
+// Note:  Arrays in different threads allocate JPMs at the same time, so the
+// seed is advanced with an atomic add; a lost update could give two JPMs the
+// same count.  Where no atomic add is known, it is a plain add.
+
+static Word_t j__udyGenSeed = 0;
+
+#define cJU_GENSEEDSTEP ((Word_t) 1 << (cJU_BITSPERWORD / 2))
+
+#if defined(__GNUC__)
+#define JU_GENSEEDNEXT()                                                \
+        __atomic_add_fetch(&j__udyGenSeed, cJU_GENSEEDSTEP, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define JU_GENSEEDNEXT()                                                \
+        ((Word_t) _InterlockedExchangeAdd((volatile long *) &j__udyGenSeed, \
+                                          (long) cJU_GENSEEDSTEP)       \
+         + cJU_GENSEEDSTEP)
+#else
+#define JU_GENSEEDNEXT() (j__udyGenSeed += cJU_GENSEEDSTEP)
+#endif
+
 // Clear words starting at address:
 //
 // Note:  Only use this for objects that care; in other cases, it doesnt
@@ -191,6 +219,7 @@ FUNCTION Pjpm_t j__udyAllocJPM(void)
         {
             ZEROWORDS(Pjpm, Words);
             Pjpm->jpm_TotalMemWords = Words;
+            Pjpm->jpm_Gen = JU_GENSEEDNEXT();
         }
 
         TRACE_ALLOC5("0x%x %8lu = j__udyAllocJPM(), Words = %lu\n",
@@ -269,6 +269,43 @@ typedef int bool_t;
 #define JUDY1CODE(Code) // null.
 #endif
 
+// STATISTICS COUNTERS:
+//
+// See JudyStats.c and JStats_t in Judy.h.  JU_STAT() counts one event in the
+// current threads JStats_t if counting is turned on; it is meant for events
+// that are rare compared to JP visits (such as cascades), which are counted
+// by JU_STATJP() in JudyPrivate1L.h.  With -DJU_NOSTATS both compile to
+// nothing, and the JudyStats*() functions only report zeroes.
+
+#if defined(__GNUC__)
+#define JU_THREADLOCAL __thread
+#elif defined(_MSC_VER)
+#define JU_THREADLOCAL __declspec(thread)
+#else
+#define JU_THREADLOCAL  // null; counters are shared by all threads.
+#endif
+
+#ifndef JU_NOSTATS
+
+extern int                   j__uStatsOn;
+extern JU_THREADLOCAL JStats_t j__uStats;
+
+extern void j__udyStatsJP(int Kind, int Level);
+
+#define JU_STAT(FIELD)                                                  \
+        do { if (j__uStatsOn) ++(j__uStats.FIELD); } while (0)
+#define JU_STATLEAFW()                                                  \
+        do {                                                            \
+            if (j__uStatsOn) j__udyStatsJP(JS_LEAFW, cJU_ROOTSTATE);    \
+        } while (0)
+
+#else
+
+#define JU_STAT(FIELD)  // null.
+#define JU_STATLEAFW()  // null.
+
+#endif // JU_NOSTATS
+
 #include <assert.h>
 
 // ****************************************************************************
@@ -491,16 +528,47 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
 #endif
 
 // Fast LeafL search routine used for inlined code:
-
-#if (! defined(SEARCH_BINARY)) || (! defined(SEARCH_LINEAR))
-// default a binary search leaf method
+//
+// The search method is chosen at compile time by defining one of:
+//
+// SEARCH_LINEAR  - simple linear walk; good only for tiny leaves.
+// SEARCH_BINARY  - classic binary search (default); log2(Pop1) dependent
+//                  probes.
+// SEARCH_INTERP  - adaptive:  binary search for small leaves, but for leaves
+//                  of SEARCH_INTERP_MINBYTES or more bytes, one interpolation
+//                  probe based on the first and last Indexes (the populated
+//                  expanse of the leaf), then a short linear walk of at most
+//                  SEARCH_INTERP_WALK Indexes, and if that does not settle
+//                  it, binary search within what is left.
+//
+// Note:  SEARCH_INTERP saves probes when the Indexes in a leaf are spread
+// fairly evenly over the expanse it covers, but the divide costs about what
+// the probes save, and JudyBench lookups were no faster with it (random
+// Indexes were slower), so it is not the default.
+//
+// MAXPOP1 is the most Indexes the caller ever searches; it is a constant, so
+// the interpolation path is only compiled in where MAXPOP1 Indexes can come
+// to SEARCH_INTERP_MINBYTES.
+
+#if (! defined(SEARCH_BINARY)) && (! defined(SEARCH_LINEAR)) \
+ && (! defined(SEARCH_INTERP))
 #define SEARCH_BINARY 1
-//#define SEARCH_LINEAR 1
+#endif
+
+// A leaf that fits in a cache line or two is searched fastest by plain binary
+// search; the interpolation divide only pays off once the leaf is bigger:
+
+#ifndef SEARCH_INTERP_MINBYTES
+#define SEARCH_INTERP_MINBYTES 128
+#endif
+
+#ifndef SEARCH_INTERP_WALK
+#define SEARCH_INTERP_WALK 8
 #endif
 
 #ifdef SEARCH_LINEAR
 
-#define SEARCHLEAFNATIVE(LEAFTYPE,ADDR,POP1,INDEX)              \
+#define SEARCHLEAFNATIVE(LEAFTYPE,ADDR,POP1,MAXPOP1,INDEX)      \
     LEAFTYPE *P_leaf = (LEAFTYPE *)(ADDR);                      \
     LEAFTYPE  I_ndex = (INDEX); /* with masking */              \
     if (I_ndex > P_leaf[(POP1) - 1]) return(~(POP1));           \
@@ -509,7 +577,7 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
     return(~(P_leaf - (LEAFTYPE *)(ADDR)));
 
 
-#define SEARCHLEAFNONNAT(ADDR,POP1,INDEX,LFBTS,COPYINDEX)       \
+#define SEARCHLEAFNONNAT(ADDR,POP1,MAXPOP1,INDEX,LFBTS,COPYINDEX) \
 {                                                               \
     uint8_t *P_leaf, *P_leafEnd;                                \
     Word_t   i_ndex;                                            \
@@ -520,7 +588,7 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
     P_leafEnd = P_leaf + ((POP1) * (LFBTS));                    \
                                                                 \
     do {                                                        \
-        JU_COPY3_PINDEX_TO_LONG(i_ndex, P_leaf);                \
+        COPYINDEX(i_ndex, P_leaf);                              \
         if (I_ndex <= i_ndex) break;                            \
         P_leaf += (LFBTS);                                      \
     } while (P_leaf < P_leafEnd);                               \
@@ -533,7 +601,7 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
 
 #ifdef SEARCH_BINARY
 
-#define SEARCHLEAFNATIVE(LEAFTYPE,ADDR,POP1,INDEX)              \
+#define SEARCHLEAFNATIVE(LEAFTYPE,ADDR,POP1,MAXPOP1,INDEX)      \
     LEAFTYPE *P_leaf = (LEAFTYPE *)(ADDR);                      \
     LEAFTYPE I_ndex = (LEAFTYPE)INDEX; /* truncate hi bits */   \
     Word_t   l_ow   = cJU_ALLONES;                              \
@@ -553,7 +621,7 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
     return(l_ow)
 
 
-#define SEARCHLEAFNONNAT(ADDR,POP1,INDEX,LFBTS,COPYINDEX)       \
+#define SEARCHLEAFNONNAT(ADDR,POP1,MAXPOP1,INDEX,LFBTS,COPYINDEX) \
     uint8_t *P_leaf = (uint8_t *)(ADDR);                        \
     Word_t   l_ow   = cJU_ALLONES;                              \
     Word_t   m_id;                                              \
@@ -580,6 +648,151 @@ extern const uint8_t j__L_BranchBJPPopToWords[];
 
 #endif // SEARCH_BINARY
 
+#ifdef SEARCH_INTERP
+
+// Estimate the offset of an Index that lies OFFSET above the first Index in
+// a leaf of IDXBYTES-byte Indexes whose first and last Indexes differ by
+// RANGE, with POP1M1 = Pop1 - 1 Indexes after the first.  Requires 0 < OFFSET
+// < RANGE, so the result is 0..POP1M1 - 1.
+//
+// Note:  A linear leaf never holds more than 256 Indexes (its Pop0 is one
+// byte), so OFFSET * POP1M1 needs at most 8 more bits than the Index.  Use a
+// 32-bit multiply and divide when that fits (much cheaper than a 64-bit
+// divide on most CPUs), a full word when it fits in that, and for full-word
+// Indexes a divide-only form that cannot overflow.  IDXBYTES is a constant,
+// so the compiler discards the unused forms.
+
+#define JU_INTERPOLATE(IDXBYTES,OFFSET,RANGE,POP1M1)                    \
+    (((IDXBYTES) < 4) ?                                                 \
+        (Word_t) (((uint32_t) (OFFSET) * (uint32_t) (POP1M1))           \
+                  / (uint32_t) (RANGE)) :                               \
+    ((IDXBYTES) < cJU_BYTESPERWORD) ?                                   \
+        (((Word_t) (OFFSET) * (POP1M1)) / (Word_t) (RANGE)) :           \
+        ((Word_t) (OFFSET) / (((Word_t) (RANGE) / (POP1M1)) + 1)))
+
+#define SEARCHLEAFNATIVE(LEAFTYPE,ADDR,POP1,MAXPOP1,INDEX)      \
+    LEAFTYPE *P_leaf = (LEAFTYPE *)(ADDR);                      \
+    LEAFTYPE I_ndex = (LEAFTYPE)INDEX; /* truncate hi bits */   \
+    Word_t   l_ow   = cJU_ALLONES;                              \
+    Word_t   m_id;                                              \
+    Word_t   h_igh  = POP1;                                     \
+                                                                \
+    if (((MAXPOP1) * sizeof(LEAFTYPE) >= SEARCH_INTERP_MINBYTES) \
+     && ((h_igh * sizeof(LEAFTYPE)) >= SEARCH_INTERP_MINBYTES)) \
+    {                                                           \
+        LEAFTYPE f_irst = P_leaf[0];                            \
+        LEAFTYPE l_ast  = P_leaf[h_igh - 1];                    \
+        int      w_alk;                                         \
+                                                                \
+        if (I_ndex <= f_irst)                                   \
+            return((I_ndex == f_irst) ? 0 : ~0);                \
+        if (I_ndex >= l_ast)                                    \
+            return((I_ndex == l_ast) ? (h_igh - 1) : ~h_igh);   \
+                                                                \
+/*      Now P_leaf[l_ow] < I_ndex < P_leaf[h_igh]: */           \
+        l_ow  = 0;                                              \
+        h_igh = h_igh - 1;                                      \
+        m_id  = JU_INTERPOLATE(sizeof(LEAFTYPE), I_ndex - f_irst, \
+                               l_ast - f_irst, h_igh);          \
+        if (m_id == 0) m_id = 1;                                \
+                                                                \
+        if (P_leaf[m_id] <= I_ndex)                             \
+        {                                                       \
+            for (l_ow = m_id, w_alk = SEARCH_INTERP_WALK;       \
+                 w_alk > 0; --w_alk, ++l_ow)                    \
+            {                                                   \
+                if (P_leaf[l_ow + 1] > I_ndex)                  \
+                { h_igh = l_ow + 1; break; }                    \
+            }                                                   \
+        }                                                       \
+        else                                                    \
+        {                                                       \
+            for (h_igh = m_id, w_alk = SEARCH_INTERP_WALK;      \
+                 w_alk > 0; --w_alk, --h_igh)                   \
+            {                                                   \
+                if (P_leaf[h_igh - 1] <= I_ndex)                \
+                { l_ow = h_igh - 1; break; }                    \
+            }                                                   \
+        }                                                       \
+    }                                                           \
+    while ((h_igh - l_ow) > 1UL)                                \
+    {                                                           \
+        m_id = (h_igh + l_ow) / 2;                              \
+        if (P_leaf[m_id] > I_ndex)                              \
+            h_igh = m_id;                                       \
+        else                                                    \
+            l_ow = m_id;                                        \
+    }                                                           \
+    if (l_ow == cJU_ALLONES || P_leaf[l_ow] != I_ndex)          \
+        return(~h_igh);                                         \
+    return(l_ow)
+
+
+#define SEARCHLEAFNONNAT(ADDR,POP1,MAXPOP1,INDEX,LFBTS,COPYINDEX) \
+    uint8_t *P_leaf = (uint8_t *)(ADDR);                        \
+    Word_t   l_ow   = cJU_ALLONES;                              \
+    Word_t   m_id;                                              \
+    Word_t   h_igh  = POP1;                                     \
+    Word_t   I_ndex = JU_LEASTBYTES((INDEX), (LFBTS));          \
+    Word_t   i_ndex;                                            \
+                                                                \
+    if (((MAXPOP1) * (LFBTS) >= SEARCH_INTERP_MINBYTES)         \
+     && ((h_igh * (LFBTS)) >= SEARCH_INTERP_MINBYTES))          \
+    {                                                           \
+        Word_t f_irst, l_ast;                                   \
+        int    w_alk;                                           \
+                                                                \
+        COPYINDEX(f_irst, P_leaf);                              \
+        COPYINDEX(l_ast,  &P_leaf[(h_igh - 1) * (LFBTS)]);      \
+                                                                \
+        if (I_ndex <= f_irst)                                   \
+            return((I_ndex == f_irst) ? 0 : ~0);                \
+        if (I_ndex >= l_ast)                                    \
+            return((I_ndex == l_ast) ? (h_igh - 1) : ~h_igh);   \
+                                                                \
+        l_ow  = 0;                                              \
+        h_igh = h_igh - 1;                                      \
+        m_id  = JU_INTERPOLATE(LFBTS, I_ndex - f_irst,          \
+                               l_ast - f_irst, h_igh);          \
+        if (m_id == 0) m_id = 1;                                \
+                                                                \
+        COPYINDEX(i_ndex, &P_leaf[m_id * (LFBTS)]);             \
+        if (i_ndex <= I_ndex)                                   \
+        {                                                       \
+            for (l_ow = m_id, w_alk = SEARCH_INTERP_WALK;       \
+                 w_alk > 0; --w_alk, ++l_ow)                    \
+            {                                                   \
+                COPYINDEX(i_ndex, &P_leaf[(l_ow + 1) * (LFBTS)]); \
+                if (i_ndex > I_ndex) { h_igh = l_ow + 1; break; } \
+            }                                                   \
+        }                                                       \
+        else                                                    \
+        {                                                       \
+            for (h_igh = m_id, w_alk = SEARCH_INTERP_WALK;      \
+                 w_alk > 0; --w_alk, --h_igh)                   \
+            {                                                   \
+                COPYINDEX(i_ndex, &P_leaf[(h_igh - 1) * (LFBTS)]); \
+                if (i_ndex <= I_ndex) { l_ow = h_igh - 1; break; } \
+            }                                                   \
+        }                                                       \
+    }                                                           \
+    while ((h_igh - l_ow) > 1UL)                                \
+    {                                                           \
+        m_id = (h_igh + l_ow) / 2;                              \
+        COPYINDEX(i_ndex, &P_leaf[m_id * (LFBTS)]);             \
+        if (i_ndex > I_ndex)                                    \
+            h_igh = m_id;                                       \
+        else                                                    \
+            l_ow = m_id;                                        \
+    }                                                           \
+    if (l_ow == cJU_ALLONES) return(~h_igh);                    \
+                                                                \
+    COPYINDEX(i_ndex, &P_leaf[l_ow * (LFBTS)]);                 \
+    if (i_ndex != I_ndex) return(~h_igh);                       \
+    return(l_ow)
+
+#endif // SEARCH_INTERP
+
 // Fast way to count bits set in 8..32[64]-bit int:
 //
 // For performance, j__udyCountBits*() are written to take advantage of
@@ -1527,87 +1740,4 @@ assert((Word_t) (OFFSET) <= (Word_t) (POP1));                   \
             return(Retval);                             \
         }
 
-// Leaf search routines
-
-#ifdef JU_NOINLINE
-
-int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-
-#ifdef JU_64BIT
-
-int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
-
-#endif // JU_64BIT
-
-int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index);
-
-#else  // complier support for inline
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNATIVE(uint8_t,  Pjll, LeafPop1, Index); }
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNATIVE(uint16_t, Pjll, LeafPop1, Index); }
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNONNAT(Pjll, LeafPop1, Index, 3, JU_COPY3_PINDEX_TO_LONG); }
-
-#ifdef JU_64BIT
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNATIVE(uint32_t, Pjll, LeafPop1, Index); }
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNONNAT(Pjll, LeafPop1, Index, 5, JU_COPY5_PINDEX_TO_LONG); }
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNONNAT(Pjll, LeafPop1, Index, 6, JU_COPY6_PINDEX_TO_LONG); }
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNONNAT(Pjll, LeafPop1, Index, 7, JU_COPY7_PINDEX_TO_LONG); }
-
-#endif // JU_64BIT
-
-#ifdef JU_WIN
-static __inline int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index)
-#else
-static inline int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index)
-#endif
-{ SEARCHLEAFNATIVE(Word_t, Pjlw, LeafPop1, Index); }
-
-#endif // compiler support for inline
-
 #endif // ! _JUDYPRIVATE_INCLUDED
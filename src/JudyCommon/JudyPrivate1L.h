@@ -482,4 +482,175 @@
 
 #endif // JUDYL
 
+// LEVEL OF A LEAF JP FOR A FINGER:
+//
+// Given a JP whose Type is any non-immediate leaf (linear, bitmap, or, for
+// Judy1, full population), return its level (Index Size in bytes), that is,
+// the number of least significant Index bytes that vary within its expanse.
+// Linear leaf Types are in sequential order starting at state 2 (or 1, which
+// is cJU_JPLEAF2 - 1 where it exists); the other leaves are all at state 1.
+
+#define JU_FINGERLEVEL(PJP)                                     \
+        ((JU_JPTYPE(PJP) >= cJU_JPLEAF_B1) ? 1 :                \
+         (JU_JPTYPE(PJP) - cJU_JPLEAF2 + 2))
+
+// STATISTICS FOR A JP VISIT:
+//
+// JU_STATJP() counts a visit to the JP at PJP in the current threads JStats_t
+// (see JU_STAT() in JudyPrivate.h), by JS_* kind and level.  The level is
+// derived from the JP Type alone, which is ordered by kind and then by level
+// within each kind; for multi-Index immediates the boundaries between Index
+// Sizes depend on the flavor and word size.
+
+#define JU_STATKIND(TYPE)                                               \
+        (((TYPE) <= cJU_JPNULLMAX)     ? JS_NULL    :                   \
+         ((TYPE) <= cJU_JPBRANCH_L)    ? JS_BRANCHL :                   \
+         ((TYPE) <= cJU_JPBRANCH_B)    ? JS_BRANCHB :                   \
+         ((TYPE) <= cJU_JPBRANCH_U)    ? JS_BRANCHU :                   \
+         ((TYPE) <  cJU_JPLEAF_B1)     ? JS_LEAF    :                   \
+         ((TYPE) == cJU_JPLEAF_B1)     ? JS_LEAFB1  :                   \
+         ((TYPE) <  cJU_JPIMMED_1_01)  ? JS_FULLPOP : JS_IMMED)
+
+#if (defined(JUDY1) && defined(JU_64BIT))
+#define JU_STATIMMEDLEVEL(TYPE)                                         \
+        (((TYPE) < cJ1_JPIMMED_1_02) ? (TYPE) - cJ1_JPIMMED_1_01 + 1 :  \
+         ((TYPE) < cJ1_JPIMMED_2_02) ? 1 :                              \
+         ((TYPE) < cJ1_JPIMMED_3_02) ? 2 :                              \
+         ((TYPE) < cJ1_JPIMMED_4_02) ? 3 :                              \
+         ((TYPE) < cJ1_JPIMMED_5_02) ? 4 :                              \
+         ((TYPE) < cJ1_JPIMMED_6_02) ? 5 :                              \
+         ((TYPE) < cJ1_JPIMMED_7_02) ? 6 : 7)
+#endif
+
+#if (defined(JUDY1) && (! defined(JU_64BIT))) \
+ || (defined(JUDYL) && defined(JU_64BIT))
+#define JU_STATIMMEDLEVEL(TYPE)                                         \
+        (((TYPE) < cJU_JPIMMED_1_02) ? (TYPE) - cJU_JPIMMED_1_01 + 1 :  \
+         ((TYPE) < cJU_JPIMMED_2_02) ? 1 :                              \
+         ((TYPE) < cJU_JPIMMED_3_02) ? 2 : 3)
+#endif
+
+#if (defined(JUDYL) && (! defined(JU_64BIT)))
+#define JU_STATIMMEDLEVEL(TYPE)                                         \
+        (((TYPE) < cJU_JPIMMED_1_02) ? (TYPE) - cJU_JPIMMED_1_01 + 1 : 1)
+#endif
+
+#define JU_STATLEVEL(TYPE)                                              \
+        (((TYPE) <= cJU_JPNULLMAX)    ? (TYPE) - cJU_JPNULL1     + 1 :  \
+         ((TYPE) <= cJU_JPBRANCH_L)   ? (TYPE) - cJU_JPBRANCH_L2 + 2 :  \
+         ((TYPE) <= cJU_JPBRANCH_B)   ? (TYPE) - cJU_JPBRANCH_B2 + 2 :  \
+         ((TYPE) <= cJU_JPBRANCH_U)   ? (TYPE) - cJU_JPBRANCH_U2 + 2 :  \
+         ((TYPE) <  cJU_JPLEAF_B1)    ? (TYPE) - cJU_JPLEAF2     + 2 :  \
+         ((TYPE) <  cJU_JPIMMED_1_01) ? 1 : JU_STATIMMEDLEVEL(TYPE))
+
+#ifndef JU_NOSTATS
+#define JU_STATJP(PJP)                                                  \
+        do {                                                            \
+            if (j__uStatsOn)                                            \
+                j__udyStatsJP(JU_STATKIND(JU_JPTYPE(PJP)),              \
+                              JU_STATLEVEL(JU_JPTYPE(PJP)));            \
+        } while (0)
+#else
+#define JU_STATJP(PJP)  // null.
+#endif
+
+// ****************************************************************************
+// Leaf search routines, see SEARCHLEAFNATIVE() and SEARCHLEAFNONNAT() in
+// JudyPrivate.h.  They are here, not there, so each can pass the most Indexes
+// it is ever given, which lets the compiler leave out the interpolation path
+// for lists too short to use it.  j__udySearchLeaf1() also searches Immediates
+// and BranchL expanses, and a 64-bit Judy1 array has no Leaf1, so its longest
+// list is an Immediate:
+
+#if (defined(JUDYL) || (! defined(JU_64BIT)))
+#define JU_SEARCHLEAF1_MAXPOP1  cJU_LEAF1_MAXPOP1
+#else
+#define JU_SEARCHLEAF1_MAXPOP1  cJU_IMMED1_MAXPOP1
+#endif
+
+#ifdef JU_NOINLINE
+
+int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+
+#ifdef JU_64BIT
+
+int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index);
+
+#endif // JU_64BIT
+
+int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index);
+
+#else  // complier support for inline
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf1(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNATIVE(uint8_t,  Pjll, LeafPop1, JU_SEARCHLEAF1_MAXPOP1, Index); }
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf2(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNATIVE(uint16_t, Pjll, LeafPop1, cJU_LEAF2_MAXPOP1, Index); }
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf3(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNONNAT(Pjll, LeafPop1, cJU_LEAF3_MAXPOP1, Index, 3,
+                   JU_COPY3_PINDEX_TO_LONG); }
+
+#ifdef JU_64BIT
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf4(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNATIVE(uint32_t, Pjll, LeafPop1, cJU_LEAF4_MAXPOP1, Index); }
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf5(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNONNAT(Pjll, LeafPop1, cJU_LEAF5_MAXPOP1, Index, 5,
+                   JU_COPY5_PINDEX_TO_LONG); }
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf6(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNONNAT(Pjll, LeafPop1, cJU_LEAF6_MAXPOP1, Index, 6,
+                   JU_COPY6_PINDEX_TO_LONG); }
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeaf7(Pjll_t Pjll, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNONNAT(Pjll, LeafPop1, cJU_LEAF7_MAXPOP1, Index, 7,
+                   JU_COPY7_PINDEX_TO_LONG); }
+
+#endif // JU_64BIT
+
+#ifdef JU_WIN
+static __inline int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index)
+#else
+static inline int j__udySearchLeafW(Pjlw_t Pjlw, Word_t LeafPop1, Word_t Index)
+#endif
+{ SEARCHLEAFNATIVE(Word_t, Pjlw, LeafPop1, cJU_LEAFW_MAXPOP1, Index); }
+
+#endif // compiler support for inline
+
 #endif // _JUDYPRIVATE1L_INCLUDED
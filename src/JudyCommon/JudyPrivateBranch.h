@@ -347,6 +347,13 @@ typedef struct J__UDY_BRANCH_UNCOMPRESSED
 
 #endif // NO_BRANCHU
 
+// The values above are the JT_DEFAULT profile; the insert code uses the
+// current ones, which JudyTuneSet() can change (see JudyTune.c):
+
+extern JTune_t j__uTune;
+
+#define JU_TUNE(FIELD)  (j__uTune.FIELD)
+
 
 // MISCELLANEOUS MACROS:
 
@@ -361,7 +368,8 @@ typedef struct J__UDY_BRANCH_UNCOMPRESSED
 
 // Produce 1-digit mask at specified state:
 
-#define cJU_MASKATSTATE(State)  (0xffL << (((State) - 1) * cJU_BITSPERBYTE))
+#define cJU_MASKATSTATE(State) \
+        ((Word_t) 0xff << (((State) - 1) * cJU_BITSPERBYTE))
 
 // Get byte (digit) from Index at the specified state, right justified:
 //
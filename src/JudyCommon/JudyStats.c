@@ -0,0 +1,123 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/src/JudyCommon/JudyStats.c $
+//
+// JudyStatsEnable(), JudyStatsGet(), and JudyStatsReset() functions, common
+// to Judy1 and JudyL, plus the counters they report; see JStats_t in Judy.h.
+// The counting is done in the Judy1 and JudyL code itself, via JU_STAT() and
+// JU_STATJP().  Compile once, without -DJUDY1 or -DJUDYL.
+//
+// Note:  The on/off flag is global, so one call turns counting on or off for
+// all threads, but the counters are per thread (where JU_THREADLOCAL is
+// supported), so counting never costs a shared cache line write.
+
+#include <string.h>                     // for memset().
+
+#include "Judy.h"
+#include "JudyPrivate.h"
+
+#ifndef JU_NOSTATS
+
+int                     j__uStatsOn = 0;        // counting enabled.
+JU_THREADLOCAL JStats_t j__uStats;              // this threads counters.
+
+// Estimated cache lines touched by one visit to each JS_* kind of JP:  The JP
+// itself is already in cache, in its parent, so null and immediate JPs cost
+// nothing more; a linear or bitmap branch reads its list or bitmap, then the
+// selected JP; a leaf reads (at least) one line of Indexes:
+
+static const uint8_t j__uStatsLines[JS_KINDS] =
+{
+        0,      // JS_NULL
+        2,      // JS_BRANCHL
+        2,      // JS_BRANCHB
+        1,      // JS_BRANCHU
+        1,      // JS_LEAF
+        1,      // JS_LEAFB1
+        0,      // JS_FULLPOP
+        0,      // JS_IMMED
+        1,      // JS_LEAFW
+};
+
+
+// ****************************************************************************
+// J U D Y   S T A T S   J P
+//
+// Count one JP visit, for JU_STATJP().  Only called when counting is on.
+
+FUNCTION void j__udyStatsJP(
+        int     Kind,           // JS_*.
+        int     Level)          // 1..cJU_ROOTSTATE.
+{
+        assert((Kind  >= 0) && (Kind  < JS_KINDS));
+        assert((Level >= 0) && (Level < JS_LEVELS));
+
+        ++(j__uStats.js_Visits[Level][Kind]);
+        j__uStats.js_CacheLines += j__uStatsLines[Kind];
+
+} // j__udyStatsJP()
+
+#endif // ! JU_NOSTATS
+
+
+// ****************************************************************************
+// J U D Y   S T A T S   E N A B L E
+
+FUNCTION void JudyStatsEnable(
+        int     On)             // 0 = off, otherwise on.
+{
+#ifndef JU_NOSTATS
+        j__uStatsOn = (On != 0);
+#else
+        (void) On;
+#endif
+
+} // JudyStatsEnable()
+
+
+// ****************************************************************************
+// J U D Y   S T A T S   G E T
+//
+// Copy out the current threads counters.
+
+FUNCTION void JudyStatsGet(
+        PJStats_t PStats)       // where to return them.
+{
+        if (PStats == (PJStats_t) NULL) return;
+
+#ifndef JU_NOSTATS
+        *PStats = j__uStats;
+#else
+        memset((void *) PStats, 0, sizeof(JStats_t));
+#endif
+
+} // JudyStatsGet()
+
+
+// ****************************************************************************
+// J U D Y   S T A T S   R E S E T
+//
+// Zero the current threads counters.
+
+FUNCTION void JudyStatsReset(void)
+{
+#ifndef JU_NOSTATS
+        memset((void *) &j__uStats, 0, sizeof(JStats_t));
+#endif
+
+} // JudyStatsReset()
@@ -0,0 +1,131 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/src/JudyCommon/JudyTune.c $
+//
+// JudyTuneGet(), JudyTuneSet(), and JudyTuneProfile() functions, common to
+// Judy1 and JudyL, plus the branch conversion thresholds they manage; see
+// JTune_t in Judy.h.  The thresholds are read by the insert code via
+// JU_TUNE() (see JudyPrivateBranch.h).  Compile once, without -DJUDY1 or
+// -DJUDYL.
+//
+// Note:  The thresholds are global, so one call changes them for all arrays
+// in all threads.  They only decide when a branch is converted, never what a
+// valid array looks like, so arrays built under one profile are equally good
+// under another, and a change seen part way through an insert does no harm.
+
+#include "Judy.h"
+#include "JudyPrivate.h"
+#include "JudyPrivateBranch.h"
+
+// The profiles, by JT_* number:
+//
+// JT_DEFAULT is the compiled-in schedule (see JudyPrivateBranch.h).
+//
+// JT_SPEED uncompresses about 4 times sooner:  a BranchU costs 256 JPs of
+// memory but saves the bitmap and popcount of a BranchB, or the search of a
+// BranchL, on every visit, and the cost of a conversion is only paid once.
+//
+// JT_COMPACT never converts a BranchL, and converts a BranchB only with 1000
+// Indexes under it, in an array of 10000, so a BranchU is at most a few
+// percent of the memory (-DNO_BRANCHU builds never convert a BranchB).
+
+static const JTune_t j__uTuneProfile[] =
+{
+        {       // JT_DEFAULT
+                JU_BRANCHL_MAX_POP,
+                JU_BRANCHB_MIN_POP,
+                JU_BRANCHB_MAX_POP,
+                JU_BTOU_POP_INCREMENT,
+        },
+        {       // JT_SPEED
+                250,
+                32,
+                200,
+                75,
+        },
+        {       // JT_COMPACT
+                ~(Word_t) 0,
+                1000,
+                10000,
+                1000,
+        },
+};
+
+#define JU_TUNEPROFILES (sizeof(j__uTuneProfile) / sizeof(JTune_t))
+
+JTune_t j__uTune =
+{
+        JU_BRANCHL_MAX_POP,
+        JU_BRANCHB_MIN_POP,
+        JU_BRANCHB_MAX_POP,
+        JU_BTOU_POP_INCREMENT,
+};
+
+
+// ****************************************************************************
+// J U D Y   T U N E   P R O F I L E
+//
+// Copy out the thresholds of a profile, for passing to JudyTuneSet() as they
+// are or after changing some of them.  An unknown profile gives JT_DEFAULT.
+
+FUNCTION void JudyTuneProfile(
+        int      Profile,       // JT_*.
+        PJTune_t PTune)         // where to return the thresholds.
+{
+        if (PTune == (PJTune_t) NULL) return;
+
+        if ((Profile < 0) || ((Word_t) Profile >= JU_TUNEPROFILES))
+            Profile = JT_DEFAULT;
+
+        *PTune = j__uTuneProfile[Profile];
+
+} // JudyTuneProfile()
+
+
+// ****************************************************************************
+// J U D Y   T U N E   G E T
+//
+// Copy out the current thresholds.
+
+FUNCTION void JudyTuneGet(
+        PJTune_t PTune)         // where to return them.
+{
+        if (PTune == (PJTune_t) NULL) return;
+
+        *PTune = j__uTune;
+
+} // JudyTuneGet()
+
+
+// ****************************************************************************
+// J U D Y   T U N E   S E T
+//
+// Make the given thresholds current; NULL restores JT_DEFAULT.
+
+FUNCTION void JudyTuneSet(
+        PJTune_t PTune)         // thresholds to use.
+{
+        if (PTune == (PJTune_t) NULL)
+        {
+            j__uTune = j__uTuneProfile[JT_DEFAULT];
+            return;
+        }
+
+        j__uTune = *PTune;
+
+} // JudyTuneSet()
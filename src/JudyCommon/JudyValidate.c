@@ -0,0 +1,728 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/src/JudyCommon/JudyValidate.c $
+//
+// Judy1Validate() and JudyLValidate() functions for Judy1 and JudyL:  Walk an
+// array and check the redundant data in it against itself; see Judy.h.
+// Compile with one of -DJUDY1 or -DJUDYL.
+//
+// These are the checks the debug-only JudyCheckPop() (in JudyGet.c) lists as
+// TBD -- correct Dcd bytes, JP Types descending the tree, sorted lists -- plus
+// its own population check, but reporting the first failure instead of
+// asserting, so they can be run in a production build.  The tree walk is
+// modeled on JudyInspect.c.  Objects are sized from the same Pop-to-Words
+// tables JudyMallocIF.c uses, so for an array with a JPM they must add up to
+// jpm_TotalMemWords.
+//
+// With -DDEBUG, this file also supplies JudyCheckSorted(), which the insert,
+// delete and cascade code call via DBGCODE().
+
+#if (! (defined(JUDY1) || defined(JUDYL)))
+#error:  One of -DJUDY1 or -DJUDYL must be specified.
+#endif
+
+#include <string.h>                     // for memset().
+
+#ifdef JUDY1
+#include "Judy1.h"
+#else
+#include "JudyL.h"
+#endif
+
+#include "JudyPrivate1L.h"
+
+// Where the Indexes in an immediate JP start:
+
+#ifdef JUDY1
+#define PJI (Pjp->jp_1Index)
+#else
+#define PJI (Pjp->jp_LIndex)
+#endif
+
+// STATE OF A WALK:
+
+typedef struct J_UDY_VALIDATE_WALK
+{
+        PJValidate_t jvw_PValidate;     // results so far.
+        Word_t       jvw_LastIndex;     // last Index found, if any.
+
+} jvw_t, * Pjvw_t;
+
+FUNCTION static int j__udyValidateJP(Pjp_t, Word_t, Word_t, Word_t, Pjvw_t,
+                                     PWord_t);
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   F A I L
+//
+// Record a failed check in the JValidate_t and return -1, for the caller to
+// pass up.
+
+FUNCTION static int j__udyValidateFail(
+        Pjvw_t     Pjvw,        // walk state.
+        JV_Check_t Check,       // that failed.
+        Pjp_t      Pjp,         // where, or NULL for the root leaf.
+        Word_t     Level,       // of Pjp, or Index Size.
+        Word_t     Index,       // digits decoded so far.
+        Word_t     Offset,      // in the node.
+        Word_t     Got,         // held in the array.
+        Word_t     Want)        // expected by the walk.
+{
+        PJValidate_t PValidate = Pjvw->jvw_PValidate;
+
+        PValidate->jv_Check  = Check;
+        PValidate->jv_JPType = (Pjp == (Pjp_t) NULL) ? 0 : JU_JPTYPE(Pjp);
+        PValidate->jv_Level  = Level;
+        PValidate->jv_Index  = Index;
+        PValidate->jv_Offset = Offset;
+        PValidate->jv_Got    = Got;
+        PValidate->jv_Want   = Want;
+        return(-1);
+
+} // j__udyValidateFail()
+
+// For use in j__udyValidateJP():
+
+#define JU_VALIDATEFAIL(Check,Level,Offset,Got,Want)                    \
+        return(j__udyValidateFail(Pjvw, Check, Pjp, Level, Index,       \
+                                  Offset, (Word_t) (Got), (Word_t) (Want)))
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   K E Y
+//
+// Return the Index at Offset in a list of IndexSize-byte Indexes (a linear
+// leaf or an immediate JP), that is, its least IndexSize bytes.
+
+FUNCTION static Word_t j__udyValidateKey(
+        uint8_t * Pleaf,        // first Index in the list.
+        Word_t    Offset,       // of the Index wanted.
+        Word_t    IndexSize)    // bytes in each Index.
+{
+        Word_t    key;
+
+        switch (IndexSize)
+        {
+        case 1: return((Word_t) Pleaf[Offset]);
+        case 2: return((Word_t) ((uint16_t *) Pleaf)[Offset]);
+        case 3: JU_COPY3_PINDEX_TO_LONG(key, Pleaf + (3 * Offset));
+                return(key);
+#ifdef JU_64BIT
+        case 4: return((Word_t) ((uint32_t *) Pleaf)[Offset]);
+        case 5: JU_COPY5_PINDEX_TO_LONG(key, Pleaf + (5 * Offset));
+                return(key);
+        case 6: JU_COPY6_PINDEX_TO_LONG(key, Pleaf + (6 * Offset));
+                return(key);
+        case 7: JU_COPY7_PINDEX_TO_LONG(key, Pleaf + (7 * Offset));
+                return(key);
+#endif
+        }
+        return(((PWord_t) Pleaf)[Offset]);      // cJU_ROOTSTATE.
+
+} // j__udyValidateKey()
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   I N D E X
+//
+// Count an Index found in a leaf or immediate, which must be above the last
+// one found, since the walk visits them in order.
+
+FUNCTION static int j__udyValidateIndex(
+        Pjvw_t Pjvw,            // walk state.
+        Pjp_t  Pjp,             // to the leaf, or NULL for the root leaf.
+        Word_t Level,           // Index Size of the leaf.
+        Word_t Index,           // found.
+        Word_t Offset)          // of Index in the leaf.
+{
+        PJValidate_t PValidate = Pjvw->jvw_PValidate;
+
+        if ((PValidate->jv_Population > 0) && (Index <= Pjvw->jvw_LastIndex))
+        {
+            return(j__udyValidateFail(Pjvw, JV_ORDER, Pjp, Level, Index,
+                                      Offset, Index, Pjvw->jvw_LastIndex + 1));
+        }
+
+        Pjvw->jvw_LastIndex = Index;
+        ++(PValidate->jv_Population);
+        return(0);
+
+} // j__udyValidateIndex()
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   L I S T
+//
+// Count the Pop1 IndexSize-byte Indexes in a list, whose higher digits are
+// those of Index.
+
+FUNCTION static int j__udyValidateList(
+        Pjvw_t    Pjvw,         // walk state.
+        Pjp_t     Pjp,          // to the leaf, or NULL for the root leaf.
+        uint8_t * Pleaf,        // first Index in the list.
+        Word_t    Pop1,         // Indexes in it.
+        Word_t    IndexSize,    // bytes in each.
+        Word_t    Index)        // digits decoded down to the list.
+{
+        Word_t    offset;
+
+        for (offset = 0; offset < Pop1; ++offset)
+        {
+            Index = (Index & (~JU_LEASTBYTESMASK(IndexSize)))
+                  | j__udyValidateKey(Pleaf, offset, IndexSize);
+
+            if (j__udyValidateIndex(Pjvw, Pjp, IndexSize, Index, offset) == -1)
+                return(-1);
+        }
+        return(0);
+
+} // j__udyValidateList()
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   D C D
+//
+// Check that a JP at Offset in a branch at ParentLevel leads to a node at a
+// lower Level (branch level or Index Size), and that its Dcd bytes agree with
+// the digits of *PIndex decoded from ParentLevel up; then copy into *PIndex
+// any digits in between, which a narrow pointer skips.  The top branch, under
+// the JPM, has no Dcd bytes.
+
+FUNCTION static int j__udyValidateDcd(
+        Pjvw_t  Pjvw,           // walk state.
+        Pjp_t   Pjp,            // to check.
+        Word_t  Level,          // of the node Pjp leads to.
+        Word_t  ParentLevel,    // of the branch holding Pjp.
+        Word_t  Offset,         // of Pjp in that branch.
+        PWord_t PIndex)         // digits decoded so far.
+{
+        Word_t  Index = *PIndex;
+        Word_t  mask;
+
+        if (Level >= ParentLevel)
+            JU_VALIDATEFAIL(JV_JPTYPE, Level, Offset, Level, ParentLevel - 1);
+
+        if (Level == cJU_ROOTSTATE) return(0);
+
+        mask = cJU_DCDMASK(Level) & (~JU_LEASTBYTESMASK(ParentLevel - 1));
+
+        if ((Index ^ JU_JPDCDPOP0(Pjp)) & mask)
+        {
+            JU_VALIDATEFAIL(JV_DCD, Level, Offset, JU_JPDCDPOP0(Pjp) & mask,
+                            Index & mask);
+        }
+
+        JU_SETDCD(*PIndex, Pjp, Level);
+        return(0);
+
+} // j__udyValidateDcd()
+
+
+#ifdef JUDY1
+// ****************************************************************************
+// J U D Y   1   V A L I D A T E
+//
+// Return 1 if PArray passes every check, or JERR.
+
+FUNCTION int Judy1Validate
+#else
+// ****************************************************************************
+// J U D Y   L   V A L I D A T E
+//
+// Return 1 if PArray passes every check, or JERR.
+
+FUNCTION int JudyLValidate
+#endif
+        (
+        Pcvoid_t     PArray,    // to check.
+        PJValidate_t PValidate, // optional, where to return the results.
+        PJError_t    PJError    // optional, for returning error info.
+        )
+{
+        JValidate_t  validate;  // when the caller gives none.
+        jvw_t        walk;
+        Word_t       pop1;
+
+        if (PValidate == (PJValidate_t) NULL) PValidate = &validate;
+
+        memset((void *) PValidate, 0, sizeof(JValidate_t));
+        walk.jvw_PValidate = PValidate;
+        walk.jvw_LastIndex = 0;
+
+        if (PArray == (Pcvoid_t) NULL) return(1);
+
+// Root leaf (small array):  There is no JPM to check its size against, so
+// only the order of its Indexes is checked:
+
+        if (JU_LEAFW_POP0(PArray) < cJU_LEAFW_MAXPOP1)
+        {
+            Pjlw_t Pjlw = P_JLW(PArray);        // first word of leaf.
+
+            pop1 = Pjlw[0] + 1;
+            PValidate->jv_Nodes = 1;
+            PValidate->jv_Words = JU_LEAFWPOPTOWORDS(pop1);
+
+            if (j__udyValidateList(&walk, (Pjp_t) NULL, (uint8_t *) (Pjlw + 1),
+                                   pop1, cJU_ROOTSTATE, 0) == -1)
+            {
+                goto Corrupt;
+            }
+            return(1);
+        }
+
+// Tree under a JPM, whose JP must be to a top branch:
+
+        {
+            Pjpm_t  Pjpm = P_JPM(PArray);
+            Pjp_t   Pjp  = &(Pjpm->jpm_JP);
+            uint8_t type = JU_JPTYPE(Pjp);
+
+            PValidate->jv_Words = sizeof(jpm_t) / cJU_BYTESPERWORD;
+
+            if ((type != cJU_JPBRANCH_L) && (type != cJU_JPBRANCH_B)
+             && (type != cJU_JPBRANCH_U))
+            {
+                (void) j__udyValidateFail(&walk, JV_JPTYPE, Pjp, cJU_ROOTSTATE,
+                                          0, 0, type, cJU_JPBRANCH_L);
+                goto Corrupt;
+            }
+
+            if (j__udyValidateJP(Pjp, 0, cJU_ROOTSTATE + 1, 0, &walk, &pop1)
+                == -1) goto Corrupt;
+
+            if (pop1 != Pjpm->jpm_Pop0 + 1)
+            {
+                (void) j__udyValidateFail(&walk, JV_POP, Pjp, cJU_ROOTSTATE,
+                                          0, 0, Pjpm->jpm_Pop0 + 1, pop1);
+                goto Corrupt;
+            }
+
+            if (PValidate->jv_Words != Pjpm->jpm_TotalMemWords)
+            {
+                (void) j__udyValidateFail(&walk, JV_MEMWORDS, Pjp,
+                                          cJU_ROOTSTATE, 0, 0,
+                                          Pjpm->jpm_TotalMemWords,
+                                          PValidate->jv_Words);
+                goto Corrupt;
+            }
+        }
+        return(1);
+
+Corrupt:
+        JU_SET_ERRNO(PJError, JU_ERRNO_CORRUPT);
+        return(JERR);
+
+} // Judy1Validate() / JudyLValidate()
+
+
+// ****************************************************************************
+// __ J U D Y   V A L I D A T E   J P
+//
+// Check Pjp, at Offset in a branch at ParentLevel, and the subtree under it;
+// Index holds the digits decoded above it.  Return in *PPop1 the Indexes
+// found, and return 0, or -1 when a check fails.
+
+FUNCTION static int j__udyValidateJP(
+        Pjp_t   Pjp,            // top of subtree.
+        Word_t  Index,          // digits decoded above Pjp.
+        Word_t  ParentLevel,    // of the branch holding Pjp.
+        Word_t  Offset,         // of Pjp in that branch.
+        Pjvw_t  Pjvw,           // walk state.
+        PWord_t PPop1)          // Indexes under Pjp.
+{
+        PJValidate_t PValidate = Pjvw->jvw_PValidate;
+        uint8_t      type = JU_JPTYPE(Pjp);
+        Word_t       level;     // of a branch or leaf.
+        Word_t       offset;    // in a branch or leaf.
+        Word_t       digit;     // of a JP or Index.
+        Word_t       pop1 = 0;  // under Pjp.
+        Word_t       pop1sub;   // under one JP of a branch.
+
+        ++(PValidate->jv_Nodes);
+
+// For branches, check the Dcd bytes before going down and the population
+// after coming back up:
+
+#define JU_VALIDATEDCD(Level)                                           \
+        if (j__udyValidateDcd(Pjvw, Pjp, Level, ParentLevel, Offset,    \
+                              &Index) == -1) return(-1)
+
+#define JU_VALIDATESUB(PjpSub,Offset)                                   \
+        if (j__udyValidateJP(PjpSub, Index, level, Offset, Pjvw,        \
+                             &pop1sub) == -1) return(-1);               \
+        pop1 += pop1sub
+
+#define JU_VALIDATEBRANCHPOP                                            \
+        if ((level < cJU_ROOTSTATE)                                     \
+         && (JU_JPBRANCH_POP0(Pjp, level) != pop1 - 1))                 \
+        {                                                               \
+            JU_VALIDATEFAIL(JV_POP, level, Offset,                      \
+                            JU_JPBRANCH_POP0(Pjp, level) + 1, pop1);    \
+        }                                                               \
+        break
+
+        switch (type)
+        {
+
+// Null JPs belong only in uncompressed branches, which check them there:
+
+        case cJU_JPNULL1:
+        case cJU_JPNULL2:
+        case cJU_JPNULL3:
+#ifdef JU_64BIT
+        case cJU_JPNULL4:
+        case cJU_JPNULL5:
+        case cJU_JPNULL6:
+        case cJU_JPNULL7:
+#endif
+            JU_VALIDATEFAIL(JV_JPTYPE, 0, Offset, type, 0);
+
+
+// ****************************************************************************
+// LINEAR BRANCH:
+//
+// 1..7 JPs, with their digits in ascending order.
+
+        case cJU_JPBRANCH_L2:
+        case cJU_JPBRANCH_L3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_L4:
+        case cJU_JPBRANCH_L5:
+        case cJU_JPBRANCH_L6:
+        case cJU_JPBRANCH_L7:
+#endif
+        case cJU_JPBRANCH_L:
+        {
+            Pjbl_t Pjbl = P_JBL(Pjp->jp_Addr);
+            Word_t numJPs;
+
+            level = type - cJU_JPBRANCH_L2 + 2;
+            JU_VALIDATEDCD(level);
+            PValidate->jv_Words += sizeof(jbl_t) / cJU_BYTESPERWORD;
+
+            numJPs = Pjbl->jbl_NumJPs;
+
+            if ((numJPs < 1) || (numJPs > cJU_BRANCHLMAXJPS))
+            {
+                JU_VALIDATEFAIL(JV_BRANCHL, level, 0, numJPs,
+                                cJU_BRANCHLMAXJPS);
+            }
+
+            for (offset = 0; offset < numJPs; ++offset)
+            {
+                digit = Pjbl->jbl_Expanse[offset];
+
+                if ((offset > 0) && (digit <= Pjbl->jbl_Expanse[offset - 1]))
+                {
+                    JU_VALIDATEFAIL(JV_BRANCHL, level, offset, digit,
+                                    Pjbl->jbl_Expanse[offset - 1] + 1);
+                }
+
+                JU_SETDIGIT(Index, digit, level);
+                JU_VALIDATESUB((Pjbl->jbl_jp) + offset, offset);
+            }
+            JU_VALIDATEBRANCHPOP;
+        }
+
+
+// ****************************************************************************
+// BITMAP BRANCH:
+//
+// Each subexpanse has a JP subarray if and only if its bitmap is not empty,
+// with one JP for each bit set.
+
+        case cJU_JPBRANCH_B2:
+        case cJU_JPBRANCH_B3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_B4:
+        case cJU_JPBRANCH_B5:
+        case cJU_JPBRANCH_B6:
+        case cJU_JPBRANCH_B7:
+#endif
+        case cJU_JPBRANCH_B:
+        {
+            Pjbb_t Pjbb = P_JBB(Pjp->jp_Addr);
+            Word_t subexp;
+            Word_t bitmap;
+            Word_t jpcount;
+            Pjp_t  Pjp2;
+
+            level = type - cJU_JPBRANCH_B2 + 2;
+            JU_VALIDATEDCD(level);
+            PValidate->jv_Words += sizeof(jbb_t) / cJU_BYTESPERWORD;
+
+            for (subexp = 0; subexp < cJU_NUMSUBEXPB; ++subexp)
+            {
+                bitmap  = JU_JBB_BITMAP(Pjbb, subexp);
+                jpcount = j__udyCountBitsB(bitmap);
+                Pjp2    = P_JP(JU_JBB_PJP(Pjbb, subexp));
+
+                if ((jpcount == 0) != (Pjp2 == (Pjp_t) NULL))
+                    JU_VALIDATEFAIL(JV_BITMAP, level, subexp, Pjp2, jpcount);
+
+                if (jpcount == 0) continue;
+
+                PValidate->jv_Words += JU_BRANCHJP_NUMJPSTOWORDS(jpcount);
+
+                for (offset = 0, digit = subexp * cJU_BITSPERSUBEXPB;
+                     bitmap != 0; ++digit, bitmap >>= 1)
+                {
+                    if (! (bitmap & 1)) continue;
+
+                    JU_SETDIGIT(Index, digit, level);
+                    JU_VALIDATESUB(Pjp2 + offset, digit);
+                    ++offset;
+                }
+            }
+            JU_VALIDATEBRANCHPOP;
+        }
+
+
+// ****************************************************************************
+// UNCOMPRESSED BRANCH:
+//
+// Null JPs must have the Type for the level below the branch.
+
+        case cJU_JPBRANCH_U2:
+        case cJU_JPBRANCH_U3:
+#ifdef JU_64BIT
+        case cJU_JPBRANCH_U4:
+        case cJU_JPBRANCH_U5:
+        case cJU_JPBRANCH_U6:
+        case cJU_JPBRANCH_U7:
+#endif
+        case cJU_JPBRANCH_U:
+        {
+            Pjbu_t  Pjbu = P_JBU(Pjp->jp_Addr);
+            uint8_t type2;
+
+            level = type - cJU_JPBRANCH_U2 + 2;
+            JU_VALIDATEDCD(level);
+            PValidate->jv_Words += sizeof(jbu_t) / cJU_BYTESPERWORD;
+
+            for (digit = 0; digit < cJU_BRANCHUNUMJPS; ++digit)
+            {
+                type2 = JU_JPTYPE((Pjbu->jbu_jp) + digit);
+
+                if ((type2 >= cJU_JPNULL1) && (type2 <= cJU_JPNULLMAX))
+                {
+                    if (type2 != cJU_JPNULL1 + level - 2)
+                    {
+                        JU_VALIDATEFAIL(JV_JPTYPE, level, digit, type2,
+                                        cJU_JPNULL1 + level - 2);
+                    }
+                    continue;
+                }
+
+                JU_SETDIGIT(Index, digit, level);
+                JU_VALIDATESUB((Pjbu->jbu_jp) + digit, digit);
+            }
+            JU_VALIDATEBRANCHPOP;
+        }
+
+
+// ****************************************************************************
+// LINEAR LEAVES:
+
+#define JU_VALIDATELEAF(cIS,PopToWords,MaxPop1)                         \
+        JU_VALIDATEDCD(cIS);                                            \
+        pop1 = JU_JPLEAF_POP0(Pjp) + 1;                                 \
+        if (pop1 > (MaxPop1))                                           \
+            JU_VALIDATEFAIL(JV_LEAFSIZE, cIS, Offset, pop1, MaxPop1);   \
+        PValidate->jv_Words += PopToWords(pop1);                        \
+        if (j__udyValidateList(Pjvw, Pjp, (uint8_t *) P_JLL(Pjp->jp_Addr), \
+                               pop1, cIS, Index) == -1) return(-1);     \
+        break
+
+#if (defined(JUDYL) || (! defined(JU_64BIT)))
+        case cJU_JPLEAF1:
+            JU_VALIDATELEAF(1, JU_LEAF1POPTOWORDS, cJU_LEAF1_MAXPOP1);
+#endif
+        case cJU_JPLEAF2:
+            JU_VALIDATELEAF(2, JU_LEAF2POPTOWORDS, cJU_LEAF2_MAXPOP1);
+        case cJU_JPLEAF3:
+            JU_VALIDATELEAF(3, JU_LEAF3POPTOWORDS, cJU_LEAF3_MAXPOP1);
+#ifdef JU_64BIT
+        case cJU_JPLEAF4:
+            JU_VALIDATELEAF(4, JU_LEAF4POPTOWORDS, cJU_LEAF4_MAXPOP1);
+        case cJU_JPLEAF5:
+            JU_VALIDATELEAF(5, JU_LEAF5POPTOWORDS, cJU_LEAF5_MAXPOP1);
+        case cJU_JPLEAF6:
+            JU_VALIDATELEAF(6, JU_LEAF6POPTOWORDS, cJU_LEAF6_MAXPOP1);
+        case cJU_JPLEAF7:
+            JU_VALIDATELEAF(7, JU_LEAF7POPTOWORDS, cJU_LEAF7_MAXPOP1);
+#endif
+
+
+// ****************************************************************************
+// BITMAP LEAF:
+//
+// The bits set must add up to the population in the JP.  For JudyL, each
+// subexpanse has a value area if and only if its bitmap is not empty.
+
+        case cJU_JPLEAF_B1:
+        {
+            Pjlb_t Pjlb = P_JLB(Pjp->jp_Addr);
+            Word_t subexp;
+            Word_t bitmap;
+
+            JU_VALIDATEDCD(1);
+            PValidate->jv_Words += sizeof(jlb_t) / cJU_BYTESPERWORD;
+
+            for (subexp = 0; subexp < cJU_NUMSUBEXPL; ++subexp)
+            {
+                bitmap = JU_JLB_BITMAP(Pjlb, subexp);
+#ifdef JUDYL
+                {
+                    Pjv_t Pjv = P_JV(JL_JLB_PVALUE(Pjlb, subexp));
+
+                    if ((bitmap == 0) != (Pjv == (Pjv_t) NULL))
+                        JU_VALIDATEFAIL(JV_VALUES, 1, subexp, Pjv, bitmap);
+
+                    if (bitmap != 0)
+                    {
+                        PValidate->jv_Words
+                            += JL_LEAFVPOPTOWORDS(j__udyCountBitsL(bitmap));
+                    }
+                }
+#endif
+                for (digit = subexp * cJU_BITSPERSUBEXPL; bitmap != 0;
+                     ++digit, bitmap >>= 1)
+                {
+                    if (! (bitmap & 1)) continue;
+
+                    JU_SETDIGIT1(Index, digit);
+                    if (j__udyValidateIndex(Pjvw, Pjp, 1, Index, digit) == -1)
+                        return(-1);
+                    ++pop1;
+                }
+            }
+
+            if (JU_JPLEAF_POP0(Pjp) != pop1 - 1)
+            {
+                JU_VALIDATEFAIL(JV_POP, 1, Offset, JU_JPLEAF_POP0(Pjp) + 1,
+                                pop1);
+            }
+            break;
+        }
+
+#ifdef JUDY1
+        case cJ1_JPFULLPOPU1:
+
+            JU_VALIDATEDCD(1);
+
+            for (digit = 0; digit < cJU_SUBEXPPERSTATE; ++digit)
+            {
+                JU_SETDIGIT1(Index, digit);
+                if (j__udyValidateIndex(Pjvw, Pjp, 1, Index, digit) == -1)
+                    return(-1);
+            }
+            pop1 = cJU_SUBEXPPERSTATE;
+            break;
+#endif
+
+
+// ****************************************************************************
+// IMMEDIATES:
+//
+// As in JudyInspect.c, the Index Size comes from JU_STATIMMEDLEVEL(), and the
+// population from counting back to the first Type of that Index Size.  A
+// single Index is held in the Dcd bytes, so its JP can be narrow, but a list
+// of 2 or more has no Dcd bytes and must be at the level just below its
+// branch.
+
+        default:
+
+            if ((type < cJU_JPIMMED_1_01) || (type >= cJU_JPIMMED_CAP))
+                JU_VALIDATEFAIL(JV_JPTYPE, 0, Offset, type, 0);
+
+            if (type < cJU_JPIMMED_1_02)        // *_01 types.
+            {
+                level = type - cJU_JPIMMED_1_01 + 1;
+                JU_VALIDATEDCD(level);
+
+                pop1  = 1;
+                Index = (Index & (~JU_LEASTBYTESMASK(level)))
+                      | (JU_JPDCDPOP0(Pjp) & JU_LEASTBYTESMASK(level));
+
+                if (j__udyValidateIndex(Pjvw, Pjp, level, Index, 0) == -1)
+                    return(-1);
+                break;
+            }
+
+            {
+                uint8_t first = type;
+
+                level = JU_STATIMMEDLEVEL(type);
+
+                while ((first > cJU_JPIMMED_1_02)
+                    && ((Word_t) JU_STATIMMEDLEVEL(first - 1) == level))
+                {
+                    --first;
+                }
+                pop1 = type - first + 2;
+            }
+
+            if (level != ParentLevel - 1)
+            {
+                JU_VALIDATEFAIL(JV_JPTYPE, level, Offset, level,
+                                ParentLevel - 1);
+            }
+
+#ifdef JUDYL
+            if (P_JV(Pjp->jp_Addr) == (Pjv_t) NULL)
+                JU_VALIDATEFAIL(JV_VALUES, level, Offset, 0, pop1);
+
+            PValidate->jv_Words += JL_LEAFVPOPTOWORDS(pop1);
+#endif
+            if (j__udyValidateList(Pjvw, Pjp, (uint8_t *) PJI, pop1, level,
+                                   Index) == -1) return(-1);
+            break;
+
+        } // switch
+
+        *PPop1 = pop1;
+        return(0);
+
+} // j__udyValidateJP()
+
+
+#if (defined(DEBUG) && defined(JUDY1))
+// ****************************************************************************
+// J U D Y   C H E C K   S O R T E D
+//
+// Assert that a list of Pop1 IndexSize-byte Indexes (in a leaf or immediate)
+// is strictly ascending; called via DBGCODE() after a list is changed.  The
+// lists are the same for Judy1 and JudyL, so this is built only once, with
+// Judy1Validate().
+
+FUNCTION void JudyCheckSorted(
+        Pjll_t Pjll,            // list to check.
+        Word_t Pop1,            // Indexes in it.
+        long   IndexSize)       // bytes in each.
+{
+        Word_t offset;
+
+        for (offset = 1; offset < Pop1; ++offset)
+        {
+            assert(j__udyValidateKey((uint8_t *) Pjll, offset - 1, IndexSize)
+                 < j__udyValidateKey((uint8_t *) Pjll, offset, IndexSize));
+        }
+
+} // JudyCheckSorted()
+#endif // DEBUG && JUDY1
@@ -56,9 +56,8 @@
    in the test program "StringCompare" is verification of both these
    assumptions.
 
-   B) A 32 bit hash value is produced from the string.  Many thanks to
-   the Internet and the author (Bob Jenkins) for coming up with a very
-   good and fast universal string hash.  Next the 32 bit hash number is
+   B) A 32 bit hash value is produced from the string, 8 bytes at a time
+   (see JudyHashStr() below).  Next the 32 bit hash number is
    used as an Index to another JudyL array.  Notice that one (1) JudyL
    array is used as a hash table per each string length.  If there are
    no hash collisions (normally) then the string is copied to a
@@ -236,57 +235,110 @@ typedef struct L_EAFSTRING
 
 //=======================================================================
 // This routine must hash string to 24..32 bits.  The "goodness" of
-// the hash is not as important as its speed.
+// the hash matters as much as its speed:  the hash is the Index to a
+// JudyL array, so a well mixed 32 bits spreads strings over its leaves
+// and keeps collisions (and the JudyL trees they cost) rare.
 //=======================================================================
 
-// hash to no more than 32 bits
+// JudyHashStr() reads 8 bytes at a time (16 in the main loop, as two
+// independent lanes so a modern CPU can overlap the multiplies), mixes each
+// 8 bytes with the round of xxHash64, and finishes with the 64 bit mixer of
+// MurmurHash3, then folds to 32 bits.  The old byte at a time (c * 31 + b)
+// loop spent about as long hashing a 100+ byte string as the rest of
+// JudyHSGet(); see the HashStr() timings in test/StringCompare.c.
+//
+// Note: the words are loaded in native byte order, with memcpy() so strings
+// need not be aligned.  The hash is the same for the same string on any
+// machine of the same byte order; it is documented (in Judy.h) because
+// callers may compute it themselves.
+
+#define HS_PRIME1       ((uint64_t) 0x9E3779B185EBCA87ULL)
+#define HS_PRIME2       ((uint64_t) 0xC2B2AE3D27D4EB4FULL)
+#define HS_MIX1         ((uint64_t) 0xFF51AFD7ED558CCDULL)
+#define HS_MIX2         ((uint64_t) 0xC4CEB9FE1A85EC53ULL)
+
+#define HS_ROTL64(X,R)  (((X) << (R)) | ((X) >> (64 - (R))))
+
+#define HS_ROUND(ACC,WORD)                      \
+{                                               \
+    (ACC) += (WORD) * HS_PRIME2;                \
+    (ACC)  = HS_ROTL64(ACC, 31);                \
+    (ACC) *= HS_PRIME1;                         \
+}
+
+static uint32_t
+judyHashStr(const uint8_t * String,     // string to hash
+            Word_t Len                  // length of string
+    )
+{
+    uint64_t  h1 = HS_PRIME1 + (uint64_t) Len;  // lane 1
+    uint64_t  h2 = HS_PRIME2 - (uint64_t) Len;  // lane 2
+    uint64_t  w1, w2;                           // next 8 bytes of each
+
+    while (Len >= 16)
+    {
+        memcpy(&w1, String,     8);
+        memcpy(&w2, String + 8, 8);
+        HS_ROUND(h1, w1);
+        HS_ROUND(h2, w2);
+        String += 16;
+        Len    -= 16;
+    }
+    if (Len >= 8)
+    {
+        memcpy(&w1, String, 8);
+        HS_ROUND(h1, w1);
+        String += 8;
+        Len    -= 8;
+    }
+    if (Len)                            // last 1..7 bytes
+    {
+        w2 = 0;
+        memcpy(&w2, String, Len);
+        HS_ROUND(h2, w2);
+    }
+
+//  combine the lanes and mix (MurmurHash3 fmix64)
+
+    h1 ^= HS_ROTL64(h2, 27);
+    h1 ^= h1 >> 33;
+    h1 *= HS_MIX1;
+    h1 ^= h1 >> 33;
+    h1 *= HS_MIX2;
+    h1 ^= h1 >> 33;
+
+    return ((uint32_t) (h1 ^ (h1 >> 32)));
+}
 
 // extern Word_t gHmask; for hash bits experiments
 
 #define JUDYHASHSTR(HVALUE,STRING,LENGTH)       \
 {                                               \
-    uint8_t *p_ = (uint8_t *)(STRING);          \
-    uint8_t *q_ = p_ + (LENGTH);                \
-    uint32_t c_ = 0;                            \
-    for (; p_ != q_; ++p_)                      \
-    {                                           \
-        c_ = (c_ * 31) + *p_;                   \
-    }                                           \
-/*  c_ &= gHmask;   see above   */              \
-    (HVALUE) = c_;                              \
+    (HVALUE) = judyHashStr((uint8_t *)(STRING), (LENGTH)); \
+/*  (HVALUE) &= gHmask;   see above   */        \
 }
 
-// Find String of Len in JudyHS structure, return pointer to associated Value
+// Hash a string the way JudyHS does, for callers that want the same hash
 
-PPvoid_t
-JudyHSGet(Pcvoid_t PArray,              // pointer (^) to structure
-           void * Str,                  // pointer to string
-           Word_t Len                   // length of string
+uint32_t
+JudyHashStr(void * Str,                 // pointer to string
+            Word_t Len                  // length of string
     )
 {
-    uint8_t  *String = (uint8_t *)Str;
-    PPvoid_t  PPValue;                  // pointer to Value
-    Word_t    Index;                    // 4[8] bytes of String
-
-    JLG(PPValue, PArray, Len);          // find hash table for strings of Len
-    if (PPValue == (PPvoid_t) NULL)
-        return ((PPvoid_t) NULL);       // no strings of this Len
+    return (judyHashStr((uint8_t *)Str, Len));
+}
 
-//  check for caller error (null pointer)
-//
-    if ((String == (void *) NULL) && (Len != 0))
-        return ((PPvoid_t) NULL);       // avoid null-pointer dereference
+// Find String of Len in the tree of JudyL arrays below a hash bucket (or
+// below the length table, for short strings), return pointer to associated
+// Value
 
-#ifndef DONOTUSEHASH
-    if (Len > WORDSIZE)                 // Hash table not necessary with short
-    {
-        uint32_t  HValue;               // hash of input string
-        JUDYHASHSTR(HValue, String, Len);       // hash to no more than 32 bits
-        JLG(PPValue, *PPValue, (Word_t)HValue); // get ^ to hash bucket
-        if (PPValue == (PPvoid_t) NULL)
-            return ((PPvoid_t) NULL);   // no entry in Hash table
-    }
-#endif // DONOTUSEHASH
+static PPvoid_t
+getStrJudyLTree(uint8_t * String,      // string to find
+                Word_t Len,             // length of string
+                PPvoid_t PPValue        // ^ to hash bucket
+    )
+{
+    Word_t    Index;                    // 4[8] bytes of String
 
 /*
   Each JudyL array decodes 4[8] bytes of the string.  Since the hash
@@ -331,6 +383,155 @@ JudyHSGet(Pcvoid_t PArray,              // pointer (^) to structure
     return (PPValue);
 }
 
+// Find String of Len in JudyHS structure, given its hash, return pointer
+// to associated Value
+
+PPvoid_t
+JudyHSGetH(Pcvoid_t PArray,             // pointer (^) to structure
+           void * Str,                  // pointer to string
+           Word_t Len,                  // length of string
+           Word_t HValue                // hash of string, see JudyHashStr()
+    )
+{
+    uint8_t  *String = (uint8_t *)Str;
+    PPvoid_t  PPValue;                  // pointer to Value
+
+    JLG(PPValue, PArray, Len);          // find hash table for strings of Len
+    if (PPValue == (PPvoid_t) NULL)
+        return ((PPvoid_t) NULL);       // no strings of this Len
+
+//  check for caller error (null pointer)
+//
+    if ((String == (void *) NULL) && (Len != 0))
+        return ((PPvoid_t) NULL);       // avoid null-pointer dereference
+
+#ifndef DONOTUSEHASH
+    if (Len > WORDSIZE)                 // Hash table not necessary with short
+    {
+        JLG(PPValue, *PPValue, HValue); // get ^ to hash bucket
+        if (PPValue == (PPvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // no entry in Hash table
+    }
+#endif // DONOTUSEHASH
+
+    return (getStrJudyLTree(String, Len, PPValue));
+}
+
+// Find String of Len in JudyHS structure, return pointer to associated Value
+
+PPvoid_t
+JudyHSGet(Pcvoid_t PArray,              // pointer (^) to structure
+           void * Str,                  // pointer to string
+           Word_t Len                   // length of string
+    )
+{
+    uint32_t  HValue = 0;               // hash of input string
+
+#ifndef DONOTUSEHASH
+    if ((Len > WORDSIZE) && (Str != (void *) NULL))
+        JUDYHASHSTR(HValue, Str, Len);  // hash to no more than 32 bits
+#endif // DONOTUSEHASH
+
+    return (JudyHSGetH(PArray, Str, Len, (Word_t)HValue));
+}
+
+// Cache prefetch hint:  start a cache fill for the line containing ADDR
+// without waiting for it; compiled out with -DJU_NOPREFETCH.
+
+#if defined(__GNUC__) && (! defined(JU_NOPREFETCH))
+#define HS_PREFETCH(ADDR) __builtin_prefetch((const void *) (ADDR))
+#else
+#define HS_PREFETCH(ADDR)   // null.
+#endif
+
+// Strings looked up together by JudyHSGetBatch(); enough to keep several
+// cache misses in flight, and few enough for the stack
+
+#define HS_BATCH        16
+
+// Find Count strings in JudyHS structure, set PPValue[i] to the pointer to
+// the Value associated with Str[i] (or NULL); return the number found
+//
+// Each JudyHSGet() is a chain of dependent lookups (length table, hash
+// table, then the ls_t or tree below the bucket), so one string at a time
+// the CPU waits for each cache miss in turn.  Here HS_BATCH strings go
+// through each stage together:  hash them all, look up all their hash
+// tables (prefetching each table), then all their buckets (prefetching each
+// ls_t or JudyL below), and only then compare the strings; so the misses of
+// one stage overlap, and the prefetches hide some of the next.
+
+Word_t
+JudyHSGetBatch(Pcvoid_t PArray,         // pointer (^) to structure
+               Word_t Count,            // number of strings
+               void ** Str,             // pointers to strings
+               Word_t * Len,            // lengths of strings
+               PPvoid_t * PPValue       // returned ^ to Values (or NULL)
+    )
+{
+    PPvoid_t  PPBucket[HS_BATCH];       // ^ to hash table, then bucket
+    uint32_t  HValue[HS_BATCH];         // hashes of strings
+    Word_t    found = 0;                // strings found
+    Word_t    base, num, ii;
+
+    for (base = 0; base < Count; base += num)
+    {
+        num = Count - base;
+        if (num > HS_BATCH) num = HS_BATCH;
+
+//      hash the strings, and find (and prefetch) their hash tables
+
+        for (ii = 0; ii < num; ++ii)
+        {
+            Word_t len = Len[base + ii];
+
+            HValue[ii] = 0;
+            PPBucket[ii] = (PPvoid_t) NULL;
+
+            if ((Str[base + ii] == (void *) NULL) && (len != 0))
+                continue;               // caller error, not found
+
+#ifndef DONOTUSEHASH
+            if (len > WORDSIZE)
+                JUDYHASHSTR(HValue[ii], Str[base + ii], len);
+#endif // DONOTUSEHASH
+
+            JLG(PPBucket[ii], PArray, len);
+            if (PPBucket[ii] != (PPvoid_t) NULL)
+                HS_PREFETCH(*PPBucket[ii]);
+        }
+
+#ifndef DONOTUSEHASH
+//      find (and prefetch) the hash buckets
+
+        for (ii = 0; ii < num; ++ii)
+        {
+            if ((PPBucket[ii] == (PPvoid_t) NULL)
+             || (Len[base + ii] <= WORDSIZE)) continue;
+
+            JLG(PPBucket[ii], *PPBucket[ii], (Word_t)HValue[ii]);
+            if (PPBucket[ii] != (PPvoid_t) NULL)
+                HS_PREFETCH(CLEAR_PLS(*PPBucket[ii]));
+        }
+#endif // DONOTUSEHASH
+
+//      compare the strings (or decode them, below a collision)
+
+        for (ii = 0; ii < num; ++ii)
+        {
+            PPvoid_t PPV = (PPvoid_t) NULL;
+
+            if (PPBucket[ii] != (PPvoid_t) NULL)
+            {
+                PPV = getStrJudyLTree((uint8_t *) Str[base + ii],
+                                      Len[base + ii], PPBucket[ii]);
+                if (PPV != (PPvoid_t) NULL) ++found;
+            }
+            PPValue[base + ii] = PPV;
+        }
+    }
+    return (found);
+}
+
 // Add string to a tree of JudyL arrays (all lengths must be same)
 
 static PPvoid_t
@@ -451,12 +652,14 @@ insStrJudyLTree(uint8_t * String,      // string to add to tree of JudyL arrays
 }
 
 
-// Insert string to JudyHS structure, return pointer to associated Value
+// Insert string to JudyHS structure, given its hash, return pointer to
+// associated Value
 
 PPvoid_t
-JudyHSIns(PPvoid_t PPArray,             // ^ to JudyHashArray name
+JudyHSInsH(PPvoid_t PPArray,            // ^ to JudyHashArray name
            void * Str,                  // pointer to string
            Word_t Len,                  // length of string
+           Word_t HValue,               // hash of string, see JudyHashStr()
            PJError_t PJError            // optional, for returning error info
     )
 {
@@ -483,9 +686,7 @@ JudyHSIns(PPvoid_t PPArray,             // ^ to JudyHashArray name
 #ifndef DONOTUSEHASH
     if (Len > WORDSIZE)
     {
-        uint32_t  HValue;                       // hash of input string
-        JUDYHASHSTR(HValue, String, Len);       // hash to no more than 32 bits
-        PPValue = JudyLIns(PPValue, (Word_t)HValue, PJError);
+        PPValue = JudyLIns(PPValue, HValue, PJError);
         if (PPValue == PPJERR)
         {
             JU_SET_ERRNO(PJError, 0);
@@ -498,6 +699,25 @@ JudyHSIns(PPvoid_t PPArray,             // ^ to JudyHashArray name
     return (PPValue);                   //  ^  to Value
 }
 
+// Insert string to JudyHS structure, return pointer to associated Value
+
+PPvoid_t
+JudyHSIns(PPvoid_t PPArray,             // ^ to JudyHashArray name
+           void * Str,                  // pointer to string
+           Word_t Len,                  // length of string
+           PJError_t PJError            // optional, for returning error info
+    )
+{
+    uint32_t  HValue = 0;               // hash of input string
+
+#ifndef DONOTUSEHASH
+    if ((Len > WORDSIZE) && (Str != (void *) NULL))
+        JUDYHASHSTR(HValue, Str, Len);  // hash to no more than 32 bits
+#endif // DONOTUSEHASH
+
+    return (JudyHSInsH(PPArray, Str, Len, (Word_t)HValue, PJError));
+}
+
 // Delete string from tree of JudyL arrays (all Lens must be same)
 
 static int
@@ -550,21 +770,19 @@ delStrJudyLTree(uint8_t * String,      // delete from tree of JudyL arrays
     return (Ret);
 }
 
-// Delete string from JHS structure
+// Delete string from JHS structure, given its hash
 
 int
-JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
+JudyHSDelH(PPvoid_t PPArray,            // ^ to JudyHashArray struct
            void * Str,                  // pointer to string
            Word_t Len,                  // length of string
+           Word_t HValue,               // hash of string, see JudyHashStr()
            PJError_t PJError            // optional, for returning error info
     )
 {
     uint8_t * String = (uint8_t *)Str;
     PPvoid_t  PPBucket, PPHtble;
     int       Ret;                      // return bool from Delete routine
-#ifndef DONOTUSEHASH
-    uint32_t  HValue = 0;               // hash value of input string
-#endif // DONOTUSEHASH
 
     if (PPArray == NULL)
         return (0);                     // no pointer, return not found
@@ -572,7 +790,7 @@ JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
 //  This is a little slower than optimum method, but not much in new CPU
 //  Verify that string is in the structure -- simplifies future assumptions
 
-    if (JudyHSGet(*PPArray, String, Len) == (PPvoid_t) NULL)
+    if (JudyHSGetH(*PPArray, String, Len, HValue) == (PPvoid_t) NULL)
         return (0);                     // string not found, return
 
 //  string is in structure, so testing for absence is not necessary
@@ -584,11 +802,9 @@ JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
 #else  // USEHASH
     if (Len > WORDSIZE)
     {
-        JUDYHASHSTR(HValue, String, Len);       // hash to no more than 32 bits
-
 //  get pointer to hash bucket
 
-        JLG(PPBucket, *PPHtble, (Word_t)HValue);
+        JLG(PPBucket, *PPHtble, HValue);
     }
     else
     {
@@ -613,7 +829,7 @@ JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
         {
 //          delete entry in Hash table
 
-            Ret = JudyLDel(PPHtble, (Word_t)HValue, PJError); 
+            Ret = JudyLDel(PPHtble, HValue, PJError); 
             if (Ret != 1)
             {
                 JU_SET_ERRNO(PJError, 0);
@@ -636,6 +852,25 @@ JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
     return (1);                         // success
 }
 
+// Delete string from JHS structure
+
+int
+JudyHSDel(PPvoid_t PPArray,             // ^ to JudyHashArray struct
+           void * Str,                  // pointer to string
+           Word_t Len,                  // length of string
+           PJError_t PJError            // optional, for returning error info
+    )
+{
+    uint32_t  HValue = 0;               // hash of input string
+
+#ifndef DONOTUSEHASH
+    if ((Len > WORDSIZE) && (Str != (void *) NULL))
+        JUDYHASHSTR(HValue, Str, Len);  // hash to no more than 32 bits
+#endif // DONOTUSEHASH
+
+    return (JudyHSDelH(PPArray, Str, Len, (Word_t)HValue, PJError));
+}
+
 static Word_t
 delJudyLTree(PPvoid_t PPValue,                 // ^ to JudyL root pointer
               Word_t Len,                       // length of string
@@ -769,3 +1004,310 @@ JudyHSFreeArray(PPvoid_t PPArray,       // ^ to JudyHashArray struct
 
     return(bytes_total);                // return bytes freed
 }
+
+// ****************************************************************************
+// ITERATION:  JudyHSFirst(), JudyHSNext() and JudyHSIterFree()
+//
+// Strings are visited in the order of the length table, then of the hash
+// table for that length, then of the tree of JudyL arrays below the hash
+// bucket, where each JudyL array orders the next 4[8] bytes of the string as
+// a COPYSTRINGtoWORD() number.  Rather than a stack of positions, the
+// iterator keeps a copy of the current string, and JudyHSNext() walks down
+// from the top again to find the string after it.  This costs about the same
+// as a JudyHSGet(), and lets the caller insert or delete (even the current
+// string) between calls.
+
+// Copy the low 0..4[8] bytes of WORD to STR (the inverse of COPYSTRINGtoWORD)
+
+#define COPYWORDtoSTRING(STR,WORD,LEN)                  \
+{                                                       \
+    Word_t   w_ = (WORD);                               \
+    Word_t   i_;                                        \
+    for (i_ = 0; i_ < (LEN); ++i_, w_ >>= 8)            \
+        ((uint8_t *)(STR))[i_] = (uint8_t)w_;           \
+}
+
+// Compare two strings of Len bytes in tree of JudyL arrays order
+
+static int
+cmpStrJudyLTree(uint8_t * String1,
+                uint8_t * String2,
+                Word_t Len
+    )
+{
+    Word_t    Index1, Index2;           // next 4[8] bytes of each
+
+    while (Len)
+    {
+        Word_t    len = (Len > WORDSIZE) ? WORDSIZE : Len;
+
+        COPYSTRINGtoWORD(Index1, String1, len);
+        COPYSTRINGtoWORD(Index2, String2, len);
+        if (Index1 != Index2)
+            return ((Index1 < Index2) ? -1 : 1);
+
+        String1 += len;
+        String2 += len;
+        Len -= len;
+    }
+    return (0);
+}
+
+// Find first string in a tree of JudyL arrays (all lengths must be same),
+// copy it to String, and return ^ to its Value
+
+static PPvoid_t
+firstStrJudyLTree(uint8_t * String,     // where to copy first string
+                  Word_t Len,           // length of strings in tree
+                  Pvoid_t PArray,       // root of tree
+                  PJError_t PJError     // for returning error info
+    )
+{
+    PPvoid_t  PPValue;
+    Word_t    Index;                    // next 4[8] bytes of String
+
+    while (Len > WORDSIZE)
+    {
+        if (IS_PLS(PArray))             // ls_t struct, termination of tree
+        {
+            Pls_t     Pls;
+            Pls = (Pls_t) CLEAR_PLS(PArray);
+            memcpy(String, Pls->ls_String, Len);
+            return ((PPvoid_t) (&(Pls->ls_Value)));
+        }
+        Index = 0;
+        PPValue = JudyLFirst(PArray, &Index, PJError);
+        if ((PPValue == (PPvoid_t) NULL) || (PPValue == PPJERR))
+            return (PPValue);
+
+        COPYWORDtoSTRING(String, Index, WORDSIZE);
+        String += WORDSIZE;
+        Len -= WORDSIZE;
+        PArray = *PPValue;
+    }
+    Index = 0;
+    PPValue = JudyLFirst(PArray, &Index, PJError);
+    if ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR))
+        COPYWORDtoSTRING(String, Index, Len);
+
+    return (PPValue);
+}
+
+// Find the string after String in a tree of JudyL arrays (all lengths must be
+// same), copy it to String, and return ^ to its Value.  String need not be in
+// the tree.
+
+static PPvoid_t
+nextStrJudyLTree(uint8_t * String,      // current string, and next one
+                 Word_t Len,            // length of strings in tree
+                 Pvoid_t PArray,        // root of tree
+                 PJError_t PJError      // for returning error info
+    )
+{
+    PPvoid_t  PPValue;
+    Word_t    Index;                    // next 4[8] bytes of String
+
+    if (PArray == (Pvoid_t) NULL)
+        return ((PPvoid_t) NULL);
+
+    if (Len <= WORDSIZE)                // last 0..4[8] bytes
+    {
+        COPYSTRINGtoWORD(Index, String, Len);
+        PPValue = JudyLNext(PArray, &Index, PJError);
+        if ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR))
+            COPYWORDtoSTRING(String, Index, Len);
+
+        return (PPValue);
+    }
+
+    if (IS_PLS(PArray))                 // only string in this tree
+    {
+        Pls_t     Pls;
+        Pls = (Pls_t) CLEAR_PLS(PArray);
+        if (cmpStrJudyLTree(Pls->ls_String, String, Len) <= 0)
+            return ((PPvoid_t) NULL);   // no later string
+
+        memcpy(String, Pls->ls_String, Len);
+        return ((PPvoid_t) (&(Pls->ls_Value)));
+    }
+
+//  Look for a later string with the same next 4[8] bytes, then for the first
+//  string with later ones
+
+    COPYSTRINGtoWORD(Index, String, WORDSIZE);
+    JLG(PPValue, PArray, Index);
+    if (PPValue != (PPvoid_t) NULL)
+    {
+        PPValue = nextStrJudyLTree(String + WORDSIZE, Len - WORDSIZE,
+                                   *PPValue, PJError);
+        if (PPValue != (PPvoid_t) NULL)
+            return (PPValue);           // found, or PPJERR
+    }
+    PPValue = JudyLNext(PArray, &Index, PJError);
+    if ((PPValue == (PPvoid_t) NULL) || (PPValue == PPJERR))
+        return (PPValue);
+
+    COPYWORDtoSTRING(String, Index, WORDSIZE);
+    return (firstStrJudyLTree(String + WORDSIZE, Len - WORDSIZE, *PPValue,
+                              PJError));
+}
+
+// Find first string of length Len, given its hash table, copy it to the
+// iterator (making room for it), and return ^ to its Value
+
+static PPvoid_t
+firstStrJudyHS(PJHSIter_t PIter,       // iterator to fill in
+               Word_t Len,              // length of strings in table
+               Pvoid_t PHtble,          // hash table for strings of Len
+               PJError_t PJError        // for returning error info
+    )
+{
+    Word_t    Words = (Len + WORDSIZE - 1) / WORDSIZE;
+
+    if (Words == 0) Words = 1;          // so jhsi_Words != 0 means started
+
+    if (PIter->jhsi_Words < Words)      // make room for string (rare)
+    {
+        uint8_t * String = (uint8_t *) JudyMalloc(Words);
+        if (String == (uint8_t *) NULL)
+        {
+            JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+            return (PPJERR);
+        }
+        if (PIter->jhsi_Words)
+            JudyFree((Pvoid_t) PIter->jhsi_String, PIter->jhsi_Words);
+
+        PIter->jhsi_String = String;
+        PIter->jhsi_Words = Words;
+    }
+    PIter->jhsi_Len = Len;
+    PIter->jhsi_Hash = 0;
+
+#ifndef DONOTUSEHASH
+    if (Len > WORDSIZE)
+    {
+        PPvoid_t  PPBucket;
+        Word_t    HValue = 0;
+
+        PPBucket = JudyLFirst(PHtble, &HValue, PJError);
+        if ((PPBucket == (PPvoid_t) NULL) || (PPBucket == PPJERR))
+            return (PPBucket);
+
+        PIter->jhsi_Hash = HValue;
+        PHtble = *PPBucket;
+    }
+#endif // DONOTUSEHASH
+
+    return (firstStrJudyLTree(PIter->jhsi_String, Len, PHtble, PJError));
+}
+
+// Find first string in JudyHS structure, return pointer to associated Value
+
+PPvoid_t
+JudyHSFirst(Pcvoid_t PArray,            // pointer (^) to structure
+            PJHSIter_t PIter,           // iterator to start
+            PJError_t PJError           // optional, for returning error info
+    )
+{
+    PPvoid_t  PPHtble;
+    Word_t    Len = 0;                  // start at shortest strings
+
+    if (PIter == (PJHSIter_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+    PPHtble = JudyLFirst(PArray, &Len, PJError);
+    if ((PPHtble == (PPvoid_t) NULL) || (PPHtble == PPJERR))
+        return (PPHtble);               // empty array
+
+    return (firstStrJudyHS(PIter, Len, *PPHtble, PJError));
+}
+
+// Find string after the iterator's string in JudyHS structure, return
+// pointer to associated Value
+
+PPvoid_t
+JudyHSNext(Pcvoid_t PArray,             // pointer (^) to structure
+           PJHSIter_t PIter,            // iterator to advance
+           PJError_t PJError            // optional, for returning error info
+    )
+{
+    PPvoid_t  PPHtble, PPBucket, PPValue;
+    Word_t    Len;
+
+    if (PIter == (PJHSIter_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+    if (PIter->jhsi_Words == 0)         // not started
+        return (JudyHSFirst(PArray, PIter, PJError));
+
+    Len = PIter->jhsi_Len;
+    JLG(PPHtble, PArray, Len);          // hash table for strings of Len
+    if (PPHtble != (PPvoid_t) NULL)
+    {
+        PPBucket = PPHtble;             // simulate hash bucket
+#ifndef DONOTUSEHASH
+        if (Len > WORDSIZE)
+            JLG(PPBucket, *PPHtble, PIter->jhsi_Hash);
+#endif // DONOTUSEHASH
+
+//      next string in the same bucket
+
+        if (PPBucket != (PPvoid_t) NULL)
+        {
+            PPValue = nextStrJudyLTree(PIter->jhsi_String, Len, *PPBucket,
+                                       PJError);
+            if (PPValue != (PPvoid_t) NULL)
+                return (PPValue);       // found, or PPJERR
+        }
+#ifndef DONOTUSEHASH
+//      first string in the next bucket
+
+        if (Len > WORDSIZE)
+        {
+            Word_t    HValue = PIter->jhsi_Hash;
+
+            PPBucket = JudyLNext(*PPHtble, &HValue, PJError);
+            if (PPBucket == PPJERR)
+                return (PPJERR);
+
+            if (PPBucket != (PPvoid_t) NULL)
+            {
+                PIter->jhsi_Hash = HValue;
+                return (firstStrJudyLTree(PIter->jhsi_String, Len,
+                                          *PPBucket, PJError));
+            }
+        }
+#endif // DONOTUSEHASH
+    }
+
+//  first string of the next length
+
+    PPHtble = JudyLNext(PArray, &Len, PJError);
+    if ((PPHtble == (PPvoid_t) NULL) || (PPHtble == PPJERR))
+        return (PPHtble);               // no more strings
+
+    return (firstStrJudyHS(PIter, Len, *PPHtble, PJError));
+}
+
+// Free the iterator's copy of the current string, return bytes freed
+
+Word_t
+JudyHSIterFree(PJHSIter_t PIter)        // iterator to free
+{
+    Word_t    bytes_freed;
+
+    if ((PIter == (PJHSIter_t) NULL) || (PIter->jhsi_Words == 0))
+        return (0);
+
+    bytes_freed = PIter->jhsi_Words * WORDSIZE;
+    JudyFree((Pvoid_t) PIter->jhsi_String, PIter->jhsi_Words);
+
+    PIter->jhsi_String = (uint8_t *) NULL;
+    PIter->jhsi_Words = 0;
+
+    return (bytes_freed);
+}
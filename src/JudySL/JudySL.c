@@ -37,9 +37,12 @@
 // JudyL array, it should save a lot of time to instead point to a "leaf"
 // object, similar to leaves in JudyL arrays.
 //
-// TBD:  Multi-index leaves, like those in JudyL, are also worth considering,
-// but their payback for JudySL is less certain.  Likewise, shortcut branches
-// are worth considering too.
+// Likewise, where all the Indexes below a pointer share their next several
+// words, a "compressed path" object holds those words, in place of a chain of
+// JudyL arrays with one index word each.
+//
+// And where a few short Indexes are all that is below a pointer, a "packed
+// leaf" holds them all, much as a JudyL leaf holds several index words.
 //
 // This code uses the Judy.h definitions and Doug Baskins convention of a "P"
 // prefix for pointers, except no "P" for the first level of char * (strings).
@@ -85,9 +88,12 @@
 #define WORDSIZE     (sizeof (Word_t))  // bytes in word = JudyL index.
 #define WORDS(BYTES) (((BYTES) + WORDSIZE - 1) / WORDSIZE)      // round up.
 
-// To mark a pointer is to a "short cut leaf", set least bit
+// To mark a pointer is to a "short cut leaf", set least bit (but not the next
+// one; see SL_PLF)
+
+#define SL_FLAGS          0x3           // all the flag bits in a pointer.
 
-#define IS_PSCL(PSCL)     (((Word_t) (PSCL)) & JLAP_INVALID)
+#define IS_PSCL(PSCL)     ((((Word_t) (PSCL)) & SL_FLAGS) == JLAP_INVALID)
 #define CLEAR_PSCL(PSCL)  ((Pscl_t)(((Word_t) (PSCL)) & (~JLAP_INVALID)))
 #define SET_PSCL(PSCL)    (((Word_t) (PSCL)) | JLAP_INVALID)
 
@@ -107,7 +113,7 @@
 
 // copy from 1..7 bytes from string to Word_t and test if \0 bytes
 //
-#define        COPYSTRINGtoWORD(WORD,STR)               \
+#define        COPYSTRINGtoWORD_B(WORD,STR)             \
 {                                                       \
     do                                                  \
     {                                                   \
@@ -131,7 +137,7 @@
 
 // copy Word_t from 1..8 bytes to string and test of \0 bytes
 //
-#define         COPYWORDtoSTRING(STR,WORD)                      \
+#define         COPYWORDtoSTRING_B(STR,WORD)                    \
 {                                                               \
     do                                                          \
     {                                                           \
@@ -146,6 +152,92 @@
     } while(0);                                                 \
 }
 
+// WORD-AT-A-TIME COPYING:
+//
+// The byte loops above run at every level of every JudySL*() call, and for
+// long Indexes (URLs and such) they are most of the cost.  With gcc on a
+// machine of known byte order, instead load the whole 8 bytes at once, swap
+// them into big-endian (Index) order, and clear every byte after the first
+// null, found with the carry-free zero-byte test (the classic haszero() trick
+// can flag a 0x01 byte above a null, which here is earlier in the string).
+//
+// The load may read bytes past the trailing null; that is safe as long as it
+// stays within the page holding the null, so when the 8 bytes would cross a
+// page boundary, use the byte loop instead.  Copying back to a string can
+// only store a whole word when the Index does not end in it (the last byte is
+// not null, so none is); otherwise the callers buffer may end sooner.
+//
+// Where the length of the Index is known, COPYSTRINGtoFULLWORD() copies a
+// word that the Index fills and COPYSTRINGtoLASTWORD() the word holding the
+// null, with the byte loop, so neither reads past the null.
+//
+// Define JU_NOWORDCOPY to always use the byte loops (for example, to keep
+// valgrind quiet about the over-read); it is defined here for builds with the
+// address or memory sanitizer, which would report it.
+
+#if defined(__SANITIZE_ADDRESS__)
+#define JU_NOWORDCOPY
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define JU_NOWORDCOPY
+#endif
+#endif
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (! defined(JU_NOWORDCOPY))
+
+#define SL_PAGESIZE  4096               // smallest page size of interest.
+#define SL_LOWBITS   0x7f7f7f7f7f7f7f7fUL
+
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define SL_BIGENDIAN(WORD)  __builtin_bswap64(WORD)
+#else
+#define SL_BIGENDIAN(WORD)  (WORD)
+#endif
+
+#define        COPYSTRINGtoWORD(WORD,STR)                       \
+{                                                               \
+    if ((((Word_t)(STR)) & (SL_PAGESIZE - 1))                   \
+        <= (SL_PAGESIZE - WORDSIZE))                            \
+    {                                                           \
+        Word_t _zero;                                           \
+        (void)memcpy(&(WORD), (STR), WORDSIZE);                 \
+        WORD  = SL_BIGENDIAN(WORD);                             \
+        _zero = ~((((WORD) & SL_LOWBITS) + SL_LOWBITS)          \
+                  | (WORD) | SL_LOWBITS);                       \
+        if (_zero)                                              \
+            WORD &= ~(~0UL >> __builtin_clzl(_zero));           \
+    }                                                           \
+    else COPYSTRINGtoWORD_B(WORD, STR)                          \
+}
+
+#define        COPYSTRINGtoFULLWORD(WORD,STR)                   \
+{                                                               \
+    (void)memcpy(&(WORD), (STR), WORDSIZE);                     \
+    WORD = SL_BIGENDIAN(WORD);                                  \
+}
+
+#define COPYSTRINGtoLASTWORD(WORD,STR) COPYSTRINGtoWORD_B(WORD, STR)
+
+#define        COPYWORDtoSTRING(STR,WORD)                       \
+{                                                               \
+    if (LASTWORD_BY_VALUE(WORD))                                \
+        COPYWORDtoSTRING_B(STR, WORD)                           \
+    else                                                        \
+    {                                                           \
+        Word_t _word = SL_BIGENDIAN(WORD);                      \
+        (void)memcpy((STR), &_word, WORDSIZE);                  \
+    }                                                           \
+}
+
+#else // JU_NOWORDCOPY
+
+#define COPYSTRINGtoWORD(WORD,STR)     COPYSTRINGtoWORD_B(WORD, STR)
+#define COPYSTRINGtoFULLWORD(WORD,STR) COPYSTRINGtoWORD_B(WORD, STR)
+#define COPYSTRINGtoLASTWORD(WORD,STR) COPYSTRINGtoWORD_B(WORD, STR)
+#define COPYWORDtoSTRING(STR,WORD)     COPYWORDtoSTRING_B(STR, WORD)
+
+#endif // JU_NOWORDCOPY
+
 #else  // JU_32BIT
 
 // copy from 1..4 bytes from string to Word_t and test if \0 bytes
@@ -176,6 +268,9 @@
         (STR)[3]       = (uint8_t)(WORD);                       \
     } while(0);                                                 \
 }
+
+#define COPYSTRINGtoFULLWORD(WORD,STR) COPYSTRINGtoWORD(WORD, STR)
+#define COPYSTRINGtoLASTWORD(WORD,STR) COPYSTRINGtoWORD(WORD, STR)
 #endif // JU_32BIT
 
 
@@ -245,12 +340,123 @@ typedef struct SHORCUTLEAF
     (void)STRCPY((PSCL)->scl_Index, INDEX);                             \
 }
 
+// SUPPORT FOR COMPRESSED PATH NODES:
+//
+// Where all the Indexes below a point share the next several words, such as
+// the long common prefix of a set of URLs, a plain JudySL tree has a chain of
+// JudyL arrays each holding one index word, costing a JudyLGet() (and likely
+// a cache miss) per word.  Instead, JudySLIns() stores such a run of words
+// inline in one "compressed path" node that points to what follows the run,
+// much as a shortcut leaf stores the rest of a single Index.  None of the
+// words is the last of an Index.  When a new Index diverges partway along a
+// path, the path is split around a new JudyL array (see JudySLSplitPath()).
+// Like a shortcut leaf, the node is marked by a flag bit in the pointer to it.
+//
+// Like emptied JudyL arrays, paths are not re-merged after deletions.
+
+typedef struct COMPRESSEDPATH
+{
+    Pvoid_t   pcn_Next;                 // what follows the path.
+    Word_t    pcn_Words;                // index words in the path.
+    Word_t    pcn_Word[1];              // the index words.
+} pcn_t  , *Ppcn_t;
+
+#define PCNSIZE(WORDS)  ((WORDS) + 2)   // in words.
+
+#define SL_PCN            0x2           // flag next to JLAP_INVALID.
+#define IS_PPCN(PPCN)     ((((Word_t) (PPCN)) & SL_FLAGS) == SL_PCN)
+#define CLEAR_PPCN(PPCN)  ((Ppcn_t)(((Word_t) (PPCN)) & (~SL_PCN)))
+#define SET_PPCN(PPCN)    (((Word_t) (PPCN)) | SL_PCN)
+
+// SUPPORT FOR PACKED LEAVES:
+//
+// Where a few short Indexes are all that is below a pointer, such as the tags
+// "color=red" and "color=blue" under "color=", a JudyL array with a shortcut
+// leaf under each index word costs a malloc() per Index besides the JudyL
+// array, and a dictionary of millions of tags is mostly such small objects.
+// Instead, JudySLIns() packs up to SL_PLFMAXPOP Indexes whose remaining bytes
+// (with the \0) number at most SL_PLFMAXLEN into one "packed leaf":  their
+// values, then their index words, each Index ending with its last word (see
+// LASTWORD_BY_VALUE()), in Index order.  Like a JudyL leaf, it is searched by
+// comparing whole words in order, which for so few, so short Indexes is no
+// slower than one JudyLGet() would be.
+//
+// A shortcut leaf becomes a packed leaf when a second short Index arrives
+// under it; a packed leaf that is full, or that a longer Index arrives at, is
+// split into a JudyL array of the first words of its Indexes, with the value,
+// a shortcut leaf, or a smaller packed leaf under each (see
+// JudySLLeafSplit()); and a packed leaf goes back to being a shortcut leaf
+// when just one Index is left.  The pointer to it has both flag bits set.
+
+typedef struct PACKEDLEAF
+{
+    Word_t    plf_Pop;                  // Indexes in the leaf.
+    Word_t    plf_Words;                // index words of all of them.
+    Pvoid_t   plf_Pvalue[1];            // their value areas, then words.
+} plf_t  , *Pplf_t;
+
+#define SL_PLFMAXPOP    16              // most Indexes in a packed leaf.
+#define SL_PLFMAXWORDS  3               // most index words per Index.
+#define SL_PLFMAXLEN    (SL_PLFMAXWORDS * WORDSIZE)     // in bytes.
+
+#define PLFSIZE(POP,WORDS)  ((POP) + (WORDS) + 2)       // in words.
+#define PLFWORDS(PPLF)      ((PWord_t) ((PPLF)->plf_Pvalue + (PPLF)->plf_Pop))
+
+#define SL_PLF            (JLAP_INVALID | SL_PCN)
+#define IS_PPLF(PPLF)     ((((Word_t) (PPLF)) & SL_FLAGS) == SL_PLF)
+#define CLEAR_PPLF(PPLF)  ((Pplf_t)(((Word_t) (PPLF)) & (~SL_FLAGS)))
+#define SET_PPLF(PPLF)    (((Word_t) (PPLF)) | SL_PLF)
+
+// SUPPORT FOR SUBTREE POPULATIONS:
+//
+// JudySLCount() and JudySLByCount() need the number of Indexes below each
+// pointer in the tree.  No Index word has a \0 byte followed by a non-null
+// byte, so the index words 1 and 2 never occur; JudySLCountInit() stores, in
+// each JudyL array in the tree, the number of Indexes at and below it as the
+// value of index word 1.  From then on the JudySL array is "counted" (its top
+// is a JudyL array with a count), and JudySLIns() and JudySLDel() keep the
+// counts up to date.
+//
+// Note:  A counted JudySL array does not go back to NULL when its last Index
+// is deleted; the top JudyL array stays, with a count of 0, until
+// JudySLFreeArray() frees it.
+//
+// To add up the populations before an index word without visiting each one,
+// a wide JudyL array also keeps, under index word 2, a "sums" object with the
+// populations of blocks of its index words (see JudySLSumsBefore()).  Each
+// insert or delete updates the sums of each JudyL array above it, in O(log N)
+// for N index words, so adding up the populations before any index word takes
+// O(log N) plus a walk of at most 2 * SL_SUMSBLOCK index words.
+//
+// JudySLCount() and JudySLByCount() only read the JudySL array, so like the
+// other read functions they can run alongside each other.  In an array that
+// is not counted, they add up the populations as they go, which is slow.
+//
+// The search functions step over index words 1 and 2 (see JudySLFirstWord(),
+// etc.).  A JudyL array made by a JudySLIns() that ran out of memory can lack
+// a count; the next insert below it stores one, and until then the count is
+// computed when needed.
+
+#define SL_COUNTWORD    1L              // never an index word.
+#define SL_SUMSWORD     2L              // never an index word.
+#define SL_HIDDEN(WORD) (((WORD) - 1L) < 2L)   // either of the above.
+
+#define SL_SUMSMIN      64              // fewest index words to keep sums.
+#define SL_SUMSBLOCK    16              // index words per block of sums.
+
 // "FORWARD" DECLARATIONS:
 
 static void JudySLModifyErrno(PJError_t PJError,
                               Pcvoid_t PArray, Pcvoid_t PArrayOrig);
+static PPvoid_t JudySLInsSub(PPvoid_t PPArray, const uint8_t * Index,
+                             PJError_t PJError);
+static Word_t JudySLCountIns(PPvoid_t PPArray, const uint8_t * Index,
+                             Word_t len, PJError_t PJError);
+static int JudySLCountDel(PPvoid_t PPArray, Word_t Word, int Top,
+                          PJError_t PJError);
 static int JudySLDelSub(PPvoid_t PPArray, PPvoid_t PPArrayOrig,
-                        const uint8_t * Index, Word_t len, PJError_t PJError);
+                        const uint8_t * Index, Word_t len, int counted,
+                        PJError_t PJError);
 static PPvoid_t JudySLPrevSub(Pcvoid_t PArray, uint8_t * Index, int orig,
                               Word_t len, PJError_t PJError);
 static PPvoid_t JudySLNextSub(Pcvoid_t PArray, uint8_t * Index, int orig,
@@ -287,236 +493,3375 @@ JudySLModifyErrno(PJError_t PJError,    // to modify if non-null.
 }                                       // JudySLModifyErrno()
 
 // ****************************************************************************
-// J U D Y   S L   G E T
+// J U D Y   S L   F I R S T / N E X T / L A S T / P R E V   W O R D
 //
-// See comments in file header and below.
+// JudyLFirst(), etc. for a JudyL array in a JudySL tree, stepping over the
+// subtree population and sums (see SL_COUNTWORD) if any.
 
-PPvoid_t
-JudySLGet(Pcvoid_t PArray, const uint8_t * Index, PJError_t PJError)
+static    PPvoid_t
+JudySLNextWord(Pcvoid_t PArray, PWord_t Pword, PJError_t PJError)
 {
-    const uint8_t *pos = Index;         // place in Index.
-    Word_t    indexword;                // buffer for aligned copy.
-    PPvoid_t  PPValue;                  // from JudyL array.
-
-// CHECK FOR CALLER ERROR (NULL POINTER):
+    PPvoid_t  PPValue = JudyLNext(PArray, Pword, PJError);
 
-    if (Index == (uint8_t *) NULL)
+    while ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+        && SL_HIDDEN(*Pword))
     {
-        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
-        return (PPJERR);
+        PPValue = JudyLNext(PArray, Pword, PJError);
     }
+    return (PPValue);
+}                                       // JudySLNextWord()
 
-// SEARCH NEXT LEVEL JUDYL ARRAY IN TREE:
-//
-// Use or copy each word from the Index string and check for it in the next
-// level JudyL array in the array tree, but first watch for shortcut leaves.
-// Upon invalid Index or end of Index (string) in current word, return.
+static    PPvoid_t
+JudySLFirstWord(Pcvoid_t PArray, PWord_t Pword, PJError_t PJError)
+{
+    PPvoid_t  PPValue = JudyLFirst(PArray, Pword, PJError);
 
-    do                                  // until return.
+    while ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+        && SL_HIDDEN(*Pword))
     {
-        if (IS_PSCL(PArray))            // a shortcut leaf.
-            return (PPSCLVALUE_EQ(pos, PArray));
-
-        COPYSTRINGtoWORD(indexword, pos);       // copy next 4[8] bytes.
+        PPValue = JudyLNext(PArray, Pword, PJError);
+    }
+    return (PPValue);
+}                                       // JudySLFirstWord()
 
-        JLG(PPValue, PArray, indexword);
+static    PPvoid_t
+JudySLPrevWord(Pcvoid_t PArray, PWord_t Pword, PJError_t PJError)
+{
+    PPvoid_t  PPValue = JudyLPrev(PArray, Pword, PJError);
 
-        if ((PPValue == (PPvoid_t) NULL) || LASTWORD_BY_VALUE(indexword))
-            return (PPValue);
+    while ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+        && SL_HIDDEN(*Pword))
+    {
+        PPValue = JudyLPrev(PArray, Pword, PJError);
+    }
+    return (PPValue);
+}                                       // JudySLPrevWord()
 
-// CONTINUE TO NEXT LEVEL DOWN JUDYL ARRAY TREE:
-//
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated here as a dead-end (not a core
-// dump or assertion; see version 1.25).
+static    PPvoid_t
+JudySLLastWord(Pcvoid_t PArray, PWord_t Pword, PJError_t PJError)
+{
+    PPvoid_t  PPValue = JudyLLast(PArray, Pword, PJError);
 
-        pos += WORDSIZE;
-        PArray = *PPValue;              // each value -> next array.
-    } while(1);                         // forever
-//  NOTREACHED JudySLGet()
-}
+    while ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+        && SL_HIDDEN(*Pword))
+    {
+        PPValue = JudyLPrev(PArray, Pword, PJError);
+    }
+    return (PPValue);
+}                                       // JudySLLastWord()
 
 // ****************************************************************************
-// J U D Y   S L   I N S
-//
-// See also the comments in JudySLGet(), which is somewhat similar, though
-// simpler.
-//
-// Theory of operation:
-//
-// Upon encountering a null pointer in the tree of JudyL arrays, insert a
-// shortcut leaf -- including directly under a null root pointer for the first
-// Index in the JudySL array.
-//
-// Upon encountering a pre-existing shortcut leaf, if the old Index is equal to
-// the new one, return the old value area.  Otherwise, "carry down" the old
-// Index until the old and new Indexes diverge, at which point each Index
-// either terminates in the last JudyL array or a new shortcut leaf is inserted
-// under it for the Indexs remainder.
+// J U D Y   S L   C O U N T E D
 //
-// TBD:  Running out of memory below the starting point causes a premature
-// return below (in several places) and leaves a dead-end in the JudySL tree.
-// Ideally the code here would back this out rather than wasting a little
-// memory, but in lieu of that, the get, delete, and search functions
-// understand dead-ends and handle them appropriately.
+// Return a pointer to the population of a JudySL array, if it is counted (see
+// SL_COUNTWORD), otherwise null.
 
-PPvoid_t
-JudySLIns(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)
+static    PWord_t
+JudySLCounted(Pcvoid_t PArray)
 {
-    PPvoid_t  PPArrayOrig = PPArray;    // for error reporting.
-    const uint8_t *pos = Index;         // place in Index.
-    const uint8_t *pos2 = (uint8_t *) NULL;     // old Index (SCL being moved).
-    Word_t    len;                      // bytes remaining.
-
-// Note:  len2 is set when needed and only used when valid, but this is not
-// clear to gcc -Wall, so initialize it here to avoid a warning:
-
-    Word_t    len2 = 0;                 // for old Index (SCL being moved).
-    Word_t    scl2 = 0;                 // size in words of SCL
-    Word_t    indexword;                // buffer for aligned copy.
-    Word_t    indexword2;               // for old Index (SCL being moved).
-    PPvoid_t  PPValue;                  // from JudyL array.
-    PPvoid_t  PPValue2;                 // for old Index (SCL being moved).
-    Pscl_t    Pscl = (Pscl_t) NULL;     // shortcut leaf.
-    Pscl_t    Pscl2;                    // for old Index (SCL being moved).
-
-// CHECK FOR CALLER ERROR (NULL POINTERS):
+    PPvoid_t  PPCount;
 
-    if (PPArray == (PPvoid_t) NULL)
-    {
-        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
-        return (PPJERR);
-    }
-    if (Index == (uint8_t *) NULL)
+    if ((PArray == (Pvoid_t) NULL) || IS_PSCL(PArray) || IS_PPLF(PArray)
+     || IS_PPCN(PArray))
     {
-        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
-        return (PPJERR);
+        return ((PWord_t) NULL);
     }
 
-    len = STRLEN(Index);        // bytes remaining.
-
-// APPEND SHORTCUT LEAF:
-//
-// If PPArray, which is the root pointer to the first or next JudyL array in
-// the tree, points to null (no next JudyL array), AND there is no shortcut
-// leaf being carried down, append a shortcut leaf here for the new Index, no
-// matter how much of the Index string remains (one or more bytes, including
-// the trailing \0).
+    JLG(PPCount, PArray, SL_COUNTWORD);
+    if (PPCount == PPJERR)              // not a JudyL array; see callers.
+        return ((PWord_t) NULL);
 
-    while (1)                           // until return.
-    {
-        if (*PPArray == (Pvoid_t)NULL)  // no next JudyL array.
-        {
-            if (Pscl == (Pscl_t) NULL)  // no SCL being carried down.
-            {
-                APPEND_SCL(Pscl, PPArray, pos, len, PJError);   // returns if error.
-                return (&(Pscl->scl_Pvalue));
-            }
-            // else do nothing here; see below.
-        }
+    return ((PWord_t) PPCount);
+}                                       // JudySLCounted()
 
-// CARRY DOWN PRE-EXISTING SHORTCUT LEAF:
+// ****************************************************************************
+// J U D Y   S L   P O P
 //
-// When PPArray points to a pre-existing shortcut leaf, if its Index is equal
-// to the Index to be inserted, meaning no insertion is required, return its
-// value area; otherwise, "move it aside" and "carry it down" -- replace it
-// (see below) with one or more levels of JudyL arrays.  Moving it aside
-// initially just means setting Pscl non-null, both as a flag and for later
-// use, and clearing the pointer to the SCL in the JudyL array.
-
-        else if (IS_PSCL(*PPArray))
-        {
-            assert(Pscl == (Pscl_t) NULL);      // no nested SCLs.
+// Return the number of Indexes at and below PArray, or JERR.  For a JudyL
+// array, use its stored population, or if there is none, add up those below
+// it.  This only reads the JudySL array.
 
-            Pscl = CLEAR_PSCL(*PPArray);
+static    Word_t
+JudySLPop(Pcvoid_t PArray, PJError_t PJError)
+{
+    Word_t    indexword = 0;            // word just found.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    pop1 = 0;                 // sum for JudyL array.
+    Word_t    pop1sub;                  // below one index word.
 
-            pos2 = Pscl->scl_Index;     // note: pos2 is always word-aligned.
-            len2 = STRLEN(pos2);        // bytes remaining.
+    if (PArray == (Pvoid_t) NULL)       // a dead end; see JudySLGet().
+        return (0);
 
-//          first check if string is already inserted
+    if (IS_PSCL(PArray))
+        return (1);
 
-            if ((len == len2) && (STRCMP(pos, pos2) == 0))
-                return (&(Pscl->scl_Pvalue));
+    if (IS_PPLF(PArray))
+        return (CLEAR_PPLF(PArray)->plf_Pop);
 
-            *PPArray = (Pvoid_t)NULL;   // disconnect SCL.
+    if (IS_PPCN(PArray))
+        return (JudySLPop(CLEAR_PPCN(PArray)->pcn_Next, PJError));
 
-            scl2 = SCLSIZE(len2);       // save for JudyFree
+    JLG(PPValue, PArray, SL_COUNTWORD);
+    if (PPValue != (PPvoid_t) NULL)
+        return (*((PWord_t) PPValue));
 
-            // continue with *PPArray now clear, and Pscl, pos2, len2 set.
+    for (PPValue = JudySLFirstWord(PArray, &indexword, PJError);
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR);
+         PPValue = JudySLNextWord(PArray, &indexword, PJError))
+    {
+        if (LASTWORD_BY_VALUE(indexword))
+        {
+            ++pop1;
+            continue;
         }
+        if ((pop1sub = JudySLPop(*PPValue, PJError)) == JERR)
+            return (JERR);
+        pop1 += pop1sub;
+    }
+    return ((PPValue == PPJERR) ? JERR : pop1);
+}                                       // JudySLPop()
 
-// CHECK IF OLD AND NEW INDEXES DIVERGE IN THE CURRENT INDEX WORD:
-//
-// If a shortcut leaf is being carried down and its remaining Index chars now
-// diverge from the remaining chars of the Index being inserted, that is, if
-// the next words of each Index differ, "plug in" the old Index here, in a new
-// JudyL array, before proceeding.
+// Return the number of Indexes at and below an index word, Word, whose value
+// is PValue, or JERR:
+
+static    Word_t
+JudySLWordPop(Pcvoid_t PValue, Word_t Word, PJError_t PJError)
+{
+    if (LASTWORD_BY_VALUE(Word))
+        return (1);
+    return (JudySLPop(PValue, PJError));
+}                                       // JudySLWordPop()
+
+// ****************************************************************************
+// J U D Y   S L   S U M S
 //
-// Note:  Call JudyLIns() for the SCL Index word before calling it for the new
-// Index word, so PPValue remains correct for the latter.  (JudyLIns() return
-// values are not stable across multiple calls.)
+// The sums of a wide JudyL array (see SL_COUNTWORD) split its index words
+// into blocks, each from a "bound" index word up to the next one, and keep
+// the populations of the blocks in a Fenwick tree, where entry i (from 1)
+// holds the slots from i - (i & -i) + 1 through i.  To add up the populations
+// before an index word, add up the slots before the block that holds it (see
+// JudySLSumsBefore()), then walk at most 2 * SL_SUMSBLOCK index words in the
+// block.  An insert or delete adds to O(log N) entries.
 //
-// Note:  Although pos2 is word-aligned, and a Pscl_t is a whole number of
-// words in size, pos2 is not certain to be null-padded through a whole word,
-// so copy it first to an index word for later use.
+// A block that grows too big is split in two (see JudySLSplitBlock()).  So
+// that this does not move every block after it, each block starts out with
+// an empty slot after it, and a third of the slots are left empty at the end
+// (for Indexes inserted in order); a split takes an empty slot near the
+// block, moving the few blocks between, and only if there is none are all
+// the blocks spread out again.  An empty slot has the bound of the next
+// block, so it holds no index words.
 //
-// See header comments about premature return().
+// A sums object is the number of slots, S, the last slot in use, the number
+// of blocks, then the S bounds (the first is always 0), then the tree:
 
-        COPYSTRINGtoWORD(indexword, pos);       // copy next 4[8] bytes.
+#define SUMSSIZE(SLOTS)   (3 + ((SLOTS) * 2))   // in words.
+#define SUMSLAST(PSUMS)   ((PSUMS)[1])
+#define SUMSBLOCKS(PSUMS) ((PSUMS)[2])
+#define SUMSBOUND(PSUMS)  ((PSUMS) + 3)
+#define SUMSTREE(PSUMS)   ((PSUMS) + 3 + (PSUMS)[0])
 
-        if (Pscl != (Pscl_t) NULL)
-        {
-            COPYSTRINGtoWORD(indexword2, pos2); // copy next 4[8] bytes.
+#define SUMSEMPTY(PSUMS,SLOT)                                           \
+        (((SLOT) > SUMSLAST(PSUMS))                                     \
+      || (((SLOT) < SUMSLAST(PSUMS))                                    \
+       && (SUMSBOUND(PSUMS)[(SLOT) + 1] == SUMSBOUND(PSUMS)[SLOT])))
 
-            if (indexword != indexword2)        // SCL and new Indexes diverge.
-            {
-                assert(*PPArray == (Pvoid_t)NULL);      // should be new JudyL array.
+#define SL_SUMSREACH    8               // farthest empty slot for a split.
 
-// Note:  If JudyLIns() returns JU_ERRNO_NOTJUDYL here, *PPArray should not be
-// modified, so JudySLModifyErrno() can do the right thing.
+// Turn the populations of Slots slots into a Fenwick tree, in place, or
+// back:
 
-                if ((PPValue2 = JudyLIns(PPArray, indexword2, PJError))
-                    == PPJERR)
-                {
-                    JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
-                    return (PPJERR);
-                }
+static void
+JudySLTreeBuild(PWord_t Ptree, Word_t Slots)
+{
+    Word_t    slot;                     // tree entry, from 1.
+    Word_t    up;                       // the one that includes it.
 
-                assert(PPValue2 != (PPvoid_t) NULL);
+    for (slot = 1; slot <= Slots; ++slot)
+        if ((up = slot + (slot & (0 - slot))) <= Slots)
+            Ptree[up - 1] += Ptree[slot - 1];
+}                                       // JudySLTreeBuild()
 
-// If the old (SCL) Index terminates here, copy its value directly into the
-// JudyL value area; otherwise create a new shortcut leaf for it, under
-// *PPValue2 (skipping the word just inserted), and copy its value to the new
-// SCL:
+static void
+JudySLTreeUnbuild(PWord_t Ptree, Word_t Slots)
+{
+    Word_t    slot;                     // tree entry, from 1.
+    Word_t    up;                       // the one that includes it.
 
-                if (len2 <= WORDSIZE)
-                {
-                    *((PWord_t)PPValue2) = (Word_t)(Pscl->scl_Pvalue);
-                }
-                else
-                {
-                    APPEND_SCL(Pscl2, PPValue2, pos2 + WORDSIZE,
-                               len2 - WORDSIZE, PJError);
-                    (Pscl2->scl_Pvalue) = Pscl->scl_Pvalue;
-                }
-//              old SCL no longer needed.
+    for (slot = Slots; slot > 0; --slot)
+        if ((up = slot + (slot & (0 - slot))) <= Slots)
+            Ptree[up - 1] -= Ptree[slot - 1];
+}                                       // JudySLTreeUnbuild()
 
-                JudyFree((void *)Pscl, scl2);
+// Add Delta (which can be "negative") to the population of slot Slot (from
+// 0):
 
-                Pscl = (Pscl_t) NULL;
-            }
-        }
+static void
+JudySLSumsAdd(PWord_t Psums, Word_t Slot, Word_t Delta)
+{
+    PWord_t   Ptree = SUMSTREE(Psums);
+
+    for (++Slot; Slot <= Psums[0]; Slot += Slot & (0 - Slot))
+        Ptree[Slot - 1] += Delta;
+}                                       // JudySLSumsAdd()
+
+// Return the number of Indexes in the slots before slot Slot (from 0):
+
+static    Word_t
+JudySLSumsBefore(PWord_t Psums, Word_t Slot)
+{
+    PWord_t   Ptree = SUMSTREE(Psums);
+    Word_t    pop1 = 0;                 // so far.
+
+    for ( ; Slot > 0; Slot &= Slot - 1)
+        pop1 += Ptree[Slot - 1];
+
+    return (pop1);
+}                                       // JudySLSumsBefore()
+
+// Return the slot of the block that holds index word Word:
+
+static    Word_t
+JudySLSumsBlock(PWord_t Psums, Word_t Word)
+{
+    PWord_t   Pbound = SUMSBOUND(Psums);
+    Word_t    lo = 0;                   // slot.
+    Word_t    hi = SUMSLAST(Psums);
+
+    while (lo < hi)
+    {
+        Word_t    mid = (lo + hi + 1) / 2;
+
+        if (Pbound[mid] <= Word) lo = mid;
+        else                     hi = mid - 1;
+    }
+    return (lo);
+}                                       // JudySLSumsBlock()
+
+// Return the slot of the block that holds Index number *PCount0 (from 0), and
+// take from *PCount0 the Indexes in the blocks before it:
+
+static    Word_t
+JudySLSumsFind(PWord_t Psums, PWord_t PCount0)
+{
+    PWord_t   Ptree = SUMSTREE(Psums);
+    Word_t    slots = Psums[0];
+    Word_t    slot = 0;                 // slots passed.
+    Word_t    step = 1;                 // power of 2.
+
+    while (step <= slots / 2)
+        step *= 2;
+
+    for ( ; step > 0; step /= 2)
+    {
+        if ((slot + step <= slots) && (Ptree[slot + step - 1] <= *PCount0))
+        {
+            slot += step;
+            *PCount0 -= Ptree[slot - 1];
+        }
+    }
+    return (slot);
+}                                       // JudySLSumsFind()
+
+// The bounds and populations of Blocks blocks are at the start of the bounds
+// and tree of a new sums object with room for 3 * Blocks slots; spread them
+// out, with an empty slot after each, and build the tree:
+
+static void
+JudySLSumsSpread(PWord_t Psums, Word_t Blocks)
+{
+    PWord_t   Pbound = SUMSBOUND(Psums);
+    PWord_t   Ptree = SUMSTREE(Psums);
+    Word_t    slot;                     // past the blocks.
+    Word_t    block;                    // number of block.
+
+    for (slot = Blocks * 2; slot < Psums[0]; ++slot)
+    {
+        Pbound[slot] = ~0UL;
+        Ptree[slot] = 0;
+    }
+    for (block = Blocks; block-- > 0; )         // last first.
+    {
+        Pbound[block * 2] = Pbound[block];
+        Ptree[block * 2] = Ptree[block];
+        Pbound[block * 2 + 1] = Pbound[block * 2 + 2];
+        Ptree[block * 2 + 1] = 0;
+    }
+    SUMSLAST(Psums) = (Blocks - 1) * 2;
+    SUMSBLOCKS(Psums) = Blocks;
+    JudySLTreeBuild(Ptree, Psums[0]);
+}                                       // JudySLSumsSpread()
+
+// ****************************************************************************
+// J U D Y   S L   D R O P   S U M S
+//
+// Free the sums, if any, of the JudyL array at *PPArray.  Return 1 if there
+// were none, 2 if freed, or JERR.
+
+static int
+JudySLDropSums(PPvoid_t PPArray, PJError_t PJError)
+{
+    PPvoid_t  PPSums;                   // from JudyL array.
+    PWord_t   Psums;                    // sums object.
+
+    JLG(PPSums, *PPArray, SL_SUMSWORD);
+    if (PPSums == (PPvoid_t) NULL)
+        return (1);
+
+    Psums = (PWord_t) *PPSums;
+    JudyFree((Pvoid_t) Psums, SUMSSIZE(Psums[0]));
+
+    return ((JudyLDel(PPArray, SL_SUMSWORD, PJError) == JERR) ? JERR : 2);
+}                                       // JudySLDropSums()
+
+// ****************************************************************************
+// J U D Y   S L   B U I L D   S U M S
+//
+// Build (or rebuild) the sums of the JudyL array at *PPArray, which has a
+// population, if it is wide enough, otherwise drop any.  Return 1, or 2 if
+// the JudyL array was changed (so its value areas can move), or JERR.
+
+static int
+JudySLBuildSums(PPvoid_t PPArray, PJError_t PJError)
+{
+    PPvoid_t  PPValue;                  // from JudyL array.
+    PPvoid_t  PPSums;                   // old sums, if any.
+    PWord_t   Psums;                    // new sums object.
+    Word_t    words;                    // index words in JudyL array.
+    Word_t    blocks;                   // in sums.
+    Word_t    word = 0;                 // number of index word.
+    Word_t    indexword = 0;            // word just found.
+    Word_t    pop1sub;                  // below one index word.
+
+    JLG(PPSums, *PPArray, SL_SUMSWORD);
+    words = JudyLCount(*PPArray, 0, ~0UL, PJE0) - 1;    // less population.
+    if (PPSums != (PPvoid_t) NULL)
+        --words;
+
+    if (words < SL_SUMSMIN)
+        return (JudySLDropSums(PPArray, PJError));
+
+    blocks = (words + SL_SUMSBLOCK - 1) / SL_SUMSBLOCK;
+    if ((Psums = (PWord_t) JudyMalloc(SUMSSIZE(blocks * 3))) == (PWord_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+        return (JERR);
+    }
+    Psums[0] = blocks * 3;
+    (void)memset(SUMSTREE(Psums), 0, blocks * WORDSIZE);
+
+    for (PPValue = JudySLFirstWord(*PPArray, &indexword, PJError);
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+         && (word < words);
+         PPValue = JudySLNextWord(*PPArray, &indexword, PJError), ++word)
+    {
+        if ((word % SL_SUMSBLOCK) == 0)
+            SUMSBOUND(Psums)[word / SL_SUMSBLOCK] = (word ? indexword : 0);
+
+        if ((pop1sub = JudySLWordPop(*PPValue, indexword, PJError)) == JERR)
+            break;
+        SUMSTREE(Psums)[word / SL_SUMSBLOCK] += pop1sub;
+    }
+    if (PPValue == (PPvoid_t) NULL)     // fewer words than counted.
+        JU_SET_ERRNO(PJError, JU_ERRNO_CORRUPT);
+
+    if (word < words)
+    {
+        JudyFree((Pvoid_t) Psums, SUMSSIZE(blocks * 3));
+        return (JERR);
+    }
+    JudySLSumsSpread(Psums, blocks);
+
+    if (PPSums != (PPvoid_t) NULL)
+    {
+        JudyFree(*PPSums, SUMSSIZE(((PWord_t) *PPSums)[0]));
+        *PPSums = (Pvoid_t) Psums;
+        return (1);
+    }
+    if ((PPValue = JudyLIns(PPArray, SL_SUMSWORD, PJError)) == PPJERR)
+    {
+        JudyFree((Pvoid_t) Psums, SUMSSIZE(blocks * 3));
+        return (JERR);
+    }
+    *PPValue = (Pvoid_t) Psums;
+    return (2);
+}                                       // JudySLBuildSums()
+
+// ****************************************************************************
+// J U D Y   S L   S P L I T   B L O C K
+//
+// Split the block in slot Slot of the sums at *PPSums, of the JudyL array
+// PArray, which has grown to Words index words, at its middle index word.  If
+// out of memory, leave the block as it is; it is only slower to add up.
+
+// Move the block in slot From to the empty slot To:
+
+static void
+JudySLSumsMove(PWord_t Psums, Word_t From, Word_t To)
+{
+    Word_t    pop1 = JudySLSumsBefore(Psums, From + 1)
+                   - JudySLSumsBefore(Psums, From);
+
+    SUMSBOUND(Psums)[To] = SUMSBOUND(Psums)[From];
+    JudySLSumsAdd(Psums, From, 0 - pop1);
+    JudySLSumsAdd(Psums, To, pop1);
+}                                       // JudySLSumsMove()
+
+// Spread out the blocks of the sums at *PPSums again, in a new sums object;
+// return 0 if out of memory, with the sums unchanged:
+
+static int
+JudySLSumsRespread(PPvoid_t PPSums)
+{
+    PWord_t   Psums = (PWord_t) *PPSums;        // old sums object.
+    PWord_t   Pnew;                     // new sums object.
+    Word_t    blocks = SUMSBLOCKS(Psums);
+    Word_t    block = 0;                // number of block.
+    Word_t    slot;                     // in old sums.
+
+    if ((Pnew = (PWord_t) JudyMalloc(SUMSSIZE(blocks * 3))) == (PWord_t) NULL)
+        return (0);
+    Pnew[0] = blocks * 3;
+
+    JudySLTreeUnbuild(SUMSTREE(Psums), Psums[0]);
+    for (slot = 0; slot <= SUMSLAST(Psums); ++slot)
+    {
+        if (SUMSEMPTY(Psums, slot))
+            continue;
+        SUMSBOUND(Pnew)[block] = SUMSBOUND(Psums)[slot];
+        SUMSTREE(Pnew)[block++] = SUMSTREE(Psums)[slot];
+    }
+    JudySLSumsSpread(Pnew, blocks);
+
+    JudyFree((Pvoid_t) Psums, SUMSSIZE(Psums[0]));
+    *PPSums = (Pvoid_t) Pnew;
+    return (1);
+}                                       // JudySLSumsRespread()
+
+static void
+JudySLSplitBlock(Pcvoid_t PArray, PPvoid_t PPSums, Word_t Slot, Word_t Words)
+{
+    PWord_t   Psums = (PWord_t) *PPSums;        // sums object.
+    Word_t    indexword = SUMSBOUND(Psums)[Slot];
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    word;                     // number of index word in block.
+    Word_t    pop1lower = 0;            // Indexes in the lower half.
+    Word_t    pop1upper;                // and in the upper half.
+    Word_t    pop1sub;                  // below one index word.
+    Word_t    dist;                     // to empty slot.
+
+// Add up the lower half, stopping at the first index word of the upper:
+
+    for (PPValue = JudySLFirstWord(PArray, &indexword, PJE0), word = 0;
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+         && (word < Words / 2);
+         PPValue = JudySLNextWord(PArray, &indexword, PJE0), ++word)
+    {
+        if ((pop1sub = JudySLWordPop(*PPValue, indexword, PJE0)) == JERR)
+            break;
+        pop1lower += pop1sub;
+    }
+    if ((PPValue == (PPvoid_t) NULL) || (PPValue == PPJERR)
+     || (word < Words / 2))
+    {
+        return;
+    }
+
+// Find the nearest empty slot, or spread out the blocks to put one next:
+
+    for (dist = 1; dist <= SL_SUMSREACH; ++dist)
+    {
+        if ((Slot + dist < Psums[0]) && SUMSEMPTY(Psums, Slot + dist))
+            break;
+        if ((dist <= Slot) && SUMSEMPTY(Psums, Slot - dist))
+            break;
+    }
+    if (dist > SL_SUMSREACH)
+    {
+        Word_t    bound = SUMSBOUND(Psums)[Slot];
+
+        if (! JudySLSumsRespread(PPSums))
+            return;
+        Psums = (PWord_t) *PPSums;
+        Slot = JudySLSumsBlock(Psums, bound);
+        dist = 1;
+    }
+    pop1upper = JudySLSumsBefore(Psums, Slot + 1)
+              - JudySLSumsBefore(Psums, Slot) - pop1lower;
+
+// Move the blocks between to make the slot after Slot empty, or if the empty
+// slot is before, the slot at Slot, which then holds the upper half:
+
+    if ((Slot + dist < Psums[0]) && SUMSEMPTY(Psums, Slot + dist))
+    {
+        Word_t    empty = Slot + dist;
+
+        for ( ; dist > 1; --dist)
+            JudySLSumsMove(Psums, Slot + dist - 1, Slot + dist);
+
+        if (empty > SUMSLAST(Psums))
+            SUMSLAST(Psums) = empty;
+    }
+    else
+    {
+        for ( ; dist > 0; --dist)
+            JudySLSumsMove(Psums, Slot - dist + 1, Slot - dist);
+        --Slot;
+    }
+
+    SUMSBOUND(Psums)[Slot + 1] = indexword;
+    JudySLSumsAdd(Psums, Slot, 0 - pop1upper);
+    JudySLSumsAdd(Psums, Slot + 1, pop1upper);
+    ++SUMSBLOCKS(Psums);
+}                                       // JudySLSplitBlock()
+
+// ****************************************************************************
+// J U D Y   S L   S U M S   U P D A T E
+//
+// After the population below index word Word of the JudyL array at *PPArray,
+// which has a population, went up or down by one (Delta is 1 or -1), whether
+// or not Word itself was inserted or deleted, update the sums:  Build them
+// when the array becomes wide enough, rebuild or drop them when most of its
+// index words are gone, and otherwise add Delta to the block holding Word,
+// splitting it if it has grown too big.  Return 1, or 2 if the JudyL array
+// was changed (so its value areas can move), or JERR.
+
+static int
+JudySLSumsUpdate(PPvoid_t PPArray, Word_t Word, int Delta, PJError_t PJError)
+{
+    PPvoid_t  PPSums;                   // from JudyL array.
+    PWord_t   Psums;                    // sums object.
+    Word_t    words;                    // index words in JudyL array.
+    Word_t    slot;                     // of block holding Word.
+
+    JLG(PPSums, *PPArray, SL_SUMSWORD);
+    if (PPSums == (PPvoid_t) NULL)
+    {
+        PPvoid_t  PPCount;              // population of JudyL array.
+
+        if (Delta < 0)
+            return (1);                 // still too narrow.
+
+        JLG(PPCount, *PPArray, SL_COUNTWORD);
+        if ((PPCount == (PPvoid_t) NULL)
+         || (*((PWord_t) PPCount) < SL_SUMSMIN)
+         || (JudyLCount(*PPArray, 0, ~0UL, PJE0) - 1 < SL_SUMSMIN))
+        {
+            return (1);                 // fewer Indexes or index words.
+        }
+        return (JudySLBuildSums(PPArray, PJError));
+    }
+    Psums = (PWord_t) *PPSums;
+
+    if (Delta < 0)
+    {
+        words = JudyLCount(*PPArray, 0, ~0UL, PJE0) - 2;
+
+        if ((words < SL_SUMSMIN / 2)
+         || (SUMSBLOCKS(Psums) * SL_SUMSBLOCK > words * 4))
+        {
+            return (JudySLBuildSums(PPArray, PJError));
+        }
+    }
+
+    slot = JudySLSumsBlock(Psums, Word);
+    JudySLSumsAdd(Psums, slot, (Word_t) (long) Delta);
+
+// A block with few Indexes has few index words; otherwise count them:
+
+    if ((Delta > 0)
+     && (JudySLSumsBefore(Psums, slot + 1) - JudySLSumsBefore(Psums, slot)
+         > SL_SUMSBLOCK * 2))
+    {
+        words = JudyLCount(*PPArray, SUMSBOUND(Psums)[slot],
+                           (slot < SUMSLAST(Psums)) ?
+                           SUMSBOUND(Psums)[slot + 1] - 1 : ~0UL, PJE0);
+        if (words > SL_SUMSBLOCK * 2)
+            JudySLSplitBlock(*PPArray, PPSums, slot, words);
+    }
+    return (1);
+}                                       // JudySLSumsUpdate()
+
+// ****************************************************************************
+// J U D Y   S L   S T O R E   P O P
+//
+// Store in the JudyL array at *PPArray the number of Indexes at and below it,
+// and build its sums, and likewise in each JudyL array below it that has no
+// population, or in all of them if Recount.  Return the number of Indexes, or
+// JERR if out of memory.
+
+static    Word_t
+JudySLStorePop(PPvoid_t PPArray, int Recount, PJError_t PJError)
+{
+    Word_t    indexword = 0;            // word just found.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    pop1 = 0;                 // sum for JudyL array.
+    Word_t    pop1sub;                  // below one index word.
+
+    if ((*PPArray == (Pvoid_t) NULL) || IS_PSCL(*PPArray)
+     || IS_PPLF(*PPArray))
+    {
+        return (JudySLPop(*PPArray, PJError));
+    }
+
+    if (IS_PPCN(*PPArray))
+        return (JudySLStorePop(&(CLEAR_PPCN(*PPArray)->pcn_Next), Recount,
+                               PJError));
+
+    if (! Recount)
+    {
+        JLG(PPValue, *PPArray, SL_COUNTWORD);
+        if (PPValue != (PPvoid_t) NULL)
+            return (*((PWord_t) PPValue));
+    }
+
+    for (PPValue = JudySLFirstWord(*PPArray, &indexword, PJError);
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR);
+         PPValue = JudySLNextWord(*PPArray, &indexword, PJError))
+    {
+        if (LASTWORD_BY_VALUE(indexword))
+        {
+            ++pop1;
+            continue;
+        }
+        if ((pop1sub = JudySLStorePop(PPValue, Recount, PJError)) == JERR)
+            return (JERR);
+        pop1 += pop1sub;
+    }
+    if ((PPValue == PPJERR)
+     || ((PPValue = JudyLIns(PPArray, SL_COUNTWORD, PJError)) == PPJERR))
+    {
+        return (JERR);
+    }
+    *((PWord_t) PPValue) = pop1;
+
+    return ((JudySLBuildSums(PPArray, PJError) == JERR) ? JERR : pop1);
+}                                       // JudySLStorePop()
+
+// ****************************************************************************
+// J U D Y   S L   N E W   P A T H
+//
+// Allocate a compressed path node for Words index words, copied from PWord
+// unless it is null, and return it (not flagged), or null if out of memory.
+
+static    Ppcn_t
+JudySLNewPath(Word_t Words, const Word_t * PWord, Pvoid_t Next,
+              PJError_t PJError)
+{
+    Ppcn_t    Ppcn;
+
+    if ((Ppcn = (Ppcn_t) JudyMalloc(PCNSIZE(Words))) == (Ppcn_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+        return ((Ppcn_t) NULL);
+    }
+    Ppcn->pcn_Next = Next;
+    Ppcn->pcn_Words = Words;
+    if (PWord != (Word_t *) NULL)
+        (void)memcpy(Ppcn->pcn_Word, PWord, Words * WORDSIZE);
+    return (Ppcn);
+}                                       // JudySLNewPath()
+
+// ****************************************************************************
+// J U D Y   S L   P A T H   M A T C H
+//
+// Return how many words of a compressed path match those of Index, and if
+// not all, set *Pindexword to the first word of Index that does not.  Since
+// no path word ends an Index, this never reads past the end of Index.
+
+static    Word_t
+JudySLPathMatch(const uint8_t * Index, Ppcn_t Ppcn, PWord_t Pindexword)
+{
+    Word_t    word;                     // in path.
+    Word_t    indexword;                // from Index.
+
+    for (word = 0; word < Ppcn->pcn_Words; ++word, Index += WORDSIZE)
+    {
+        COPYSTRINGtoWORD(indexword, Index);     // copy next 4[8] bytes.
+        if (indexword != Ppcn->pcn_Word[word])
+        {
+            *Pindexword = indexword;
+            break;
+        }
+    }
+    return (word);
+}                                       // JudySLPathMatch()
+
+// ****************************************************************************
+// J U D Y   S L   S P L I T   P A T H
+//
+// Split the compressed path at *PPArray before its word Word, where a new
+// Index diverges from it:  the words before Word (if any) stay a path, which
+// now leads to a new JudyL array holding only Word, whose value is the rest
+// of the path (if any) leading to what the old path led to.  The caller then
+// inserts the new Indexs word in that JudyL array.  Return JERR if out of
+// memory, with the path unchanged.
+
+static int
+JudySLSplitPath(PPvoid_t PPArray, Word_t Word, PJError_t PJError)
+{
+    Ppcn_t    Ppcn = CLEAR_PPCN(*PPArray);      // path to split.
+    Word_t    words = Ppcn->pcn_Words;
+    Ppcn_t    Pupper = (Ppcn_t) NULL;   // path before Word.
+    Ppcn_t    Plower = (Ppcn_t) NULL;   // path after Word.
+    Pvoid_t   Pbelow = Ppcn->pcn_Next;  // what follows Word.
+    Pvoid_t   PArray = (Pvoid_t) NULL;  // new JudyL array.
+    PPvoid_t  PPValue;                  // for Word in it.
+
+    if (Word + 1 < words)
+    {
+        Plower = JudySLNewPath(words - Word - 1, Ppcn->pcn_Word + Word + 1,
+                               Pbelow, PJError);
+        if (Plower == (Ppcn_t) NULL)
+            return (JERR);
+        Pbelow = (Pvoid_t) SET_PPCN(Plower);
+    }
+    if ((Word > 0) && ((Pupper = JudySLNewPath(Word, Ppcn->pcn_Word,
+                                               (Pvoid_t) NULL, PJError))
+                       == (Ppcn_t) NULL))
+    {
+        if (Plower != (Ppcn_t) NULL)
+            JudyFree((Pvoid_t) Plower, PCNSIZE(Plower->pcn_Words));
+        return (JERR);
+    }
+    if ((PPValue = JudyLIns(&PArray, Ppcn->pcn_Word[Word], PJError))
+        == PPJERR)
+    {
+        if (Plower != (Ppcn_t) NULL)
+            JudyFree((Pvoid_t) Plower, PCNSIZE(Plower->pcn_Words));
+        if (Pupper != (Ppcn_t) NULL)
+            JudyFree((Pvoid_t) Pupper, PCNSIZE(Pupper->pcn_Words));
+        return (JERR);
+    }
+    *PPValue = Pbelow;
+
+    if (Pupper != (Ppcn_t) NULL)
+    {
+        Pupper->pcn_Next = PArray;
+        *PPArray = (Pvoid_t) SET_PPCN(Pupper);
+    }
+    else
+        *PPArray = PArray;
+
+    JudyFree((Pvoid_t) Ppcn, PCNSIZE(words));
+    return (1);
+}                                       // JudySLSplitPath()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   E N T R Y
+//
+// Return the first index word of Index number Entry in a packed leaf.
+
+static    PWord_t
+JudySLLeafEntry(Pplf_t Pplf, Word_t Entry)
+{
+    PWord_t   Pword = PLFWORDS(Pplf);
+
+    while (Entry)
+    {
+        if (LASTWORD_BY_VALUE(*Pword++))
+            --Entry;
+    }
+    return (Pword);
+}                                       // JudySLLeafEntry()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   F I N D
+//
+// Return how many Indexes in a packed leaf precede Index, and set *Pfound if
+// the next one is Index.  No Index in the leaf is longer than SL_PLFMAXWORDS
+// words, so no more words of Index than that are needed to tell.
+
+static    Word_t
+JudySLLeafFind(Pplf_t Pplf, const uint8_t * Index, int *Pfound)
+{
+    Word_t    indexword[SL_PLFMAXWORDS];        // first words of Index.
+    PWord_t   Pword = PLFWORDS(Pplf);   // first word of an entry.
+    Word_t    entry;                    // in leaf.
+    Word_t    word;                     // in entry.
+
+    for (word = 0; word < SL_PLFMAXWORDS; ++word)
+    {
+        COPYSTRINGtoWORD(indexword[word], Index + (word * WORDSIZE));
+        if (LASTWORD_BY_VALUE(indexword[word]))
+            break;
+    }
+    *Pfound = 0;
+
+// An entry equals Index when they agree through the last word of the entry,
+// which is then the last of Index too:
+
+    for (entry = 0; entry < Pplf->plf_Pop; ++entry)
+    {
+        for (word = 0; Pword[word] == indexword[word]; ++word)
+        {
+            if (LASTWORD_BY_VALUE(Pword[word]))
+            {
+                *Pfound = 1;
+                return (entry);
+            }
+        }
+        if (Pword[word] > indexword[word])
+            return (entry);
+
+        while (! LASTWORD_BY_VALUE(Pword[word]))        // pass the entry.
+            ++word;
+        Pword += word + 1;
+    }
+    return (entry);
+}                                       // JudySLLeafFind()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   C O P Y
+//
+// Copy Index number Entry of a packed leaf to Index, and return its value
+// area.
+
+static    PPvoid_t
+JudySLLeafCopy(Pplf_t Pplf, Word_t Entry, uint8_t * Index)
+{
+    PWord_t   Pword = JudySLLeafEntry(Pplf, Entry);
+
+    while (1)
+    {
+        COPYWORDtoSTRING(Index, *Pword);        // copy next 4[8] bytes.
+        if (LASTWORD_BY_VALUE(*Pword))
+            break;
+        Index += WORDSIZE;
+        ++Pword;
+    }
+    return (&(Pplf->plf_Pvalue[Entry]));
+}                                       // JudySLLeafCopy()
+
+// ****************************************************************************
+// J U D Y   S L   N E W   L E A F
+//
+// Allocate a packed leaf for Pop Indexes of Words index words in all, and
+// return it (not flagged), or null if out of memory.  JudySLPutWords() then
+// copies the Words index words of an Index into it, returning the next word.
+
+static    Pplf_t
+JudySLNewLeaf(Word_t Pop, Word_t Words, PJError_t PJError)
+{
+    Pplf_t    Pplf;
+
+    if ((Pplf = (Pplf_t) JudyMalloc(PLFSIZE(Pop, Words))) == (Pplf_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+        return ((Pplf_t) NULL);
+    }
+    Pplf->plf_Pop = Pop;
+    Pplf->plf_Words = Words;
+    return (Pplf);
+}                                       // JudySLNewLeaf()
+
+static    PWord_t
+JudySLPutWords(PWord_t Pword, const uint8_t * Index, Word_t Words)
+{
+    Word_t    word;
+
+    for (word = 0; word + 1 < Words; ++word)
+        COPYSTRINGtoFULLWORD(Pword[word], Index + (word * WORDSIZE));
+    COPYSTRINGtoLASTWORD(Pword[word], Index + (word * WORDSIZE));
+    return (Pword + Words);
+}                                       // JudySLPutWords()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   I N S
+//
+// Insert a new Index (the rest of it, Len bytes with the \0) in the packed
+// leaf at *PPArray, before Index number Entry, and return its value area, or
+// PPJERR if out of memory, with the leaf unchanged.
+//
+// If *PPArray is instead a shortcut leaf, make it a packed leaf holding both
+// its Index and the new one, which differ, and are both short enough.
+
+static    PPvoid_t
+JudySLLeafIns(PPvoid_t PPArray, Word_t Entry, const uint8_t * Index,
+              Word_t Len, PJError_t PJError)
+{
+    Word_t    words = WORDS(Len);       // of new Index.
+    Pplf_t    Pold;                     // packed leaf to replace.
+    Word_t    before;                   // words before new Index.
+    Pplf_t    Pplf;                     // new packed leaf.
+    PWord_t   Pword;                    // in it.
+
+    if (IS_PSCL(*PPArray))
+    {
+        Pscl_t    Pscl = CLEAR_PSCL(*PPArray);
+        Word_t    words2 = WORDS(STRLEN(Pscl->scl_Index));
+
+        Entry = (STRCMP(Index, Pscl->scl_Index) > 0);
+
+        if ((Pplf = JudySLNewLeaf(2, words + words2, PJError))
+            == (Pplf_t) NULL)
+        {
+            return (PPJERR);
+        }
+        Pword = PLFWORDS(Pplf);
+        if (Entry)
+            Pword = JudySLPutWords(Pword, Pscl->scl_Index, words2);
+        Pword = JudySLPutWords(Pword, Index, words);
+        if (! Entry)
+            (void)JudySLPutWords(Pword, Pscl->scl_Index, words2);
+
+        Pplf->plf_Pvalue[1 - Entry] = Pscl->scl_Pvalue;
+        Pplf->plf_Pvalue[Entry] = (Pvoid_t) NULL;
+
+        JudyFree((Pvoid_t) Pscl, SCLSIZE(words2 * WORDSIZE));
+        *PPArray = (Pvoid_t) SET_PPLF(Pplf);
+        return (&(Pplf->plf_Pvalue[Entry]));
+    }
+
+    Pold = CLEAR_PPLF(*PPArray);
+    before = (Word_t) (JudySLLeafEntry(Pold, Entry) - PLFWORDS(Pold));
+
+    if ((Pplf = JudySLNewLeaf(Pold->plf_Pop + 1, Pold->plf_Words + words,
+                              PJError)) == (Pplf_t) NULL)
+    {
+        return (PPJERR);
+    }
+    (void)memcpy(Pplf->plf_Pvalue, Pold->plf_Pvalue, Entry * WORDSIZE);
+    Pplf->plf_Pvalue[Entry] = (Pvoid_t) NULL;
+    (void)memcpy(Pplf->plf_Pvalue + Entry + 1, Pold->plf_Pvalue + Entry,
+                 (Pold->plf_Pop - Entry) * WORDSIZE);
+
+    Pword = PLFWORDS(Pplf);
+    (void)memcpy(Pword, PLFWORDS(Pold), before * WORDSIZE);
+    Pword = JudySLPutWords(Pword + before, Index, words);
+    (void)memcpy(Pword, PLFWORDS(Pold) + before,
+                 (Pold->plf_Words - before) * WORDSIZE);
+
+    JudyFree((Pvoid_t) Pold, PLFSIZE(Pold->plf_Pop, Pold->plf_Words));
+    *PPArray = (Pvoid_t) SET_PPLF(Pplf);
+    return (&(Pplf->plf_Pvalue[Entry]));
+}                                       // JudySLLeafIns()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   D E L
+//
+// Delete Index number Entry from the packed leaf at *PPArray, which becomes a
+// shortcut leaf if only one Index is left.  Return 1, or JERR if out of
+// memory, with the leaf unchanged.
+
+static int
+JudySLLeafDel(PPvoid_t PPArray, Word_t Entry, PJError_t PJError)
+{
+    Pplf_t    Pold = CLEAR_PPLF(*PPArray);      // packed leaf to replace.
+    PWord_t   Pentry = JudySLLeafEntry(Pold, Entry);
+    Word_t    before = (Word_t) (Pentry - PLFWORDS(Pold));
+    Word_t    words = 1;                // of Index deleted.
+    Pplf_t    Pplf;                     // new packed leaf.
+
+    while (! LASTWORD_BY_VALUE(Pentry[words - 1]))
+        ++words;
+
+    if (Pold->plf_Pop == 2)
+    {
+        Pscl_t    Pscl;
+        Word_t    words2 = Pold->plf_Words - words;     // of the other.
+
+        if ((Pscl = (Pscl_t) JudyMalloc(SCLSIZE(words2 * WORDSIZE)))
+            == (Pscl_t) NULL)
+        {
+            JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+            return (JERR);
+        }
+        Pscl->scl_Pvalue = *JudySLLeafCopy(Pold, 1 - Entry, Pscl->scl_Index);
+
+        JudyFree((Pvoid_t) Pold, PLFSIZE(2, Pold->plf_Words));
+        *PPArray = (Pvoid_t) SET_PSCL(Pscl);
+        return (1);
+    }
+
+    if ((Pplf = JudySLNewLeaf(Pold->plf_Pop - 1, Pold->plf_Words - words,
+                              PJError)) == (Pplf_t) NULL)
+    {
+        return (JERR);
+    }
+    (void)memcpy(Pplf->plf_Pvalue, Pold->plf_Pvalue, Entry * WORDSIZE);
+    (void)memcpy(Pplf->plf_Pvalue + Entry, Pold->plf_Pvalue + Entry + 1,
+                 (Pplf->plf_Pop - Entry) * WORDSIZE);
+    (void)memcpy(PLFWORDS(Pplf), PLFWORDS(Pold), before * WORDSIZE);
+    (void)memcpy(PLFWORDS(Pplf) + before, Pentry + words,
+                 (Pplf->plf_Words - before) * WORDSIZE);
+
+    JudyFree((Pvoid_t) Pold, PLFSIZE(Pold->plf_Pop, Pold->plf_Words));
+    *PPArray = (Pvoid_t) SET_PPLF(Pplf);
+    return (1);
+}                                       // JudySLLeafDel()
+
+// ****************************************************************************
+// J U D Y   S L   L E A F   S P L I T
+//
+// Replace the packed leaf at *PPArray with a JudyL array of the first words
+// of its Indexes.  Under each index word goes the value of the Index that
+// ends in it, or a shortcut leaf for the rest of the only Index that does
+// not, or a packed leaf for the rests of several.  The caller then inserts
+// the new Indexs word in the JudyL array.  Return JERR if out of memory, with
+// the leaf unchanged.
+
+static int
+JudySLLeafSplit(PPvoid_t PPArray, PJError_t PJError)
+{
+    Pplf_t    Pplf = CLEAR_PPLF(*PPArray);      // leaf to split.
+    PWord_t   Pword = PLFWORDS(Pplf);   // first word of an Index.
+    PWord_t   Pnext;                    // past those sharing it.
+    PWord_t   Psrc;                     // word to copy.
+    PWord_t   Pdst;                     // where to.
+    Word_t    entry = 0;                // number of Index.
+    Word_t    entries;                  // sharing its first word.
+    Word_t    words;                    // of theirs, after the first.
+    Word_t    word;                     // in an Index.
+    int       first;                    // Psrc is a first word.
+    Pvoid_t   PArray = (Pvoid_t) NULL;  // new JudyL array.
+    Pvoid_t   Pbelow;                   // value or leaf for index word.
+    PPvoid_t  PPValue;                  // for index word.
+
+    while (entry < Pplf->plf_Pop)
+    {
+        for (Pnext = Pword, entries = words = 0;
+             (entry + entries < Pplf->plf_Pop) && (*Pnext == *Pword);
+             ++entries)
+        {
+            for (word = 1; ! LASTWORD_BY_VALUE(Pnext[word - 1]); ++word)
+                continue;
+            words += word - 1;
+            Pnext += word;
+        }
+
+        if (LASTWORD_BY_VALUE(*Pword))  // only Index that ends here.
+        {
+            Pbelow = Pplf->plf_Pvalue[entry];
+        }
+        else if (entries == 1)
+        {
+            Pscl_t    Pscl;
+
+            if ((Pscl = (Pscl_t) JudyMalloc(SCLSIZE(words * WORDSIZE)))
+                == (Pscl_t) NULL)
+            {
+                JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+                break;
+            }
+            Pscl->scl_Pvalue = Pplf->plf_Pvalue[entry];
+            for (word = 0; word < words; ++word)
+                COPYWORDtoSTRING(Pscl->scl_Index + (word * WORDSIZE),
+                                 Pword[word + 1]);
+            Pbelow = (Pvoid_t) SET_PSCL(Pscl);
+        }
+        else
+        {
+            Pplf_t    Plower;
+
+            if ((Plower = JudySLNewLeaf(entries, words, PJError))
+                == (Pplf_t) NULL)
+            {
+                break;
+            }
+            (void)memcpy(Plower->plf_Pvalue, Pplf->plf_Pvalue + entry,
+                         entries * WORDSIZE);
+            for (Psrc = Pword, Pdst = PLFWORDS(Plower), first = 1;
+                 Psrc < Pnext; ++Psrc)
+            {
+                if (! first)
+                    *Pdst++ = *Psrc;
+                first = LASTWORD_BY_VALUE(*Psrc);
+            }
+            Pbelow = (Pvoid_t) SET_PPLF(Plower);
+        }
+
+        if ((PPValue = JudyLIns(&PArray, *Pword, PJError)) == PPJERR)
+        {
+            if (! LASTWORD_BY_VALUE(*Pword))
+                (void)JudySLFreeArray(&Pbelow, PJE0);
+            break;
+        }
+        *PPValue = Pbelow;
+
+        entry += entries;
+        Pword = Pnext;
+    }
+
+// If out of memory, free the part of the JudyL array made so far, which is
+// a JudySL tree like any other:
+
+    if (entry < Pplf->plf_Pop)
+    {
+        (void)JudySLFreeArray(&PArray, PJE0);
+        return (JERR);
+    }
+
+    JudyFree((Pvoid_t) Pplf, PLFSIZE(Pplf->plf_Pop, Pplf->plf_Words));
+    *PPArray = PArray;
+    return (1);
+}                                       // JudySLLeafSplit()
+
+// ****************************************************************************
+// J U D Y   S L   G E T
+//
+// See comments in file header and below.
+
+PPvoid_t
+JudySLGet(Pcvoid_t PArray, const uint8_t * Index, PJError_t PJError)
+{
+    const uint8_t *pos = Index;         // place in Index.
+    Word_t    indexword;                // buffer for aligned copy.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+// CHECK FOR CALLER ERROR (NULL POINTER):
+
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+// SEARCH NEXT LEVEL JUDYL ARRAY IN TREE:
+//
+// Use or copy each word from the Index string and check for it in the next
+// level JudyL array in the array tree, but first watch for shortcut leaves.
+// Upon invalid Index or end of Index (string) in current word, return.
+
+    do                                  // until return.
+    {
+        if (IS_PSCL(PArray))            // a shortcut leaf.
+            return (PPSCLVALUE_EQ(pos, PArray));
+
+        if (IS_PPLF(PArray))            // a packed leaf.
+        {
+            Pplf_t    Pplf = CLEAR_PPLF(PArray);
+            Word_t    entry;
+            int       found;
+
+            entry = JudySLLeafFind(Pplf, pos, &found);
+            return (found ? &(Pplf->plf_Pvalue[entry]) : (PPvoid_t) NULL);
+        }
+
+        if (IS_PPCN(PArray))            // a compressed path.
+        {
+            Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+
+            if (JudySLPathMatch(pos, Ppcn, &indexword) != Ppcn->pcn_Words)
+                return ((PPvoid_t) NULL);
+
+            pos += Ppcn->pcn_Words * WORDSIZE;
+            PArray = Ppcn->pcn_Next;
+            continue;
+        }
+
+        COPYSTRINGtoWORD(indexword, pos);       // copy next 4[8] bytes.
+
+        JLG(PPValue, PArray, indexword);
+
+        if ((PPValue == (PPvoid_t) NULL) || LASTWORD_BY_VALUE(indexword))
+            return (PPValue);
+
+// CONTINUE TO NEXT LEVEL DOWN JUDYL ARRAY TREE:
+//
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated here as a dead-end (not a core
+// dump or assertion; see version 1.25).
+
+        pos += WORDSIZE;
+        PArray = *PPValue;              // each value -> next array.
+    } while(1);                         // forever
+//  NOTREACHED JudySLGet()
+}
+
+// ****************************************************************************
+// J U D Y   S L   I N S
+//
+// See also the comments in JudySLGet(), which is somewhat similar, though
+// simpler.
+//
+// Theory of operation:
+//
+// Upon encountering a null pointer in the tree of JudyL arrays, insert a
+// shortcut leaf -- including directly under a null root pointer for the first
+// Index in the JudySL array.
+//
+// Upon encountering a pre-existing shortcut leaf, if the old Index is equal to
+// the new one, return the old value area.  Otherwise, if both are short, pack
+// them into one leaf; if not, "carry down" the old Index until the old and new
+// Indexes diverge, at which point each Index either terminates in the last
+// JudyL array or a new shortcut leaf is inserted under it for the Indexs
+// remainder.  A packed leaf takes more short Indexes until it is full.
+//
+// TBD:  Running out of memory below the starting point causes a premature
+// return below (in several places) and leaves a dead-end in the JudySL tree.
+// Ideally the code here would back this out rather than wasting a little
+// memory, but in lieu of that, the get, delete, and search functions
+// understand dead-ends and handle them appropriately.
+
+PPvoid_t
+JudySLIns(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)
+{
+    PPvoid_t  PPValue;                  // for Index.
+    Word_t    retcode;                  // from JudySLCountIns().
+
+// CHECK FOR CALLER ERROR (NULL POINTERS):
+
+    if (PPArray == (PPvoid_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
+        return (PPJERR);
+    }
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    if (JudySLCounted(*PPArray) == (PWord_t) NULL)
+        return (JudySLInsSub(PPArray, Index, PJError));
+
+// IN A COUNTED ARRAY:
+//
+// Only a new Index changes the populations, so look for it first.  A JudyL
+// array that gets a population stored in it can move its value areas, so
+// then look up the new one again.
+
+    if ((PPValue = JudySLGet(*PPArray, Index, PJError)) != (PPvoid_t) NULL)
+        return (PPValue);               // present, or error.
+
+    if ((PPValue = JudySLInsSub(PPArray, Index, PJError)) == PPJERR)
+        return (PPJERR);
+
+    if ((retcode = JudySLCountIns(PPArray, Index, STRLEN(Index), PJError))
+        == JERR)
+    {
+        return (PPJERR);
+    }
+    if (retcode == 2)
+        PPValue = JudySLGet(*PPArray, Index, PJError);
+
+    return (PPValue);
+}                                       // JudySLIns()
+
+// ****************************************************************************
+// J U D Y   S L   C O U N T   I N S
+//
+// Add a just-inserted Index to the population and sums of each JudyL array
+// above it, from the bottom up, storing any population missing from a new
+// JudyL array (including the Index).  Return 1, or 2 if any JudyL array was
+// changed (so its value areas can move), or JERR.
+
+static    Word_t
+JudySLCountIns(PPvoid_t PPArray, const uint8_t * Index, Word_t len,
+               PJError_t PJError)
+{
+    Word_t    indexword;                // next word of Index.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    retcode = 1;              // from lower level.
+
+    if ((*PPArray == (Pvoid_t) NULL) || IS_PSCL(*PPArray)
+     || IS_PPLF(*PPArray))
+    {
+        return (1);
+    }
+
+    if (IS_PPCN(*PPArray))
+    {
+        Ppcn_t    Ppcn = CLEAR_PPCN(*PPArray);
+
+        return (JudySLCountIns(&(Ppcn->pcn_Next),
+                               Index + (Ppcn->pcn_Words * WORDSIZE),
+                               len - (Ppcn->pcn_Words * WORDSIZE), PJError));
+    }
+
+    if (len > WORDSIZE)
+    {
+        COPYSTRINGtoFULLWORD(indexword, Index); // copy next 4[8] bytes.
+        JLG(PPValue, *PPArray, indexword);
+
+        if ((PPValue != (PPvoid_t) NULL)
+         && ((retcode = JudySLCountIns(PPValue, Index + WORDSIZE,
+                                       len - WORDSIZE, PJError)) == JERR))
+        {
+            return (JERR);
+        }
+    }
+    else
+    {
+        COPYSTRINGtoLASTWORD(indexword, Index); // copy last 1..4[8] bytes.
+    }
+
+    JLG(PPValue, *PPArray, SL_COUNTWORD);
+    if (PPValue == (PPvoid_t) NULL)
+    {
+        return ((JudySLStorePop(PPArray, /* Recount = */ 0, PJError)
+                 == JERR) ? JERR : 2);
+    }
+    ++(*((PWord_t) PPValue));
+
+    switch (JudySLSumsUpdate(PPArray, indexword, 1, PJError))
+    {
+    case JERR: return (JERR);
+    case 2:    return (2);
+    default:   return (retcode);
+    }
+}                                       // JudySLCountIns()
+
+// ****************************************************************************
+// J U D Y   S L   I N S   S U B
+//
+// This is the "engine" for JudySLIns(), with the callers pointers checked.
+
+static    PPvoid_t
+JudySLInsSub(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)
+{
+    PPvoid_t  PPArrayOrig = PPArray;    // for error reporting.
+    const uint8_t *pos = Index;         // place in Index.
+    const uint8_t *pos2 = (uint8_t *) NULL;     // old Index (SCL being moved).
+    Word_t    len;                      // bytes remaining.
+
+// Note:  len2 is set when needed and only used when valid, but this is not
+// clear to gcc -Wall, so initialize it here to avoid a warning:
+
+    Word_t    len2 = 0;                 // for old Index (SCL being moved).
+    Word_t    scl2 = 0;                 // size in words of SCL
+    Word_t    indexword;                // buffer for aligned copy.
+    Word_t    indexword2;               // for old Index (SCL being moved).
+    PPvoid_t  PPValue;                  // from JudyL array.
+    PPvoid_t  PPValue2;                 // for old Index (SCL being moved).
+    Pscl_t    Pscl = (Pscl_t) NULL;     // shortcut leaf.
+    Pscl_t    Pscl2;                    // for old Index (SCL being moved).
+
+    len = STRLEN(Index);        // bytes remaining.
+
+// APPEND SHORTCUT LEAF:
+//
+// If PPArray, which is the root pointer to the first or next JudyL array in
+// the tree, points to null (no next JudyL array), AND there is no shortcut
+// leaf being carried down, append a shortcut leaf here for the new Index, no
+// matter how much of the Index string remains (one or more bytes, including
+// the trailing \0).
+
+    while (1)                           // until return.
+    {
+        if (*PPArray == (Pvoid_t)NULL)  // no next JudyL array.
+        {
+            if (Pscl == (Pscl_t) NULL)  // no SCL being carried down.
+            {
+                APPEND_SCL(Pscl, PPArray, pos, len, PJError);   // returns if error.
+                return (&(Pscl->scl_Pvalue));
+            }
+            // else do nothing here; see below.
+        }
+
+// CARRY DOWN PRE-EXISTING SHORTCUT LEAF:
+//
+// When PPArray points to a pre-existing shortcut leaf, if its Index is equal
+// to the Index to be inserted, meaning no insertion is required, return its
+// value area; otherwise, "move it aside" and "carry it down" -- replace it
+// (see below) with one or more levels of JudyL arrays.  Moving it aside
+// initially just means setting Pscl non-null, both as a flag and for later
+// use, and clearing the pointer to the SCL in the JudyL array.
+
+        else if (IS_PSCL(*PPArray))
+        {
+            assert(Pscl == (Pscl_t) NULL);      // no nested SCLs.
+
+            Pscl = CLEAR_PSCL(*PPArray);
+
+            pos2 = Pscl->scl_Index;     // note: pos2 is always word-aligned.
+            len2 = STRLEN(pos2);        // bytes remaining.
+
+//          first check if string is already inserted
+
+            if ((len == len2) && (STRCMP(pos, pos2) == 0))
+                return (&(Pscl->scl_Pvalue));
+
+//          if both are short, pack them in one leaf instead (returns)
+
+            if ((len <= SL_PLFMAXLEN) && (len2 <= SL_PLFMAXLEN))
+                return (JudySLLeafIns(PPArray, 0, pos, len, PJError));
+
+            *PPArray = (Pvoid_t)NULL;   // disconnect SCL.
+
+            scl2 = SCLSIZE(len2);       // save for JudyFree
+
+            // continue with *PPArray now clear, and Pscl, pos2, len2 set.
+        }
+
+// INSERT IN, OR SPLIT, A PACKED LEAF:
+//
+// If the new Index is short enough for the packed leaf, return its value area
+// if it is there already, or else add it if there is room.  Otherwise split
+// the leaf, and continue with the new JudyL array in its place.
+
+        else if (IS_PPLF(*PPArray))
+        {
+            Pplf_t    Pplf = CLEAR_PPLF(*PPArray);
+            Word_t    entry;
+            int       found;
+
+            if (len <= SL_PLFMAXLEN)
+            {
+                entry = JudySLLeafFind(Pplf, pos, &found);
+                if (found)
+                    return (&(Pplf->plf_Pvalue[entry]));
+
+                if (Pplf->plf_Pop < SL_PLFMAXPOP)
+                    return (JudySLLeafIns(PPArray, entry, pos, len, PJError));
+            }
+            if (JudySLLeafSplit(PPArray, PJError) == JERR)
+                return (PPJERR);
+        }
+
+// PASS OR SPLIT A COMPRESSED PATH:
+//
+// If the new Index has all the words of the path, skip them; otherwise split
+// the path where they diverge and continue with the new JudyL array there.
+
+        else if (IS_PPCN(*PPArray))
+        {
+            Ppcn_t    Ppcn = CLEAR_PPCN(*PPArray);
+            Word_t    words = JudySLPathMatch(pos, Ppcn, &indexword);
+
+            if (words == Ppcn->pcn_Words)
+            {
+                pos += words * WORDSIZE;
+                len -= words * WORDSIZE;
+                PPArray = &(Ppcn->pcn_Next);
+                continue;
+            }
+            if (JudySLSplitPath(PPArray, words, PJError) == JERR)
+                return (PPJERR);
+
+            if (words)                  // upper path remains.
+            {
+                PPArray = &(CLEAR_PPCN(*PPArray)->pcn_Next);
+                pos += words * WORDSIZE;
+                len -= words * WORDSIZE;
+            }
+        }
+
+// CHECK IF OLD AND NEW INDEXES DIVERGE IN THE CURRENT INDEX WORD:
+//
+// If a shortcut leaf is being carried down and its remaining Index chars now
+// diverge from the remaining chars of the Index being inserted, that is, if
+// the next words of each Index differ, "plug in" the old Index here, in a new
+// JudyL array, before proceeding.
+//
+// Note:  Call JudyLIns() for the SCL Index word before calling it for the new
+// Index word, so PPValue remains correct for the latter.  (JudyLIns() return
+// values are not stable across multiple calls.)
+//
+// Note:  Although pos2 is word-aligned, and a Pscl_t is a whole number of
+// words in size, pos2 is not certain to be null-padded through a whole word,
+// so copy it first to an index word for later use.
+//
+// See header comments about premature return().
+
+        COPYSTRINGtoWORD(indexword, pos);       // copy next 4[8] bytes.
+
+        if (Pscl != (Pscl_t) NULL)
+        {
+            COPYSTRINGtoWORD(indexword2, pos2); // copy next 4[8] bytes.
+
+            if (indexword != indexword2)        // SCL and new Indexes diverge.
+            {
+                assert(*PPArray == (Pvoid_t)NULL);      // should be new JudyL array.
+
+// Note:  If JudyLIns() returns JU_ERRNO_NOTJUDYL here, *PPArray should not be
+// modified, so JudySLModifyErrno() can do the right thing.
+
+                if ((PPValue2 = JudyLIns(PPArray, indexword2, PJError))
+                    == PPJERR)
+                {
+                    JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+                    return (PPJERR);
+                }
+
+                assert(PPValue2 != (PPvoid_t) NULL);
+
+// If the old (SCL) Index terminates here, copy its value directly into the
+// JudyL value area; otherwise create a new shortcut leaf for it, under
+// *PPValue2 (skipping the word just inserted), and copy its value to the new
+// SCL:
+
+                if (len2 <= WORDSIZE)
+                {
+                    *((PWord_t)PPValue2) = (Word_t)(Pscl->scl_Pvalue);
+                }
+                else
+                {
+                    APPEND_SCL(Pscl2, PPValue2, pos2 + WORDSIZE,
+                               len2 - WORDSIZE, PJError);
+                    (Pscl2->scl_Pvalue) = Pscl->scl_Pvalue;
+                }
+//              old SCL no longer needed.
+
+                JudyFree((void *)Pscl, scl2);
+
+                Pscl = (Pscl_t) NULL;
+            }
+
+// If instead they share this word, put it and any more they share in a new
+// compressed path, and continue below it (where they then diverge).  None of
+// these words can end either Index, as the Indexes differ.
+
+            else
+            {
+                Word_t    words = 1;
+                Word_t    word;
+                Ppcn_t    Ppcn;
+
+                while (1)
+                {
+                    COPYSTRINGtoWORD(indexword, pos + (words * WORDSIZE));
+                    COPYSTRINGtoWORD(indexword2, pos2 + (words * WORDSIZE));
+                    if (indexword != indexword2)
+                        break;
+                    ++words;
+                }
+                if ((Ppcn = JudySLNewPath(words, (PWord_t) NULL,
+                                          (Pvoid_t) NULL, PJError))
+                    == (Ppcn_t) NULL)
+                {
+                    *PPArray = (Pvoid_t) SET_PSCL(Pscl);        // put back.
+                    return (PPJERR);
+                }
+                for (word = 0; word < words; ++word)
+                {
+                    COPYSTRINGtoWORD(Ppcn->pcn_Word[word],
+                                     pos + (word * WORDSIZE));
+                }
+                *PPArray = (Pvoid_t) SET_PPCN(Ppcn);
+
+                pos  += words * WORDSIZE;
+                len  -= words * WORDSIZE;
+                pos2 += words * WORDSIZE;
+                len2 -= words * WORDSIZE;
+                PPArray = &(Ppcn->pcn_Next);
+                continue;
+            }
+        }
 
 // APPEND NEXT LEVEL JUDYL ARRAY TO TREE:
 //
-// If a shortcut leaf was carried down and diverged at this level, the code
-// above already appended the new JudyL array, but the next word of the new
-// Index still must be inserted in it.
+// If a shortcut leaf was carried down and diverged at this level, the code
+// above already appended the new JudyL array, but the next word of the new
+// Index still must be inserted in it.
+//
+// See header comments about premature return().
+//
+// Note:  If JudyLIns() returns JU_ERRNO_NOTJUDYL here, *PPArray should not be
+// modified, so JudySLModifyErrno() can do the right thing.
+
+        if ((PPValue = JudyLIns(PPArray, indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+            return (PPJERR);
+        }
+
+        assert(PPValue != (PPvoid_t) NULL);
+
+// CHECK IF NEW INDEX TERMINATES:
+//
+// Note that if it does, and an old SCL was being carried down, it must have
+// diverged by this point, and is already handled.
+
+        if (len <= WORDSIZE)
+        {
+            assert(Pscl == (Pscl_t) NULL);
+            return (PPValue);           // is value for whole Index string.
+        }
+
+        pos += WORDSIZE;
+        len -= WORDSIZE;
+        pos2 += WORDSIZE;               // useless unless Pscl is set.
+        len2 -= WORDSIZE;
+
+        PPArray = PPValue;              // each value -> next array.
+    }                                   // while.
+}                                       // NOTREACHED, JudySLInsSub()
+
+// ****************************************************************************
+// J U D Y   S L   D E L
+//
+// See the comments in JudySLGet(), which is somewhat similar.
+//
+// Unlike JudySLGet() and JudySLIns(), recurse downward through the tree of
+// JudyL arrays to find and delete the given Index, if present, and then on the
+// way back up, any of its parent arrays which ends up empty.
+//
+// TECHNICAL NOTES:
+//
+// Recursion seems bad, but this allows for an arbitrary-length Index.  Also, a
+// more clever iterative solution that used JudyLCount() (see below) would
+// still require a function call per tree level, so why not just recurse?
+//
+// An earlier version (1.20) used a fixed-size stack, which limited the Index
+// size.  We were going to replace this with using JudyLCount(), in order to
+// note and return to (read this carefully) the highest level JudyL array with
+// a count of 1, all of whose descendant JudyL arrays also have a count of 1,
+// and delete from that point downwards.  This solution would traverse the
+// array tree downward looking to see if the given Index is in the tree, then
+// if so, delete layers downwards starting below the last one that contains
+// other Indexes than the one being deleted.
+//
+// TBD:  To save time coding, and to very likely save time overall during
+// execution, this function does "lazy deletions", or putting it more nicely,
+// it allows "hysteresis" in the JudySL tree, when shortcut leafs are present.
+// It only removes the specified Index, and recursively any empty JudyL arrays
+// above it, without fully reversing the effects of JudySLIns().  This is
+// probably OK because any application that calls JudySLDel() is likely to call
+// JudySLIns() again with the same or a neighbor Index.
+
+int
+JudySLDel(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)   // optional, for returning error info.
+{
+
+// Check for caller error (null pointer):
+
+    if (PPArray == (PPvoid_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
+        return (JERR);
+    }
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (JERR);
+    }
+
+// Do the deletion:
+
+    return (JudySLDelSub(PPArray, PPArray, Index, STRLEN(Index),
+                         JudySLCounted(*PPArray) != (PWord_t) NULL, PJError));
+
+}                                       // JudySLDel()
+
+// ****************************************************************************
+// J U D Y   S L   D E L   S U B
+//
+// This is the "engine" for JudySLDel() that expects aligned and len to already
+// be computed (only once).  See the header comments for JudySLDel().
+
+static int
+JudySLDelSub(PPvoid_t PPArray,          // in which to delete.
+             PPvoid_t PPArrayOrig,      // for error reporting.
+             const uint8_t * Index,     // to delete.
+             Word_t len,                // bytes remaining.
+             int counted,               // keep subtree populations.
+             PJError_t PJError)         // optional, for returning error info.
+{
+    Word_t    indexword;                // next word to find.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    int       retcode;                  // from lower-level call.
+
+    assert(PPArray != (PPvoid_t) NULL);
+    assert(Index != (uint8_t *) NULL);
+
+// DELETE SHORTCUT LEAF:
+//
+// As described above, this can leave an empty JudyL array, or one containing
+// only a single other Index word -- which could be, but is not, condensed into
+// a higher-level shortcut leaf.  More precisely, at this level it leaves a
+// temporary "dead end" in the JudySL tree, similar to when running out of
+// memory during JudySLIns(), and this is somewhat cleaned up by higher
+// recursions of the same function (see below); but remaining shortcut leaves
+// for other Indexes are not coalesced.
+
+    if (IS_PSCL(*PPArray))
+    {
+        Pscl_t    Pscll = CLEAR_PSCL(*PPArray);
+        Word_t    words;
+
+        if (STRCMP(Index, Pscll->scl_Index))
+            return (0);                 // incorrect index.
+
+        words = SCLSIZE(STRLEN(Pscll->scl_Index));
+        JudyFree((void *)Pscll, words);
+
+        *PPArray = (Pvoid_t)NULL;
+        return (1);                     // correct index deleted.
+    }
+
+// DELETE FROM PACKED LEAF:
+
+    if (IS_PPLF(*PPArray))
+    {
+        Word_t    entry;
+        int       found;
+
+        entry = JudySLLeafFind(CLEAR_PPLF(*PPArray), Index, &found);
+        if (! found)
+            return (0);                 // Index not in JudySL array.
+
+        return (JudySLLeafDel(PPArray, entry, PJError));
+    }
+
+// DELETE BELOW A COMPRESSED PATH:
+//
+// Free the path too if nothing is left below it.
+
+    if (IS_PPCN(*PPArray))
+    {
+        Ppcn_t    Ppcn = CLEAR_PPCN(*PPArray);
+        Word_t    words = Ppcn->pcn_Words;
+
+        if (JudySLPathMatch(Index, Ppcn, &indexword) != words)
+            return (0);                 // Index not in JudySL array.
+
+        if ((retcode = JudySLDelSub(&(Ppcn->pcn_Next), PPArrayOrig,
+                                    Index + (words * WORDSIZE),
+                                    len - (words * WORDSIZE), counted,
+                                    PJError)) != 1)
+        {
+            return (retcode);           // no lower-level delete, or error.
+        }
+        if (Ppcn->pcn_Next == (Pvoid_t) NULL)
+        {
+            JudyFree((void *)Ppcn, PCNSIZE(words));
+            *PPArray = (Pvoid_t)NULL;
+        }
+        return (1);
+    }
+
+// DELETE LAST INDEX WORD, FROM CURRENT JUDYL ARRAY:
+//
+// When at the end of the full Index, delete the last word, if present, from
+// the current JudyL array, and return the result all the way up.
+
+    COPYSTRINGtoWORD(indexword, Index); // copy next 4[8] bytes.
+
+    if (len <= WORDSIZE)
+    {
+        if ((retcode = JudyLDel(PPArray, indexword, PJError)) == JERR)
+        {
+            JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+            return (JERR);
+        }
+        if ((retcode == 1) && counted)
+        {
+            return (JudySLCountDel(PPArray, indexword,
+                                   PPArray == PPArrayOrig, PJError));
+        }
+        return (retcode);
+    }
+
+// DELETE BELOW NON-LAST INDEX WORD IN CURRENT JUDYL ARRAY:
+//
+// If a word before the end of the full Index is present in the current JudyL
+// array, recurse through its value, which must be a pointer to another JudyL
+// array, to continue the deletion at the next level.  Return the JudyLGet()
+// return if the Indexs current word is not in the JudyL array, or if no
+// delete occurs below this level, both of which mean the whole Index is not
+// currently valid.
+//
+
+    JLG(PPValue, *PPArray, indexword);
+    if (PPValue == (PPvoid_t) NULL)
+        return (0);                     // Index not in JudySL array.
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25).
+    if ((retcode =
+         JudySLDelSub(PPValue, PPArrayOrig, Index + WORDSIZE,
+                      len - WORDSIZE, counted, PJError)) != 1)
+    {
+        return (retcode);               // no lower-level delete, or error.
+    }
+
+// DELETE EMPTY JUDYL ARRAY:
+//
+// A delete occurred below in the tree.  If the child JudyL array became empty,
+// delete the current Index word from the current JudyL array, which could
+// empty the current array and null out *PPArray in turn (or pass through an
+// error).  Otherwise simply indicate that a deletion did occur.
+
+    if (*PPValue == (Pvoid_t)NULL)
+    {
+        if ((retcode = JudyLDel(PPArray, indexword, PJError)) == JERR)
+        {
+            JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+            return (JERR);
+        }
+    }
+
+    if (! counted)
+        return (1);
+
+    return (JudySLCountDel(PPArray, indexword, PPArray == PPArrayOrig,
+                           PJError));
+}                                       // JudySLDelSub()
+
+// ****************************************************************************
+// J U D Y   S L   C O U N T   D E L
+//
+// After a delete below index word Word of the JudyL array at *PPArray in a
+// counted JudySL array, take one from its population, if it has one, and
+// from its sums; or if none are left, free the array, which holds nothing
+// else but dead ends, unless it is the Top of the JudySL array, which stays
+// counted while empty.  Return 1, or JERR.
+
+static int
+JudySLCountDel(PPvoid_t PPArray, Word_t Word, int Top, PJError_t PJError)
+{
+    PPvoid_t  PPCount;                  // population of JudyL array.
+
+    JLG(PPCount, *PPArray, SL_COUNTWORD);
+    if (PPCount == (PPvoid_t) NULL)     // see JudySLCountIns().
+        return ((JudySLDropSums(PPArray, PJError) == JERR) ? JERR : 1);
+
+    if ((--(*((PWord_t) PPCount)) == 0) && (! Top))
+    {
+        if (JudySLFreeArray(PPArray, PJError) == JERR)
+            return (JERR);
+        return (1);
+    }
+    return ((JudySLSumsUpdate(PPArray, Word, -1, PJError) == JERR) ?
+            JERR : 1);
+}                                       // JudySLCountDel()
+
+// ****************************************************************************
+// J U D Y   S L   P R E V
+//
+// Recursively traverse the JudySL tree downward using JudyLGet() to look for
+// each successive index word from Index in the JudyL array at each level.  At
+// the last level for the Index (LASTWORD_BY_LEN()), use JudyLPrev() instead of
+// JudyLGet(), to exclude the initial Index.  If this doesnt result in finding
+// a previous Index, work back up the tree using JudyLPrev() at each higher
+// level to search for a previous index word.  Upon finding a previous index
+// word, descend again if/as necessary, this time inclusively, to find and
+// return the full previous Index.
+//
+// Also support shortcut leaves.
+//
+// Since this function is recursive and it also needs to know if its still
+// looking for the original Index (to exclude it at the LASTWORD_BY_LEN()
+// level) or for the remaining words of the previous Index (inclusive),
+// actually call a subroutine that takes an additional parameter.
+//
+// See also the technical notes in JudySLDel() regarding the use of recursion
+// rather than iteration.
+
+PPvoid_t
+JudySLPrev(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+{
+// Check for caller error (null pointer), or empty JudySL array:
+
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    if (PArray == (Pvoid_t)NULL)
+        return ((PPvoid_t) NULL);
+// Do the search:
+    return (JudySLPrevSub(PArray, Index, /* original = */ 1,
+                          STRLEN(Index), PJError));
+}                                       // JudySLPrev()
+
+// ****************************************************************************
+// J U D Y   S L   P R E V   S U B
+//
+// This is the "engine" for JudySLPrev() that knows whether its still looking
+// for the original Index (exclusive) or a neighbor index (inclusive), and that
+// expects aligned and len to already be computed (only once).  See the header
+// comments for JudySLPrev().
+
+static    PPvoid_t
+JudySLPrevSub(Pcvoid_t PArray, uint8_t * Index, int orig,
+              Word_t len,               // bytes remaining.
+              PJError_t PJError)        // optional, for returning error info.
+{
+    Word_t    indexword;                // next word to find.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+// COMPRESSED PATH:
+//
+// If the original Index has all the words of the path, search below it;
+// otherwise every Index below the path precedes the original Index, or none
+// does, depending on the first word that differs.  In a subsequent search,
+// or if all precede, copy the path words to Index and find the last Index
+// below the path.
+
+    if (IS_PPCN(PArray))
+    {
+        Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+        Word_t    words = Ppcn->pcn_Words;
+        Word_t    word;
+
+        if (orig)
+        {
+            word = JudySLPathMatch(Index, Ppcn, &indexword);
+
+            if (word == words)
+                return (JudySLPrevSub(Ppcn->pcn_Next,
+                                      Index + (words * WORDSIZE),
+                                      /* original = */ 1,
+                                      len - (words * WORDSIZE), PJError));
+
+            if (indexword < Ppcn->pcn_Word[word])
+                return ((PPvoid_t) NULL);       // all follow Index.
+        }
+        for (word = 0; word < words; ++word)
+            COPYWORDtoSTRING(Index + (word * WORDSIZE), Ppcn->pcn_Word[word]);
+
+        return (JudySLPrevSub(Ppcn->pcn_Next, Index + (words * WORDSIZE),
+                              /* original = */ 0, 0, PJError));
+    }
+
+// PACKED LEAF:
+//
+// Find the Index before the original Index, or the last Index, if any.
+
+    if (IS_PPLF(PArray))
+    {
+        Pplf_t    Pplf = CLEAR_PPLF(PArray);
+        Word_t    entry = Pplf->plf_Pop;
+        int       found;
+
+        if (orig)
+            entry = JudySLLeafFind(Pplf, Index, &found);
+
+        if (entry == 0)
+            return ((PPvoid_t) NULL);
+
+        return (JudySLLeafCopy(Pplf, entry - 1, Index));
+    }
+
+// ORIGINAL SEARCH:
+//
+// When at a shortcut leaf, copy its remaining Index (string) chars into Index
+// and return its value area if the current Index is after (greater than) the
+// SCLs index; otherwise return null.
+    if (orig)
+    {
+        if (IS_PSCL(PArray))
+        {
+            if ((PPValue = PPSCLVALUE_GT(Index, PArray)) != (PPvoid_t) NULL)
+                (void)STRCPY(Index, PSCLINDEX(PArray));
+            return (PPValue);
+        }
+
+// If the current Index word:
+// - is not the last word in Index (end of string),
+// - exists in the current JudyL array, and,
+// - a previous Index is found below it, return that Indexs value area.
+
+        COPYSTRINGtoWORD(indexword, Index);     // copy next 4[8] bytes.
+        if (len > WORDSIZE)             // not at end of Index.
+        {
+            JLG(PPValue, PArray, indexword);
+            if (PPValue != (PPvoid_t) NULL)
+            {
+
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+
+                PPValue = JudySLPrevSub(*PPValue, Index + WORDSIZE,
+                                        /* original = */ 1,
+                                        len - WORDSIZE, PJError);
+                if (PPValue == PPJERR)
+                    return (PPJERR);    // propagate error.
+                if (PPValue != (PPvoid_t) NULL)
+                    return (PPValue);   // see above.
+            }
+        }
+
+// Search for previous index word:
+//
+// One of the above conditions is false.  Search the current JudyL array for
+// the Index word, if any, prior to the current index word.  If none is found,
+// return null; otherwise fall through to common later code.
+
+        if ((PPValue = JudySLPrevWord(PArray, &indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            return (PPJERR);
+        }
+
+        if (PPValue == (PPvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // no previous index word.
+    }                                   // if.
+
+// SUBSEQUENT SEARCH:
+//
+// A higher level search already excluded the initial Index, then found a
+// previous index word, and is now traversing down to determine the rest of the
+// Index and to obtain its value area.  If at a shortcut leaf, return its value
+// area.  Otherwise search the current JudyL array backward from the upper
+// limit for its last index word.  If no index word is found, return null --
+// should never happen unless the JudySL tree is corrupt; otherwise fall
+// through to common later code.
+
+    else
+    {
+        if (IS_PSCL(PArray))            // at shortcut leaf.
+        {
+            (void)STRCPY(Index, PSCLINDEX(PArray));
+            return (&PSCLVALUE(PArray));
+        }
+
+        indexword = ~0UL;
+        if ((PPValue = JudySLLastWord(PArray, &indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            return (PPJERR);
+        }
+
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+
+        if (PPValue == (PPvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // no previous index word.
+    }
+
+// FOUND PREVIOUS INDEX WORD:
+//
+// A previous (if original) or last (if subsequent) index word was located in
+// the current JudyL array.  Store it into the callers Index (string).  Then
+// if the found (previous) Index ends here, return its value area; otherwise do
+// a subsequent search below this point, which should never fail unless the
+// JudySL tree is corrupt, but this is detected at a lower level by the above
+// assertion.
+//
+// Note:  Treat Index as unaligned, even if it is aligned, to avoid writing
+// past the end of allocated memory (in case its less than a whole number of
+// words).
+
+    COPYWORDtoSTRING(Index, indexword); // copy next 4[8] bytes.
+    if (LASTWORD_BY_VALUE(indexword))
+        return (PPValue);
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+    return (JudySLPrevSub(*PPValue, Index + WORDSIZE, /* original = */ 0,
+                          len - WORDSIZE, PJError));
+}                                       // JudySLPrevSub()
+
+// ****************************************************************************
+// J U D Y   S L   N E X T
+//
+// See the comments in JudySLPrev(), which is very similar.
+//
+// TBD:  Could the two functions call a common engine function with various
+// subfunctions and other constants specified?
+
+PPvoid_t
+JudySLNext(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+{
+// Check for caller error (null pointer), or empty JudySL array:
+
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    if (PArray == (Pvoid_t)NULL)
+        return ((PPvoid_t) NULL);
+// Do the search:
+    return (JudySLNextSub(PArray, Index, /* original = */ 1,
+                          STRLEN(Index), PJError));
+}                                       // JudySLNext()
+
+// ****************************************************************************
+// J U D Y   S L   N E X T   S U B
+//
+// See the comments in JudySLPrevSub(), which is very similar.
+
+static    PPvoid_t
+JudySLNextSub(Pcvoid_t PArray, uint8_t * Index, int orig,
+              Word_t len,               // bytes remaining.
+              PJError_t PJError)        // optional, for returning error info.
+{
+    Word_t    indexword;                // next word to find.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+    if (IS_PPCN(PArray))                // see JudySLPrevSub().
+    {
+        Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+        Word_t    words = Ppcn->pcn_Words;
+        Word_t    word;
+
+        if (orig)
+        {
+            word = JudySLPathMatch(Index, Ppcn, &indexword);
+
+            if (word == words)
+                return (JudySLNextSub(Ppcn->pcn_Next,
+                                      Index + (words * WORDSIZE),
+                                      /* original = */ 1,
+                                      len - (words * WORDSIZE), PJError));
+
+            if (indexword > Ppcn->pcn_Word[word])
+                return ((PPvoid_t) NULL);       // all precede Index.
+        }
+        for (word = 0; word < words; ++word)
+            COPYWORDtoSTRING(Index + (word * WORDSIZE), Ppcn->pcn_Word[word]);
+
+        return (JudySLNextSub(Ppcn->pcn_Next, Index + (words * WORDSIZE),
+                              /* original = */ 0, 0, PJError));
+    }
+
+    if (IS_PPLF(PArray))                // see JudySLPrevSub().
+    {
+        Pplf_t    Pplf = CLEAR_PPLF(PArray);
+        Word_t    entry = 0;
+        int       found;
+
+        if (orig)
+        {
+            entry = JudySLLeafFind(Pplf, Index, &found);
+            entry += found;
+        }
+        if (entry == Pplf->plf_Pop)
+            return ((PPvoid_t) NULL);
+
+        return (JudySLLeafCopy(Pplf, entry, Index));
+    }
+
+    if (orig)
+    {
+        if (IS_PSCL(PArray))
+        {
+            if ((PPValue = PPSCLVALUE_LT(Index, PArray)) != (PPvoid_t) NULL)
+                (void)STRCPY(Index, PSCLINDEX(PArray));
+            return (PPValue);
+        }
+
+        COPYSTRINGtoWORD(indexword, Index);     // copy next 4[8] bytes.
+
+        if (len > WORDSIZE)             // not at end of Index.
+        {
+            JLG(PPValue, PArray, indexword);
+            if (PPValue != (PPvoid_t) NULL)
+            {
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+
+                PPValue = JudySLNextSub(*PPValue, Index + WORDSIZE,
+                                        /* original = */ 1,
+                                        len - WORDSIZE, PJError);
+                if (PPValue == PPJERR)
+                    return (PPJERR);    // propagate error.
+                if (PPValue != (PPvoid_t) NULL)
+                    return (PPValue);   // see above.
+            }
+        }
+
+        if ((PPValue = JudySLNextWord(PArray, &indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            return (PPJERR);
+        }
+
+        if (PPValue == (PPvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // no next index word.
+    }
+    else
+    {
+        if (IS_PSCL(PArray))            // at shortcut leaf.
+        {
+            (void)STRCPY(Index, PSCLINDEX(PArray));
+            return (&PSCLVALUE(PArray));
+        }
+
+        indexword = 0;
+        if ((PPValue = JudySLFirstWord(PArray, &indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            return (PPJERR);
+        }
+
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+
+        if (PPValue == (PPvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // no next index word.
+    }
+
+    COPYWORDtoSTRING(Index, indexword); // copy next 4[8] bytes
+    if (LASTWORD_BY_VALUE(indexword))
+        return (PPValue);
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue; this is automatically treated as a dead-end (not a core dump
+// or assertion; see version 1.25):
+    return (JudySLNextSub(*PPValue, Index + WORDSIZE, /* original = */ 0,
+                          len - WORDSIZE, PJError));
+}                                       // JudySLNextSub()
+
+// ****************************************************************************
+// J U D Y   S L   F I R S T
+//
+// Like JudyLFirst(), do a JudySLGet(), then if necessary a JudySLNext().
+
+PPvoid_t
+JudySLFirst(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError)        // optional, for returning error info.
+{
+    PPvoid_t  PPValue;                  // from JudyL array.
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    if ((PPValue = JudySLGet(PArray, Index, PJError)) == PPJERR)
+        return (PPJERR);                // propagate serious error.
+    if ((PPValue == (PPvoid_t) NULL)    // first try failed.
+        && ((PPValue = JudySLNext(PArray, Index, PJError)) == PPJERR))
+    {
+        return (PPJERR);                // propagate serious error.
+    }
+
+    return (PPValue);
+}                                       // JudySLFirst()
+
+// ****************************************************************************
+// J U D Y   S L   L A S T
+//
+// Like JudyLLast(), do a JudySLGet(), then if necessary a JudySLPrev().
+
+PPvoid_t
+JudySLLast(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+{
+    PPvoid_t  PPValue;                  // from JudyL array.
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    if ((PPValue = JudySLGet(PArray, Index, PJError)) == PPJERR)
+        return (PPJERR);                // propagate serious error.
+    if ((PPValue == (PPvoid_t) NULL)    // first try failed.
+        && ((PPValue = JudySLPrev(PArray, Index, PJError)) == PPJERR))
+    {
+        return (PPJERR);                // propagate serious error.
+    }
+
+    return (PPValue);
+}                                       // JudySLLast()
+
+// ****************************************************************************
+// J U D Y   S L   F R E E   A R R A Y
+//
+// Walk the JudySL tree of JudyL arrays to free each JudyL array, depth-first.
+// During the walk, ignore indexes (strings) that end in the current JudyL
+// array to be freed.  Just recurse through those indexes which do not end,
+// that is, those whose associated value areas point to subsidiary JudyL
+// arrays, except for those which point to shortcut leaves.  Return the total
+// bytes freed in all of the JudyL arrays at or below the current level.
+//
+// Like the JudyLFreeArray() and Judy1FreeArray() code, this is written
+// recursively, which is probably fast enough, to allow indexes (strings) of
+// arbitrary size.  If recursion turns out to be a problem, consider instead
+// doing some large, fixed number of iterative descents (like 100) using a
+// fixed-size "stack" (array), then recursing upon overflow (relatively
+// rarely).
+
+Word_t
+JudySLFreeArray(PPvoid_t PPArray, PJError_t PJError)    // optional, for returning error info.
+{
+    PPvoid_t  PPArrayOrig = PPArray;    // for error reporting.
+    Word_t    indexword = 0;            // word just found.
+    PPvoid_t  PPValue;                  // from Judy array.
+    Word_t    bytes_freed = 0;          // bytes freed at this level.
+    Word_t    bytes_total = 0;          // bytes freed at all levels.
+    if (PPArray == (PPvoid_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
+        return (JERR);
+    }
+
+// FREE SHORTCUT LEAF:
+
+    if (IS_PSCL(*PPArray))
+    {
+        Word_t    freewords;
+        Pscl_t    Pscl;
+
+        Pscl = CLEAR_PSCL(*PPArray);
+
+        freewords = SCLSIZE(STRLEN(Pscl->scl_Index));
+
+        JudyFree((void *)Pscl, freewords);
+
+        *PPArray = (Pvoid_t)NULL;
+
+        return (freewords * WORDSIZE);
+    }
+
+// FREE PACKED LEAF:
+
+    if (IS_PPLF(*PPArray))
+    {
+        Pplf_t    Pplf = CLEAR_PPLF(*PPArray);
+        Word_t    freewords = PLFSIZE(Pplf->plf_Pop, Pplf->plf_Words);
+
+        JudyFree((void *)Pplf, freewords);
+        *PPArray = (Pvoid_t)NULL;
+
+        return (freewords * WORDSIZE);
+    }
+
+// FREE COMPRESSED PATH, AND WHAT FOLLOWS IT:
+
+    if (IS_PPCN(*PPArray))
+    {
+        Ppcn_t    Ppcn = CLEAR_PPCN(*PPArray);
+        Word_t    freewords = PCNSIZE(Ppcn->pcn_Words);
+
+        if ((bytes_total = JudySLFreeArray(&(Ppcn->pcn_Next), PJError)) == JERR)
+            return (JERR);              // propagate serious error.
+
+        JudyFree((void *)Ppcn, freewords);
+        *PPArray = (Pvoid_t)NULL;
+
+        return (bytes_total + (freewords * WORDSIZE));
+    }
+
+// FREE SUMS, IF ANY (SEE SL_COUNTWORD):
+
+    JLG(PPValue, *PPArray, SL_SUMSWORD);
+    if ((PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR))
+    {
+        PWord_t   Psums = (PWord_t) *PPValue;
+
+        bytes_total += SUMSSIZE(Psums[0]) * WORDSIZE;
+        JudyFree((Pvoid_t) Psums, SUMSSIZE(Psums[0]));
+    }
+
+// FREE EACH SUB-ARRAY (DEPTH-FIRST):
+//
+// If a previous JudySLIns() ran out of memory partway down the tree, it left a
+// null *PPValue.  This is automatically treated correctly here as a dead-end.
+//
+// An Index (string) ends in the current word iff the last byte of the
+// (null-padded) word is null.
+
+    for (PPValue = JudySLFirstWord(*PPArray, &indexword, PJError);
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR);
+         PPValue = JudySLNextWord(*PPArray, &indexword, PJError))
+    {
+        if (!LASTWORD_BY_VALUE(indexword))
+        {
+            if ((bytes_freed = JudySLFreeArray(PPValue, PJError)) == JERR)
+                return (JERR);          // propagate serious error.
+            bytes_total += bytes_freed;
+        }
+    }
+
+// Check for a serious error in a JudyL*() call:
+
+    if (PPValue == PPJERR)
+    {
+        JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+        return (JERR);
+    }
+
+// Now free the current array, which also nulls the pointer:
+//
+// Note:  *PPArray can be null here for a totally null JudySL array =>
+// JudyLFreeArray() returns zero.
+
+    if ((bytes_freed = JudyLFreeArray(PPArray, PJError)) == JERR)
+    {
+        JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+        return (JERR);
+    }
+    return (bytes_total + bytes_freed);
+}                                       // JudySLFreeArray()
+
+// ****************************************************************************
+// J U D Y   S L   C O U N T   I N I T
+//
+// Make a JudySL array counted (see SL_COUNTWORD), so that JudySLCount() and
+// JudySLByCount() take O(log N) per level, at the cost of keeping the counts
+// up to date in JudySLIns() and JudySLDel().  Best called on an empty array,
+// when it is created; otherwise this visits every Index.  A counted array
+// always has a JudyL array at the top, so first replace a shortcut leaf,
+// packed leaf, or compressed path there with one.  The array stays counted,
+// and so is not NULL even when emptied, until JudySLFreeArray().  Return 1,
+// or JERR.
+
+int
+JudySLCountInit(PPvoid_t PPArray, PJError_t PJError)
+{
+    Pvoid_t   PArray = (Pvoid_t) NULL;  // new top JudyL array.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+    if (PPArray == (PPvoid_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
+        return (JERR);
+    }
+    if (JudySLCounted(*PPArray) != (PWord_t) NULL)
+        return (1);                     // already counted.
+
+    if (*PPArray == (Pvoid_t) NULL)
+    {
+        if ((PPValue = JudyLIns(PPArray, SL_COUNTWORD, PJError)) == PPJERR)
+            return (JERR);
+        *((PWord_t) PPValue) = 0;
+        return (1);
+    }
+
+    if (IS_PSCL(*PPArray))
+    {
+        Pscl_t    Pscl = CLEAR_PSCL(*PPArray);
+
+        if (((PPValue = JudyLIns(&PArray, SL_COUNTWORD, PJError)) == PPJERR)
+         || ((PPValue = JudySLInsSub(&PArray, Pscl->scl_Index, PJError))
+             == PPJERR))
+        {
+            (void)JudySLFreeArray(&PArray, PJE0);
+            return (JERR);
+        }
+        *PPValue = Pscl->scl_Pvalue;
+        JudyFree((Pvoid_t) Pscl, SCLSIZE(STRLEN(Pscl->scl_Index)));
+        *PPArray = PArray;
+    }
+    else if (IS_PPLF(*PPArray))
+    {
+        if (JudySLLeafSplit(PPArray, PJError) == JERR)
+            return (JERR);
+    }
+    else if (IS_PPCN(*PPArray))
+    {
+        if (JudySLSplitPath(PPArray, 0, PJError) == JERR)
+            return (JERR);
+    }
+
+    return ((JudySLStorePop(PPArray, /* Recount = */ 1, PJError) == JERR) ?
+            JERR : 1);
+}                                       // JudySLCountInit()
+
+// ****************************************************************************
+// J U D Y   S L   C O U N T
+// J U D Y   S L   B Y   C O U N T
+//
+// Like JudyLCount() and JudyLByCount(), for strings:  JudySLCount() returns
+// the number of Indexes from Index1 through Index2, and JudySLByCount() finds
+// Index number Count (1 for the first), copies it to Index, and returns its
+// value area, or null if there are fewer Indexes.
+//
+// Both descend the tree once, like JudySLGet(), and only read the JudySL
+// array.  In a counted array (see JudySLCountInit()), the subtree populations
+// and sums described with SL_COUNTWORD let JudySLSumsBefore() or
+// JudySLSumsFind() find the block of the index word at each level, so the
+// cost is O(log N) plus a walk of at most 2 * SL_SUMSBLOCK index words, per
+// level.  Otherwise the index words at each level are added up, and the
+// populations below them too.
+
+// Return the number of Indexes below the index words before Word in the JudyL
+// array PArray, or JERR:
+
+static    Word_t
+JudySLPopBefore(Pcvoid_t PArray, Word_t Word, PJError_t PJError)
+{
+    PPvoid_t  PPSums;                   // from JudyL array.
+    PWord_t   Psums;                    // sums object.
+    Word_t    block;                    // holding Word.
+    Word_t    indexword = 0;            // word just found.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    pop1sum = 0;              // of those before Word.
+    Word_t    pop1sub;                  // below one index word.
+
+// With sums, start at the bound of the block holding Word:
+
+    JLG(PPSums, PArray, SL_SUMSWORD);
+    if (PPSums != (PPvoid_t) NULL)
+    {
+        Psums = (PWord_t) *PPSums;
+        block = JudySLSumsBlock(Psums, Word);
+        pop1sum = JudySLSumsBefore(Psums, block);
+        indexword = SUMSBOUND(Psums)[block];
+    }
+
+    for (PPValue = JudySLFirstWord(PArray, &indexword, PJError);
+         (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR)
+         && (indexword < Word);
+         PPValue = JudySLNextWord(PArray, &indexword, PJError))
+    {
+        if ((pop1sub = JudySLWordPop(*PPValue, indexword, PJError)) == JERR)
+            return (JERR);
+        pop1sum += pop1sub;
+    }
+    return ((PPValue == PPJERR) ? JERR : pop1sum);
+}                                       // JudySLPopBefore()
+
+// Return the number of Indexes before Index, and also Index itself if
+// Inclusive and present, or JERR:
+
+static    Word_t
+JudySLPopTo(Pcvoid_t PArray, const uint8_t * Index, int Inclusive,
+            PJError_t PJError)
+{
+    const uint8_t *pos = Index;         // place in Index.
+    Word_t    len = STRLEN(Index);      // bytes remaining.
+    Word_t    indexword;                // buffer for aligned copy.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    pop1 = 0;                 // Indexes found before.
+    Word_t    pop1sub;                  // from one level.
+    int       cmp;                      // of Index and shortcut leaf.
+
+    while (1)                           // until return.
+    {
+        if (PArray == (Pvoid_t) NULL)
+            return (pop1);
+
+        if (IS_PSCL(PArray))
+        {
+            cmp = SCLCMP(pos, PArray);
+            return (pop1 + ((cmp > 0) || (Inclusive && (cmp == 0))));
+        }
+
+        if (IS_PPLF(PArray))          // cmp is whether found.
+        {
+            pop1 += JudySLLeafFind(CLEAR_PPLF(PArray), pos, &cmp);
+            return (pop1 + (Inclusive && cmp));
+        }
+
+// A compressed path either matches Index, or all the Indexes below it precede
+// or follow Index:
+
+        if (IS_PPCN(PArray))
+        {
+            Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+            Word_t    words = JudySLPathMatch(pos, Ppcn, &indexword);
+
+            if (words < Ppcn->pcn_Words)
+            {
+                if (indexword < Ppcn->pcn_Word[words])
+                    return (pop1);      // all follow Index.
+
+                if ((pop1sub = JudySLPop(Ppcn->pcn_Next, PJError)) == JERR)
+                    return (JERR);
+                return (pop1 + pop1sub);
+            }
+            pos += words * WORDSIZE;
+            len -= words * WORDSIZE;
+            PArray = Ppcn->pcn_Next;
+            continue;
+        }
+
+        if (len > WORDSIZE)
+        {
+            COPYSTRINGtoFULLWORD(indexword, pos);       // next 4[8] bytes.
+        }
+        else
+        {
+            COPYSTRINGtoLASTWORD(indexword, pos);       // last 1..4[8] bytes.
+        }
+
+        if ((pop1sub = JudySLPopBefore(PArray, indexword, PJError)) == JERR)
+            return (JERR);
+        pop1 += pop1sub;
+
+        JLG(PPValue, PArray, indexword);
+        if (PPValue == (PPvoid_t) NULL)
+            return (pop1);
+
+        if (len <= WORDSIZE)
+            return (pop1 + (Inclusive ? 1 : 0));
+
+        pos += WORDSIZE;
+        len -= WORDSIZE;
+        PArray = *PPValue;
+    }
+}                                       // JudySLPopTo()
+
+Word_t
+JudySLCount(Pcvoid_t PArray, const uint8_t * Index1, const uint8_t * Index2,
+            PJError_t PJError)
+{
+    Word_t    pop1before1;              // Indexes before Index1.
+    Word_t    pop1through2;             // Indexes through Index2.
+
+// Like JudyLCount(), return 0, not JERR, for an error:
+
+    if ((Index1 == (uint8_t *) NULL) || (Index2 == (uint8_t *) NULL))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (0);
+    }
+    if ((PArray == (Pvoid_t) NULL) || (STRCMP(Index1, Index2) > 0))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NONE);
+        return (0);
+    }
+
+    if (((pop1through2 = JudySLPopTo(PArray, Index2, 1, PJError)) == JERR)
+     || ((pop1before1 = JudySLPopTo(PArray, Index1, 0, PJError)) == JERR))
+    {
+        return (0);
+    }
+
+    if (pop1through2 == pop1before1)
+        JU_SET_ERRNO(PJError, JU_ERRNO_NONE);
+
+    return (pop1through2 - pop1before1);
+}                                       // JudySLCount()
+
+PPvoid_t
+JudySLByCount(Pcvoid_t PArray, Word_t Count, uint8_t * Index,
+              PJError_t PJError)
+{
+    uint8_t  *pos = Index;              // place in Index.
+    Word_t    count0 = Count - 1;       // Indexes before it, in subtree.
+    Word_t    indexword;                // word just found.
+    PPvoid_t  PPValue;                  // from JudyL array.
+    Word_t    pop1;                     // of the JudySL array.
+    Word_t    pop1sub;                  // below one index word.
+    PWord_t   Psums;                    // of a JudyL array.
+
+    if (Index == (uint8_t *) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+    if ((PArray == (Pvoid_t) NULL) || (Count == 0))
+        return ((PPvoid_t) NULL);
+
+    if ((pop1 = JudySLPop(PArray, PJError)) == JERR)
+        return (PPJERR);
+    if (Count > pop1)
+        return ((PPvoid_t) NULL);
+
+// DESCEND TO THE INDEX:
+//
+// At each JudyL array, find the index word holding the Index, and how many
+// Indexes below it come before the Index.
+
+    while (1)                           // until return.
+    {
+        if (PArray == (Pvoid_t) NULL)
+            return ((PPvoid_t) NULL);   // dead end; see JudySLGet().
+
+        if (IS_PSCL(PArray))
+        {
+            (void)STRCPY(pos, PSCLINDEX(PArray));
+            return (&PSCLVALUE(PArray));
+        }
+
+        if (IS_PPLF(PArray))
+        {
+            if (count0 >= CLEAR_PPLF(PArray)->plf_Pop)
+                return ((PPvoid_t) NULL);       // corrupt populations.
+
+            return (JudySLLeafCopy(CLEAR_PPLF(PArray), count0, pos));
+        }
+
+        if (IS_PPCN(PArray))
+        {
+            Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+            Word_t    word;
+
+            for (word = 0; word < Ppcn->pcn_Words; ++word, pos += WORDSIZE)
+                COPYWORDtoSTRING(pos, Ppcn->pcn_Word[word]);
+
+            PArray = Ppcn->pcn_Next;
+            continue;
+        }
+
+// With sums, start at the bound of the block holding the Index:
+
+        indexword = 0;
+        JLG(PPValue, PArray, SL_SUMSWORD);
+        if (PPValue != (PPvoid_t) NULL)
+        {
+            Psums = (PWord_t) *PPValue;
+            indexword = SUMSBOUND(Psums)[JudySLSumsFind(Psums, &count0)];
+        }
+
+        for (PPValue = JudySLFirstWord(PArray, &indexword, PJError);
+             (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR);
+             PPValue = JudySLNextWord(PArray, &indexword, PJError))
+        {
+            if ((pop1sub = JudySLWordPop(*PPValue, indexword, PJError))
+                == JERR)
+            {
+                return (PPJERR);
+            }
+            if (count0 < pop1sub)
+                break;
+            count0 -= pop1sub;
+        }
+        if ((PPValue == (PPvoid_t) NULL) || (PPValue == PPJERR))
+            return (PPValue);           // corrupt populations, or error.
+
+        COPYWORDtoSTRING(pos, indexword);       // copy next 4[8] bytes.
+        if (LASTWORD_BY_VALUE(indexword))
+            return (PPValue);
+
+        pos += WORDSIZE;
+        PArray = *PPValue;
+    }
+}                                       // JudySLByCount()
+
+// ****************************************************************************
+// J U D Y   S L   P R E F I X   F I R S T / N E X T
+//
+// Visit, in order, every Index that begins with a given prefix.  JudySLFirst()
+// and JudySLNext() would do it, but each JudySLNext() starts again at the top
+// of the tree, and the caller must check the prefix itself.  Instead, descend
+// once to the JudyL array (or compressed path) where the prefix ends, keeping
+// the path in the cursor -- each JudyL array, compressed path, or last a
+// shortcut or packed leaf, with its current index word (or for a packed leaf,
+// the number of its current Index) and its place in Index -- then
+// walk only that subtree:  each JudySLPrefixNext() continues from the bottom
+// of the path, so it costs only as many JudyL calls as levels it actually
+// moves.
+//
+// Levels above the one where the prefix ends (jslc_Base) are fixed, and if
+// that level is a JudyL array, only index words from the one holding the
+// start of the prefix (null-padded) through jslc_High (the same bytes padded
+// with 0xff) match it; likewise, if it is a packed leaf, only its Indexes
+// through number jslc_High.  A compressed path or shortcut leaf has no other
+// entries to move to, so the walk just backs up past it.
+//
+// The cursor points into the JudySL array, so the array must not be modified
+// between calls.  Index must have room for the longest Index in the array and
+// must be left as returned, since only the part that changes is rewritten.
+
+#define SLC_ARRAY(PCURSOR,LEVEL) ((Pvoid_t)((PCURSOR)->jslc_Stack[3 * (LEVEL)]))
+#define SLC_WORD(PCURSOR,LEVEL)  ((PCURSOR)->jslc_Stack[3 * (LEVEL) + 1])
+#define SLC_PLACE(PCURSOR,LEVEL) ((PCURSOR)->jslc_Stack[3 * (LEVEL) + 2])
+
+// Push PArray, for the part of Index at PLACE, as level LEVEL of the path (the
+// stack is grown if necessary):
+
+#define SLC_PUSH(PCURSOR,LEVEL,PARRAY,PLACE,PJERROR)                    \
+{                                                                       \
+    if (((LEVEL) >= (PCURSOR)->jslc_Size)                               \
+     && (JudySLCursorGrow(PCURSOR, PJERROR) == JERR))                   \
+    {                                                                   \
+        (PCURSOR)->jslc_Depth = 0;                                      \
+        return (PPJERR);                                                \
+    }                                                                   \
+    (PCURSOR)->jslc_Stack[3 * (LEVEL)]     = (Word_t) (PARRAY);         \
+    (PCURSOR)->jslc_Stack[3 * (LEVEL) + 1] = 0;                         \
+    (PCURSOR)->jslc_Stack[3 * (LEVEL) + 2] = (PLACE);                   \
+    (PCURSOR)->jslc_Depth = (LEVEL) + 1;                                \
+}
+
+// Double the room in the cursor for levels of the path:
+
+static Word_t
+JudySLCursorGrow(PJSLCursor_t PCursor, PJError_t PJError)
+{
+    Word_t    size = PCursor->jslc_Size ? (PCursor->jslc_Size * 2) : 8;
+    PWord_t   Pstack;
+
+    if ((Pstack = (PWord_t) JudyMalloc(size * 3)) == (PWord_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NOMEM);
+        return (JERR);
+    }
+    if (PCursor->jslc_Size)
+    {
+        (void)memcpy(Pstack, PCursor->jslc_Stack,
+                     PCursor->jslc_Size * 3 * WORDSIZE);
+        JudyFree((Pvoid_t) PCursor->jslc_Stack, PCursor->jslc_Size * 3);
+    }
+    PCursor->jslc_Stack = Pstack;
+    PCursor->jslc_Size = size;
+    return (size);
+}                                       // JudySLCursorGrow()
+
+// Walk the path to the next Index and copy it to Index, rewriting it from
+// level From down.  PPValue is either the value area of the entry at the
+// bottom of the path, just found (for a compressed path, its pcn_Next), or
+// null to move past that entry first.
+
+static PPvoid_t
+JudySLCursorWalk(PJSLCursor_t PCursor, uint8_t * Index, PPvoid_t PPValue,
+                 Word_t From, PJError_t PJError)
+{
+    Word_t    level;                    // bottom of path.
+    Word_t    indexword;                // at that level.
+    Word_t    place;                    // in Index, of that level.
+    Pvoid_t   PArray;                   // at that level.
+
+    while (1)                           // until return.
+    {
+        level = PCursor->jslc_Depth - 1;
+        PArray = SLC_ARRAY(PCursor, level);
+        indexword = SLC_WORD(PCursor, level);
+
+// MOVE PAST THE CURRENT ENTRY:
+//
+// A shortcut leaf or compressed path has only one entry; otherwise look for
+// the next Index in a packed leaf, or index word at this level.  If there is
+// none (or none matching the prefix), back up a level, ending the walk when
+// the levels left belong to the prefix.
+
+        if (PPValue == (PPvoid_t) NULL)
+        {
+            if (IS_PPLF(PArray))
+            {
+                if ((++indexword < CLEAR_PPLF(PArray)->plf_Pop)
+                 && ((level != PCursor->jslc_Base)
+                  || (indexword <= PCursor->jslc_High)))
+                {
+                    PPValue = &(CLEAR_PPLF(PArray)->plf_Pvalue[indexword]);
+                }
+            }
+            else if (! (IS_PSCL(PArray) || IS_PPCN(PArray)))
+            {
+                if ((PPValue = JudySLNextWord(PArray, &indexword, PJError))
+                    == PPJERR)
+                {
+                    JudySLModifyErrno(PJError, PArray, SLC_ARRAY(PCursor, 0));
+                    PCursor->jslc_Depth = 0;
+                    return (PPJERR);
+                }
+                if ((level == PCursor->jslc_Base)
+                 && (indexword > PCursor->jslc_High))
+                {
+                    PPValue = (PPvoid_t) NULL;
+                }
+            }
+            if (PPValue == (PPvoid_t) NULL)
+            {
+                if (--(PCursor->jslc_Depth) <= PCursor->jslc_Base)
+                {
+                    PCursor->jslc_Depth = 0;
+                    return ((PPvoid_t) NULL);   // no more Indexes.
+                }
+                continue;
+            }
+            SLC_WORD(PCursor, level) = indexword;
+            if (level < From)
+                From = level;
+        }
+
+// FOUND AN INDEX:
+//
+// At a shortcut or packed leaf, or the last word of an Index, copy the Index
+// to the callers buffer and return its value area.
+
+        if (IS_PSCL(PArray) || IS_PPLF(PArray)
+         || ((! IS_PPCN(PArray)) && LASTWORD_BY_VALUE(indexword)))
+        {
+            for ( ; From <= level; ++From)
+            {
+                Pvoid_t   Pentry = SLC_ARRAY(PCursor, From);
+                uint8_t  *Pplace = Index + SLC_PLACE(PCursor, From);
+
+                if (IS_PSCL(Pentry))
+                {
+                    (void)STRCPY(Pplace, PSCLINDEX(Pentry));
+                }
+                else if (IS_PPLF(Pentry))
+                {
+                    (void)JudySLLeafCopy(CLEAR_PPLF(Pentry),
+                                         SLC_WORD(PCursor, From), Pplace);
+                }
+                else if (IS_PPCN(Pentry))
+                {
+                    Ppcn_t    Ppcn = CLEAR_PPCN(Pentry);
+                    Word_t    word;
+
+                    for (word = 0; word < Ppcn->pcn_Words; ++word)
+                        COPYWORDtoSTRING(Pplace + (word * WORDSIZE),
+                                         Ppcn->pcn_Word[word]);
+                }
+                else
+                {
+                    COPYWORDtoSTRING(Pplace, SLC_WORD(PCursor, From));
+                }
+            }
+            return (PPValue);
+        }
+
+// DESCEND TO THE FIRST ENTRY BELOW:
+//
+// A null JudyL array (a dead end left by a JudySLIns() that ran out of
+// memory) has no first index word, so is simply passed by.
+
+        place = SLC_PLACE(PCursor, level) + (IS_PPCN(PArray) ?
+                (CLEAR_PPCN(PArray)->pcn_Words * WORDSIZE) : WORDSIZE);
+        PArray = *PPValue;
+        SLC_PUSH(PCursor, level + 1, PArray, place, PJError);
+
+        if (IS_PSCL(PArray))
+        {
+            PPValue = &PSCLVALUE(PArray);
+            continue;
+        }
+        if (IS_PPLF(PArray))
+        {
+            PPValue = &(CLEAR_PPLF(PArray)->plf_Pvalue[0]);
+            continue;
+        }
+        if (IS_PPCN(PArray))
+        {
+            PPValue = &(CLEAR_PPCN(PArray)->pcn_Next);
+            continue;
+        }
+        indexword = 0;
+        if ((PPValue = JudySLFirstWord(PArray, &indexword, PJError)) == PPJERR)
+        {
+            JudySLModifyErrno(PJError, PArray, SLC_ARRAY(PCursor, 0));
+            PCursor->jslc_Depth = 0;
+            return (PPJERR);
+        }
+        SLC_WORD(PCursor, level + 1) = indexword;
+    }
+}                                       // JudySLCursorWalk()
+
+PPvoid_t
+JudySLPrefixFirst(Pcvoid_t PArray, const uint8_t * Prefix,
+                  PJSLCursor_t PCursor, uint8_t * Index, PJError_t PJError)
+{
+    const uint8_t *pos = Prefix;        // place in Prefix.
+    Word_t    len;                      // bytes of Prefix, without \0.
+    Word_t    level = 0;                // in the path.
+    Word_t    indexword;                // next word of Prefix.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+    if ((Prefix == (uint8_t *) NULL) || (Index == (uint8_t *) NULL)
+     || (PCursor == (PJSLCursor_t) NULL))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    len = STRLEN(Prefix) - 1;
+    PCursor->jslc_Depth = 0;
+
+// DESCEND THROUGH THE WHOLE WORDS OF THE PREFIX:
+//
+// A shortcut leaf on the way holds the only Index with the prefix, if any,
+// and a packed leaf all of them, in a run; a compressed path that the prefix
+// ends in holds all of them, if its words match the prefix.
+
+    while (1)                           // until break or return.
+    {
+        if (PArray == (Pvoid_t) NULL)
+        {
+            PCursor->jslc_Depth = 0;
+            return ((PPvoid_t) NULL);   // no Index has the prefix.
+        }
+        SLC_PUSH(PCursor, level, PArray, (Word_t) (pos - Prefix), PJError);
+        PCursor->jslc_Base = level;
+
+        if (IS_PSCL(PArray))
+        {
+            if (strncmp((void *)PSCLINDEX(PArray), (void *)pos,
+                        len - (pos - Prefix)))
+            {
+                PCursor->jslc_Depth = 0;
+                return ((PPvoid_t) NULL);
+            }
+            return (JudySLCursorWalk(PCursor, Index, &PSCLVALUE(PArray),
+                                     0, PJError));
+        }
+        if (IS_PPLF(PArray))
+        {
+            Pplf_t    Pplf = CLEAR_PPLF(PArray);
+            Word_t    rest = len - (pos - Prefix);      // bytes of prefix.
+            Word_t    entry;
+            uint8_t   buf[SL_PLFMAXLEN];                // an Index of it.
+
+            SLC_WORD(PCursor, level) = Pplf->plf_Pop;   // none yet.
+
+            for (entry = 0; entry < Pplf->plf_Pop; ++entry)
+            {
+                (void)JudySLLeafCopy(Pplf, entry, buf);
+
+                if (strncmp((void *)buf, (void *)pos, rest) == 0)
+                {
+                    if (SLC_WORD(PCursor, level) == Pplf->plf_Pop)
+                        SLC_WORD(PCursor, level) = entry;
+                    PCursor->jslc_High = entry;
+                }
+                else if (SLC_WORD(PCursor, level) < Pplf->plf_Pop)
+                    break;              // past the run.
+            }
+            if ((entry = SLC_WORD(PCursor, level)) == Pplf->plf_Pop)
+            {
+                PCursor->jslc_Depth = 0;
+                return ((PPvoid_t) NULL);
+            }
+            return (JudySLCursorWalk(PCursor, Index,
+                                     &(Pplf->plf_Pvalue[entry]), 0, PJError));
+        }
+        if (IS_PPCN(PArray))
+        {
+            Ppcn_t    Ppcn = CLEAR_PPCN(PArray);
+            Word_t    word;
+            Word_t    rest;             // bytes of prefix in this word.
+
+            for (word = 0; word < Ppcn->pcn_Words; ++word, pos += WORDSIZE)
+            {
+                COPYSTRINGtoWORD(indexword, pos);       // null-padded.
+
+                if ((rest = len - (pos - Prefix)) < WORDSIZE)
+                {
+                    if ((Ppcn->pcn_Word[word] & ~(~0UL >> (rest * 8)))
+                        != indexword)
+                    {
+                        break;          // no match.
+                    }
+                    return (JudySLCursorWalk(PCursor, Index,
+                                             &(Ppcn->pcn_Next), 0, PJError));
+                }
+                if (Ppcn->pcn_Word[word] != indexword)
+                    break;              // no match.
+            }
+            if (word < Ppcn->pcn_Words)
+            {
+                PCursor->jslc_Depth = 0;
+                return ((PPvoid_t) NULL);
+            }
+            PArray = Ppcn->pcn_Next;
+            ++level;
+            continue;
+        }
+        if (len - (pos - Prefix) < WORDSIZE)
+            break;                      // prefix ends in this array.
+
+        COPYSTRINGtoWORD(indexword, pos);       // copy next 4[8] bytes.
+        JLG(PPValue, PArray, indexword);
+        if (PPValue == (PPvoid_t) NULL)
+        {
+            PCursor->jslc_Depth = 0;
+            return ((PPvoid_t) NULL);
+        }
+        SLC_WORD(PCursor, level) = indexword;
+
+        PArray = *PPValue;
+        pos += WORDSIZE;
+        ++level;
+    }
+
+// FIND THE FIRST INDEX WORD WITH THE REST OF THE PREFIX:
+
+    COPYSTRINGtoWORD(indexword, pos);   // null-padded.
+    PCursor->jslc_High = indexword | (~0UL >> ((len % WORDSIZE) * 8));
+
+    if ((PPValue = JudySLFirstWord(PArray, &indexword, PJError)) == PPJERR)
+    {
+        JudySLModifyErrno(PJError, PArray, SLC_ARRAY(PCursor, 0));
+        PCursor->jslc_Depth = 0;
+        return (PPJERR);
+    }
+    if ((PPValue == (PPvoid_t) NULL) || (indexword > PCursor->jslc_High))
+    {
+        PCursor->jslc_Depth = 0;
+        return ((PPvoid_t) NULL);
+    }
+    SLC_WORD(PCursor, level) = indexword;
+
+    return (JudySLCursorWalk(PCursor, Index, PPValue, 0, PJError));
+}                                       // JudySLPrefixFirst()
+
+PPvoid_t
+JudySLPrefixNext(PJSLCursor_t PCursor, uint8_t * Index, PJError_t PJError)
+{
+    if ((PCursor == (PJSLCursor_t) NULL) || (Index == (uint8_t *) NULL))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+    if (PCursor->jslc_Depth == 0)
+        return ((PPvoid_t) NULL);       // done, or never started.
+
+    return (JudySLCursorWalk(PCursor, Index, (PPvoid_t) NULL, ~0UL, PJError));
+}                                       // JudySLPrefixNext()
+
+Word_t
+JudySLCursorFree(PJSLCursor_t PCursor)
+{
+    Word_t    bytes_freed;
+
+    if ((PCursor == (PJSLCursor_t) NULL) || (PCursor->jslc_Size == 0))
+        return (0);
+
+    bytes_freed = PCursor->jslc_Size * 3 * WORDSIZE;
+    JudyFree((Pvoid_t) PCursor->jslc_Stack, PCursor->jslc_Size * 3);
+
+    PCursor->jslc_Stack = (PWord_t) NULL;
+    PCursor->jslc_Size = 0;
+    PCursor->jslc_Depth = 0;
+
+    return (bytes_freed);
+}                                       // JudySLCursorFree()
+
+// ****************************************************************************
+// JUDYSLB:  LENGTH-DELIMITED (BINARY) INDEXES
+//
+// The JudySLB*() functions are JudySL*() for Indexes given as (pointer,
+// length) rather than as null-terminated strings, so an Index can be any
+// bytes, including \0s, and need not be scanned for its end.  Indexes are
+// ordered as memcmp() orders them, with an Index that is a prefix of another
+// sorting first; the empty (zero length) Index is valid and sorts first.
+//
+// METHOD:  As in JudySL, the Index is broken into chunks, one per level of the
+// tree of JudyL arrays, but each index word holds only W-1 Index bytes (in the
+// high-order bytes, null-padded), and its low-order byte is a tag:  either the
+// number of Index bytes in the word (0..W-1), if the Index ends in this word,
+// or SLB_MORE if it continues below.  Since a tag is never larger than
+// SLB_MORE, and a shorter Index has a smaller tag than a longer one with the
+// same bytes, JudyL order of index words is also the Index order described
+// above, so First/Next/Last/Prev work just as in JudySL.
+//
+// Shortcut leaves are as in JudySL, except that they record the length of
+// the remaining Index rather than relying on a trailing \0.  The two kinds of
+// arrays are not interchangeable; pass a JudySLB array only to JudySLB*().
+
+#define SLB_DATABYTES   (WORDSIZE - 1)  // Index bytes per index word.
+#define SLB_MORE        0xffL           // tag:  the Index continues below.
+
+#define SLB_TAG(WORD)           ((WORD) & 0xffL)
+#define LASTWORD_BY_TAG(WORD)   (SLB_TAG(WORD) != SLB_MORE)
+
+typedef struct SHORTCUTLEAFB
+{
+    Pvoid_t   sclb_Pvalue;              // callers value area.
+    Word_t    sclb_Len;                 // bytes in sclb_Index.
+    uint8_t   sclb_Index[WORDSIZE];     // remaining Index bytes.
+} sclb_t  , *Psclb_t;
+
+#define STRUCTOVDB      (sizeof(sclb_t) - WORDSIZE)
+#define SCLBSIZE(LEN)   (((LEN) + STRUCTOVDB + WORDSIZE - 1) / WORDSIZE)
+
+#define CLEAR_PSCLB(PSCL)  ((Psclb_t)(((Word_t) (PSCL)) & (~JLAP_INVALID)))
+
+// Like APPEND_SCL(), for a JudySLB shortcut leaf:
+
+#define APPEND_SCLB(PSCL,PPARRAY,INDEX,LEN,PJERROR)                     \
+{                                                                       \
+    if (((PSCL) = (Psclb_t) JudyMalloc(SCLBSIZE(LEN))) == (Psclb_t)NULL) \
+    {                                                                   \
+        JU_SET_ERRNO(PJERROR, JU_ERRNO_NOMEM);                          \
+        return (PPJERR);                                                \
+    }                                                                   \
+    *(PPARRAY) = (Pvoid_t)SET_PSCL(PSCL);                               \
+    ((PSCL)->sclb_Pvalue) = (Pvoid_t)NULL;                              \
+    ((PSCL)->sclb_Len)    = (LEN);                                      \
+    (void)memcpy((PSCL)->sclb_Index, INDEX, LEN);                       \
+}
+
+static int JudySLBDelSub(PPvoid_t PPArray, PPvoid_t PPArrayOrig,
+                         const uint8_t * Index, Word_t len,
+                         PJError_t PJError);
+static PPvoid_t JudySLBPrevSub(Pcvoid_t PArray, uint8_t * Index,
+                               Word_t done, Word_t len, PWord_t PLen,
+                               int orig, PJError_t PJError);
+static PPvoid_t JudySLBNextSub(Pcvoid_t PArray, uint8_t * Index,
+                               Word_t done, Word_t len, PWord_t PLen,
+                               int orig, PJError_t PJError);
+
+// ****************************************************************************
+// J U D Y   S L B   W O R D
+//
+// Return the index word for the next chunk of an Index with len bytes left.
+// A whole chunk is followed by at least one more Index byte, so a full word
+// can be loaded without reading past the Index.
+
+static Word_t
+JudySLBWord(const uint8_t * Index, Word_t len)
+{
+    Word_t    word;
+    Word_t    ii;
+
+    if (len > SLB_DATABYTES)            // Index continues below.
+    {
+#ifdef SL_BIGENDIAN
+        (void)memcpy(&word, Index, WORDSIZE);
+        return (SL_BIGENDIAN(word) | SLB_MORE);
+#else
+        len = SLB_DATABYTES;
+        word = SLB_MORE;
+#endif
+    }
+    else
+        word = len;                     // Index ends here.
+
+    for (ii = 0; ii < len; ++ii)
+        word |= ((Word_t)Index[ii]) << ((WORDSIZE - 1 - ii) * 8);
+
+    return (word);
+}                                       // JudySLBWord()
+
+// ****************************************************************************
+// J U D Y   S L B   C O P Y
+//
+// Copy the Index bytes in an index word to Index and return how many there
+// were.
+
+static Word_t
+JudySLBCopy(uint8_t * Index, Word_t word)
+{
+    Word_t    len = LASTWORD_BY_TAG(word) ? SLB_TAG(word) : SLB_DATABYTES;
+    Word_t    ii;
+
+    for (ii = 0; ii < len; ++ii)
+        Index[ii] = (uint8_t)(word >> ((WORDSIZE - 1 - ii) * 8));
+
+    return (len);
+}                                       // JudySLBCopy()
+
+// ****************************************************************************
+// J U D Y   S L B   C M P
+//
+// Compare an Index remainder to the one in a shortcut leaf, like STRCMP().
+
+static int
+JudySLBCmp(const uint8_t * Index, Word_t len, Psclb_t Psclb)
+{
+    Word_t    minlen = (len < Psclb->sclb_Len) ? len : Psclb->sclb_Len;
+    int       cmp;
+
+    if ((cmp = memcmp(Index, Psclb->sclb_Index, minlen)) != 0)
+        return (cmp);
+
+    return ((len > Psclb->sclb_Len) - (len < Psclb->sclb_Len));
+}                                       // JudySLBCmp()
+
+// ****************************************************************************
+// J U D Y   S L B   G E T
 //
-// See header comments about premature return().
+// See JudySLGet().
+
+PPvoid_t
+JudySLBGet(Pcvoid_t PArray, const uint8_t * Index, Word_t Len,
+           PJError_t PJError)
+{
+    Word_t    indexword;                // next word to find.
+    PPvoid_t  PPValue;                  // from JudyL array.
+
+    if ((Index == (uint8_t *) NULL) && (Len != 0))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    while (1)                           // until return.
+    {
+        if (IS_PSCL(PArray))            // a shortcut leaf.
+        {
+            if (JudySLBCmp(Index, Len, CLEAR_PSCLB(PArray)))
+                return ((PPvoid_t) NULL);
+            return (&(CLEAR_PSCLB(PArray)->sclb_Pvalue));
+        }
+
+        indexword = JudySLBWord(Index, Len);
+
+        JLG(PPValue, PArray, indexword);
+
+        if ((PPValue == (PPvoid_t) NULL) || LASTWORD_BY_TAG(indexword))
+            return (PPValue);
+
+        Index += SLB_DATABYTES;
+        Len   -= SLB_DATABYTES;
+        PArray = *PPValue;              // each value -> next array.
+    }
+}                                       // JudySLBGet()
+
+// ****************************************************************************
+// J U D Y   S L B   I N S
 //
-// Note:  If JudyLIns() returns JU_ERRNO_NOTJUDYL here, *PPArray should not be
-// modified, so JudySLModifyErrno() can do the right thing.
+// See JudySLIns(), which this follows step for step.
+
+PPvoid_t
+JudySLBIns(PPvoid_t PPArray, const uint8_t * Index, Word_t Len,
+           PJError_t PJError)
+{
+    PPvoid_t  PPArrayOrig = PPArray;    // for error reporting.
+    const uint8_t *pos = Index;         // place in Index.
+    const uint8_t *pos2 = (uint8_t *) NULL;     // old Index (SCL being moved).
+    Word_t    len = Len;                // bytes remaining.
+    Word_t    len2 = 0;                 // for old Index (SCL being moved).
+    Word_t    scl2 = 0;                 // size in words of SCL
+    Word_t    indexword;                // next word to insert.
+    Word_t    indexword2;               // for old Index (SCL being moved).
+    PPvoid_t  PPValue;                  // from JudyL array.
+    PPvoid_t  PPValue2;                 // for old Index (SCL being moved).
+    Psclb_t   Pscl = (Psclb_t) NULL;    // shortcut leaf.
+    Psclb_t   Pscl2;                    // for old Index (SCL being moved).
+
+    if (PPArray == (PPvoid_t) NULL)
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
+        return (PPJERR);
+    }
+    if ((Index == (uint8_t *) NULL) && (Len != 0))
+    {
+        JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
+        return (PPJERR);
+    }
+
+    while (1)                           // until return.
+    {
+// APPEND SHORTCUT LEAF:
+
+        if (*PPArray == (Pvoid_t)NULL)
+        {
+            if (Pscl == (Psclb_t) NULL) // no SCL being carried down.
+            {
+                APPEND_SCLB(Pscl, PPArray, pos, len, PJError);
+                return (&(Pscl->sclb_Pvalue));
+            }
+        }
+
+// CARRY DOWN PRE-EXISTING SHORTCUT LEAF:
+
+        else if (IS_PSCL(*PPArray))
+        {
+            assert(Pscl == (Psclb_t) NULL);     // no nested SCLs.
+
+            Pscl = CLEAR_PSCLB(*PPArray);
+
+            if (JudySLBCmp(pos, len, Pscl) == 0)
+                return (&(Pscl->sclb_Pvalue));
+
+            pos2 = Pscl->sclb_Index;
+            len2 = Pscl->sclb_Len;
+            scl2 = SCLBSIZE(len2);      // save for JudyFree
+
+            *PPArray = (Pvoid_t)NULL;   // disconnect SCL.
+        }
+
+// CHECK IF OLD AND NEW INDEXES DIVERGE IN THE CURRENT INDEX WORD:
+
+        indexword = JudySLBWord(pos, len);
+
+        if (Pscl != (Psclb_t) NULL)
+        {
+            indexword2 = JudySLBWord(pos2, len2);
+
+            if (indexword != indexword2)        // SCL and new Indexes diverge.
+            {
+                if ((PPValue2 = JudyLIns(PPArray, indexword2, PJError))
+                    == PPJERR)
+                {
+                    JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
+                    return (PPJERR);
+                }
+
+                if (LASTWORD_BY_TAG(indexword2))
+                {
+                    *((PWord_t)PPValue2) = (Word_t)(Pscl->sclb_Pvalue);
+                }
+                else
+                {
+                    APPEND_SCLB(Pscl2, PPValue2, pos2 + SLB_DATABYTES,
+                                len2 - SLB_DATABYTES, PJError);
+                    (Pscl2->sclb_Pvalue) = Pscl->sclb_Pvalue;
+                }
+                JudyFree((void *)Pscl, scl2);
+
+                Pscl = (Psclb_t) NULL;
+            }
+        }
+
+// APPEND NEXT LEVEL JUDYL ARRAY TO TREE:
 
         if ((PPValue = JudyLIns(PPArray, indexword, PJError)) == PPJERR)
         {
@@ -524,136 +3869,72 @@ JudySLIns(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)
             return (PPJERR);
         }
 
-        assert(PPValue != (PPvoid_t) NULL);
-
-// CHECK IF NEW INDEX TERMINATES:
-//
-// Note that if it does, and an old SCL was being carried down, it must have
-// diverged by this point, and is already handled.
-
-        if (len <= WORDSIZE)
+        if (LASTWORD_BY_TAG(indexword))
         {
-            assert(Pscl == (Pscl_t) NULL);
-            return (PPValue);           // is value for whole Index string.
+            assert(Pscl == (Psclb_t) NULL);
+            return (PPValue);           // is value for whole Index.
         }
 
-        pos += WORDSIZE;
-        len -= WORDSIZE;
-        pos2 += WORDSIZE;               // useless unless Pscl is set.
-        len2 -= WORDSIZE;
+        pos += SLB_DATABYTES;
+        len -= SLB_DATABYTES;
+        pos2 += SLB_DATABYTES;          // useless unless Pscl is set.
+        len2 -= SLB_DATABYTES;
 
         PPArray = PPValue;              // each value -> next array.
-    }                                   // while.
-}                                       // NOTREACHED, JudySLIns()
+    }
+}                                       // JudySLBIns()
 
 // ****************************************************************************
-// J U D Y   S L   D E L
-//
-// See the comments in JudySLGet(), which is somewhat similar.
-//
-// Unlike JudySLGet() and JudySLIns(), recurse downward through the tree of
-// JudyL arrays to find and delete the given Index, if present, and then on the
-// way back up, any of its parent arrays which ends up empty.
-//
-// TECHNICAL NOTES:
-//
-// Recursion seems bad, but this allows for an arbitrary-length Index.  Also, a
-// more clever iterative solution that used JudyLCount() (see below) would
-// still require a function call per tree level, so why not just recurse?
-//
-// An earlier version (1.20) used a fixed-size stack, which limited the Index
-// size.  We were going to replace this with using JudyLCount(), in order to
-// note and return to (read this carefully) the highest level JudyL array with
-// a count of 1, all of whose descendant JudyL arrays also have a count of 1,
-// and delete from that point downwards.  This solution would traverse the
-// array tree downward looking to see if the given Index is in the tree, then
-// if so, delete layers downwards starting below the last one that contains
-// other Indexes than the one being deleted.
+// J U D Y   S L B   D E L
 //
-// TBD:  To save time coding, and to very likely save time overall during
-// execution, this function does "lazy deletions", or putting it more nicely,
-// it allows "hysteresis" in the JudySL tree, when shortcut leafs are present.
-// It only removes the specified Index, and recursively any empty JudyL arrays
-// above it, without fully reversing the effects of JudySLIns().  This is
-// probably OK because any application that calls JudySLDel() is likely to call
-// JudySLIns() again with the same or a neighbor Index.
+// See JudySLDel(); deletion is just as lazy.
 
 int
-JudySLDel(PPvoid_t PPArray, const uint8_t * Index, PJError_t PJError)   // optional, for returning error info.
+JudySLBDel(PPvoid_t PPArray, const uint8_t * Index, Word_t Len,
+           PJError_t PJError)
 {
-
-// Check for caller error (null pointer):
-
     if (PPArray == (PPvoid_t) NULL)
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
         return (JERR);
     }
-    if (Index == (uint8_t *) NULL)
+    if ((Index == (uint8_t *) NULL) && (Len != 0))
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
         return (JERR);
     }
 
-// Do the deletion:
-
-    return (JudySLDelSub(PPArray, PPArray, Index, STRLEN(Index), PJError));
-
-}                                       // JudySLDel()
+    return (JudySLBDelSub(PPArray, PPArray, Index, Len, PJError));
 
-// ****************************************************************************
-// J U D Y   S L   D E L   S U B
-//
-// This is the "engine" for JudySLDel() that expects aligned and len to already
-// be computed (only once).  See the header comments for JudySLDel().
+}                                       // JudySLBDel()
 
 static int
-JudySLDelSub(PPvoid_t PPArray,          // in which to delete.
-             PPvoid_t PPArrayOrig,      // for error reporting.
-             const uint8_t * Index,     // to delete.
-             Word_t len,                // bytes remaining.
-             PJError_t PJError)         // optional, for returning error info.
+JudySLBDelSub(PPvoid_t PPArray,         // in which to delete.
+              PPvoid_t PPArrayOrig,     // for error reporting.
+              const uint8_t * Index,    // to delete.
+              Word_t len,               // bytes remaining.
+              PJError_t PJError)        // optional, for returning error info.
 {
     Word_t    indexword;                // next word to find.
     PPvoid_t  PPValue;                  // from JudyL array.
     int       retcode;                  // from lower-level call.
 
-    assert(PPArray != (PPvoid_t) NULL);
-    assert(Index != (uint8_t *) NULL);
-
-// DELETE SHORTCUT LEAF:
-//
-// As described above, this can leave an empty JudyL array, or one containing
-// only a single other Index word -- which could be, but is not, condensed into
-// a higher-level shortcut leaf.  More precisely, at this level it leaves a
-// temporary "dead end" in the JudySL tree, similar to when running out of
-// memory during JudySLIns(), and this is somewhat cleaned up by higher
-// recursions of the same function (see below); but remaining shortcut leaves
-// for other Indexes are not coalesced.
-
     if (IS_PSCL(*PPArray))
     {
-        Pscl_t    Pscll = CLEAR_PSCL(*PPArray);
-        Word_t    words;
+        Psclb_t   Pscll = CLEAR_PSCLB(*PPArray);
 
-        if (STRCMP(Index, Pscll->scl_Index))
+        if (JudySLBCmp(Index, len, Pscll))
             return (0);                 // incorrect index.
 
-        words = SCLSIZE(STRLEN(Pscll->scl_Index));
-        JudyFree((void *)Pscll, words);
+        JudyFree((void *)Pscll, SCLBSIZE(Pscll->sclb_Len));
 
         *PPArray = (Pvoid_t)NULL;
         return (1);                     // correct index deleted.
     }
 
-// DELETE LAST INDEX WORD, FROM CURRENT JUDYL ARRAY:
-//
-// When at the end of the full Index, delete the last word, if present, from
-// the current JudyL array, and return the result all the way up.
-
-    COPYSTRINGtoWORD(indexword, Index); // copy next 4[8] bytes.
+    indexword = JudySLBWord(Index, len);
 
-    if (len <= WORDSIZE)
+    if (LASTWORD_BY_TAG(indexword))
     {
         if ((retcode = JudyLDel(PPArray, indexword, PJError)) == JERR)
         {
@@ -663,35 +3944,17 @@ JudySLDelSub(PPvoid_t PPArray,          // in which to delete.
         return (retcode);
     }
 
-// DELETE BELOW NON-LAST INDEX WORD IN CURRENT JUDYL ARRAY:
-//
-// If a word before the end of the full Index is present in the current JudyL
-// array, recurse through its value, which must be a pointer to another JudyL
-// array, to continue the deletion at the next level.  Return the JudyLGet()
-// return if the Indexs current word is not in the JudyL array, or if no
-// delete occurs below this level, both of which mean the whole Index is not
-// currently valid.
-//
-
     JLG(PPValue, *PPArray, indexword);
     if (PPValue == (PPvoid_t) NULL)
-        return (0);                     // Index not in JudySL array.
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25).
-    if ((retcode =
-         JudySLDelSub(PPValue, PPArrayOrig, Index + WORDSIZE,
-                      len - WORDSIZE, PJError)) != 1)
+        return (0);                     // Index not in JudySLB array.
+
+    if ((retcode = JudySLBDelSub(PPValue, PPArrayOrig, Index + SLB_DATABYTES,
+                                 len - SLB_DATABYTES, PJError)) != 1)
     {
         return (retcode);               // no lower-level delete, or error.
     }
 
 // DELETE EMPTY JUDYL ARRAY:
-//
-// A delete occurred below in the tree.  If the child JudyL array became empty,
-// delete the current Index word from the current JudyL array, which could
-// empty the current array and null out *PPArray in turn (or pass through an
-// error).  Otherwise simply indicate that a deletion did occur.
 
     if (*PPValue == (Pvoid_t)NULL)
     {
@@ -700,428 +3963,286 @@ JudySLDelSub(PPvoid_t PPArray,          // in which to delete.
             JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
             return (JERR);
         }
-
         return (retcode);
     }
 
     return (1);
-}                                       // JudySLDelSub()
+}                                       // JudySLBDelSub()
 
 // ****************************************************************************
-// J U D Y   S L   P R E V
-//
-// Recursively traverse the JudySL tree downward using JudyLGet() to look for
-// each successive index word from Index in the JudyL array at each level.  At
-// the last level for the Index (LASTWORD_BY_LEN()), use JudyLPrev() instead of
-// JudyLGet(), to exclude the initial Index.  If this doesnt result in finding
-// a previous Index, work back up the tree using JudyLPrev() at each higher
-// level to search for a previous index word.  Upon finding a previous index
-// word, descend again if/as necessary, this time inclusively, to find and
-// return the full previous Index.
-//
-// Also support shortcut leaves.
-//
-// Since this function is recursive and it also needs to know if its still
-// looking for the original Index (to exclude it at the LASTWORD_BY_LEN()
-// level) or for the remaining words of the previous Index (inclusive),
-// actually call a subroutine that takes an additional parameter.
+// J U D Y   S L B   P R E V
+// J U D Y   S L B   N E X T
 //
-// See also the technical notes in JudySLDel() regarding the use of recursion
-// rather than iteration.
+// See JudySLPrev() and JudySLNext().  On input, Index and *PLen give the
+// starting Index; on success they are replaced by the Index found, so Index
+// must have room for the longest Index in the array.  The Sub functions also
+// take done, the number of Index bytes already decoded above PArray, so they
+// can set *PLen.
 
 PPvoid_t
-JudySLPrev(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+JudySLBPrev(Pcvoid_t PArray, uint8_t * Index, PWord_t PLen, PJError_t PJError)
 {
-// Check for caller error (null pointer), or empty JudySL array:
-
-    if (Index == (uint8_t *) NULL)
+    if ((Index == (uint8_t *) NULL) || (PLen == (PWord_t) NULL))
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
-        return (PPJERR);
-    }
-
-    if (PArray == (Pvoid_t)NULL)
-        return ((PPvoid_t) NULL);
-// Do the search:
-    return (JudySLPrevSub(PArray, Index, /* original = */ 1,
-                          STRLEN(Index), PJError));
-}                                       // JudySLPrev()
-
-// ****************************************************************************
-// J U D Y   S L   P R E V   S U B
-//
-// This is the "engine" for JudySLPrev() that knows whether its still looking
-// for the original Index (exclusive) or a neighbor index (inclusive), and that
-// expects aligned and len to already be computed (only once).  See the header
-// comments for JudySLPrev().
+        return (PPJERR);
+    }
+    if (PArray == (Pvoid_t)NULL)
+        return ((PPvoid_t) NULL);
+
+    return (JudySLBPrevSub(PArray, Index, 0, *PLen, PLen,
+                           /* original = */ 1, PJError));
+}                                       // JudySLBPrev()
 
 static    PPvoid_t
-JudySLPrevSub(Pcvoid_t PArray, uint8_t * Index, int orig,
-              Word_t len,               // bytes remaining.
-              PJError_t PJError)        // optional, for returning error info.
+JudySLBPrevSub(Pcvoid_t PArray, uint8_t * Index,
+               Word_t done,             // bytes decoded above PArray.
+               Word_t len,              // bytes remaining.
+               PWord_t PLen,            // for the Index found.
+               int orig, PJError_t PJError)
 {
     Word_t    indexword;                // next word to find.
     PPvoid_t  PPValue;                  // from JudyL array.
-// ORIGINAL SEARCH:
-//
-// When at a shortcut leaf, copy its remaining Index (string) chars into Index
-// and return its value area if the current Index is after (greater than) the
-// SCLs index; otherwise return null.
-    if (orig)
+
+    if (IS_PSCL(PArray))                // at shortcut leaf.
     {
-        if (IS_PSCL(PArray))
-        {
-            if ((PPValue = PPSCLVALUE_GT(Index, PArray)) != (PPvoid_t) NULL)
-                (void)STRCPY(Index, PSCLINDEX(PArray));
-            return (PPValue);
-        }
+        Psclb_t   Psclb = CLEAR_PSCLB(PArray);
 
-// If the current Index word:
-// - is not the last word in Index (end of string),
-// - exists in the current JudyL array, and,
-// - a previous Index is found below it, return that Indexs value area.
+        if (orig && (JudySLBCmp(Index + done, len, Psclb) <= 0))
+            return ((PPvoid_t) NULL);
 
-        COPYSTRINGtoWORD(indexword, Index);     // copy next 4[8] bytes.
-        if (len > WORDSIZE)             // not at end of Index.
+        (void)memcpy(Index + done, Psclb->sclb_Index, Psclb->sclb_Len);
+        *PLen = done + Psclb->sclb_Len;
+        return (&(Psclb->sclb_Pvalue));
+    }
+
+    if (orig)
+    {
+        indexword = JudySLBWord(Index + done, len);
+
+        if (! LASTWORD_BY_TAG(indexword))
         {
             JLG(PPValue, PArray, indexword);
             if (PPValue != (PPvoid_t) NULL)
             {
-
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
-
-                PPValue = JudySLPrevSub(*PPValue, Index + WORDSIZE,
-                                        /* original = */ 1,
-                                        len - WORDSIZE, PJError);
-                if (PPValue == PPJERR)
-                    return (PPJERR);    // propagate error.
+                PPValue = JudySLBPrevSub(*PPValue, Index,
+                                         done + SLB_DATABYTES,
+                                         len - SLB_DATABYTES, PLen,
+                                         /* original = */ 1, PJError);
                 if (PPValue != (PPvoid_t) NULL)
-                    return (PPValue);   // see above.
+                    return (PPValue);   // found, or error.
             }
         }
 
-// Search for previous index word:
-//
-// One of the above conditions is false.  Search the current JudyL array for
-// the Index word, if any, prior to the current index word.  If none is found,
-// return null; otherwise fall through to common later code.
-
         if ((PPValue = JudyLPrev(PArray, &indexword, PJError)) == PPJERR)
         {
-            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            JudySLModifyErrno(PJError, PArray, done ? (Pvoid_t)NULL : PArray);
             return (PPJERR);
         }
-
-        if (PPValue == (PPvoid_t) NULL)
-            return ((PPvoid_t) NULL);   // no previous index word.
-    }                                   // if.
-
-// SUBSEQUENT SEARCH:
-//
-// A higher level search already excluded the initial Index, then found a
-// previous index word, and is now traversing down to determine the rest of the
-// Index and to obtain its value area.  If at a shortcut leaf, return its value
-// area.  Otherwise search the current JudyL array backward from the upper
-// limit for its last index word.  If no index word is found, return null --
-// should never happen unless the JudySL tree is corrupt; otherwise fall
-// through to common later code.
-
+    }
     else
     {
-        if (IS_PSCL(PArray))            // at shortcut leaf.
-        {
-            (void)STRCPY(Index, PSCLINDEX(PArray));
-            return (&PSCLVALUE(PArray));
-        }
-
         indexword = ~0UL;
         if ((PPValue = JudyLLast(PArray, &indexword, PJError)) == PPJERR)
         {
-            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            JudySLModifyErrno(PJError, PArray, (Pvoid_t)NULL);
             return (PPJERR);
         }
-
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
-
-        if (PPValue == (PPvoid_t) NULL)
-            return ((PPvoid_t) NULL);   // no previous index word.
     }
 
-// FOUND PREVIOUS INDEX WORD:
-//
-// A previous (if original) or last (if subsequent) index word was located in
-// the current JudyL array.  Store it into the callers Index (string).  Then
-// if the found (previous) Index ends here, return its value area; otherwise do
-// a subsequent search below this point, which should never fail unless the
-// JudySL tree is corrupt, but this is detected at a lower level by the above
-// assertion.
-//
-// Note:  Treat Index as unaligned, even if it is aligned, to avoid writing
-// past the end of allocated memory (in case its less than a whole number of
-// words).
+    if (PPValue == (PPvoid_t) NULL)
+        return ((PPvoid_t) NULL);       // no previous index word.
 
-    COPYWORDtoSTRING(Index, indexword); // copy next 4[8] bytes.
-    if (LASTWORD_BY_VALUE(indexword))
-        return (PPValue);
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
-    return (JudySLPrevSub(*PPValue, Index + WORDSIZE, /* original = */ 0,
-                          len - WORDSIZE, PJError));
-}                                       // JudySLPrevSub()
+    done += JudySLBCopy(Index + done, indexword);
 
-// ****************************************************************************
-// J U D Y   S L   N E X T
-//
-// See the comments in JudySLPrev(), which is very similar.
-//
-// TBD:  Could the two functions call a common engine function with various
-// subfunctions and other constants specified?
+    if (LASTWORD_BY_TAG(indexword))
+    {
+        *PLen = done;
+        return (PPValue);
+    }
+    return (JudySLBPrevSub(*PPValue, Index, done, 0, PLen,
+                           /* original = */ 0, PJError));
+}                                       // JudySLBPrevSub()
 
 PPvoid_t
-JudySLNext(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+JudySLBNext(Pcvoid_t PArray, uint8_t * Index, PWord_t PLen, PJError_t PJError)
 {
-// Check for caller error (null pointer), or empty JudySL array:
-
-    if (Index == (uint8_t *) NULL)
+    if ((Index == (uint8_t *) NULL) || (PLen == (PWord_t) NULL))
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
         return (PPJERR);
     }
-
     if (PArray == (Pvoid_t)NULL)
         return ((PPvoid_t) NULL);
-// Do the search:
-    return (JudySLNextSub(PArray, Index, /* original = */ 1,
-                          STRLEN(Index), PJError));
-}                                       // JudySLNext()
 
-// ****************************************************************************
-// J U D Y   S L   N E X T   S U B
-//
-// See the comments in JudySLPrevSub(), which is very similar.
+    return (JudySLBNextSub(PArray, Index, 0, *PLen, PLen,
+                           /* original = */ 1, PJError));
+}                                       // JudySLBNext()
 
 static    PPvoid_t
-JudySLNextSub(Pcvoid_t PArray, uint8_t * Index, int orig,
-              Word_t len,               // bytes remaining.
-              PJError_t PJError)        // optional, for returning error info.
+JudySLBNextSub(Pcvoid_t PArray, uint8_t * Index,
+               Word_t done,             // bytes decoded above PArray.
+               Word_t len,              // bytes remaining.
+               PWord_t PLen,            // for the Index found.
+               int orig, PJError_t PJError)
 {
     Word_t    indexword;                // next word to find.
     PPvoid_t  PPValue;                  // from JudyL array.
-    if (orig)
+
+    if (IS_PSCL(PArray))                // at shortcut leaf.
     {
-        if (IS_PSCL(PArray))
-        {
-            if ((PPValue = PPSCLVALUE_LT(Index, PArray)) != (PPvoid_t) NULL)
-                (void)STRCPY(Index, PSCLINDEX(PArray));
-            return (PPValue);
-        }
+        Psclb_t   Psclb = CLEAR_PSCLB(PArray);
 
-        COPYSTRINGtoWORD(indexword, Index);     // copy next 4[8] bytes.
+        if (orig && (JudySLBCmp(Index + done, len, Psclb) >= 0))
+            return ((PPvoid_t) NULL);
 
-        if (len > WORDSIZE)             // not at end of Index.
+        (void)memcpy(Index + done, Psclb->sclb_Index, Psclb->sclb_Len);
+        *PLen = done + Psclb->sclb_Len;
+        return (&(Psclb->sclb_Pvalue));
+    }
+
+    if (orig)
+    {
+        indexword = JudySLBWord(Index + done, len);
+
+        if (! LASTWORD_BY_TAG(indexword))
         {
             JLG(PPValue, PArray, indexword);
             if (PPValue != (PPvoid_t) NULL)
             {
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
-
-                PPValue = JudySLNextSub(*PPValue, Index + WORDSIZE,
-                                        /* original = */ 1,
-                                        len - WORDSIZE, PJError);
-                if (PPValue == PPJERR)
-                    return (PPJERR);    // propagate error.
+                PPValue = JudySLBNextSub(*PPValue, Index,
+                                         done + SLB_DATABYTES,
+                                         len - SLB_DATABYTES, PLen,
+                                         /* original = */ 1, PJError);
                 if (PPValue != (PPvoid_t) NULL)
-                    return (PPValue);   // see above.
+                    return (PPValue);   // found, or error.
             }
         }
 
         if ((PPValue = JudyLNext(PArray, &indexword, PJError)) == PPJERR)
         {
-            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            JudySLModifyErrno(PJError, PArray, done ? (Pvoid_t)NULL : PArray);
             return (PPJERR);
         }
-
-        if (PPValue == (PPvoid_t) NULL)
-            return ((PPvoid_t) NULL);   // no next index word.
     }
     else
     {
-        if (IS_PSCL(PArray))            // at shortcut leaf.
-        {
-            (void)STRCPY(Index, PSCLINDEX(PArray));
-            return (&PSCLVALUE(PArray));
-        }
-
         indexword = 0;
         if ((PPValue = JudyLFirst(PArray, &indexword, PJError)) == PPJERR)
         {
-            JudySLModifyErrno(PJError, PArray, orig ? PArray : (Pvoid_t)NULL);
+            JudySLModifyErrno(PJError, PArray, (Pvoid_t)NULL);
             return (PPJERR);
         }
+    }
 
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
+    if (PPValue == (PPvoid_t) NULL)
+        return ((PPvoid_t) NULL);       // no next index word.
 
-        if (PPValue == (PPvoid_t) NULL)
-            return ((PPvoid_t) NULL);   // no next index word.
-    }
+    done += JudySLBCopy(Index + done, indexword);
 
-    COPYWORDtoSTRING(Index, indexword); // copy next 4[8] bytes
-    if (LASTWORD_BY_VALUE(indexword))
+    if (LASTWORD_BY_TAG(indexword))
+    {
+        *PLen = done;
         return (PPValue);
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue; this is automatically treated as a dead-end (not a core dump
-// or assertion; see version 1.25):
-    return (JudySLNextSub(*PPValue, Index + WORDSIZE, /* original = */ 0,
-                          len - WORDSIZE, PJError));
-}                                       // JudySLNextSub()
+    }
+    return (JudySLBNextSub(*PPValue, Index, done, 0, PLen,
+                           /* original = */ 0, PJError));
+}                                       // JudySLBNextSub()
 
 // ****************************************************************************
-// J U D Y   S L   F I R S T
+// J U D Y   S L B   F I R S T
+// J U D Y   S L B   L A S T
 //
-// Like JudyLFirst(), do a JudySLGet(), then if necessary a JudySLNext().
+// Like JudySLFirst() and JudySLLast().
 
 PPvoid_t
-JudySLFirst(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError)        // optional, for returning error info.
+JudySLBFirst(Pcvoid_t PArray, uint8_t * Index, PWord_t PLen, PJError_t PJError)
 {
     PPvoid_t  PPValue;                  // from JudyL array.
-    if (Index == (uint8_t *) NULL)
+
+    if ((Index == (uint8_t *) NULL) || (PLen == (PWord_t) NULL))
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
         return (PPJERR);
     }
-
-    if ((PPValue = JudySLGet(PArray, Index, PJError)) == PPJERR)
-        return (PPJERR);                // propagate serious error.
-    if ((PPValue == (PPvoid_t) NULL)    // first try failed.
-        && ((PPValue = JudySLNext(PArray, Index, PJError)) == PPJERR))
-    {
+    if ((PPValue = JudySLBGet(PArray, Index, *PLen, PJError)) == PPJERR)
         return (PPJERR);                // propagate serious error.
-    }
+    if (PPValue == (PPvoid_t) NULL)     // first try failed.
+        PPValue = JudySLBNext(PArray, Index, PLen, PJError);
 
     return (PPValue);
-}                                       // JudySLFirst()
-
-// ****************************************************************************
-// J U D Y   S L   L A S T
-//
-// Like JudyLLast(), do a JudySLGet(), then if necessary a JudySLPrev().
+}                                       // JudySLBFirst()
 
 PPvoid_t
-JudySLLast(Pcvoid_t PArray, uint8_t * Index, PJError_t PJError) // optional, for returning error info.
+JudySLBLast(Pcvoid_t PArray, uint8_t * Index, PWord_t PLen, PJError_t PJError)
 {
     PPvoid_t  PPValue;                  // from JudyL array.
-    if (Index == (uint8_t *) NULL)
+
+    if ((Index == (uint8_t *) NULL) || (PLen == (PWord_t) NULL))
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPINDEX);
         return (PPJERR);
     }
-
-    if ((PPValue = JudySLGet(PArray, Index, PJError)) == PPJERR)
-        return (PPJERR);                // propagate serious error.
-    if ((PPValue == (PPvoid_t) NULL)    // first try failed.
-        && ((PPValue = JudySLPrev(PArray, Index, PJError)) == PPJERR))
-    {
+    if ((PPValue = JudySLBGet(PArray, Index, *PLen, PJError)) == PPJERR)
         return (PPJERR);                // propagate serious error.
-    }
+    if (PPValue == (PPvoid_t) NULL)     // first try failed.
+        PPValue = JudySLBPrev(PArray, Index, PLen, PJError);
 
     return (PPValue);
-}                                       // JudySLLast()
+}                                       // JudySLBLast()
 
 // ****************************************************************************
-// J U D Y   S L   F R E E   A R R A Y
-//
-// Walk the JudySL tree of JudyL arrays to free each JudyL array, depth-first.
-// During the walk, ignore indexes (strings) that end in the current JudyL
-// array to be freed.  Just recurse through those indexes which do not end,
-// that is, those whose associated value areas point to subsidiary JudyL
-// arrays, except for those which point to shortcut leaves.  Return the total
-// bytes freed in all of the JudyL arrays at or below the current level.
+// J U D Y   S L B   F R E E   A R R A Y
 //
-// Like the JudyLFreeArray() and Judy1FreeArray() code, this is written
-// recursively, which is probably fast enough, to allow indexes (strings) of
-// arbitrary size.  If recursion turns out to be a problem, consider instead
-// doing some large, fixed number of iterative descents (like 100) using a
-// fixed-size "stack" (array), then recursing upon overflow (relatively
-// rarely).
+// See JudySLFreeArray().
 
 Word_t
-JudySLFreeArray(PPvoid_t PPArray, PJError_t PJError)    // optional, for returning error info.
+JudySLBFreeArray(PPvoid_t PPArray, PJError_t PJError)
 {
     PPvoid_t  PPArrayOrig = PPArray;    // for error reporting.
     Word_t    indexword = 0;            // word just found.
     PPvoid_t  PPValue;                  // from Judy array.
     Word_t    bytes_freed = 0;          // bytes freed at this level.
     Word_t    bytes_total = 0;          // bytes freed at all levels.
+
     if (PPArray == (PPvoid_t) NULL)
     {
         JU_SET_ERRNO(PJError, JU_ERRNO_NULLPPARRAY);
         return (JERR);
     }
 
-// FREE SHORTCUT LEAF:
-
     if (IS_PSCL(*PPArray))
     {
-        Word_t    freewords;
-        Pscl_t    Pscl;
-
-        Pscl = CLEAR_PSCL(*PPArray);
-
-        freewords = SCLSIZE(STRLEN(Pscl->scl_Index));
-
-        JudyFree((void *)Pscl, freewords);
+        Psclb_t   Psclb = CLEAR_PSCLB(*PPArray);
+        Word_t    freewords = SCLBSIZE(Psclb->sclb_Len);
 
+        JudyFree((void *)Psclb, freewords);
         *PPArray = (Pvoid_t)NULL;
-
         return (freewords * WORDSIZE);
     }
 
-// FREE EACH SUB-ARRAY (DEPTH-FIRST):
-//
-// If a previous JudySLIns() ran out of memory partway down the tree, it left a
-// null *PPValue.  This is automatically treated correctly here as a dead-end.
-//
-// An Index (string) ends in the current word iff the last byte of the
-// (null-padded) word is null.
-
     for (PPValue = JudyLFirst(*PPArray, &indexword, PJError);
          (PPValue != (PPvoid_t) NULL) && (PPValue != PPJERR);
          PPValue = JudyLNext(*PPArray, &indexword, PJError))
     {
-        if (!LASTWORD_BY_VALUE(indexword))
+        if (! LASTWORD_BY_TAG(indexword))
         {
-            if ((bytes_freed = JudySLFreeArray(PPValue, PJError)) == JERR)
+            if ((bytes_freed = JudySLBFreeArray(PPValue, PJError)) == JERR)
                 return (JERR);          // propagate serious error.
             bytes_total += bytes_freed;
         }
     }
 
-// Check for a serious error in a JudyL*() call:
-
     if (PPValue == PPJERR)
     {
         JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
         return (JERR);
     }
 
-// Now free the current array, which also nulls the pointer:
-//
-// Note:  *PPArray can be null here for a totally null JudySL array =>
-// JudyLFreeArray() returns zero.
-
     if ((bytes_freed = JudyLFreeArray(PPArray, PJError)) == JERR)
     {
         JudySLModifyErrno(PJError, *PPArray, *PPArrayOrig);
         return (JERR);
     }
     return (bytes_total + bytes_freed);
-}                                       // JudySLFreeArray()
+}                                       // JudySLBFreeArray()
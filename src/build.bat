@@ -23,12 +23,16 @@ copy JudyCommon\JudyFirst.c        	Judy1\Judy1First.c
 copy JudyCommon\JudyFreeArray.c    	Judy1\Judy1FreeArray.c
 copy JudyCommon\JudyGet.c          	Judy1\Judy1Test.c
 copy JudyCommon\JudyGet.c          	Judy1\j__udy1Test.c
+copy JudyCommon\JudyGet.c          	Judy1\Judy1TestF.c
 copy JudyCommon\JudyInsArray.c     	Judy1\Judy1SetArray.c
 copy JudyCommon\JudyIns.c          	Judy1\Judy1Set.c
 copy JudyCommon\JudyInsertBranch.c 	Judy1\Judy1InsertBranch.c
 copy JudyCommon\JudyMallocIF.c     	Judy1\Judy1MallocIF.c
 copy JudyCommon\JudyMemActive.c    	Judy1\Judy1MemActive.c
 copy JudyCommon\JudyMemUsed.c      	Judy1\Judy1MemUsed.c
+copy JudyCommon\JudyFinger.c       	Judy1\Judy1Finger.c
+copy JudyCommon\JudyInspect.c      	Judy1\Judy1Inspect.c
+copy JudyCommon\JudyValidate.c     	Judy1\Judy1Validate.c
 copy JudyCommon\JudyPrevNext.c     	Judy1\Judy1Next.c
 copy JudyCommon\JudyPrevNext.c     	Judy1\Judy1Prev.c
 copy JudyCommon\JudyPrevNextEmpty.c	Judy1\Judy1NextEmpty.c
@@ -46,12 +50,16 @@ copy JudyCommon\JudyFirst.c        	JudyL\JudyLFirst.c
 copy JudyCommon\JudyFreeArray.c    	JudyL\JudyLFreeArray.c
 copy JudyCommon\JudyGet.c          	JudyL\JudyLGet.c
 copy JudyCommon\JudyGet.c          	JudyL\j__udyLGet.c
+copy JudyCommon\JudyGet.c          	JudyL\JudyLGetF.c
 copy JudyCommon\JudyInsArray.c     	JudyL\JudyLInsArray.c
 copy JudyCommon\JudyIns.c          	JudyL\JudyLIns.c
 copy JudyCommon\JudyInsertBranch.c 	JudyL\JudyLInsertBranch.c
 copy JudyCommon\JudyMallocIF.c     	JudyL\JudyLMallocIF.c
 copy JudyCommon\JudyMemActive.c    	JudyL\JudyLMemActive.c
 copy JudyCommon\JudyMemUsed.c      	JudyL\JudyLMemUsed.c
+copy JudyCommon\JudyFinger.c       	JudyL\JudyLFinger.c
+copy JudyCommon\JudyInspect.c      	JudyL\JudyLInspect.c
+copy JudyCommon\JudyValidate.c     	JudyL\JudyLValidate.c
 copy JudyCommon\JudyPrevNext.c     	JudyL\JudyLNext.c
 copy JudyCommon\JudyPrevNext.c     	JudyL\JudyLPrev.c
 copy JudyCommon\JudyPrevNextEmpty.c	JudyL\JudyLNextEmpty.c
@@ -62,6 +70,8 @@ copy JudyCommon\JudyTables.c	        JudyL\JudyLTablesGen.c
 echo Compile JudyCommon\JudyMalloc - common to Judy1 and JudyL
 cd JudyCommon
 %CC% -I. -I.. -DJU_WIN -c JudyMalloc.c
+%CC% -I. -I.. -DJU_WIN -c JudyStats.c
+%CC% -I. -I.. -DJU_WIN -c JudyTune.c
 
 cd ..
 
@@ -77,6 +87,8 @@ echo %CC% %INC% %COPT% %O% -c Judy1Test.c
 %CC% %INC% %COPT% %O% -c Judy1Test.c
 echo %CC% %INC% %COPT% %O% -c -DJUDYGETINLINE j__udy1Test.c
 %CC% %INC% %COPT% %O% -c -DJUDYGETINLINE j__udy1Test.c
+echo %CC% %INC% %COPT% %O% -c -DJUDYGETFINGER Judy1TestF.c
+%CC% %INC% %COPT% %O% -c -DJUDYGETFINGER Judy1TestF.c
 echo %CC% %INC% %COPT% %O% -c Judy1Set.c
 %CC% %INC% %COPT% %O% -c Judy1Set.c
 echo %CC% %INC% %COPT% %O% -c Judy1SetArray.c
@@ -101,6 +113,12 @@ echo %CC% %INC% %COPT% %O% -c Judy1FreeArray.c
 %CC% %INC% %COPT% %O% -c Judy1FreeArray.c
 echo %CC% %INC% %COPT% %O% -c Judy1MemUsed.c
 %CC% %INC% %COPT% %O% -c Judy1MemUsed.c
+echo %CC% %INC% %COPT% %O% -c Judy1Finger.c
+%CC% %INC% %COPT% %O% -c Judy1Finger.c
+echo %CC% %INC% %COPT% %O% -c Judy1Inspect.c
+%CC% %INC% %COPT% %O% -c Judy1Inspect.c
+echo %CC% %INC% %COPT% %O% -c Judy1Validate.c
+%CC% %INC% %COPT% %O% -c Judy1Validate.c
 echo %CC% %INC% %COPT% %O% -c Judy1MemActive.c
 %CC% %INC% %COPT% %O% -c Judy1MemActive.c
 echo %CC% %INC% %COPT% %O% -c Judy1Cascade.c
@@ -128,6 +146,8 @@ echo %CC% %INC% %COPT% %L% -c JudyLGet.c
 %CC% %INC% %COPT% %L% -c JudyLGet.c
 echo %CC% %INC% %COPT% %L% -c -DJUDYGETINLINE j__udyLGet.c
 %CC% %INC% %COPT% %L% -c -DJUDYGETINLINE j__udyLGet.c
+echo %CC% %INC% %COPT% %L% -c -DJUDYGETFINGER JudyLGetF.c
+%CC% %INC% %COPT% %L% -c -DJUDYGETFINGER JudyLGetF.c
 echo %CC% %INC% %COPT% %L% -c JudyLIns.c
 %CC% %INC% %COPT% %L% -c JudyLIns.c
 echo %CC% %INC% %COPT% %L% -c JudyLInsArray.c
@@ -152,6 +172,12 @@ echo %CC% %INC% %COPT% %L% -c JudyLFreeArray.c
 %CC% %INC% %COPT% %L% -c JudyLFreeArray.c
 echo %CC% %INC% %COPT% %L% -c JudyLMemUsed.c
 %CC% %INC% %COPT% %L% -c JudyLMemUsed.c
+echo %CC% %INC% %COPT% %L% -c JudyLFinger.c
+%CC% %INC% %COPT% %L% -c JudyLFinger.c
+echo %CC% %INC% %COPT% %L% -c JudyLInspect.c
+%CC% %INC% %COPT% %L% -c JudyLInspect.c
+echo %CC% %INC% %COPT% %L% -c JudyLValidate.c
+%CC% %INC% %COPT% %L% -c JudyLValidate.c
 echo %CC% %INC% %COPT% %L% -c JudyLMemActive.c
 %CC% %INC% %COPT% %L% -c JudyLMemActive.c
 echo %CC% %INC% %COPT% %L% -c JudyLCascade.c
@@ -7,6 +7,7 @@
 #include <unistd.h>		// getopt()
 #include <math.h>               // pow()
 #include <stdio.h>		// printf()
+#include <string.h>		// strcmp()
 
 #include <Judy.h>
 
@@ -46,6 +47,12 @@ int TestJudyCount(void *J1, void *JL, Word_t LowIndex, Word_t Elements);
 
 Word_t TestJudyNext(void *J1, void *JL, Word_t LowIndex, Word_t Elements);
 
+int TestJudyFinger(void **J1, void **JL, Word_t Seed, Word_t Elements);
+
+int TestJudyInspect(void *J1, void *JL);
+
+int TestJudyValidate(void *J1, void *JL);
+
 int TestJudyPrev(void *J1, void *JL, Word_t HighIndex, Word_t Elements);
 
 int
@@ -150,6 +157,7 @@ Word_t pFlag = 0;
 Word_t CFlag = 0;
 Word_t DFlag = 0;
 Word_t SkipN = 0;		// default == Random skip
+char  *Profile = "default";	// branch conversion (see JudyTuneSet())
 Word_t nElms = 1000000;	// Default = 1M
 Word_t ErrorFlag = 0;
 Word_t TotalIns = 0;
@@ -215,6 +223,7 @@ main(int argc, char *argv[])
     Word_t PtsPdec = 10;	// points per decade
     Word_t Groups;		// Number of measurement groups
     Word_t grp;
+    JTune_t Tune;
 
     int    c;
     extern char *optarg;
@@ -223,7 +232,7 @@ main(int argc, char *argv[])
 // PARSE INPUT PARAMETERS
 //////////////////////////////////////////////////////////////
 
-    while ((c = getopt(argc, argv, "n:S:P:b:L:B:pdDC")) != -1)
+    while ((c = getopt(argc, argv, "n:S:P:b:L:B:T:pdDC")) != -1)
     {
 	switch (c)
 	{
@@ -278,15 +287,32 @@ main(int argc, char *argv[])
 	    CFlag = 1;
 	    break;
 
+	case 'T':		// Branch conversion profile
+	    Profile = optarg;
+	    break;
+
 	default:
 	    ErrorFlag++;
 	    break;
 	}
     }
 
+//  Convert branches as the profile says
+
+    if      (strcmp(Profile, "default") == 0) JudyTuneProfile(JT_DEFAULT,&Tune);
+    else if (strcmp(Profile, "speed")   == 0) JudyTuneProfile(JT_SPEED,  &Tune);
+    else if (strcmp(Profile, "compact") == 0) JudyTuneProfile(JT_COMPACT,&Tune);
+    else
+    {
+	ErrorFlag++;
+	printf("\nIllegal branch conversion profile of %s !!!\n", Profile);
+	JudyTuneProfile(JT_DEFAULT, &Tune);
+    }
+    JudyTuneSet(&Tune);
+
     if (ErrorFlag)
     {
-	printf("\n%s -n# -S# -B# -P# -b # -DRCpd\n\n", argv[0]);
+	printf("\n%s -n# -S# -B# -P# -b # -T<profile> -DRCpd\n\n", argv[0]);
 	printf("Where:\n");
 	printf("-n <#>  number of indexes used in tests\n");
 	printf("-C      skip JudyCount tests\n");
@@ -296,6 +322,7 @@ main(int argc, char *argv[])
 	printf("-S <#>  index skip amount, 0 = random\n");
 	printf("-B <#>  # bits-1 in random number generator\n");
 	printf("-P <#>  number measurement points per decade\n");
+	printf("-T <..> branch conversion profile: default, speed or compact\n");
 	printf("\n");
 
 	exit(1);
@@ -320,6 +347,8 @@ main(int argc, char *argv[])
 	printf(" -p");
     if (CFlag)
 	printf(" -C");
+    if (strcmp(Profile, "default"))
+	printf(" -T%s", Profile);
     printf("\n\n");
 
     if (sizeof(Word_t) == 8)
@@ -383,6 +412,10 @@ main(int argc, char *argv[])
 }
 #endif // testLFSR
 
+//  Count what the Judy code does, to check the statistics counters too:
+    JudyStatsEnable(1);
+    JudyStatsReset();
+
     for (grp = 0; grp < Groups; grp++)
     {
 	Word_t LowIndex, HighIndex;
@@ -411,6 +444,9 @@ main(int argc, char *argv[])
 //      Test JLP, J1P
 	TestJudyPrev(J1, JL, ~0UL, TotalPop);
 
+//      Test JLGF, J1TF, JLNF, J1NF, JLIF, J1SF
+	TestJudyFinger(&J1, &JL, Seed, Delta);
+
 //      Test JLNE, J1NE
 	TestJudyNextEmpty(J1, JL, LowIndex, Delta);
 
@@ -423,6 +459,12 @@ main(int argc, char *argv[])
 	    TestJudyDel(&J1, &JL, &JH, Seed, Delta);
 	}
 
+//      Test J1I, JLI (Inspect)
+	TestJudyInspect(J1, JL);
+
+//      Test J1V, JLV (Validate)
+	TestJudyValidate(J1, JL);
+
 	printf("%9lu %9lu %7lu %9lu", TotalPop, TotalIns, Delta, TotalDel);
 	{
 	    Word_t Count1, CountL;
@@ -451,6 +493,34 @@ main(int argc, char *argv[])
 	if (Count1 != TotalPop)
 	    FAILURE("Judy1Count wrong", Count1);
 
+//	Every insert of a new Index either fills a leaf in place or copies it,
+//	and enough of them must have cascaded leaves and visited JPs:
+	{
+	    JStats_t Stats;
+	    Word_t   level, kind, visits = 0;
+
+	    JudyStatsGet(&Stats);
+
+	    for (level = 0; level < JS_LEVELS; level++)
+		for (kind = 0; kind < JS_KINDS; kind++)
+		    visits += Stats.js_Visits[level][kind];
+
+	    if (pFlag)
+	    {
+		printf("Stats: visits = %lu, cachelines = %lu, cascades = %lu, "
+		       "decascades = %lu, BtoU = %lu, inplace = %lu, realloc = %lu\n",
+		       visits, Stats.js_CacheLines, Stats.js_Cascades,
+		       Stats.js_Decascades, Stats.js_BranchBToU,
+		       Stats.js_LeafGrowInPlace, Stats.js_LeafRealloc);
+	    }
+	    if (visits < TotalIns)
+		FAILURE("JudyStatsGet too few JP visits", visits);
+	    if ((TotalIns > 1000) && (Stats.js_Cascades == 0))
+		FAILURE("JudyStatsGet no cascades, inserts =", TotalIns);
+	    if ((Stats.js_LeafGrowInPlace + Stats.js_LeafRealloc) == 0)
+		FAILURE("JudyStatsGet no leaf inserts, inserts =", TotalIns);
+	}
+
 	if (TotalPop)
 	{
 	    J1FA(Bytes, J1);	// Free the Judy1 Array
@@ -772,6 +842,187 @@ Word_t TestJudyNext(void *J1, void *JL, Word_t LowIndex, Word_t Elements)
 }
 
 
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyFinger"
+
+// The fingers are static so they outlive each group of inserts and deletes,
+// which must make them stale but never wrong.
+
+static JFinger_t J1Finger, JLFinger;
+
+int
+TestJudyFinger(void **J1, void **JL, Word_t Seed, Word_t Elements)
+{
+    Word_t JLindex, J1index, JFLindex, JF1index;
+    Word_t TstIndex;
+    Word_t *PValue, *PValueF;
+    Word_t elm;
+    Word_t Seed1;
+    int Rcode, RcodeF;
+
+//  A full scan with the fingers must match a plain scan:
+
+    J1index = JLindex = JF1index = JFLindex = 0;
+
+    JLF(PValue, *JL, JLindex);
+    J1F(Rcode, *J1, J1index);
+
+    PValueF = (PWord_t)JudyLGetF(*JL, JFLindex, &JLFinger, PJE0);
+    if (PValueF == (PWord_t)NULL)
+        PValueF = (PWord_t)JudyLNextF(*JL, &JFLindex, &JLFinger, PJE0);
+
+    RcodeF = Judy1TestF(*J1, JF1index, &J1Finger, PJE0);
+    if (RcodeF == 0)
+        RcodeF = Judy1NextF(*J1, &JF1index, &J1Finger, PJE0);
+
+    for (elm = 0; elm < TotalPop; elm++)
+    {
+	if (PValueF != PValue)
+	    FAILURE("JudyLNextF ret different PValue at", elm);
+	if (RcodeF != Rcode)
+	    FAILURE("Judy1NextF ret different Rcode at", elm);
+	if (JFLindex != JLindex)
+	    FAILURE("JudyLNextF ret different PIndex at", elm);
+	if (JF1index != J1index)
+	    FAILURE("Judy1NextF ret different PIndex at", elm);
+
+	JLN(PValue, *JL, JLindex);
+	J1N(Rcode, *J1, J1index);
+	PValueF = (PWord_t)JudyLNextF(*JL, &JFLindex, &JLFinger, PJE0);
+	RcodeF  = Judy1NextF(*J1, &JF1index, &J1Finger, PJE0);
+    }
+    if ((PValueF != NULL) || (RcodeF != 0))
+        FAILURE("Judy*NextF did not end at population", TotalPop);
+
+//  Lookups, and inserts of Indexes that are already present, of this
+//  groups Indexes and their neighbors must match the plain functions:
+
+    for (Seed1 = Seed, elm = 0; elm < Elements; elm++)
+    {
+	Seed1 = GetNextIndex(Seed1);
+
+	if (DFlag)
+	    TstIndex = Swizzle(Seed1);
+	else
+	    TstIndex = Seed1;
+
+	if (Judy1TestF(*J1, TstIndex, &J1Finger, PJE0) != 1)
+	    FAILURE("Judy1TestF failed - Index missing at", elm);
+	if (Judy1SetF(J1, TstIndex, &J1Finger, PJE0) != 0)
+	    FAILURE("Judy1SetF failed - DUP Index at", elm);
+
+	JLG(PValue, *JL, TstIndex);
+	if ((PWord_t)JudyLGetF(*JL, TstIndex, &JLFinger, PJE0) != PValue)
+	    FAILURE("JudyLGetF ret different PValue at", elm);
+	if ((PWord_t)JudyLInsF(JL, TstIndex, &JLFinger, PJE0) != PValue)
+	    FAILURE("JudyLInsF ret different PValue at", elm);
+
+	J1T(Rcode, *J1, TstIndex + 1);
+	if (Judy1TestF(*J1, TstIndex + 1, &J1Finger, PJE0) != Rcode)
+	    FAILURE("Judy1TestF ret different Rcode at", elm);
+
+	JLG(PValue, *JL, TstIndex + 1);
+	if ((PWord_t)JudyLGetF(*JL, TstIndex + 1, &JLFinger, PJE0) != PValue)
+	    FAILURE("JudyLGetF ret different PValue at", elm);
+    }
+    return(0);
+}
+
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyInspect"
+
+// The structure report must account for every Index and every byte:
+
+static void
+CheckInspect(JInspect_t * PInspect, Word_t Bytes, Word_t Count, Word_t MemUsed)
+{
+    Word_t level, pop, pop1 = 0;
+
+    if (Bytes != PInspect->ji_TotalBytes)
+	FAILURE("Inspect return != ji_TotalBytes, bytes =", Bytes);
+    if (PInspect->ji_Population != Count)
+	FAILURE("Inspect population != Count, population =",
+		PInspect->ji_Population);
+    if (PInspect->ji_JPMBytes && (Bytes != MemUsed))
+	FAILURE("Inspect bytes != MemUsed, bytes =", Bytes);
+
+    for (level = 0; level < JI_LEVELS; level++)
+    {
+	pop1 += PInspect->ji_Leaf[level].jin_Pop1;
+	for (pop = 0; pop < JI_MAXIMMED; pop++)
+	{
+	    if (PInspect->ji_Immed[level][pop].jin_Pop1
+	     != PInspect->ji_Immed[level][pop].jin_Count * pop)
+		FAILURE("Inspect bad immediate count, level =", level);
+	    pop1 += PInspect->ji_Immed[level][pop].jin_Pop1;
+	}
+	if (PInspect->ji_Leaf[level].jin_Pop1
+	  > PInspect->ji_Leaf[level].jin_Slots)
+	    FAILURE("Inspect leaf overfull, level =", level);
+    }
+    pop1 += PInspect->ji_LeafB1.jin_Pop1 + PInspect->ji_FullPopu1.jin_Pop1;
+
+    if (pop1 != Count)
+	FAILURE("Inspect sum of node populations != Count, sum =", pop1);
+    if (Count && (PInspect->ji_MaxDepth == 0) && PInspect->ji_JPMBytes)
+	FAILURE("Inspect max depth = 0, Count =", Count);
+}
+
+int
+TestJudyInspect(void *J1, void *JL)
+{
+    JInspect_t Inspect;
+    Word_t Bytes, Count;
+
+    J1C(Count, J1, 0, ~0);
+    Bytes = Judy1Inspect(J1, &Inspect, PJE0);
+    if (Bytes == JERR)
+	FAILURE("Judy1Inspect failed, Count =", Count);
+    CheckInspect(&Inspect, Bytes, Count, Judy1MemUsed(J1));
+
+    JLC(Count, JL, 0, ~0);
+    Bytes = JudyLInspect(JL, &Inspect, PJE0);
+    if (Bytes == JERR)
+	FAILURE("JudyLInspect failed, Count =", Count);
+    CheckInspect(&Inspect, Bytes, Count, JudyLMemUsed(JL));
+
+    if (JudyLInspect(JL, (PJInspect_t) NULL, PJE0) != JERR)
+	FAILURE("JudyLInspect accepted a null PInspect, Count =", Count);
+
+    return(0);
+}
+
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyValidate"
+
+// Every array built by the API must pass its own structural self-check:
+
+int
+TestJudyValidate(void *J1, void *JL)
+{
+    JValidate_t Validate;
+    Word_t Count;
+
+    J1C(Count, J1, 0, ~0);
+    if (Judy1Validate(J1, &Validate, PJE0) != 1)
+	FAILURE("Judy1Validate failed, check =", Validate.jv_Check);
+    if (Validate.jv_Population != Count)
+	FAILURE("Judy1Validate population != Count, population =",
+		Validate.jv_Population);
+
+    JLC(Count, JL, 0, ~0);
+    if (JudyLValidate(JL, &Validate, PJE0) != 1)
+	FAILURE("JudyLValidate failed, check =", Validate.jv_Check);
+    if (Validate.jv_Population != Count)
+	FAILURE("JudyLValidate population != Count, population =",
+		Validate.jv_Population);
+
+    return(0);
+}
+
+
 #undef __FUNCTI0N__
 #define __FUNCTI0N__ "TestJudyPrev"
 
@@ -16,6 +16,7 @@
 #include <sys/utsname.h>                // uname()
 
 #include <Judy.h>                       // for Judy macros J*()
+#include "JudyKeys.h"                   // JudyKeys()
 //#include <JudyHS.h>             // compiling with old Judy.h without JudyHS
 
 #ifdef NOINLINE                         /* this is the 21st century? */
@@ -378,6 +379,8 @@ Word_t    IFlag = 0;                    // time duplicate inserts/sets
 Word_t    DFlag = 0;                    // bit reverse the data stream
 Word_t    lFlag = 0;                    // do not do multi-insert tests
 Word_t    SkipN = 0;                    // default == Random skip
+char     *KSpec = NULL;                 // Index distribution, not LFSR
+Word_t   *Keys = NULL;                  // the Indexes from KSpec
 Word_t    TValues = 1000000;            // Maximum retrieve tests for timing
 Word_t    nElms = 1000000;              // Max population of arrays
 Word_t    ErrorFlag = 0;
@@ -413,7 +416,9 @@ Random(Word_t newseed)
 _INLINE_ Word_t                         // so INLINING compilers get to look at it.
 GetNextIndex(Word_t Index)
 {
-    if (SkipN)
+    if (Keys)                           // Index is a position in Keys[]
+        Index++;
+    else if (SkipN)
         Index += SkipN;
     else
         Index = Random(Index);
@@ -421,6 +426,17 @@ GetNextIndex(Word_t Index)
     return (Index);
 }
 
+// Turn a number from GetNextIndex() into the Index to test
+static inline Word_t                    // static, as it calls static Swizzle().
+SeedToIndex(Word_t Seed)
+{
+    if (Keys)
+        return (Keys[Seed - 1]);
+    if (DFlag)
+        return (Swizzle(Seed));
+    return (Seed);
+}
+
 #undef __FUNCTI0N__
 #define __FUNCTI0N__ "main"
 
@@ -460,7 +476,7 @@ main(int argc, char *argv[])
 // PARSE INPUT PARAMETERS
 //============================================================
 
-    while ((c = getopt(argc, argv, "n:S:T:P:b:B:dDcC1LHvIl")) != -1)
+    while ((c = getopt(argc, argv, "n:S:T:P:b:B:K:dDcC1LHvIl")) != -1)
     {
         switch (c)
         {
@@ -474,6 +490,10 @@ main(int argc, char *argv[])
             SkipN = strtoul(optarg, NULL, 0);
             break;
 
+        case 'K':                      // Index distribution
+            KSpec = optarg;
+            break;
+
         case 'T':                      // Maximum retrieve tests for timing 
             TValues = strtoul(optarg, NULL, 0);
             break;
@@ -544,13 +564,15 @@ main(int argc, char *argv[])
 
     if (ErrorFlag)
     {
-        printf("\n%s -n# -P# -S# -B# -T# -dDcCpdI\n\n", argv[0]);
+        printf("\n%s -n# -P# -S# -B# -K<dist> -T# -dDcCpdI\n\n", argv[0]);
         printf("Where:\n");
         printf("-n <#>  number of indexes (1000000) used in tests\n");
         printf("-P <#>  number measurement points (40) per decade\n");
         printf("-S <#>  index skip amount, 0 = random\n");
         printf("-B <#>  # bits (10..%d) in random number generator\n",
                (int)sizeof(Word_t) * 8);
+        printf("-K <..> Index distribution, not the -S/-B stream, one of:\n");
+        JudyKeysHelp();
         printf("-L      time JudyL\n");
         printf("-1      time Judy1\n");
         printf("-H      time JudyHS\n");
@@ -574,7 +596,13 @@ main(int argc, char *argv[])
     RandomBit = 1UL << (BValue - 1);
     Magic = MagicList[BValue];
 
-    if (nElms > ((RandomBit - 2) * 2))
+//  A distribution makes all the Indexes now (a short trace means fewer)
+    if (KSpec)
+    {
+        if ((Keys = JudyKeys(KSpec, &nElms, StartSeed)) == NULL)
+            FAILURE("Cannot make Indexes, -n", nElms);
+    }
+    else if (nElms > ((RandomBit - 2) * 2))
     {
         printf
             ("# Number = -n%lu of Indexes reduced to max expanse of Random numbers\n",
@@ -585,6 +613,9 @@ main(int argc, char *argv[])
     printf("# TITLE %s -n%lu -S%lu -T%lu -B%lu -P%lu",
            argv[0], nElms, SkipN, TValues, BValue, PtsPdec);
 
+    if (KSpec)
+        printf(" -K %s", KSpec);
+
 //        case 'b':              // May not work past 35 bits if changed
 
     if (J1Flag)
@@ -752,8 +783,11 @@ main(int argc, char *argv[])
 // BEGIN TESTS AT EACH GROUP SIZE
 //============================================================
 
-//  Get the kicker to test the LFSR
-    FirstSeed = Seed = StartSeed & (RandomBit * 2 - 1);
+//  Get the kicker to test the LFSR, or start at Keys[0]
+    if (Keys)
+        FirstSeed = Seed = 0;
+    else
+        FirstSeed = Seed = StartSeed & (RandomBit * 2 - 1);
 
     for (Pop1 = grp = 0; grp < Groups; grp++)
     {
@@ -988,10 +1022,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
                 {
                     Seed1 = GetNextIndex(Seed1);
 
-                    if (DFlag)
-                        TstIndex = Swizzle(Seed1);
-                    else
-                        TstIndex = Seed1;
+                    TstIndex = SeedToIndex(Seed1);
 #ifdef SKIPMACRO
                     Rc = Judy1Unset(J1, TstIndex, PJE0);
 #else
@@ -1006,10 +1037,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 J1S(Rc, *J1, TstIndex);
                 if (Rc == 0)
@@ -1050,10 +1078,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
                 {
                     Seed1 = GetNextIndex(Seed1);
 
-                    if (DFlag)
-                        TstIndex = Swizzle(Seed1);
-                    else
-                        TstIndex = Seed1;
+                    TstIndex = SeedToIndex(Seed1);
 #ifdef SKIPMACRO
                     Rc = JudyLDel(JL, TstIndex, PJE0);
 #else
@@ -1068,10 +1093,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 JLI(PValue, *JL, TstIndex);
                 if (*PValue == TstIndex)
@@ -1119,10 +1141,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
                 {
                     Seed1 = GetNextIndex(Seed1);
 
-                    if (DFlag)
-                        TstIndex = Swizzle(Seed1);
-                    else
-                        TstIndex = Seed1;
+                    TstIndex = SeedToIndex(Seed1);
 
                     JHSD(Rc, *JH, &TstIndex, sizeof(Word_t));
                 }
@@ -1134,10 +1153,7 @@ TestJudyIns(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 JHSI(PValue, *JH, &TstIndex, sizeof(Word_t));
                 if (*PValue == TstIndex)
@@ -1197,10 +1213,7 @@ TestJudyDup(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -1238,10 +1251,7 @@ TestJudyDup(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -1281,10 +1291,7 @@ TestJudyDup(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -1347,10 +1354,7 @@ TestJudyGet(void *J1, void *JL, void *JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -1396,10 +1400,7 @@ TestJudyGet(void *J1, void *JL, void *JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -1450,10 +1451,7 @@ TestJudyGet(void *J1, void *JL, void *JH, Word_t Seed, Word_t Elements)
             {
                 Seed1 = GetNextIndex(Seed1);
 
-                if (DFlag)
-                    TstIndex = Swizzle(Seed1);
-                else
-                    TstIndex = Seed1;
+                TstIndex = SeedToIndex(Seed1);
 
                 if (TstIndex < LowIndex)
                     LowIndex = TstIndex;
@@ -2134,10 +2132,7 @@ TestJudyDel(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
         {
             Seed1 = GetNextIndex(Seed1);
 
-            if (DFlag)
-                TstIndex = Swizzle(Seed1);
-            else
-                TstIndex = Seed1;
+            TstIndex = SeedToIndex(Seed1);
 
 #ifdef SKIPMACRO
             Rc = Judy1Unset(J1, TstIndex, PJE0);
@@ -2159,10 +2154,7 @@ TestJudyDel(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
         {
             Seed1 = GetNextIndex(Seed1);
 
-            if (DFlag)
-                TstIndex = Swizzle(Seed1);
-            else
-                TstIndex = Seed1;
+            TstIndex = SeedToIndex(Seed1);
 
 #ifdef SKIPMACRO
             Rc = JudyLDel(JL, TstIndex, PJE0);
@@ -2184,10 +2176,7 @@ TestJudyDel(void **J1, void **JL, void **JH, Word_t Seed, Word_t Elements)
         {
             Seed1 = GetNextIndex(Seed1);
 
-            if (DFlag)
-                TstIndex = Swizzle(Seed1);
-            else
-                TstIndex = Seed1;
+            TstIndex = SeedToIndex(Seed1);
 
             JHSD(Rc, *JH, &TstIndex, sizeof(Word_t));
             if (Rc != 1)
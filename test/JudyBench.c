@@ -0,0 +1,588 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyBench.c $
+//      This program measures the common operations on Judy1, JudyL, JudySL
+//      and JudyHS arrays with the hardware performance counters, and prints
+//      the cost of each operation as CSV or JSON, for comparing one build of
+//      the library with another.
+//
+//      Judy1LHTime measures only time, with gettimeofday() (or a 32-bit
+//      rdtsc, given -DCPUMHZ), which cannot tell why an operation got slower.
+//      Here each pass of an operation over the whole array is bracketed by
+//      Linux perf_event_open(2) counters -- cycles, instructions, L1 data
+//      cache and last level cache misses, data TLB misses and mispredicted
+//      branches -- and by clock_gettime().  A counter that the machine or the
+//      kernel (see /proc/sys/kernel/perf_event_paranoid) does not allow is
+//      left empty (CSV) or null (JSON); on other systems only time is
+//      measured.
+
+#include <stdlib.h>		// malloc(), exit()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memset(), strchr(), strcmp()
+#include <stdio.h>		// printf()
+#include <time.h>		// clock_gettime()
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+#include "JudyCycles.h"		// JudyCounterOpen()
+
+// Compile:
+// # cc -O JudyBench.c -lJudy -lm -o JudyBench
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+// Specify prototypes for each benchmark routine
+void BenchJudy1(void);
+
+void BenchJudyL(void);
+
+void BenchJudySL(void);
+
+void BenchJudyHS(void);
+
+Word_t nElms = 1000000;		// Default = 1M
+Word_t MaxLen = 16;		// Default longest string
+Word_t Seed = 0xc1fc;		// default beginning number
+char  *Dist = "random";		// Judy1/JudyL Index distribution
+int    jFlag = 0;		// JSON (not CSV) output
+int    Profile = JT_DEFAULT;	// branch conversion (see JudyTuneSet())
+char  *ADTs = "1LSH";		// which arrays to measure
+
+// The Judy1/JudyL Indexes, and the strings for JudySL/JudyHS, back to back
+// in Strings[], string i at Offset[i] of Length[i] bytes plus a \0
+
+Word_t  *Indexes;
+uint8_t *Strings;
+Word_t  *Offset;
+Word_t  *Length;
+
+// Results are added to Sink, so no measured call can be optimized away
+
+volatile Word_t Sink;
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+// THE COUNTERS:
+//
+// All of them (see JudyCycles.h), opened once and read after each pass:
+
+#define COUNTERS JC_COUNTERS
+
+int     CounterFd[COUNTERS];		// -1 if not available
+double  CounterVal[COUNTERS];		// last measurement, < 0 if none
+
+static void
+OpenCounters(void)
+{
+    int    ctr;
+
+    for (ctr = 0; ctr < COUNTERS; ctr++)
+	CounterFd[ctr] = JudyCounterOpen(ctr);
+}
+
+static void
+StartCounters(void)
+{
+    int    ctr;
+
+    for (ctr = 0; ctr < COUNTERS; ctr++)
+	JudyCounterStart(CounterFd[ctr]);
+}
+
+static void
+StopCounters(void)
+{
+    int    ctr;
+
+    for (ctr = 0; ctr < COUNTERS; ctr++)
+	JudyCounterStop(CounterFd[ctr]);
+
+    for (ctr = 0; ctr < COUNTERS; ctr++)
+	CounterVal[ctr] = JudyCounterRead(CounterFd[ctr]);
+}
+
+// TIMING ONE PASS:
+//
+// BEGIN starts the counters and the clock; END(ADT, OP, POP, OPS) stops them
+// and reports the pass of OPS operations on an array of POP Indexes.
+
+struct timespec TSBeg__, TSEnd__;
+
+#define BEGIN								\
+{									\
+    StartCounters();							\
+    clock_gettime(CLOCK_MONOTONIC, &TSBeg__);				\
+}
+
+#define END(ADT, OP, POP, OPS)						\
+{									\
+    clock_gettime(CLOCK_MONOTONIC, &TSEnd__);				\
+    StopCounters();							\
+    Report(ADT, OP, POP, OPS);						\
+}
+
+int Records = 0;		// printed so far
+
+static void
+Report(const char *ADT, const char *Op, Word_t Pop, Word_t Ops)
+{
+    double ns;
+    int    ctr;
+
+    ns = ((double)(TSEnd__.tv_sec - TSBeg__.tv_sec) * 1E9
+	+ (double)(TSEnd__.tv_nsec - TSBeg__.tv_nsec)) / Ops;
+
+    if (jFlag)
+    {
+	printf("%s  {\"adt\": \"%s\", \"op\": \"%s\", \"population\": %lu, "
+	       "\"ops\": %lu, \"ns\": %.2f",
+	       Records ? ",\n" : "", ADT, Op, Pop, Ops, ns);
+	for (ctr = 0; ctr < COUNTERS; ctr++)
+	{
+	    if (CounterVal[ctr] < 0.0)
+		printf(", \"%s\": null", JCName[ctr]);
+	    else
+		printf(", \"%s\": %.3f", JCName[ctr],
+		       CounterVal[ctr] / Ops);
+	}
+	printf("}");
+    }
+    else
+    {
+	printf("%s,%s,%lu,%lu,%.2f", ADT, Op, Pop, Ops, ns);
+	for (ctr = 0; ctr < COUNTERS; ctr++)
+	{
+	    if (CounterVal[ctr] < 0.0)
+		printf(",");
+	    else
+		printf(",%.3f", CounterVal[ctr] / Ops);
+	}
+	printf("\n");
+    }
+    Records++;
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    Word_t  elm, total = 0;
+    JTune_t Tune;
+    int     c, ctr;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:l:s:a:k:T:Sj")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of Indexes
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'l':		// Longest string
+	    MaxLen = strtoul(optarg, NULL, 0);
+	    if (MaxLen == 0)
+		FAILURE("Strings must be longer than -l", MaxLen);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'a':		// Arrays to measure
+	    ADTs = optarg;
+	    break;
+
+	case 'k':		// Index distribution
+	    Dist = optarg;
+	    break;
+
+	case 'T':		// Branch conversion profile
+	    if      (strcmp(optarg, "default") == 0) Profile = JT_DEFAULT;
+	    else if (strcmp(optarg, "speed")   == 0) Profile = JT_SPEED;
+	    else if (strcmp(optarg, "compact") == 0) Profile = JT_COMPACT;
+	    else FAILURE("Profile not default, speed or compact, -T", 0);
+	    break;
+
+	case 'S':		// Sequential Indexes
+	    Dist = "stride:1";
+	    break;
+
+	case 'j':		// JSON output
+	    jFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -l# -s# -a1LSH -k<dist> -T<profile> -S -j\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  number of Indexes in each array\n");
+	    printf("-l <#>  longest JudySL/JudyHS string, half are shorter\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-a <..> arrays to measure: 1 = Judy1, L = JudyL, "
+		   "S = JudySL, H = JudyHS\n");
+	    printf("-k <..> distribution of the Judy1/JudyL Indexes "
+		   "(random), one of:\n");
+	    JudyKeysHelp();
+	    printf("-T <..> branch conversion profile: default, speed or "
+		   "compact (JudyTuneSet)\n");
+	    printf("-S      sequential Judy1/JudyL Indexes, same as "
+		   "-k stride:1\n");
+	    printf("-j      print JSON, not CSV\n");
+	    printf("\nOne record per pass of an operation over the array, "
+		   "with the counts per operation\n");
+	    exit(1);
+	}
+    }
+
+//  Make the Indexes (a short trace means fewer), and the strings:  random
+//  letters and digits, from half the longest up
+
+    if ((Indexes = JudyKeys(Dist, &nElms, Seed)) == NULL)
+	FAILURE("Cannot make Indexes, -n", nElms);
+
+    Offset  = (Word_t *)malloc(nElms * sizeof(Word_t));
+    Length  = (Word_t *)malloc(nElms * sizeof(Word_t));
+    if ((Offset == NULL) || (Length == NULL))
+	FAILURE("Out of memory, Indexes =", nElms);
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	Length[elm]  = (MaxLen + 1) / 2 + Random() % (MaxLen / 2 + 1);
+	Offset[elm]  = total;
+	total += Length[elm] + 1;
+    }
+    if ((Strings = (uint8_t *)malloc(total)) == NULL)
+	FAILURE("Out of memory, bytes =", total);
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	uint8_t *str = Strings + Offset[elm];
+	Word_t   ii;
+
+	for (ii = 0; ii < Length[elm]; ii++)
+	    str[ii] = "abcdefghijklmnopqrstuvwxyz0123456789"[Random() % 36];
+	str[ii] = '\0';
+    }
+
+//  Convert branches as the profile says
+
+    JudyTuneProfile(Profile, &Tune);
+    JudyTuneSet(&Tune);
+
+    OpenCounters();
+
+    if (jFlag)
+	printf("[\n");
+    else
+    {
+	printf("adt,op,population,ops,ns");
+	for (ctr = 0; ctr < COUNTERS; ctr++)
+	    printf(",%s", JCName[ctr]);
+	printf("\n");
+    }
+
+    if (strchr(ADTs, '1')) BenchJudy1();
+    if (strchr(ADTs, 'L')) BenchJudyL();
+    if (strchr(ADTs, 'S')) BenchJudySL();
+    if (strchr(ADTs, 'H')) BenchJudyHS();
+
+    if (jFlag)
+	printf("\n]\n");
+
+    exit(0);
+}
+
+// EACH ARRAY:
+//
+// Insert every Index, then look up every one in the same order, visit all of
+// them in order, count those up to each one (except JudyHS, which cannot),
+// and delete every one.
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "BenchJudy1"
+
+void
+BenchJudy1(void)
+{
+    Pvoid_t J1 = NULL;
+    Word_t  elm, pop, index, count, sum = 0;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	J1S(Rc, J1, Indexes[elm]);
+	sum += Rc;
+    }
+    END("Judy1", "ins", sum, nElms);
+    pop = sum;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	J1T(Rc, J1, Indexes[elm]);
+	sum += Rc;
+    }
+    END("Judy1", "get", pop, nElms);
+
+    BEGIN;
+    index = 0;
+    count = 0;
+    J1F(Rc, J1, index);
+    while (Rc)
+    {
+	count++;
+	J1N(Rc, J1, index);
+    }
+    END("Judy1", "next", pop, count);
+    if (count != pop)
+	FAILURE("Judy1Next visited wrong number, count =", count);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	J1C(count, J1, 0, Indexes[elm]);
+	sum += count;
+    }
+    END("Judy1", "count", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	J1U(Rc, J1, Indexes[elm]);
+	sum += Rc;
+    }
+    END("Judy1", "del", pop, nElms);
+    if (J1 != NULL)
+	FAILURE("Judy1 array not empty, pop =", pop);
+
+    Sink += sum;
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "BenchJudyL"
+
+void
+BenchJudyL(void)
+{
+    Pvoid_t JL = NULL;
+    PWord_t PValue;
+    Word_t  elm, pop = 0, index, count, sum = 0;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JLI(PValue, JL, Indexes[elm]);
+	if (PValue == PJERR)
+	    FAILURE("JudyLIns failed at", elm);
+	if (*PValue == 0)
+	    pop++;
+	*PValue = elm + 1;
+    }
+    END("JudyL", "ins", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JLG(PValue, JL, Indexes[elm]);
+	sum += *PValue;
+    }
+    END("JudyL", "get", pop, nElms);
+
+    BEGIN;
+    index = 0;
+    count = 0;
+    JLF(PValue, JL, index);
+    while (PValue != NULL)
+    {
+	count++;
+	sum += *PValue;
+	JLN(PValue, JL, index);
+    }
+    END("JudyL", "next", pop, count);
+    if (count != pop)
+	FAILURE("JudyLNext visited wrong number, count =", count);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JLC(count, JL, 0, Indexes[elm]);
+	sum += count;
+    }
+    END("JudyL", "count", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JLD(Rc, JL, Indexes[elm]);
+	sum += Rc;
+    }
+    END("JudyL", "del", pop, nElms);
+    if (JL != NULL)
+	FAILURE("JudyL array not empty, pop =", pop);
+
+    Sink += sum;
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "BenchJudySL"
+
+void
+BenchJudySL(void)
+{
+    Pvoid_t  JSL = NULL;
+    PWord_t  PValue;
+    Word_t   elm, pop = 0, count, sum = 0;
+    uint8_t *Index;
+    int      Rc;
+
+    if ((Index = (uint8_t *)malloc(MaxLen + 1)) == NULL)
+	FAILURE("Out of memory, bytes =", MaxLen + 1);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JSLI(PValue, JSL, Strings + Offset[elm]);
+	if (PValue == PJERR)
+	    FAILURE("JudySLIns failed at", elm);
+	if (*PValue == 0)
+	    pop++;
+	*PValue = elm + 1;
+    }
+    END("JudySL", "ins", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JSLG(PValue, JSL, Strings + Offset[elm]);
+	sum += *PValue;
+    }
+    END("JudySL", "get", pop, nElms);
+
+    BEGIN;
+    count = 0;
+    Index[0] = '\0';
+    JSLF(PValue, JSL, Index);
+    while (PValue != NULL)
+    {
+	count++;
+	sum += *PValue;
+	JSLN(PValue, JSL, Index);
+    }
+    END("JudySL", "next", pop, count);
+    if (count != pop)
+	FAILURE("JudySLNext visited wrong number, count =", count);
+
+//  Storing the subtree populations that JudySLCount() uses is left out of
+//  the measurement
+
+    JSLCI(count, JSL);
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JSLC(count, JSL, (uint8_t *)"", Strings + Offset[elm]);
+	sum += count;
+    }
+    END("JudySL", "count", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JSLD(Rc, JSL, Strings + Offset[elm]);
+	sum += Rc;
+    }
+    END("JudySL", "del", pop, nElms);
+
+//  A counted array keeps its (zero) count until freed
+
+    Index[0] = '\0';
+    JSLF(PValue, JSL, Index);
+    if (PValue != NULL)
+	FAILURE("JudySL array not empty, pop =", pop);
+    JSLFA(count, JSL);
+
+    free(Index);
+    Sink += sum;
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "BenchJudyHS"
+
+void
+BenchJudyHS(void)
+{
+    Pvoid_t   JH = NULL;
+    PWord_t   PValue;
+    JHSIter_t Iter;
+    Word_t    elm, pop = 0, count, sum = 0;
+    int       Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JHSI(PValue, JH, Strings + Offset[elm], Length[elm]);
+	if (PValue == PJERR)
+	    FAILURE("JudyHSIns failed at", elm);
+	if (*PValue == 0)
+	    pop++;
+	*PValue = elm + 1;
+    }
+    END("JudyHS", "ins", pop, nElms);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JHSG(PValue, JH, Strings + Offset[elm], Length[elm]);
+	sum += *PValue;
+    }
+    END("JudyHS", "get", pop, nElms);
+
+    JHSITERINIT(&Iter);
+    BEGIN;
+    count = 0;
+    JHSF(PValue, JH, Iter);
+    while (PValue != NULL)
+    {
+	count++;
+	sum += *PValue;
+	JHSN(PValue, JH, Iter);
+    }
+    END("JudyHS", "next", pop, count);
+    JudyHSIterFree(&Iter);
+    if (count != pop)
+	FAILURE("JudyHSNext visited wrong number, count =", count);
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	JHSD(Rc, JH, Strings + Offset[elm], Length[elm]);
+	sum += Rc;
+    }
+    END("JudyHS", "del", pop, nElms);
+    if (JH != NULL)
+	FAILURE("JudyHS array not empty, pop =", pop);
+
+    Sink += sum;
+}
@@ -0,0 +1,1527 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyCompare.c $
+//      This program compares Judy, for time and memory, on the same Indexes,
+//      with the data structures most often used instead of it today:
+//
+//      chain           a hash table of chained nodes, as C++ unordered_map
+//      swiss           an open addressed table, probed a group of 8 slots at
+//                      a time by 7-bit tags, as the Swiss tables
+//      rbtree          a red-black tree, as C++ map
+//      btree           a B+tree of 32 Indexes to a node
+//      art             an adaptive radix tree:  nodes of 4, 16, 48 and 256
+//                      children, prefixes of up to 8 bytes, and leaves made
+//                      only when needed
+//      JudyL           for Word_t Indexes; JudySL and JudyHS for strings
+//
+//      SLcompare.c compares JudySL with the hash, splay and red-black trees
+//      of its time; this adds the newer kinds, and Word_t Indexes.  All of
+//      them are written here, in C, so the program needs nothing but the
+//      Judy library.  Each gets memory through Alloc() (Judy through
+//      JudyMalloc()), which adds up what malloc(3) holds, its overhead
+//      included, as JudyMemBench does; a string Index is copied into each,
+//      as a C++ string key would be.
+//
+//      For each structure the first -n Indexes are inserted, then looked up
+//      (all found), then -n other Indexes are looked up (none found); every
+//      lookup is checked, and all memory must be back when the structure is
+//      freed.  One CSV line is printed for each, with the time per operation
+//      and the bytes per Index.
+
+#include <stdlib.h>		// malloc(), exit()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memcpy(), strcmp()
+#include <stdio.h>		// printf()
+#include <time.h>		// clock_gettime()
+#ifdef __GLIBC__
+#include <malloc.h>		// malloc_usable_size()
+#endif
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+
+// Compile:
+// # cc -O JudyCompare.c -lJudy -lm -o JudyCompare
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+Word_t nElms = 1000000;		// Default = 1M
+Word_t MaxLen = 16;		// Default longest string
+Word_t Seed = 0xc1fc;		// default beginning number
+int    SFlag = 0;		// string (not Word_t) Indexes
+char  *Dist = "random";		// Word_t Index distribution
+char  *ADTs = NULL;		// which structures, NULL = all
+
+// The Indexes:  2 * nElms Word_t, or pointers to strings; the first nElms
+// are inserted, the rest looked up and not found
+
+Word_t *Keys;
+Word_t *Length;			// of each string
+
+// THE MEMORY COUNT:
+//
+// Everything allocated is counted as malloc(3) holds it:  with glibc, the
+// usable size of the chunk plus its header; elsewhere 2 more words.
+
+Word_t MemBytes;
+
+static Word_t
+ChunkBytes(void *P, size_t Bytes)
+{
+#ifdef __GLIBC__
+    (void) Bytes;
+    return(malloc_usable_size(P) + sizeof(size_t));
+#else
+    (void) P;
+    return((Bytes + sizeof(Word_t) - 1) / sizeof(Word_t) * sizeof(Word_t)
+	 + 2 * sizeof(Word_t));
+#endif
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Alloc"
+
+static void *
+Alloc(size_t Bytes)
+{
+    void *P = malloc(Bytes);
+
+    if (P == NULL)
+	FAILURE("Out of memory, bytes =", Bytes);
+    MemBytes += ChunkBytes(P, Bytes);
+    return(P);
+}
+
+static void *
+AllocZero(size_t Bytes)
+{
+    return(memset(Alloc(Bytes), 0, Bytes));
+}
+
+static void
+Free(void *P, size_t Bytes)
+{
+    MemBytes -= ChunkBytes(P, Bytes);
+    free(P);
+}
+
+// J U D Y   M A L L O C
+//
+// Replace the library versions, so Judy is counted the same way.
+
+Word_t
+JudyMalloc(Word_t Words)
+{
+    return((Word_t)Alloc(Words * sizeof(Word_t)));
+}
+
+void
+JudyFree(void *PWord, Word_t Words)
+{
+    Free(PWord, Words * sizeof(Word_t));
+}
+
+Word_t
+JudyMallocVirtual(Word_t Words)
+{
+    return(JudyMalloc(Words));
+}
+
+void
+JudyFreeVirtual(void *PWord, Word_t Words)
+{
+    JudyFree(PWord, Words);
+}
+
+// THE INDEXES, EITHER KIND:
+//
+// An Index is a Word_t, or (with -S) a pointer to a \0 terminated string.
+
+static Word_t
+KeyHash(Word_t Key)
+{
+    uint64_t hash;
+
+    if (SFlag)
+    {
+	const uint8_t *str = (const uint8_t *)Key;
+
+	for (hash = 0xcbf29ce484222325ULL; *str; str++)	// FNV-1a
+	    hash = (hash ^ *str) * 0x100000001b3ULL;
+    }
+    else
+	hash = (uint64_t)Key * 0x9e3779b97f4a7c15ULL;
+
+    return((Word_t)(hash ^ (hash >> 32)));
+}
+
+static int
+KeyCmp(Word_t A, Word_t B)
+{
+    if (SFlag)
+	return(strcmp((const char *)A, (const char *)B));
+    return((A > B) - (A < B));
+}
+
+#define KeyEq(A, B)  (SFlag ? (strcmp((const char *)(A),		\
+				      (const char *)(B)) == 0)		\
+			    : ((A) == (B)))
+
+// Byte Depth of an Index, most significant first; a string ends with its \0,
+// so no string is a prefix of another:
+
+#define KeyByte(KEY, DEPTH)						\
+    (SFlag ? ((const uint8_t *)(KEY))[DEPTH]				\
+	   : (uint8_t)((KEY) >> ((sizeof(Word_t) - 1 - (DEPTH)) * 8)))
+
+static Word_t
+KeyCopy(Word_t Key)
+{
+    size_t len;
+
+    if (! SFlag)
+	return(Key);
+    len = strlen((const char *)Key) + 1;
+    return((Word_t)memcpy(Alloc(len), (const void *)Key, len));
+}
+
+static void
+KeyFree(Word_t Key)
+{
+    if (SFlag)
+	Free((void *)Key, strlen((const char *)Key) + 1);
+}
+
+// ****************************************************************************
+// C H A I N E D   H A S H   T A B L E
+//
+// Buckets of singly linked nodes, each keeping its hash; the table doubles
+// when there are as many nodes as buckets.
+
+typedef struct CHAINNODE
+{
+    struct CHAINNODE *cn_Next;
+    Word_t cn_Hash;
+    Word_t cn_Key;
+    Word_t cn_Value;
+} cn_t;
+
+cn_t  **ChainBucket;
+Word_t  ChainSize;
+Word_t  ChainPop;
+
+static void
+ChainGrow(void)
+{
+    cn_t  **old = ChainBucket;
+    cn_t   *Pcn, *next;
+    Word_t  ii, oldsize = ChainSize;
+
+    ChainSize   = oldsize ? oldsize * 2 : 16;
+    ChainBucket = (cn_t **)AllocZero(ChainSize * sizeof(cn_t *));
+
+    for (ii = 0; ii < oldsize; ii++)
+    {
+	for (Pcn = old[ii]; Pcn != NULL; Pcn = next)
+	{
+	    next = Pcn->cn_Next;
+	    Pcn->cn_Next = ChainBucket[Pcn->cn_Hash & (ChainSize - 1)];
+	    ChainBucket[Pcn->cn_Hash & (ChainSize - 1)] = Pcn;
+	}
+    }
+    if (old != NULL)
+	Free(old, oldsize * sizeof(cn_t *));
+}
+
+static Word_t *
+ChainGet(Word_t Key)
+{
+    Word_t hash = KeyHash(Key);
+    cn_t  *Pcn;
+
+    if (ChainBucket == NULL)
+	return(NULL);
+
+    for (Pcn = ChainBucket[hash & (ChainSize - 1)]; Pcn; Pcn = Pcn->cn_Next)
+	if ((Pcn->cn_Hash == hash) && KeyEq(Pcn->cn_Key, Key))
+	    return(&Pcn->cn_Value);
+    return(NULL);
+}
+
+static Word_t *
+ChainIns(Word_t Key)
+{
+    Word_t *PValue;
+    cn_t   *Pcn;
+
+    if ((PValue = ChainGet(Key)) != NULL)
+	return(PValue);
+
+    if (ChainPop >= ChainSize)
+	ChainGrow();
+
+    Pcn = (cn_t *)Alloc(sizeof(cn_t));
+    Pcn->cn_Hash  = KeyHash(Key);
+    Pcn->cn_Key   = KeyCopy(Key);
+    Pcn->cn_Value = 0;
+    Pcn->cn_Next  = ChainBucket[Pcn->cn_Hash & (ChainSize - 1)];
+    ChainBucket[Pcn->cn_Hash & (ChainSize - 1)] = Pcn;
+    ChainPop++;
+    return(&Pcn->cn_Value);
+}
+
+static void
+ChainFree(void)
+{
+    cn_t  *Pcn, *next;
+    Word_t ii;
+
+    for (ii = 0; ii < ChainSize; ii++)
+    {
+	for (Pcn = ChainBucket[ii]; Pcn != NULL; Pcn = next)
+	{
+	    next = Pcn->cn_Next;
+	    KeyFree(Pcn->cn_Key);
+	    Free(Pcn, sizeof(cn_t));
+	}
+    }
+    if (ChainBucket != NULL)
+	Free(ChainBucket, ChainSize * sizeof(cn_t *));
+    ChainBucket = NULL;
+    ChainSize = ChainPop = 0;
+}
+
+// ****************************************************************************
+// S W I S S   T A B L E
+//
+// One control byte a slot:  SW_EMPTY, or the low 7 bits of the hash of the
+// Index in it.  The rest of the hash picks a group of 8 slots to start at;
+// all 8 control bytes are tested at once, in a 64-bit word.  Groups are
+// probed in triangular steps until one has an empty slot.  There are no
+// deletes, so no tombstones; the table doubles at 7/8 full.
+
+#define SW_EMPTY	0x80
+#define SW_LSB		0x0101010101010101ULL
+#define SW_MSB		0x8080808080808080ULL
+
+typedef struct SWISSSLOT
+{
+    Word_t sw_Key;
+    Word_t sw_Value;
+} sws_t;
+
+uint8_t *SwCtrl;
+sws_t   *SwSlot;
+Word_t   SwGroups;
+Word_t   SwPop;
+
+// The slot in a group of the lowest byte flagged in a 64-bit match:
+
+static int
+SwFirst(uint64_t Match)
+{
+    int bit;
+
+#ifdef __GNUC__
+    bit = __builtin_ctzll(Match);
+#else
+    for (bit = 0; ! (Match & 1); bit++)
+	Match >>= 1;
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return(7 - bit / 8);
+#else
+    return(bit / 8);
+#endif
+}
+
+// Return the slot holding Key, else (if PEmpty) the empty slot for it; or -1:
+
+static long
+SwFind(Word_t Key, Word_t Hash, long *PEmpty)
+{
+    uint64_t ctrl, match;
+    Word_t   group, step, tag = Hash & 0x7f;
+    long     slot;
+
+    if (SwGroups == 0)
+	return(-1);
+
+    for (group = (Hash >> 7) & (SwGroups - 1), step = 0; ;
+	 group = (group + ++step) & (SwGroups - 1))
+    {
+	memcpy(&ctrl, SwCtrl + group * 8, 8);
+
+//	Bytes equal to the tag become 0, and are found as in "haszero()"; a
+//	byte above a real match may be flagged too, so check each Index
+
+	match  = ctrl ^ (SW_LSB * tag);
+	match  = (match - SW_LSB) & ~match & SW_MSB;
+	for ( ; match; match &= match - 1)
+	{
+	    slot = group * 8 + SwFirst(match);
+	    if ((SwCtrl[slot] == tag) && KeyEq(SwSlot[slot].sw_Key, Key))
+		return(slot);
+	}
+
+	if (ctrl & SW_MSB)		// an empty slot, so not here
+	{
+	    if (PEmpty != NULL)
+		*PEmpty = group * 8 + SwFirst(ctrl & SW_MSB);
+	    return(-1);
+	}
+    }
+}
+
+static void
+SwGrow(void)
+{
+    uint8_t *oldctrl  = SwCtrl;
+    sws_t   *oldslot  = SwSlot;
+    Word_t   oldslots = SwGroups * 8;
+    Word_t   ii;
+    long     empty;
+
+    SwGroups = SwGroups ? SwGroups * 2 : 2;
+    SwCtrl = (uint8_t *)memset(Alloc(SwGroups * 8), SW_EMPTY, SwGroups * 8);
+    SwSlot = (sws_t *)Alloc(SwGroups * 8 * sizeof(sws_t));
+
+    for (ii = 0; ii < oldslots; ii++)
+    {
+	Word_t hash;
+
+	if (oldctrl[ii] & SW_EMPTY)
+	    continue;
+
+	hash = KeyHash(oldslot[ii].sw_Key);
+	(void) SwFind(oldslot[ii].sw_Key, hash, &empty);
+	SwCtrl[empty] = hash & 0x7f;
+	SwSlot[empty] = oldslot[ii];
+    }
+    if (oldctrl != NULL)
+    {
+	Free(oldctrl, oldslots);
+	Free(oldslot, oldslots * sizeof(sws_t));
+    }
+}
+
+static Word_t *
+SwGet(Word_t Key)
+{
+    long slot = SwFind(Key, KeyHash(Key), NULL);
+
+    return((slot < 0) ? NULL : &SwSlot[slot].sw_Value);
+}
+
+static Word_t *
+SwIns(Word_t Key)
+{
+    Word_t hash = KeyHash(Key);
+    long   slot, empty;
+
+    if ((slot = SwFind(Key, hash, &empty)) >= 0)
+	return(&SwSlot[slot].sw_Value);
+
+    if ((SwPop + 1) * 8 > SwGroups * 8 * 7)
+    {
+	SwGrow();
+	(void) SwFind(Key, hash, &empty);
+    }
+
+    SwCtrl[empty] = hash & 0x7f;
+    SwSlot[empty].sw_Key   = KeyCopy(Key);
+    SwSlot[empty].sw_Value = 0;
+    SwPop++;
+    return(&SwSlot[empty].sw_Value);
+}
+
+static void
+SwFree(void)
+{
+    Word_t ii;
+
+    for (ii = 0; ii < SwGroups * 8; ii++)
+	if (! (SwCtrl[ii] & SW_EMPTY))
+	    KeyFree(SwSlot[ii].sw_Key);
+
+    if (SwCtrl != NULL)
+    {
+	Free(SwCtrl, SwGroups * 8);
+	Free(SwSlot, SwGroups * 8 * sizeof(sws_t));
+    }
+    SwCtrl = NULL;
+    SwSlot = NULL;
+    SwGroups = SwPop = 0;
+}
+
+// ****************************************************************************
+// R E D - B L A C K   T R E E
+
+typedef struct RBNODE
+{
+    struct RBNODE *rb_Left;
+    struct RBNODE *rb_Right;
+    struct RBNODE *rb_Parent;
+    Word_t         rb_Red;
+    Word_t         rb_Key;
+    Word_t         rb_Value;
+} rb_t;
+
+rb_t *RbRoot;
+
+static void
+RbRotate(rb_t *X, int Left)
+{
+    rb_t *Y = Left ? X->rb_Right : X->rb_Left;
+
+    if (Left)
+    {
+	if ((X->rb_Right = Y->rb_Left) != NULL)
+	    Y->rb_Left->rb_Parent = X;
+    }
+    else
+    {
+	if ((X->rb_Left = Y->rb_Right) != NULL)
+	    Y->rb_Right->rb_Parent = X;
+    }
+
+    Y->rb_Parent = X->rb_Parent;
+    if (X->rb_Parent == NULL)
+	RbRoot = Y;
+    else if (X == X->rb_Parent->rb_Left)
+	X->rb_Parent->rb_Left = Y;
+    else
+	X->rb_Parent->rb_Right = Y;
+
+    if (Left)
+	Y->rb_Left = X;
+    else
+	Y->rb_Right = X;
+    X->rb_Parent = Y;
+}
+
+static Word_t *
+RbGet(Word_t Key)
+{
+    rb_t *Prb = RbRoot;
+    int   cmp;
+
+    while (Prb != NULL)
+    {
+	if ((cmp = KeyCmp(Key, Prb->rb_Key)) == 0)
+	    return(&Prb->rb_Value);
+	Prb = (cmp < 0) ? Prb->rb_Left : Prb->rb_Right;
+    }
+    return(NULL);
+}
+
+static Word_t *
+RbIns(Word_t Key)
+{
+    rb_t **PPrb = &RbRoot;
+    rb_t  *parent = NULL, *Z, *Pnew, *G, *U;
+    int    cmp;
+
+    while (*PPrb != NULL)
+    {
+	parent = *PPrb;
+	if ((cmp = KeyCmp(Key, parent->rb_Key)) == 0)
+	    return(&parent->rb_Value);
+	PPrb = (cmp < 0) ? &parent->rb_Left : &parent->rb_Right;
+    }
+
+    Z = Pnew = (rb_t *)Alloc(sizeof(rb_t));
+    Z->rb_Left  = Z->rb_Right = NULL;
+    Z->rb_Parent = parent;
+    Z->rb_Red   = 1;
+    Z->rb_Key   = KeyCopy(Key);
+    Z->rb_Value = 0;
+    *PPrb = Z;
+
+//  Restore the colors:  no red node has a red parent
+
+    while ((Z->rb_Parent != NULL) && Z->rb_Parent->rb_Red)
+    {
+	int left;
+
+	parent = Z->rb_Parent;
+	G      = parent->rb_Parent;
+	left   = (parent == G->rb_Left);
+	U      = left ? G->rb_Right : G->rb_Left;
+
+	if ((U != NULL) && U->rb_Red)
+	{
+	    parent->rb_Red = U->rb_Red = 0;
+	    G->rb_Red = 1;
+	    Z = G;
+	    continue;
+	}
+	if (Z == (left ? parent->rb_Right : parent->rb_Left))
+	{
+	    Z = parent;
+	    RbRotate(Z, left);
+	    parent = Z->rb_Parent;
+	}
+	parent->rb_Red = 0;
+	G->rb_Red = 1;
+	RbRotate(G, ! left);
+    }
+    RbRoot->rb_Red = 0;
+    return(&Pnew->rb_Value);
+}
+
+static void
+RbFreeNode(rb_t *Prb)
+{
+    if (Prb == NULL)
+	return;
+    RbFreeNode(Prb->rb_Left);
+    RbFreeNode(Prb->rb_Right);
+    KeyFree(Prb->rb_Key);
+    Free(Prb, sizeof(rb_t));
+}
+
+static void
+RbFree(void)
+{
+    RbFreeNode(RbRoot);
+    RbRoot = NULL;
+}
+
+// ****************************************************************************
+// B + T R E E
+//
+// Up to BT_MAX Indexes a node.  Inner nodes hold separators:  child i has the
+// Indexes below separator i, and at or above separator i - 1.  Only leaves
+// hold values, and own the string copies.  A full node is split on the way
+// down, so a split never climbs back up.
+
+#define BT_MAX	32
+
+typedef struct BTHEAD
+{
+    Word_t bt_Leaf;
+    Word_t bt_Count;
+    Word_t bt_Key[BT_MAX];
+} bth_t;
+
+typedef struct BTLEAF
+{
+    Word_t bt_Leaf;
+    Word_t bt_Count;
+    Word_t bt_Key[BT_MAX];
+    Word_t bt_Value[BT_MAX];
+    struct BTLEAF *bt_Next;		// for walks in order
+} btl_t;
+
+typedef struct BTINNER
+{
+    Word_t bt_Leaf;
+    Word_t bt_Count;
+    Word_t bt_Key[BT_MAX];
+    bth_t *bt_Child[BT_MAX + 1];
+} bti_t;
+
+bth_t *BtRoot;
+
+// First position with Key < Keys[pos] (Upper) or Key <= Keys[pos] (!Upper):
+
+static Word_t
+BtSearch(const Word_t *Keys, Word_t Count, Word_t Key, int Upper)
+{
+    Word_t low = 0, high = Count, mid;
+    int    cmp;
+
+    while (low < high)
+    {
+	mid = (low + high) / 2;
+	cmp = KeyCmp(Key, Keys[mid]);
+	if ((cmp < 0) || (! Upper && (cmp == 0)))
+	    high = mid;
+	else
+	    low = mid + 1;
+    }
+    return(low);
+}
+
+static void
+BtSplitChild(bti_t *Parent, Word_t Pos)
+{
+    bth_t *child = Parent->bt_Child[Pos];
+    bth_t *right;
+    Word_t sep, half = BT_MAX / 2;
+
+    if (child->bt_Leaf)
+    {
+	btl_t *Pl = (btl_t *)child;
+	btl_t *Pr = (btl_t *)Alloc(sizeof(btl_t));
+
+	Pr->bt_Leaf  = 1;
+	Pr->bt_Count = BT_MAX - half;
+	memcpy(Pr->bt_Key, Pl->bt_Key + half, Pr->bt_Count * sizeof(Word_t));
+	memcpy(Pr->bt_Value, Pl->bt_Value + half,
+	       Pr->bt_Count * sizeof(Word_t));
+	Pr->bt_Next  = Pl->bt_Next;
+	Pl->bt_Next  = Pr;
+	Pl->bt_Count = half;
+	sep   = Pr->bt_Key[0];
+	right = (bth_t *)Pr;
+    }
+    else
+    {
+	bti_t *Pl = (bti_t *)child;
+	bti_t *Pr = (bti_t *)Alloc(sizeof(bti_t));
+
+	Pr->bt_Leaf  = 0;
+	Pr->bt_Count = BT_MAX - half - 1;
+	memcpy(Pr->bt_Key, Pl->bt_Key + half + 1,
+	       Pr->bt_Count * sizeof(Word_t));
+	memcpy(Pr->bt_Child, Pl->bt_Child + half + 1,
+	       (Pr->bt_Count + 1) * sizeof(bth_t *));
+	Pl->bt_Count = half;
+	sep   = Pl->bt_Key[half];
+	right = (bth_t *)Pr;
+    }
+
+    memmove(Parent->bt_Key + Pos + 1, Parent->bt_Key + Pos,
+	    (Parent->bt_Count - Pos) * sizeof(Word_t));
+    memmove(Parent->bt_Child + Pos + 2, Parent->bt_Child + Pos + 1,
+	    (Parent->bt_Count - Pos) * sizeof(bth_t *));
+    Parent->bt_Key[Pos]       = sep;
+    Parent->bt_Child[Pos + 1] = right;
+    Parent->bt_Count++;
+}
+
+static Word_t *
+BtGet(Word_t Key)
+{
+    bth_t *Pn = BtRoot;
+    Word_t pos;
+
+    if (Pn == NULL)
+	return(NULL);
+
+    while (! Pn->bt_Leaf)
+	Pn = ((bti_t *)Pn)->bt_Child[BtSearch(Pn->bt_Key, Pn->bt_Count, Key,
+					      1)];
+
+    pos = BtSearch(Pn->bt_Key, Pn->bt_Count, Key, 0);
+    if ((pos < Pn->bt_Count) && KeyEq(Pn->bt_Key[pos], Key))
+	return(((btl_t *)Pn)->bt_Value + pos);
+    return(NULL);
+}
+
+static Word_t *
+BtIns(Word_t Key)
+{
+    bth_t *Pn;
+    btl_t *Pl;
+    Word_t pos;
+
+    if (BtRoot == NULL)
+    {
+	BtRoot = (bth_t *)AllocZero(sizeof(btl_t));
+	BtRoot->bt_Leaf = 1;
+    }
+    if (BtRoot->bt_Count == BT_MAX)
+    {
+	bti_t *Proot = (bti_t *)Alloc(sizeof(bti_t));
+
+	Proot->bt_Leaf     = 0;
+	Proot->bt_Count    = 0;
+	Proot->bt_Child[0] = BtRoot;
+	BtSplitChild(Proot, 0);
+	BtRoot = (bth_t *)Proot;
+    }
+
+    for (Pn = BtRoot; ! Pn->bt_Leaf; )
+    {
+	bti_t *Pi = (bti_t *)Pn;
+
+	pos = BtSearch(Pi->bt_Key, Pi->bt_Count, Key, 1);
+	if (Pi->bt_Child[pos]->bt_Count == BT_MAX)
+	{
+	    BtSplitChild(Pi, pos);
+	    if (KeyCmp(Key, Pi->bt_Key[pos]) >= 0)
+		pos++;
+	}
+	Pn = Pi->bt_Child[pos];
+    }
+
+    Pl  = (btl_t *)Pn;
+    pos = BtSearch(Pl->bt_Key, Pl->bt_Count, Key, 0);
+    if ((pos < Pl->bt_Count) && KeyEq(Pl->bt_Key[pos], Key))
+	return(Pl->bt_Value + pos);
+
+    memmove(Pl->bt_Key + pos + 1, Pl->bt_Key + pos,
+	    (Pl->bt_Count - pos) * sizeof(Word_t));
+    memmove(Pl->bt_Value + pos + 1, Pl->bt_Value + pos,
+	    (Pl->bt_Count - pos) * sizeof(Word_t));
+    Pl->bt_Key[pos]   = KeyCopy(Key);
+    Pl->bt_Value[pos] = 0;
+    Pl->bt_Count++;
+    return(Pl->bt_Value + pos);
+}
+
+static void
+BtFreeNode(bth_t *Pn)
+{
+    Word_t ii;
+
+    if (Pn->bt_Leaf)
+    {
+	for (ii = 0; ii < Pn->bt_Count; ii++)
+	    KeyFree(Pn->bt_Key[ii]);
+	Free(Pn, sizeof(btl_t));
+	return;
+    }
+    for (ii = 0; ii <= Pn->bt_Count; ii++)
+	BtFreeNode(((bti_t *)Pn)->bt_Child[ii]);
+    Free(Pn, sizeof(bti_t));
+}
+
+static void
+BtFree(void)
+{
+    if (BtRoot != NULL)
+	BtFreeNode(BtRoot);
+    BtRoot = NULL;
+}
+
+// ****************************************************************************
+// A D A P T I V E   R A D I X   T R E E
+//
+// A byte of the Index at each level.  A node has room for 4, 16, 48 or 256
+// children, and grows to the next size when full.  A run of bytes all the
+// Indexes under a node share is kept in the node as its prefix, up to 8
+// bytes; a longer run takes a chain of nodes.  A child is a node, or (with
+// the low bit set) a leaf holding one Index and its value; a leaf is made
+// as high in the tree as it can be, and pushed down only when another Index
+// needs the same place.
+
+#define ART_MAXPREFIX	8
+
+enum { ART4, ART16, ART48, ART256 };
+
+typedef struct ARTNODE
+{
+    uint8_t  an_Type;
+    uint8_t  an_PrefixLen;
+    uint16_t an_Count;
+    uint8_t  an_Prefix[ART_MAXPREFIX];
+} an_t;
+
+typedef struct { an_t an; uint8_t an_Key[4];     void *an_Child[4];  } an4_t;
+typedef struct { an_t an; uint8_t an_Key[16];    void *an_Child[16]; } an16_t;
+typedef struct { an_t an; uint8_t an_Index[256]; void *an_Child[48]; } an48_t;
+typedef struct { an_t an; void *an_Child[256]; } an256_t;
+
+typedef struct ARTLEAF
+{
+    Word_t al_Key;
+    Word_t al_Value;
+} al_t;
+
+#define ART_ISLEAF(P)	((Word_t)(P) & 1)
+#define ART_LEAF(P)	((al_t *)((Word_t)(P) & ~(Word_t)1))
+#define ART_TAG(PAL)	((void *)((Word_t)(PAL) | 1))
+
+const size_t ArtSize[4] =
+    { sizeof(an4_t), sizeof(an16_t), sizeof(an48_t), sizeof(an256_t) };
+
+void *ArtRoot;
+
+static an_t *
+ArtNewNode(int Type)
+{
+    an_t *Pan = (an_t *)AllocZero(ArtSize[Type]);
+
+    Pan->an_Type = Type;
+    return(Pan);
+}
+
+// The slot for the child at byte C, or NULL:
+
+static void **
+ArtFind(an_t *Pan, uint8_t C)
+{
+    int ii;
+
+    switch (Pan->an_Type)
+    {
+    case ART4:
+	for (ii = 0; ii < Pan->an_Count; ii++)
+	    if (((an4_t *)Pan)->an_Key[ii] == C)
+		return(((an4_t *)Pan)->an_Child + ii);
+	return(NULL);
+
+    case ART16:
+	for (ii = 0; ii < Pan->an_Count; ii++)
+	    if (((an16_t *)Pan)->an_Key[ii] == C)
+		return(((an16_t *)Pan)->an_Child + ii);
+	return(NULL);
+
+    case ART48:
+	ii = ((an48_t *)Pan)->an_Index[C];
+	return(ii ? ((an48_t *)Pan)->an_Child + ii - 1 : NULL);
+
+    default:
+	return(((an256_t *)Pan)->an_Child[C]
+	     ? ((an256_t *)Pan)->an_Child + C : NULL);
+    }
+}
+
+// Add Child at byte C to the node in *PSlot, growing it if it is full:
+
+static void
+ArtAddChild(void **PSlot, uint8_t C, void *Child)
+{
+    an_t *Pan = (an_t *)*PSlot;
+    an_t *Pnew;
+    int   ii;
+
+    switch (Pan->an_Type)
+    {
+    case ART4:
+    {
+	an4_t *Pn4 = (an4_t *)Pan;
+
+	if (Pan->an_Count < 4)
+	{
+	    Pn4->an_Key[Pan->an_Count]   = C;
+	    Pn4->an_Child[Pan->an_Count] = Child;
+	    Pan->an_Count++;
+	    return;
+	}
+	Pnew = ArtNewNode(ART16);
+	memcpy(((an16_t *)Pnew)->an_Key, Pn4->an_Key, 4);
+	memcpy(((an16_t *)Pnew)->an_Child, Pn4->an_Child, 4 * sizeof(void *));
+	break;
+    }
+    case ART16:
+    {
+	an16_t *Pn16 = (an16_t *)Pan;
+
+	if (Pan->an_Count < 16)
+	{
+	    Pn16->an_Key[Pan->an_Count]   = C;
+	    Pn16->an_Child[Pan->an_Count] = Child;
+	    Pan->an_Count++;
+	    return;
+	}
+	Pnew = ArtNewNode(ART48);
+	for (ii = 0; ii < 16; ii++)
+	{
+	    ((an48_t *)Pnew)->an_Index[Pn16->an_Key[ii]] = ii + 1;
+	    ((an48_t *)Pnew)->an_Child[ii] = Pn16->an_Child[ii];
+	}
+	break;
+    }
+    case ART48:
+    {
+	an48_t *Pn48 = (an48_t *)Pan;
+
+	if (Pan->an_Count < 48)		// no deletes, so no holes
+	{
+	    Pn48->an_Child[Pan->an_Count] = Child;
+	    Pn48->an_Index[C] = ++Pan->an_Count;
+	    return;
+	}
+	Pnew = ArtNewNode(ART256);
+	for (ii = 0; ii < 256; ii++)
+	    if (Pn48->an_Index[ii])
+		((an256_t *)Pnew)->an_Child[ii] =
+		    Pn48->an_Child[Pn48->an_Index[ii] - 1];
+	break;
+    }
+    default:
+	((an256_t *)Pan)->an_Child[C] = Child;
+	Pan->an_Count++;
+	return;
+    }
+
+//  Grown:  keep the header, free the old node, and add to the new one
+
+    Pnew->an_PrefixLen = Pan->an_PrefixLen;
+    Pnew->an_Count     = Pan->an_Count;
+    memcpy(Pnew->an_Prefix, Pan->an_Prefix, ART_MAXPREFIX);
+    Free(Pan, ArtSize[Pan->an_Type]);
+    *PSlot = Pnew;
+    ArtAddChild(PSlot, C, Child);
+}
+
+// How many bytes of the prefix of a node match Key at Depth:
+
+static int
+ArtPrefixMatch(an_t *Pan, Word_t Key, Word_t Depth)
+{
+    int ii;
+
+    for (ii = 0; ii < Pan->an_PrefixLen; ii++)
+	if (Pan->an_Prefix[ii] != KeyByte(Key, Depth + ii))
+	    break;
+    return(ii);
+}
+
+static Word_t *
+ArtGet(Word_t Key)
+{
+    void  *P = ArtRoot;
+    void **PSlot;
+    Word_t depth = 0;
+
+    while (P != NULL)
+    {
+	an_t *Pan;
+
+	if (ART_ISLEAF(P))
+	{
+	    al_t *Pal = ART_LEAF(P);
+
+	    return(KeyEq(Pal->al_Key, Key) ? &Pal->al_Value : NULL);
+	}
+
+	Pan = (an_t *)P;
+	if (Pan->an_PrefixLen)
+	{
+	    if (ArtPrefixMatch(Pan, Key, depth) < Pan->an_PrefixLen)
+		return(NULL);
+	    depth += Pan->an_PrefixLen;
+	}
+	if ((PSlot = ArtFind(Pan, KeyByte(Key, depth))) == NULL)
+	    return(NULL);
+	P = *PSlot;
+	depth++;
+    }
+    return(NULL);
+}
+
+static al_t *
+ArtNewLeaf(Word_t Key)
+{
+    al_t *Pal = (al_t *)Alloc(sizeof(al_t));
+
+    Pal->al_Key   = KeyCopy(Key);
+    Pal->al_Value = 0;
+    return(Pal);
+}
+
+// Add a new leaf for Key at byte C of the node in *PSlot:
+
+static Word_t *
+ArtAddLeaf(void **PSlot, uint8_t C, Word_t Key)
+{
+    al_t *Pal = ArtNewLeaf(Key);
+
+    ArtAddChild(PSlot, C, ART_TAG(Pal));
+    return(&Pal->al_Value);
+}
+
+static Word_t *
+ArtInsAt(void **PSlot, Word_t Key, Word_t Depth)
+{
+    void  *P = *PSlot;
+    void **PChild;
+    an_t  *Pan;
+    al_t  *Pal;
+    Word_t common;
+    int    match;
+
+    if (P == NULL)
+    {
+	Pal = ArtNewLeaf(Key);
+	*PSlot = ART_TAG(Pal);
+	return(&Pal->al_Value);
+    }
+
+    if (ART_ISLEAF(P))
+    {
+	Pal = ART_LEAF(P);
+	if (KeyEq(Pal->al_Key, Key))
+	    return(&Pal->al_Value);
+
+//	Push the leaf down under a node for the bytes the two share
+
+	for (common = 0; KeyByte(Pal->al_Key, Depth + common)
+		      == KeyByte(Key, Depth + common); common++)
+	    continue;
+
+	Pan = ArtNewNode(ART4);
+	Pan->an_PrefixLen = (common < ART_MAXPREFIX) ? common : ART_MAXPREFIX;
+	for (match = 0; match < Pan->an_PrefixLen; match++)
+	    Pan->an_Prefix[match] = KeyByte(Key, Depth + match);
+	Depth += Pan->an_PrefixLen;
+
+	((an4_t *)Pan)->an_Key[0]   = KeyByte(Pal->al_Key, Depth);
+	((an4_t *)Pan)->an_Child[0] = P;
+	Pan->an_Count = 1;
+	*PSlot = Pan;
+
+	if (Pan->an_PrefixLen < common)	// more in common than a prefix holds
+	    return(ArtInsAt(((an4_t *)Pan)->an_Child, Key, Depth + 1));
+
+	return(ArtAddLeaf(PSlot, KeyByte(Key, Depth), Key));
+    }
+
+    Pan = (an_t *)P;
+    if (Pan->an_PrefixLen)
+    {
+	match = ArtPrefixMatch(Pan, Key, Depth);
+	if (match < Pan->an_PrefixLen)
+	{
+//	    Split the prefix:  a new node for the bytes that match, with the
+//	    old node and the new leaf under it
+
+	    an_t   *Pup = ArtNewNode(ART4);
+	    uint8_t byte = Pan->an_Prefix[match];
+
+	    Pup->an_PrefixLen = match;
+	    memcpy(Pup->an_Prefix, Pan->an_Prefix, match);
+	    Pan->an_PrefixLen -= match + 1;
+	    memmove(Pan->an_Prefix, Pan->an_Prefix + match + 1,
+		    Pan->an_PrefixLen);
+
+	    ((an4_t *)Pup)->an_Key[0]   = byte;
+	    ((an4_t *)Pup)->an_Child[0] = Pan;
+	    Pup->an_Count = 1;
+	    *PSlot = Pup;
+
+	    return(ArtAddLeaf(PSlot, KeyByte(Key, Depth + match), Key));
+	}
+	Depth += Pan->an_PrefixLen;
+    }
+
+    if ((PChild = ArtFind(Pan, KeyByte(Key, Depth))) != NULL)
+	return(ArtInsAt(PChild, Key, Depth + 1));
+
+    return(ArtAddLeaf(PSlot, KeyByte(Key, Depth), Key));
+}
+
+static Word_t *
+ArtIns(Word_t Key)
+{
+    return(ArtInsAt(&ArtRoot, Key, 0));
+}
+
+static void
+ArtFreeNode(void *P)
+{
+    an_t *Pan = (an_t *)P;
+    int   ii;
+
+    if (ART_ISLEAF(P))
+    {
+	KeyFree(ART_LEAF(P)->al_Key);
+	Free(ART_LEAF(P), sizeof(al_t));
+	return;
+    }
+
+    switch (Pan->an_Type)
+    {
+    case ART4:
+	for (ii = 0; ii < Pan->an_Count; ii++)
+	    ArtFreeNode(((an4_t *)Pan)->an_Child[ii]);
+	break;
+    case ART16:
+	for (ii = 0; ii < Pan->an_Count; ii++)
+	    ArtFreeNode(((an16_t *)Pan)->an_Child[ii]);
+	break;
+    case ART48:
+	for (ii = 0; ii < Pan->an_Count; ii++)
+	    ArtFreeNode(((an48_t *)Pan)->an_Child[ii]);
+	break;
+    default:
+	for (ii = 0; ii < 256; ii++)
+	    if (((an256_t *)Pan)->an_Child[ii] != NULL)
+		ArtFreeNode(((an256_t *)Pan)->an_Child[ii]);
+	break;
+    }
+    Free(Pan, ArtSize[Pan->an_Type]);
+}
+
+static void
+ArtFree(void)
+{
+    if (ArtRoot != NULL)
+	ArtFreeNode(ArtRoot);
+    ArtRoot = NULL;
+}
+
+// ****************************************************************************
+// J U D Y
+//
+// The same calls, so each structure is timed through the same function
+// pointers.
+
+Pvoid_t JudyArray = (Pvoid_t) NULL;
+Word_t  HSLength;		// length of the string Index being passed
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "CmpLIns"
+
+static Word_t *
+CmpLIns(Word_t Key)
+{
+    Word_t *PValue;
+
+    JLI(PValue, JudyArray, Key);
+    if (PValue == PJERR)
+	FAILURE("JudyLIns failed at Index", Key);
+    return(PValue);
+}
+
+static Word_t *
+CmpLGet(Word_t Key)
+{
+    Word_t *PValue;
+
+    JLG(PValue, JudyArray, Key);
+    return(PValue);
+}
+
+static void
+CmpLFree(void)
+{
+    Word_t bytes;
+
+    JLFA(bytes, JudyArray);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "CmpSLIns"
+
+static Word_t *
+CmpSLIns(Word_t Key)
+{
+    Word_t *PValue;
+
+    JSLI(PValue, JudyArray, (uint8_t *)Key);
+    if (PValue == PJERR)
+	FAILURE("JudySLIns failed at string number", 0);
+    return(PValue);
+}
+
+static Word_t *
+CmpSLGet(Word_t Key)
+{
+    Word_t *PValue;
+
+    JSLG(PValue, JudyArray, (uint8_t *)Key);
+    return(PValue);
+}
+
+static void
+CmpSLFree(void)
+{
+    Word_t bytes;
+
+    JSLFA(bytes, JudyArray);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "CmpHSIns"
+
+static Word_t *
+CmpHSIns(Word_t Key)
+{
+    Word_t *PValue;
+
+    JHSI(PValue, JudyArray, (void *)Key, HSLength);
+    if (PValue == PJERR)
+	FAILURE("JudyHSIns failed at string number", 0);
+    return(PValue);
+}
+
+static Word_t *
+CmpHSGet(Word_t Key)
+{
+    Word_t *PValue;
+
+    JHSG(PValue, JudyArray, (void *)Key, HSLength);
+    return(PValue);
+}
+
+static void
+CmpHSFree(void)
+{
+    Word_t bytes;
+
+    JHSFA(bytes, JudyArray);
+}
+
+// ****************************************************************************
+// THE STRUCTURES COMPARED:
+
+#define CMP_WORD	1		// takes Word_t Indexes
+#define CMP_STRING	2		// takes string Indexes
+
+typedef struct COMPARED
+{
+    const char *cmp_Name;
+    int         cmp_Keys;		// CMP_WORD and/or CMP_STRING
+    Word_t   *(*cmp_Ins)(Word_t);
+    Word_t   *(*cmp_Get)(Word_t);
+    void      (*cmp_Free)(void);
+} cmp_t;
+
+cmp_t Compared[] =
+{
+    { "JudyL",  CMP_WORD,              CmpLIns,  CmpLGet,  CmpLFree  },
+    { "JudySL", CMP_STRING,            CmpSLIns, CmpSLGet, CmpSLFree },
+    { "JudyHS", CMP_STRING,            CmpHSIns, CmpHSGet, CmpHSFree },
+    { "chain",  CMP_WORD | CMP_STRING, ChainIns,  ChainGet,  ChainFree  },
+    { "swiss",  CMP_WORD | CMP_STRING, SwIns,     SwGet,     SwFree     },
+    { "rbtree", CMP_WORD | CMP_STRING, RbIns,     RbGet,     RbFree     },
+    { "btree",  CMP_WORD | CMP_STRING, BtIns,     BtGet,     BtFree     },
+    { "art",    CMP_WORD | CMP_STRING, ArtIns,    ArtGet,    ArtFree    },
+};
+
+#define COMPARED_COUNT	(sizeof(Compared) / sizeof(Compared[0]))
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+// Nanoseconds since some fixed time:
+
+static double
+NanoSec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((double)ts.tv_sec * 1e9 + (double)ts.tv_nsec);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "MakeStrings"
+
+// 2 * nElms different random strings of MaxLen / 2 to MaxLen characters; a
+// JudyHS array weeds out the repeats, and is freed before anything is
+// counted:
+
+static void
+MakeStrings(void)
+{
+    static const char chars[] =
+	"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-";
+    Pvoid_t seen = (Pvoid_t) NULL;
+    Word_t *PValue;
+    Word_t  elm, ii, len, bytes;
+    char   *str;
+
+    Keys   = (Word_t *)malloc(2 * nElms * sizeof(Word_t));
+    Length = (Word_t *)malloc(2 * nElms * sizeof(Word_t));
+    if ((Keys == NULL) || (Length == NULL))
+	FAILURE("Out of memory for strings, count =", 2 * nElms);
+
+    for (elm = 0; elm < 2 * nElms; )
+    {
+	len = MaxLen / 2 + Random() % (MaxLen - MaxLen / 2 + 1);
+	if ((str = (char *)malloc(len + 1)) == NULL)
+	    FAILURE("Out of memory for strings, count =", elm);
+	for (ii = 0; ii < len; ii++)
+	    str[ii] = chars[Random() % (sizeof(chars) - 1)];
+	str[len] = '\0';
+
+	JHSI(PValue, seen, str, len);
+	if (PValue == PJERR)
+	    FAILURE("JudyHSIns failed at string number", elm);
+	if (*PValue)			// a repeat
+	{
+	    free(str);
+	    continue;
+	}
+	*PValue = 1;
+	Keys[elm]   = (Word_t)str;
+	Length[elm] = len;
+	elm++;
+    }
+    JHSFA(bytes, seen);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Compare"
+
+// Insert, find and miss with one structure, and print its CSV line:
+
+static void
+Compare(cmp_t *Pcmp)
+{
+    Word_t *PValue;
+    Word_t  elm, mem;
+    double  begin, ins, get, miss;
+
+    MemBytes = 0;
+
+    begin = NanoSec();
+    for (elm = 0; elm < nElms; elm++)
+    {
+	if (Length)
+	    HSLength = Length[elm];
+	PValue = (*Pcmp->cmp_Ins)(Keys[elm]);
+	if (*PValue != 0)
+	    FAILURE("Index inserted twice, number", elm);
+	*PValue = elm + 1;
+    }
+    ins = NanoSec() - begin;
+    mem = MemBytes;
+
+    begin = NanoSec();
+    for (elm = 0; elm < nElms; elm++)
+    {
+	if (Length)
+	    HSLength = Length[elm];
+	PValue = (*Pcmp->cmp_Get)(Keys[elm]);
+	if ((PValue == NULL) || (*PValue != elm + 1))
+	    FAILURE("Index not found, number", elm);
+    }
+    get = NanoSec() - begin;
+
+    begin = NanoSec();
+    for (elm = nElms; elm < 2 * nElms; elm++)
+    {
+	if (Length)
+	    HSLength = Length[elm];
+	if ((*Pcmp->cmp_Get)(Keys[elm]) != NULL)
+	    FAILURE("Index found that was not inserted, number", elm);
+    }
+    miss = NanoSec() - begin;
+
+    (*Pcmp->cmp_Free)();
+    if (MemBytes != 0)
+	FAILURE("Bytes not freed =", MemBytes);
+
+    printf("%s,%s,%lu,%.1f,%.1f,%.1f,%.2f\n",
+	   SFlag ? "string" : "word", Pcmp->cmp_Name, nElms,
+	   ins / nElms, get / nElms, miss / nElms, (double)mem / nElms);
+    fflush(stdout);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    Word_t  count, ii;
+    int     c;
+
+    while ((c = getopt(argc, argv, "n:l:s:k:a:S")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No Indexes to compare with, -n", nElms);
+	    break;
+
+	case 'l':
+	    MaxLen = strtoul(optarg, NULL, 0);
+	    if (MaxLen < 2)
+		FAILURE("Strings too short to differ, -l", MaxLen);
+	    break;
+
+	case 's':
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		Seed = 0xc1fc;
+	    break;
+
+	case 'k':
+	    Dist = optarg;
+	    break;
+
+	case 'a':
+	    ADTs = optarg;
+	    break;
+
+	case 'S':
+	    SFlag = 1;
+	    break;
+
+	default:
+	    printf("\nUsage: %s [-n #] [-l #] [-s #] [-k dist] [-a list] "
+		   "[-S]\n\n", argv[0]);
+	    printf("-n #      number of Indexes inserted (%lu)\n", nElms);
+	    printf("-S        string Indexes (else Word_t)\n");
+	    printf("-l #      longest string, shortest is half (%lu)\n",
+		   MaxLen);
+	    printf("-s #      random seed (0x%lx)\n", Seed);
+	    printf("-k dist   Word_t Index distribution (%s), one of:\n", Dist);
+	    JudyKeysHelp();
+	    printf("-a list   structures to compare, by name, comma "
+		   "separated:\n          ");
+	    for (ii = 0; ii < COMPARED_COUNT; ii++)
+		printf(" %s", Compared[ii].cmp_Name);
+	    printf("\n          (default all that take the kind of Index)\n");
+	    printf("\nOne CSV line each:  nanoseconds per insert, lookup and "
+		   "missed lookup,\n");
+	    printf("and bytes per Index from malloc(3), overhead included.\n");
+	    exit(1);
+	}
+    }
+
+    if (SFlag)
+	printf("# JudyCompare -n %lu -S -l %lu -s 0x%lx\n", nElms, MaxLen,
+	       Seed);
+    else
+	printf("# JudyCompare -n %lu -k %s -s 0x%lx\n", nElms, Dist, Seed);
+
+//  Make the Indexes:  the first nElms are inserted, the rest are misses
+
+    if (SFlag)
+	MakeStrings();
+    else
+    {
+	count = 2 * nElms;
+	if ((Keys = JudyKeys(Dist, &count, Seed)) == NULL)
+	    exit(1);
+	if (count < 2)
+	    FAILURE("Too few Indexes from the key trace, count =", count);
+	nElms = count / 2;		// a short trace
+    }
+
+    printf("keys,adt,population,ins_ns,get_ns,miss_ns,bytes_per_index\n");
+
+    for (ii = 0; ii < COMPARED_COUNT; ii++)
+    {
+	cmp_t *Pcmp = Compared + ii;
+
+	if (! (Pcmp->cmp_Keys & (SFlag ? CMP_STRING : CMP_WORD)))
+	    continue;
+	if (ADTs != NULL)		// by name, in a comma separated list
+	{
+	    size_t len = strlen(Pcmp->cmp_Name);
+	    char  *at;
+
+	    for (at = strstr(ADTs, Pcmp->cmp_Name); at != NULL;
+		 at = strstr(at + 1, Pcmp->cmp_Name))
+	    {
+		if (((at == ADTs) || (at[-1] == ','))
+		 && ((at[len] == '\0') || (at[len] == ',')))
+		    break;
+	    }
+	    if (at == NULL)
+		continue;
+	}
+	Compare(Pcmp);
+    }
+    exit(0);
+
+}  // main()
@@ -0,0 +1,194 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyCycles.h $
+//      Hardware counters for the Judy timing programs.
+//
+//      On Linux, JudyCounterOpen() opens one perf_event_open(2) counter of
+//      this process in user mode:  cycles, instructions, L1 data cache and
+//      last level cache misses, data TLB misses or mispredicted branches
+//      (JC_CYCLES .. JC_BRANCHMISSES).  It returns -1 if the machine or the
+//      kernel (see /proc/sys/kernel/perf_event_paranoid) does not allow that
+//      counter, and on other systems always.  Each counter is opened by
+//      itself, not as a group, so one the machine lacks does not keep the
+//      others from counting; if the kernel multiplexes them,
+//      JudyCounterRead() scales the count up by the time the counter was
+//      enabled over the time it ran.
+//
+//      OpenCycles(), StartCycles() and StopCycles() count the cycles of one
+//      piece of code, with the JC_CYCLES counter if it is allowed, otherwise
+//      on x86 the time stamp counter, which counts at a fixed rate near the
+//      nominal clock, not the cycles of a turbo or throttled core; otherwise
+//      none.  CycleSource names which.
+//
+//      The definitions are all here, not in a library, so each program
+//      compiles as one file, as Checkit expects; as they are not static, a
+//      program need not use them all.  Include it after <Judy.h>.
+
+#include <string.h>		// memset()
+
+#ifdef __linux__
+#include <unistd.h>		// read()
+#include <sys/ioctl.h>		// ioctl()
+#include <sys/syscall.h>	// syscall(), __NR_perf_event_open
+#include <linux/perf_event.h>	// struct perf_event_attr
+#endif
+
+#define JC_CYCLES	0
+#define JC_INSTRUCTIONS	1
+#define JC_L1DMISSES	2
+#define JC_LLCMISSES	3
+#define JC_DTLBMISSES	4
+#define JC_BRANCHMISSES	5
+#define JC_COUNTERS	6
+
+// Names for output, such as CSV column headings:
+
+const char *JCName[JC_COUNTERS] =
+{
+    "cycles", "instructions", "l1d_misses",
+    "llc_misses", "dtlb_misses", "branch_misses"
+};
+
+#ifdef __linux__
+
+#define JC_HWCACHE(CACHE) ((CACHE) | (PERF_COUNT_HW_CACHE_OP_READ << 8)	\
+			   | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+const struct { uint32_t Type; uint64_t Config; } JCEvent[JC_COUNTERS] =
+{
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, JC_HWCACHE(PERF_COUNT_HW_CACHE_L1D) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HW_CACHE, JC_HWCACHE(PERF_COUNT_HW_CACHE_DTLB) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+#endif // __linux__
+
+// Open counter JC_*, disabled; return its file descriptor, or -1:
+
+int
+JudyCounterOpen(int Counter)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size		= sizeof(attr);
+    attr.type		= JCEvent[Counter].Type;
+    attr.config		= JCEvent[Counter].Config;
+    attr.disabled	= 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv	= 1;
+    attr.read_format	= PERF_FORMAT_TOTAL_TIME_ENABLED
+			| PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return((int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    (void)Counter;
+    return(-1);
+#endif
+}
+
+// Zero and start one counter; stop it.  Both do nothing given -1:
+
+void
+JudyCounterStart(int Fd)
+{
+#ifdef __linux__
+    if (Fd < 0)
+	return;
+    ioctl(Fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(Fd, PERF_EVENT_IOC_ENABLE, 0);
+#else
+    (void)Fd;
+#endif
+}
+
+void
+JudyCounterStop(int Fd)
+{
+#ifdef __linux__
+    if (Fd >= 0)
+	ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0);
+#else
+    (void)Fd;
+#endif
+}
+
+// The count since JudyCounterStart(), scaled for multiplexing, or < 0 if
+// there is none:
+
+double
+JudyCounterRead(int Fd)
+{
+#ifdef __linux__
+    uint64_t value[3];		// count, time enabled, time running
+
+    if ((Fd < 0)
+     || (read(Fd, value, sizeof(value)) != sizeof(value))
+     || (value[2] == 0))
+	return(-1.0);
+
+    return((double)value[0] * value[1] / value[2]);
+#else
+    (void)Fd;
+    return(-1.0);
+#endif
+}
+
+// THE CYCLE COUNTER:
+
+const char *CycleSource = "none";
+int CycleFd = -1;
+
+void
+OpenCycles(void)
+{
+    CycleFd = JudyCounterOpen(JC_CYCLES);
+    if (CycleFd >= 0)
+    {
+	CycleSource = "perf_event";
+	return;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    CycleSource = "rdtsc";
+#endif
+}
+
+Word_t
+ReadTSC(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int lo, hi;
+
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return(((Word_t)hi << 16 << 16) | lo);
+#else
+    return(0);
+#endif
+}
+
+void
+StartCycles(Word_t *PStart)
+{
+    if (CycleFd >= 0)
+    {
+	JudyCounterStart(CycleFd);
+	return;
+    }
+    *PStart = ReadTSC();
+}
+
+Word_t
+StopCycles(Word_t Start)
+{
+    double count;
+
+    if (CycleFd >= 0)
+    {
+	JudyCounterStop(CycleFd);
+	count = JudyCounterRead(CycleFd);
+	return((count < 0.0) ? 0 : (Word_t)count);
+    }
+    return(ReadTSC() - Start);
+}
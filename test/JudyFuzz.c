@@ -0,0 +1,1591 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyFuzz.c $
+//      This program is a differential fuzz test of Judy1, JudyL, JudySL,
+//      JudySLB and JudyHS:  it reads a sequence of operations out of a string
+//      of bytes, does each one both to a Judy array and to a simple reference
+//      (a sorted array, searched by halves, with the same meaning as a C++
+//      map), and stops with the difference, and abort(), the first time the
+//      two do not agree.
+//
+//      Judy1LHCheck and the other checks run fixed sequences chosen by hand;
+//      a change to the branch and leaf code needs the odd sequences too.
+//      The operations are:
+//
+//      Judy1, JudyL    Set/Ins, Unset/Del, Test/Get, First, Next, Last, Prev,
+//                      FirstEmpty, NextEmpty, LastEmpty, PrevEmpty, Count,
+//                      ByCount, SetArray/InsArray, FreeArray, and a walk of
+//                      the whole array
+//      JudySL          Ins, Del, Get, First, Next, Last, Prev, Count,
+//                      ByCount, a prefix scan, FreeArray, and a walk
+//      JudySLB         Ins, Del, Get, First, Next, Last, Prev, FreeArray, and
+//                      a walk
+//      JudyHS          Ins, Del, Get, GetBatch, FreeArray, and a walk with
+//                      JudyHSFirst() and JudyHSNext()
+//
+//      plus, for each, an insert or delete of a run of up to 1021 Indexes at
+//      once, so that a short input still grows arrays big enough to cascade
+//      into branches and decascade back.
+//
+//      Every JudyL, JudySL, JudySLB and JudyHS value is checked too.  All
+//      memory comes through JudyMalloc() here, which checks that each
+//      JudyFree() gives back the size that was allocated, and that nothing
+//      is left when the arrays are freed at the end of the sequence.
+//
+//      Standalone, the program runs -n sequences of random bytes from seed
+//      -s, deterministically, and writes the bytes of one that fails to a
+//      file (-w) for replay; given files, it replays each of them instead,
+//      and -v prints each operation.  Compiled with -DJUDYFUZZ_LIBFUZZER, it
+//      has no main(), only LLVMFuzzerTestOneInput(), for libFuzzer:
+//
+// # clang -g -O1 -fsanitize=fuzzer,address -DJUDYFUZZ_LIBFUZZER
+//	JudyFuzz.c -I../src ../src/obj/.libs/libJudy.a -o JudyFuzzer
+
+#include <stdlib.h>		// malloc(), abort()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memcmp(), memcpy()
+#include <stdio.h>		// printf()
+
+#include <Judy.h>
+
+// Compile:
+// # cc -O JudyFuzz.c -lJudy -o JudyFuzz
+
+#define FZ_MAXLEN	32		// longest string Index
+#define FZ_MAXARRAY	16		// most Indexes for SetArray/InsArray
+#define FZ_MAXBATCH	8		// most strings for JudyHSGetBatch()
+
+Word_t Verbose = 0;		// print each operation
+char  *FailFile = "JudyFuzz.fail";	// where to write a failing input
+
+// The input being run, for the failure report:
+
+const uint8_t *FzData;
+size_t         FzSize;
+size_t         FzPos;			// next byte to decode
+Word_t         FzOp;			// operations done
+const char    *FzADT = "";		// and the current one
+const char    *FzName = "";
+
+// ****************************************************************************
+// M I S M A T C H
+//
+// Report a difference from the reference, save the input, and abort() (which
+// is what libFuzzer looks for).
+
+static void
+Mismatch(const char *What, Word_t Got, Word_t Want)
+{
+    FILE *fp;
+
+    printf("JudyFuzz: %s %s (operation %lu, input byte %lu): %s:  "
+	   "got 0x%lx, want 0x%lx\n", FzADT, FzName, FzOp, (Word_t)FzPos,
+	   What, Got, Want);
+
+#ifndef JUDYFUZZ_LIBFUZZER
+    if ((FailFile != NULL) && ((fp = fopen(FailFile, "wb")) != NULL))
+    {
+	fwrite(FzData, 1, FzSize, fp);
+	fclose(fp);
+	printf("JudyFuzz: input written to %s\n", FailFile);
+    }
+#else
+    (void) fp;
+#endif
+    fflush(stdout);
+    abort();
+}
+
+#define CHECK(COND, WHAT, GOT, WANT)					\
+    { if (! (COND)) Mismatch(WHAT, (Word_t)(GOT), (Word_t)(WANT)); }
+
+// ****************************************************************************
+// J U D Y   M A L L O C
+//
+// Each allocation is given 2 words ahead of it (which keeps the alignment
+// of malloc()) holding its size and a mark, for JudyFree() to check.
+
+#define FZ_MARK		((Word_t)0x4a75647946757a7aULL)	// "JudyFuzz"
+
+Word_t FzWords;				// words allocated and not freed
+
+Word_t
+JudyMalloc(Word_t Words)
+{
+    PWord_t Pword = (PWord_t)malloc((Words + 2) * sizeof(Word_t));
+
+    if (Pword == NULL)
+	return(0);
+    Pword[0] = Words;
+    Pword[1] = FZ_MARK;
+    FzWords += Words;
+    return((Word_t)(Pword + 2));
+}
+
+void
+JudyFree(void *PWord, Word_t Words)
+{
+    PWord_t Pword = (PWord_t)PWord - 2;
+
+    CHECK(Pword[1] == FZ_MARK, "JudyFree() of memory not allocated",
+	  Pword[1], FZ_MARK);
+    CHECK(Pword[0] == Words, "JudyFree() size", Words, Pword[0]);
+    Pword[1] = 0;
+    FzWords -= Words;
+    free(Pword);
+}
+
+Word_t
+JudyMallocVirtual(Word_t Words)
+{
+    return(JudyMalloc(Words));
+}
+
+void
+JudyFreeVirtual(void *PWord, Word_t Words)
+{
+    JudyFree(PWord, Words);
+}
+
+// ****************************************************************************
+// D E C O D I N G
+//
+// Each operation takes a byte for the array, a byte for what to do, then as
+// many bytes as it needs; past the end, every byte is 0.
+
+static uint8_t
+Byte(void)
+{
+    return((FzPos < FzSize) ? FzData[FzPos++] : 0);
+}
+
+// ****************************************************************************
+// T H E   R E F E R E N C E S
+
+// Word_t Indexes (Judy1, JudyL), in order:
+
+typedef struct REFWORD
+{
+    Word_t *rw_Index;
+    Word_t *rw_Value;
+    Word_t  rw_Pop;
+    Word_t  rw_Size;
+} rw_t;
+
+// String Indexes (JudySL, JudySLB, JudyHS), in memcmp() order, a prefix
+// before any longer Index:
+
+typedef struct REFSTRING
+{
+    uint8_t **rs_Str;
+    Word_t   *rs_Len;
+    Word_t   *rs_Value;
+    Word_t    rs_Pop;
+    Word_t    rs_Size;
+} rs_t;
+
+static void *
+Grow(void *P, Word_t Items)
+{
+    if ((P = realloc(P, Items * sizeof(Word_t))) == NULL)
+    {
+	printf("JudyFuzz: out of memory\n");
+	abort();
+    }
+    return(P);
+}
+
+// First position with an Index at or above Index:
+
+static Word_t
+RefWordPos(rw_t *Prw, Word_t Index)
+{
+    Word_t low = 0, high = Prw->rw_Pop, mid;
+
+    while (low < high)
+    {
+	mid = (low + high) / 2;
+	if (Prw->rw_Index[mid] < Index)
+	    low = mid + 1;
+	else
+	    high = mid;
+    }
+    return(low);
+}
+
+static int
+RefWordHas(rw_t *Prw, Word_t Index, Word_t *PPos)
+{
+    *PPos = RefWordPos(Prw, Index);
+    return((*PPos < Prw->rw_Pop) && (Prw->rw_Index[*PPos] == Index));
+}
+
+static void
+RefWordIns(rw_t *Prw, Word_t Pos, Word_t Index, Word_t Value)
+{
+    if (Prw->rw_Pop == Prw->rw_Size)
+    {
+	Prw->rw_Size  = Prw->rw_Size ? Prw->rw_Size * 2 : 64;
+	Prw->rw_Index = (Word_t *)Grow(Prw->rw_Index, Prw->rw_Size);
+	Prw->rw_Value = (Word_t *)Grow(Prw->rw_Value, Prw->rw_Size);
+    }
+    memmove(Prw->rw_Index + Pos + 1, Prw->rw_Index + Pos,
+	    (Prw->rw_Pop - Pos) * sizeof(Word_t));
+    memmove(Prw->rw_Value + Pos + 1, Prw->rw_Value + Pos,
+	    (Prw->rw_Pop - Pos) * sizeof(Word_t));
+    Prw->rw_Index[Pos] = Index;
+    Prw->rw_Value[Pos] = Value;
+    Prw->rw_Pop++;
+}
+
+static void
+RefWordDel(rw_t *Prw, Word_t Pos)
+{
+    Prw->rw_Pop--;
+    memmove(Prw->rw_Index + Pos, Prw->rw_Index + Pos + 1,
+	    (Prw->rw_Pop - Pos) * sizeof(Word_t));
+    memmove(Prw->rw_Value + Pos, Prw->rw_Value + Pos + 1,
+	    (Prw->rw_Pop - Pos) * sizeof(Word_t));
+}
+
+// The first (Up) or last (! Up) Index not in the reference, from Index on;
+// return 0 if there is none:
+
+static int
+RefWordEmpty(rw_t *Prw, Word_t *PIndex, int Up)
+{
+    Word_t index = *PIndex;
+    Word_t pos;
+
+    if (! RefWordHas(Prw, index, &pos))
+	return(1);
+
+    if (Up)
+    {
+	for ( ; (pos < Prw->rw_Pop) && (Prw->rw_Index[pos] == index); pos++)
+	    if (index++ == ~(Word_t)0)
+		return(0);
+    }
+    else
+    {
+	for ( ; Prw->rw_Index[pos] == index; pos--)
+	{
+	    if (index-- == 0)
+		return(0);
+	    if (pos == 0)
+		break;
+	}
+    }
+    *PIndex = index;
+    return(1);
+}
+
+static int
+StrCmp(const uint8_t *A, Word_t ALen, const uint8_t *B, Word_t BLen)
+{
+    int cmp = memcmp(A, B, (ALen < BLen) ? ALen : BLen);
+
+    if (cmp)
+	return(cmp);
+    return((ALen > BLen) - (ALen < BLen));
+}
+
+static Word_t
+RefStrPos(rs_t *Prs, const uint8_t *Str, Word_t Len)
+{
+    Word_t low = 0, high = Prs->rs_Pop, mid;
+
+    while (low < high)
+    {
+	mid = (low + high) / 2;
+	if (StrCmp(Prs->rs_Str[mid], Prs->rs_Len[mid], Str, Len) < 0)
+	    low = mid + 1;
+	else
+	    high = mid;
+    }
+    return(low);
+}
+
+static int
+RefStrHas(rs_t *Prs, const uint8_t *Str, Word_t Len, Word_t *PPos)
+{
+    *PPos = RefStrPos(Prs, Str, Len);
+    return((*PPos < Prs->rs_Pop)
+	&& (StrCmp(Prs->rs_Str[*PPos], Prs->rs_Len[*PPos], Str, Len) == 0));
+}
+
+static void
+RefStrIns(rs_t *Prs, Word_t Pos, const uint8_t *Str, Word_t Len,
+	  Word_t Value)
+{
+    uint8_t *copy;
+
+    if (Prs->rs_Pop == Prs->rs_Size)
+    {
+	Prs->rs_Size  = Prs->rs_Size ? Prs->rs_Size * 2 : 64;
+	Prs->rs_Str   = (uint8_t **)Grow(Prs->rs_Str, Prs->rs_Size);
+	Prs->rs_Len   = (Word_t *)Grow(Prs->rs_Len, Prs->rs_Size);
+	Prs->rs_Value = (Word_t *)Grow(Prs->rs_Value, Prs->rs_Size);
+    }
+    if ((copy = (uint8_t *)malloc(Len + 1)) == NULL)
+    {
+	printf("JudyFuzz: out of memory\n");
+	abort();
+    }
+    memcpy(copy, Str, Len);
+    copy[Len] = '\0';
+
+    memmove(Prs->rs_Str + Pos + 1, Prs->rs_Str + Pos,
+	    (Prs->rs_Pop - Pos) * sizeof(uint8_t *));
+    memmove(Prs->rs_Len + Pos + 1, Prs->rs_Len + Pos,
+	    (Prs->rs_Pop - Pos) * sizeof(Word_t));
+    memmove(Prs->rs_Value + Pos + 1, Prs->rs_Value + Pos,
+	    (Prs->rs_Pop - Pos) * sizeof(Word_t));
+    Prs->rs_Str[Pos]   = copy;
+    Prs->rs_Len[Pos]   = Len;
+    Prs->rs_Value[Pos] = Value;
+    Prs->rs_Pop++;
+}
+
+static void
+RefStrDel(rs_t *Prs, Word_t Pos)
+{
+    free(Prs->rs_Str[Pos]);
+    Prs->rs_Pop--;
+    memmove(Prs->rs_Str + Pos, Prs->rs_Str + Pos + 1,
+	    (Prs->rs_Pop - Pos) * sizeof(uint8_t *));
+    memmove(Prs->rs_Len + Pos, Prs->rs_Len + Pos + 1,
+	    (Prs->rs_Pop - Pos) * sizeof(Word_t));
+    memmove(Prs->rs_Value + Pos, Prs->rs_Value + Pos + 1,
+	    (Prs->rs_Pop - Pos) * sizeof(Word_t));
+}
+
+static void
+RefStrFree(rs_t *Prs)
+{
+    while (Prs->rs_Pop)
+	RefStrDel(Prs, Prs->rs_Pop - 1);
+}
+
+// ****************************************************************************
+// T H E   A R R A Y S
+
+#define A_JUDY1		0
+#define A_JUDYL		1
+#define A_JUDYSL	2
+#define A_JUDYSLB	3
+#define A_JUDYHS	4
+#define A_COUNT		5
+
+const char *ADTName[A_COUNT] =
+    { "Judy1", "JudyL", "JudySL", "JudySLB", "JudyHS" };
+
+Pvoid_t PArray[A_COUNT];
+rw_t    RefWord[2];			// Judy1, JudyL
+rs_t    RefStr[3];			// JudySL, JudySLB, JudyHS
+Word_t  NextValue;			// a new value for each store
+
+// A Word_t Index, mostly near others or at the edges, where the bugs are:
+
+static Word_t
+WordIndex(rw_t *Prw)
+{
+    static Word_t last;			// the Index before
+    Word_t        index, shift;
+    uint8_t       how = Byte();
+
+    switch (how & 7)
+    {
+    case 0:				// small
+    case 1:
+	index = Byte();
+	break;
+
+    case 2:				// 2 bytes, at any level
+	shift  = (Byte() % sizeof(Word_t)) * 8;
+	index  = (Word_t)Byte() << 8;
+	index |= Byte();
+	index <<= shift;
+	break;
+
+    case 3:				// near the one before
+	index = last + (Word_t)(long)(int8_t)Byte();
+	break;
+
+    case 4:				// one in the array, or next to it
+    case 5:
+	if (Prw->rw_Pop == 0)
+	{
+	    index = Byte();
+	    break;
+	}
+	index  = Prw->rw_Index[Byte() % Prw->rw_Pop];
+	index += (Word_t)(long)((how >> 3) % 3) - 1;
+	break;
+
+    case 6:				// any
+	for (index = shift = 0; shift < sizeof(Word_t); shift++)
+	    index = (index << 8) | Byte();
+	break;
+
+    default:				// at the top of a level, or of all
+	shift = (Byte() % sizeof(Word_t)) * 8;
+	index = (((Word_t)1 << shift) << 8) - 1 - (how >> 3 & 3);
+	break;
+    }
+    return(last = index);
+}
+
+// A string Index of up to FZ_MAXLEN bytes into Str, its length returned;
+// for JudySL (NoZero) with no \0 and terminated by one:
+
+static Word_t
+StrIndex(rs_t *Prs, uint8_t *Str, int NoZero)
+{
+    static uint8_t last[FZ_MAXLEN];	// the Index before
+    static Word_t  lastlen;
+    Word_t         len, ii, bits = 0;
+    uint8_t        how = Byte();
+    uint8_t        size = Byte();
+
+    len = (size & 0x80) ? size % (FZ_MAXLEN + 1) : size % 10;
+
+    switch (how & 3)
+    {
+    case 0:				// any bytes
+	for (ii = 0; ii < len; ii++)
+	    Str[ii] = Byte();
+	break;
+
+    case 1:				// only a and b, to share prefixes
+	for (ii = 0; ii < len; ii++)
+	{
+	    if (ii % 8 == 0)
+		bits = Byte();
+	    Str[ii] = 'a' + (bits & 1);
+	    bits >>= 1;
+	}
+	break;
+
+    case 2:				// the one before, changed
+	memcpy(Str, last, lastlen);
+	for (ii = lastlen; ii < len; ii++)
+	    Str[ii] = 'a';
+	if (len)
+	    Str[Byte() % len] ^= 1 + (how >> 2);
+	break;
+
+    default:				// one in the array
+	if (Prs->rs_Pop == 0)
+	{
+	    len = 0;
+	    break;
+	}
+	ii  = Byte() % Prs->rs_Pop;
+	len = Prs->rs_Len[ii];
+	memcpy(Str, Prs->rs_Str[ii], len);
+	break;
+    }
+
+    if (NoZero)
+    {
+	for (ii = 0; ii < len; ii++)
+	    if (Str[ii] == '\0')
+		Str[ii] = 1;
+	Str[len] = '\0';
+    }
+    memcpy(last, Str, len);
+    lastlen = len;
+    return(len);
+}
+
+static void
+Trace(Word_t Index)
+{
+    if (Verbose)
+	printf("%lu: %s %s 0x%lx\n", FzOp, FzADT, FzName, Index);
+}
+
+static void
+TraceStr(const uint8_t *Str, Word_t Len)
+{
+    Word_t ii;
+
+    if (! Verbose)
+	return;
+    printf("%lu: %s %s \"", FzOp, FzADT, FzName);
+    for (ii = 0; ii < Len; ii++)
+	printf((Str[ii] >= ' ') && (Str[ii] < 0x7f) ? "%c" : "\\x%02x",
+	       Str[ii]);
+    printf("\" (%lu)\n", Len);
+}
+
+// ****************************************************************************
+// J U D Y 1   A N D   J U D Y L
+
+#define W_INS		0
+#define W_DEL		1
+#define W_GET		2
+#define W_FIRST		3
+#define W_NEXT		4
+#define W_LAST		5
+#define W_PREV		6
+#define W_FIRSTEMPTY	7
+#define W_NEXTEMPTY	8
+#define W_LASTEMPTY	9
+#define W_PREVEMPTY	10
+#define W_COUNT		11
+#define W_BYCOUNT	12
+#define W_INSARRAY	13
+#define W_FREE		14
+#define W_WALK		15
+#define W_INSRUN	16
+#define W_DELRUN	17
+
+const char *WOpName[] =
+{
+    "Ins", "Del", "Get", "First", "Next", "Last", "Prev", "FirstEmpty",
+    "NextEmpty", "LastEmpty", "PrevEmpty", "Count", "ByCount", "InsArray",
+    "FreeArray", "walk", "Ins run", "Del run"
+};
+
+// Of 32, how often each is done:  inserts most, frees seldom
+
+const uint8_t WOps[32] =
+{
+    W_INS, W_INS, W_INS, W_INS, W_INS, W_INS, W_INSRUN, W_INSRUN,
+    W_DELRUN, W_INS, W_DEL, W_DEL, W_DEL, W_DEL, W_DEL, W_GET,
+    W_GET, W_FIRST, W_NEXT, W_LAST, W_PREV, W_FIRSTEMPTY, W_NEXTEMPTY,
+    W_LASTEMPTY, W_PREVEMPTY, W_COUNT, W_COUNT, W_BYCOUNT, W_BYCOUNT,
+    W_INSARRAY, W_WALK, W_FREE
+};
+
+// Check a JudyL value area against the reference value at Pos:
+
+static void
+CheckValue(int ADT, PPvoid_t PPValue, Word_t Pos)
+{
+    if (ADT == A_JUDYL)
+	CHECK(*(PWord_t)PPValue == RefWord[1].rw_Value[Pos], "value",
+	      *(PWord_t)PPValue, RefWord[1].rw_Value[Pos]);
+}
+
+// Do a search (First, Next, Last, Prev) and check the Index it finds, if any:
+
+static void
+WordSearch(int ADT, int Op, Word_t Index)
+{
+    rw_t    *Prw = RefWord + ADT;
+    Word_t   pos, want = Index, got = Index;
+    PPvoid_t PPValue = NULL;
+    int      found = 0, Rc = 0;
+
+//  The reference:
+
+    pos = RefWordPos(Prw, Index);
+    switch (Op)
+    {
+    case W_NEXT:			// skip Index itself
+	if ((pos < Prw->rw_Pop) && (Prw->rw_Index[pos] == Index))
+	    pos++;
+	/* FALLTHROUGH */
+    case W_FIRST:
+	if ((found = (pos < Prw->rw_Pop)))
+	    want = Prw->rw_Index[pos];
+	break;
+
+    case W_LAST:			// Index itself, if there
+	if ((pos < Prw->rw_Pop) && (Prw->rw_Index[pos] == Index))
+	{
+	    found = 1;
+	    want  = Index;
+	    break;
+	}
+	/* FALLTHROUGH */
+    case W_PREV:
+	if ((found = (pos > 0)))
+	    want = Prw->rw_Index[--pos];
+	break;
+    }
+
+//  Judy:
+
+    if (ADT == A_JUDY1)
+    {
+	switch (Op)
+	{
+	case W_FIRST: Rc = Judy1First(PArray[ADT], &got, PJE0); break;
+	case W_NEXT:  Rc = Judy1Next( PArray[ADT], &got, PJE0); break;
+	case W_LAST:  Rc = Judy1Last( PArray[ADT], &got, PJE0); break;
+	case W_PREV:  Rc = Judy1Prev( PArray[ADT], &got, PJE0); break;
+	}
+	CHECK(Rc != JERR, "error return", Rc, found);
+    }
+    else
+    {
+	switch (Op)
+	{
+	case W_FIRST: PPValue = JudyLFirst(PArray[ADT], &got, PJE0); break;
+	case W_NEXT:  PPValue = JudyLNext( PArray[ADT], &got, PJE0); break;
+	case W_LAST:  PPValue = JudyLLast( PArray[ADT], &got, PJE0); break;
+	case W_PREV:  PPValue = JudyLPrev( PArray[ADT], &got, PJE0); break;
+	}
+	CHECK(PPValue != PPJERR, "error return", -1, found);
+	Rc = (PPValue != NULL);
+    }
+
+    CHECK(Rc == found, "found", Rc, found);
+    if (found)
+    {
+	CHECK(got == want, "Index found", got, want);
+	if (PPValue != NULL)
+	    CheckValue(ADT, PPValue, pos);
+    }
+}
+
+static void
+WordEmpty(int ADT, int Op, Word_t Index)
+{
+    rw_t  *Prw = RefWord + ADT;
+    Word_t want = Index, got = Index;
+    int    found, Rc = 0;
+
+    switch (Op)
+    {
+    case W_FIRSTEMPTY:
+	found = RefWordEmpty(Prw, &want, 1);
+	break;
+    case W_NEXTEMPTY:
+	found = (want++ != ~(Word_t)0) && RefWordEmpty(Prw, &want, 1);
+	break;
+    case W_LASTEMPTY:
+	found = RefWordEmpty(Prw, &want, 0);
+	break;
+    default:
+	found = (want-- != 0) && RefWordEmpty(Prw, &want, 0);
+	break;
+    }
+
+    switch (Op + (ADT == A_JUDYL) * 100)
+    {
+    case W_FIRSTEMPTY:       Rc = Judy1FirstEmpty(PArray[ADT], &got, PJE0);
+			     break;
+    case W_NEXTEMPTY:        Rc = Judy1NextEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    case W_LASTEMPTY:        Rc = Judy1LastEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    case W_PREVEMPTY:        Rc = Judy1PrevEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    case W_FIRSTEMPTY + 100: Rc = JudyLFirstEmpty(PArray[ADT], &got, PJE0);
+			     break;
+    case W_NEXTEMPTY + 100:  Rc = JudyLNextEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    case W_LASTEMPTY + 100:  Rc = JudyLLastEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    case W_PREVEMPTY + 100:  Rc = JudyLPrevEmpty( PArray[ADT], &got, PJE0);
+			     break;
+    }
+    CHECK(Rc != JERR, "error return", Rc, found);
+    CHECK(Rc == found, "found", Rc, found);
+    if (found)
+	CHECK(got == want, "empty Index found", got, want);
+}
+
+// Walk the whole array, both ways, checking every Index (and value):
+
+static void
+WordWalk(int ADT)
+{
+    rw_t    *Prw = RefWord + ADT;
+    Word_t   pos, index, count;
+    PPvoid_t PPValue;
+    JValidate_t Validate;
+    int      Rc;
+
+    for (pos = 0, index = 0; ; pos++)
+    {
+	if (ADT == A_JUDY1)
+	{
+	    Rc = pos ? Judy1Next(PArray[ADT], &index, PJE0)
+		     : Judy1First(PArray[ADT], &index, PJE0);
+	    PPValue = NULL;
+	}
+	else
+	{
+	    PPValue = pos ? JudyLNext(PArray[ADT], &index, PJE0)
+			  : JudyLFirst(PArray[ADT], &index, PJE0);
+	    CHECK(PPValue != PPJERR, "walk error return", pos, 0);
+	    Rc = (PPValue != NULL);
+	}
+	CHECK(Rc == (pos < Prw->rw_Pop), "walk found", Rc, pos);
+	if (! Rc)
+	    break;
+	CHECK(index == Prw->rw_Index[pos], "walk Index", index,
+	      Prw->rw_Index[pos]);
+	if (PPValue != NULL)
+	    CheckValue(ADT, PPValue, pos);
+    }
+
+    for (pos = Prw->rw_Pop, index = ~(Word_t)0; ; pos--)
+    {
+	if (ADT == A_JUDY1)
+	    Rc = (pos < Prw->rw_Pop) ? Judy1Prev(PArray[ADT], &index, PJE0)
+				     : Judy1Last(PArray[ADT], &index, PJE0);
+	else
+	    Rc = (((pos < Prw->rw_Pop)
+		   ? JudyLPrev(PArray[ADT], &index, PJE0)
+		   : JudyLLast(PArray[ADT], &index, PJE0)) != NULL);
+	CHECK(Rc == (pos > 0), "walk back found", Rc, pos);
+	if (! Rc)
+	    break;
+	CHECK(index == Prw->rw_Index[pos - 1], "walk back Index", index,
+	      Prw->rw_Index[pos - 1]);
+    }
+
+    count = (ADT == A_JUDY1) ? Judy1Count(PArray[ADT], 0, ~(Word_t)0, PJE0)
+			     : JudyLCount(PArray[ADT], 0, ~(Word_t)0, PJE0);
+    CHECK(count == Prw->rw_Pop, "population", count, Prw->rw_Pop);
+
+    Rc = (ADT == A_JUDY1) ? Judy1Validate(PArray[ADT], &Validate, PJE0)
+			  : JudyLValidate(PArray[ADT], &Validate, PJE0);
+    CHECK(Rc == 1, "Validate", Validate.jv_Check, JV_OK);
+}
+
+// Insert (Set) one Index, giving a JudyL Index a new value:
+
+static void
+WordIns(int ADT, Word_t Index)
+{
+    rw_t    *Prw = RefWord + ADT;
+    Word_t   pos;
+    PPvoid_t PPValue;
+    int      Rc, has;
+
+    has = RefWordHas(Prw, Index, &pos);
+    if (ADT == A_JUDY1)
+    {
+	Rc = Judy1Set(PArray + ADT, Index, PJE0);
+	CHECK(Rc == ! has, "Judy1Set return", Rc, ! has);
+	if (! has)
+	    RefWordIns(Prw, pos, Index, 0);
+	return;
+    }
+    PPValue = JudyLIns(PArray + ADT, Index, PJE0);
+    CHECK((PPValue != NULL) && (PPValue != PPJERR), "JudyLIns return",
+	  PPValue, 0);
+    if (has)
+	CheckValue(ADT, PPValue, pos);
+    else
+    {
+	CHECK(*(PWord_t)PPValue == 0, "new value", *(PWord_t)PPValue, 0);
+	RefWordIns(Prw, pos, Index, 0);
+    }
+    *(PWord_t)PPValue = Prw->rw_Value[pos] = ++NextValue;
+}
+
+static void
+WordDel(int ADT, Word_t Index)
+{
+    rw_t  *Prw = RefWord + ADT;
+    Word_t pos;
+    int    Rc, has;
+
+    has = RefWordHas(Prw, Index, &pos);
+    Rc = (ADT == A_JUDY1) ? Judy1Unset(PArray + ADT, Index, PJE0)
+			  : JudyLDel(PArray + ADT, Index, PJE0);
+    CHECK(Rc == has, "delete return", Rc, has);
+    if (has)
+	RefWordDel(Prw, pos);
+}
+
+static void
+WordOp(int ADT, int Op)
+{
+    rw_t    *Prw = RefWord + ADT;
+    Word_t   index, index2, pos, pos2, count, want, ii;
+    Word_t   indexes[FZ_MAXARRAY], values[FZ_MAXARRAY];
+    PPvoid_t PPValue;
+    int      Rc, has;
+
+    switch (Op)
+    {
+    case W_INS:
+	index = WordIndex(Prw);
+	Trace(index);
+	WordIns(ADT, index);
+	break;
+
+    case W_DEL:
+	index = WordIndex(Prw);
+	Trace(index);
+	WordDel(ADT, index);
+	break;
+
+    case W_INSRUN:
+    case W_DELRUN:
+    {
+	uint8_t step;
+
+//	Up to 1021 Indexes from one decoded, spaced by 1..128 or a power of 2
+
+	index = WordIndex(Prw);
+	count = 1 + Byte() * 4;
+	step  = Byte();
+	want  = (step & 0x80) ? (Word_t)1 << (step % (8 * sizeof(Word_t)))
+			      : 1 + step;
+	Trace(index);
+	for (ii = 0; ii < count; ii++, index += want)
+	{
+	    if (Op == W_INSRUN)
+		WordIns(ADT, index);
+	    else
+		WordDel(ADT, index);
+	}
+	break;
+    }
+
+    case W_GET:
+	index = WordIndex(Prw);
+	Trace(index);
+	has = RefWordHas(Prw, index, &pos);
+	if (ADT == A_JUDY1)
+	{
+	    Rc = Judy1Test(PArray[ADT], index, PJE0);
+	    CHECK(Rc == has, "Judy1Test return", Rc, has);
+	    break;
+	}
+	PPValue = JudyLGet(PArray[ADT], index, PJE0);
+	CHECK(PPValue != PPJERR, "JudyLGet error return", -1, has);
+	CHECK((PPValue != NULL) == has, "JudyLGet found", PPValue != NULL,
+	      has);
+	if (has)
+	    CheckValue(ADT, PPValue, pos);
+	break;
+
+    case W_FIRST:
+    case W_NEXT:
+    case W_LAST:
+    case W_PREV:
+	index = WordIndex(Prw);
+	Trace(index);
+	WordSearch(ADT, Op, index);
+	break;
+
+    case W_FIRSTEMPTY:
+    case W_NEXTEMPTY:
+    case W_LASTEMPTY:
+    case W_PREVEMPTY:
+	index = WordIndex(Prw);
+	Trace(index);
+	WordEmpty(ADT, Op, index);
+	break;
+
+    case W_COUNT:
+	index  = WordIndex(Prw);
+	index2 = WordIndex(Prw);
+	Trace(index);
+	pos  = RefWordPos(Prw, index);
+	pos2 = RefWordPos(Prw, index2);
+	if ((pos2 < Prw->rw_Pop) && (Prw->rw_Index[pos2] == index2))
+	    pos2++;			// through Index2
+	want = (index <= index2) ? pos2 - pos : 0;
+	count = (ADT == A_JUDY1)
+	      ? Judy1Count(PArray[ADT], index, index2, PJE0)
+	      : JudyLCount(PArray[ADT], index, index2, PJE0);
+	CHECK(count == want, "Count", count, want);
+	break;
+
+    case W_BYCOUNT:
+	count = Byte() % (Prw->rw_Pop + 2);	// 0 and Pop + 1 miss
+	Trace(count);
+	has = (count >= 1) && (count <= Prw->rw_Pop);
+	index = 0;
+	if (ADT == A_JUDY1)
+	    Rc = Judy1ByCount(PArray[ADT], count, &index, PJE0);
+	else
+	{
+	    PPValue = JudyLByCount(PArray[ADT], count, &index, PJE0);
+	    Rc = (PPValue != NULL) && (PPValue != PPJERR);
+	    if (Rc && has)
+		CheckValue(ADT, PPValue, count - 1);
+	}
+	CHECK(Rc == has, "ByCount found", Rc, has);
+	if (has)
+	    CHECK(index == Prw->rw_Index[count - 1], "ByCount Index", index,
+		  Prw->rw_Index[count - 1]);
+	break;
+
+    case W_INSARRAY:
+    {
+	JError_t JError;
+
+//	Up to FZ_MAXARRAY Indexes, sorted, with no repeats
+
+	count = 1 + Byte() % FZ_MAXARRAY;
+	for (ii = 0; ii < count; ii++)
+	    indexes[ii] = WordIndex(Prw);
+	for (ii = 1; ii < count; ii++)		// insertion sort
+	{
+	    index = indexes[ii];
+	    for (pos = ii; (pos > 0) && (indexes[pos - 1] > index); pos--)
+		indexes[pos] = indexes[pos - 1];
+	    indexes[pos] = index;
+	}
+	for (ii = pos = 0; ii < count; ii++)
+	    if ((ii == 0) || (indexes[ii] != indexes[pos - 1]))
+		indexes[pos++] = indexes[ii];
+	count = pos;
+	for (ii = 0; ii < count; ii++)
+	    values[ii] = ++NextValue;
+	Trace(count);
+
+//	Only an empty array can take them
+
+	Rc = (ADT == A_JUDY1)
+	   ? Judy1SetArray(PArray + ADT, count, indexes, &JError)
+	   : JudyLInsArray(PArray + ADT, count, indexes, values, &JError);
+	if (Prw->rw_Pop)
+	{
+	    CHECK(Rc == JERR, "InsArray into a full array", Rc, JERR);
+	    CHECK(JU_ERRNO(&JError) == JU_ERRNO_NONNULLPARRAY,
+		  "InsArray errno", JU_ERRNO(&JError), JU_ERRNO_NONNULLPARRAY);
+	    break;
+	}
+	CHECK(Rc == 1, "InsArray return", Rc, 1);
+	for (ii = 0; ii < count; ii++)
+	    RefWordIns(Prw, ii, indexes[ii], (ADT == A_JUDY1) ? 0 : values[ii]);
+	break;
+    }
+
+    case W_FREE:
+	Trace(Prw->rw_Pop);
+	count = (ADT == A_JUDY1) ? Judy1FreeArray(PArray + ADT, PJE0)
+				 : JudyLFreeArray(PArray + ADT, PJE0);
+	CHECK(count != JERR, "FreeArray return", count, 0);
+	CHECK(PArray[ADT] == NULL, "array after FreeArray", PArray[ADT], 0);
+	Prw->rw_Pop = 0;
+	break;
+
+    default:
+	Trace(Prw->rw_Pop);
+	WordWalk(ADT);
+	break;
+    }
+}
+
+// ****************************************************************************
+// J U D Y S L ,   J U D Y S L B   A N D   J U D Y H S
+
+#define S_INS		0
+#define S_DEL		1
+#define S_GET		2
+#define S_FIRST		3
+#define S_NEXT		4
+#define S_LAST		5
+#define S_PREV		6
+#define S_COUNT		7
+#define S_BYCOUNT	8
+#define S_PREFIX	9
+#define S_BATCH		10
+#define S_FREE		11
+#define S_WALK		12
+#define S_INSRUN	13
+#define S_DELRUN	14
+#define S_COUNTINIT	15
+
+const char *SOpName[] =
+{
+    "Ins", "Del", "Get", "First", "Next", "Last", "Prev", "Count", "ByCount",
+    "PrefixFirst", "GetBatch", "FreeArray", "walk", "Ins run", "Del run",
+    "CountInit"
+};
+
+const uint8_t SOps[32] =
+{
+    S_INS, S_INS, S_INS, S_INS, S_INS, S_INS, S_INSRUN, S_INSRUN,
+    S_DELRUN, S_INS, S_DEL, S_DEL, S_DEL, S_DEL, S_DEL, S_GET,
+    S_GET, S_FIRST, S_NEXT, S_LAST, S_PREV, S_FIRST, S_NEXT, S_LAST,
+    S_PREV, S_COUNT, S_BYCOUNT, S_PREFIX, S_BATCH, S_WALK, S_COUNTINIT, S_FREE
+};
+
+// What each array can do (JudySL all but GetBatch):
+
+static int
+StrCan(int ADT, int Op)
+{
+    switch (Op)
+    {
+    case S_INS: case S_DEL: case S_GET: case S_FREE: case S_WALK:
+    case S_INSRUN: case S_DELRUN:
+	return(1);
+    case S_BATCH:
+	return(ADT == A_JUDYHS);
+    case S_FIRST: case S_NEXT: case S_LAST: case S_PREV:
+	return(ADT != A_JUDYHS);
+    default:
+	return(ADT == A_JUDYSL);
+    }
+}
+
+static PPvoid_t
+StrGet(int ADT, uint8_t *Str, Word_t Len)
+{
+    switch (ADT)
+    {
+    case A_JUDYSL:  return(JudySLGet(PArray[ADT], Str, PJE0));
+    case A_JUDYSLB: return(JudySLBGet(PArray[ADT], Str, Len, PJE0));
+    default:        return(JudyHSGet(PArray[ADT], Str, Len));
+    }
+}
+
+static void
+StrCheckValue(PPvoid_t PPValue, rs_t *Prs, Word_t Pos)
+{
+    CHECK(*(PWord_t)PPValue == Prs->rs_Value[Pos], "value",
+	  *(PWord_t)PPValue, Prs->rs_Value[Pos]);
+}
+
+// Do a search (First, Next, Last, Prev), in JudySL or JudySLB:
+
+static void
+StrSearch(int ADT, int Op, uint8_t *Str, Word_t Len)
+{
+    rs_t    *Prs = RefStr + ADT - A_JUDYSL;
+    uint8_t  got[FZ_MAXLEN + 1];
+    Word_t   gotlen = Len, pos;
+    PPvoid_t PPValue = NULL;
+    int      has, found = 0;
+
+    has = RefStrHas(Prs, Str, Len, &pos);
+    switch (Op)
+    {
+    case S_NEXT:
+	pos += has;
+	/* FALLTHROUGH */
+    case S_FIRST:
+	found = (pos < Prs->rs_Pop);
+	break;
+    case S_LAST:
+	if ((found = has))
+	    break;
+	/* FALLTHROUGH */
+    case S_PREV:
+	if ((found = (pos > 0)))
+	    pos--;
+	break;
+    }
+
+    memcpy(got, Str, Len + 1);
+    if (ADT == A_JUDYSL)
+    {
+	switch (Op)
+	{
+	case S_FIRST: PPValue = JudySLFirst(PArray[ADT], got, PJE0); break;
+	case S_NEXT:  PPValue = JudySLNext( PArray[ADT], got, PJE0); break;
+	case S_LAST:  PPValue = JudySLLast( PArray[ADT], got, PJE0); break;
+	case S_PREV:  PPValue = JudySLPrev( PArray[ADT], got, PJE0); break;
+	}
+	gotlen = strlen((char *)got);
+    }
+    else
+    {
+	switch (Op)
+	{
+	case S_FIRST: PPValue = JudySLBFirst(PArray[ADT], got, &gotlen, PJE0);
+		      break;
+	case S_NEXT:  PPValue = JudySLBNext( PArray[ADT], got, &gotlen, PJE0);
+		      break;
+	case S_LAST:  PPValue = JudySLBLast( PArray[ADT], got, &gotlen, PJE0);
+		      break;
+	case S_PREV:  PPValue = JudySLBPrev( PArray[ADT], got, &gotlen, PJE0);
+		      break;
+	}
+    }
+    CHECK(PPValue != PPJERR, "error return", -1, found);
+    CHECK((PPValue != NULL) == found, "found", PPValue != NULL, found);
+    if (! found)
+	return;
+
+    CHECK(gotlen == Prs->rs_Len[pos], "length of Index found", gotlen,
+	  Prs->rs_Len[pos]);
+    CHECK(memcmp(got, Prs->rs_Str[pos], gotlen) == 0, "Index found at",
+	  pos, pos);
+    StrCheckValue(PPValue, Prs, pos);
+}
+
+// Walk the whole array, checking every Index and value:
+
+static void
+StrWalk(int ADT)
+{
+    rs_t    *Prs = RefStr + ADT - A_JUDYSL;
+    uint8_t  str[FZ_MAXLEN + 1];
+    Word_t   len = 0, pos, count;
+    PPvoid_t PPValue;
+
+    if (ADT == A_JUDYHS)		// in hash order:  look each one up
+    {
+	JHSIter_t iter;
+	int       has;
+
+	JHSITERINIT(&iter);
+	for (count = 0, PPValue = JudyHSFirst(PArray[ADT], &iter, PJE0);
+	     PPValue != NULL;
+	     count++, PPValue = JudyHSNext(PArray[ADT], &iter, PJE0))
+	{
+	    CHECK(PPValue != PPJERR, "JudyHSNext error return", count, 0);
+	    has = RefStrHas(Prs, iter.jhsi_String, iter.jhsi_Len, &pos);
+	    CHECK(has, "JudyHSNext found a string not stored, number", count,
+		  0);
+	    StrCheckValue(PPValue, Prs, pos);
+	}
+	JudyHSIterFree(&iter);
+	CHECK(count == Prs->rs_Pop, "strings walked", count, Prs->rs_Pop);
+	return;
+    }
+
+    str[0] = '\0';
+    for (pos = 0; ; pos++)
+    {
+	if (ADT == A_JUDYSL)
+	{
+	    PPValue = pos ? JudySLNext(PArray[ADT], str, PJE0)
+			  : JudySLFirst(PArray[ADT], str, PJE0);
+	    len = strlen((char *)str);
+	}
+	else
+	    PPValue = pos ? JudySLBNext(PArray[ADT], str, &len, PJE0)
+			  : JudySLBFirst(PArray[ADT], str, &len, PJE0);
+
+	CHECK(PPValue != PPJERR, "walk error return", pos, 0);
+	CHECK((PPValue != NULL) == (pos < Prs->rs_Pop), "walk found",
+	      PPValue != NULL, pos);
+	if (PPValue == NULL)
+	    break;
+	CHECK((len == Prs->rs_Len[pos])
+	   && (memcmp(str, Prs->rs_Str[pos], len) == 0), "walk Index at",
+	      pos, pos);
+	StrCheckValue(PPValue, Prs, pos);
+    }
+}
+
+// Insert one string Index, giving it a new value:
+
+static void
+StrIns(int ADT, uint8_t *Str, Word_t Len)
+{
+    rs_t    *Prs = RefStr + ADT - A_JUDYSL;
+    Word_t   pos;
+    PPvoid_t PPValue;
+    int      has;
+
+    has = RefStrHas(Prs, Str, Len, &pos);
+    switch (ADT)
+    {
+    case A_JUDYSL:  PPValue = JudySLIns(PArray + ADT, Str, PJE0); break;
+    case A_JUDYSLB: PPValue = JudySLBIns(PArray + ADT, Str, Len, PJE0); break;
+    default:        PPValue = JudyHSIns(PArray + ADT, Str, Len, PJE0); break;
+    }
+    CHECK((PPValue != NULL) && (PPValue != PPJERR), "Ins return", PPValue, 0);
+    if (has)
+	StrCheckValue(PPValue, Prs, pos);
+    else
+    {
+	CHECK(*(PWord_t)PPValue == 0, "new value", *(PWord_t)PPValue, 0);
+	RefStrIns(Prs, pos, Str, Len, 0);
+    }
+    *(PWord_t)PPValue = Prs->rs_Value[pos] = ++NextValue;
+}
+
+static void
+StrDel(int ADT, uint8_t *Str, Word_t Len)
+{
+    rs_t  *Prs = RefStr + ADT - A_JUDYSL;
+    Word_t pos;
+    int    Rc, has;
+
+    has = RefStrHas(Prs, Str, Len, &pos);
+    switch (ADT)
+    {
+    case A_JUDYSL:  Rc = JudySLDel(PArray + ADT, Str, PJE0); break;
+    case A_JUDYSLB: Rc = JudySLBDel(PArray + ADT, Str, Len, PJE0); break;
+    default:        Rc = JudyHSDel(PArray + ADT, Str, Len, PJE0); break;
+    }
+    CHECK(Rc == has, "Del return", Rc, has);
+    if (has)
+	RefStrDel(Prs, pos);
+}
+
+static void
+StrOp(int ADT, int Op)
+{
+    rs_t    *Prs = RefStr + ADT - A_JUDYSL;
+    uint8_t  str[FZ_MAXLEN + 1], str2[FZ_MAXLEN + 1];
+    Word_t   len, len2, pos, pos2, count, want, ii;
+    PPvoid_t PPValue;
+    int      has;
+
+    switch (Op)
+    {
+    case S_INS:
+	len = StrIndex(Prs, str, ADT == A_JUDYSL);
+	TraceStr(str, len);
+	StrIns(ADT, str, len);
+	break;
+
+    case S_DEL:
+	len = StrIndex(Prs, str, ADT == A_JUDYSL);
+	TraceStr(str, len);
+	StrDel(ADT, str, len);
+	break;
+
+    case S_INSRUN:
+    case S_DELRUN:
+
+//	Up to 1021 strings, one decoded with 2 bytes of count (never 0) added
+
+	len = StrIndex(Prs, str, ADT == A_JUDYSL);
+	if (len > FZ_MAXLEN - 2)
+	    len = FZ_MAXLEN - 2;
+	count = 1 + Byte() * 4;
+	TraceStr(str, len);
+	for (ii = 0; ii < count; ii++)
+	{
+	    str[len]     = 1 + ii / 255;
+	    str[len + 1] = 1 + ii % 255;
+	    str[len + 2] = '\0';
+	    if (Op == S_INSRUN)
+		StrIns(ADT, str, len + 2);
+	    else
+		StrDel(ADT, str, len + 2);
+	}
+	break;
+
+    case S_GET:
+	len = StrIndex(Prs, str, ADT == A_JUDYSL);
+	TraceStr(str, len);
+	has = RefStrHas(Prs, str, len, &pos);
+	PPValue = StrGet(ADT, str, len);
+	CHECK(PPValue != PPJERR, "Get error return", -1, has);
+	CHECK((PPValue != NULL) == has, "Get found", PPValue != NULL, has);
+	if (has)
+	    StrCheckValue(PPValue, Prs, pos);
+	break;
+
+    case S_FIRST:
+    case S_NEXT:
+    case S_LAST:
+    case S_PREV:
+	len = StrIndex(Prs, str, ADT == A_JUDYSL);
+	TraceStr(str, len);
+	StrSearch(ADT, Op, str, len);
+	break;
+
+    case S_COUNT:			// JudySL only
+	len  = StrIndex(Prs, str, 1);
+	len2 = StrIndex(Prs, str2, 1);
+	TraceStr(str, len);
+	pos  = RefStrPos(Prs, str, len);
+	if (RefStrHas(Prs, str2, len2, &pos2))
+	    pos2++;			// through Index2
+	want = (StrCmp(str, len, str2, len2) <= 0) ? pos2 - pos : 0;
+	count = JudySLCount(PArray[ADT], str, str2, PJE0);
+	CHECK(count == want, "Count", count, want);
+	break;
+
+    case S_COUNTINIT:			// JudySL only
+	Trace(Prs->rs_Pop);
+	count = JudySLCountInit(PArray + ADT, PJE0);
+	CHECK(count == 1, "CountInit return", count, 1);
+	break;
+
+    case S_BYCOUNT:			// JudySL only
+	count = Byte() % (Prs->rs_Pop + 2);
+	Trace(count);
+	has = (count >= 1) && (count <= Prs->rs_Pop);
+	PPValue = JudySLByCount(PArray[ADT], count, str, PJE0);
+	CHECK(PPValue != PPJERR, "ByCount error return", -1, has);
+	CHECK((PPValue != NULL) == has, "ByCount found", PPValue != NULL,
+	      has);
+	if (! has)
+	    break;
+	len = strlen((char *)str);
+	CHECK((len == Prs->rs_Len[count - 1])
+	   && (memcmp(str, Prs->rs_Str[count - 1], len) == 0),
+	      "ByCount Index, number", count, count);
+	StrCheckValue(PPValue, Prs, count - 1);
+	break;
+
+    case S_PREFIX:			// JudySL only
+    {
+	JSLCursor_t cursor;
+
+	len = StrIndex(Prs, str2, 1) % 4;	// short, to match some
+	str2[len] = '\0';
+	TraceStr(str2, len);
+	JSLCURSORINIT(&cursor);
+	pos = RefStrPos(Prs, str2, len);
+	for (PPValue = JudySLPrefixFirst(PArray[ADT], str2, &cursor, str,
+					 PJE0);
+	     ;
+	     PPValue = JudySLPrefixNext(&cursor, str, PJE0), pos++)
+	{
+	    has = (pos < Prs->rs_Pop) && (Prs->rs_Len[pos] >= len)
+	       && (memcmp(Prs->rs_Str[pos], str2, len) == 0);
+	    CHECK(PPValue != PPJERR, "prefix scan error return", pos, has);
+	    CHECK((PPValue != NULL) == has, "prefix scan found, at",
+		  PPValue != NULL, pos);
+	    if (! has)
+		break;
+	    len2 = strlen((char *)str);
+	    CHECK((len2 == Prs->rs_Len[pos])
+	       && (memcmp(str, Prs->rs_Str[pos], len2) == 0),
+		  "prefix scan Index at", pos, pos);
+	    StrCheckValue(PPValue, Prs, pos);
+	}
+	JudySLCursorFree(&cursor);
+	break;
+    }
+
+    case S_BATCH:			// JudyHS only
+    {
+	uint8_t  strs[FZ_MAXBATCH][FZ_MAXLEN + 1];
+	void    *Pstr[FZ_MAXBATCH];
+	Word_t   lens[FZ_MAXBATCH];
+	PPvoid_t PPValues[FZ_MAXBATCH];
+
+	count = 1 + Byte() % FZ_MAXBATCH;
+	Trace(count);
+	for (ii = want = 0; ii < count; ii++)
+	{
+	    lens[ii] = StrIndex(Prs, strs[ii], 0);
+	    Pstr[ii] = strs[ii];
+	    want += RefStrHas(Prs, strs[ii], lens[ii], &pos);
+	}
+	CHECK(JudyHSGetBatch(PArray[ADT], count, Pstr, lens, PPValues)
+	   == want, "GetBatch found", -1, want);
+	for (ii = 0; ii < count; ii++)
+	{
+	    has = RefStrHas(Prs, strs[ii], lens[ii], &pos);
+	    CHECK((PPValues[ii] != NULL) == has, "GetBatch found, number",
+		  ii, has);
+	    if (has)
+		StrCheckValue(PPValues[ii], Prs, pos);
+	}
+	break;
+    }
+
+    case S_FREE:
+	Trace(Prs->rs_Pop);
+	switch (ADT)
+	{
+	case A_JUDYSL:  count = JudySLFreeArray(PArray + ADT, PJE0); break;
+	case A_JUDYSLB: count = JudySLBFreeArray(PArray + ADT, PJE0); break;
+	default:        count = JudyHSFreeArray(PArray + ADT, PJE0); break;
+	}
+	CHECK(count != JERR, "FreeArray return", count, 0);
+	CHECK(PArray[ADT] == NULL, "array after FreeArray", PArray[ADT], 0);
+	RefStrFree(Prs);
+	break;
+
+    default:
+	Trace(Prs->rs_Pop);
+	StrWalk(ADT);
+	break;
+    }
+}
+
+// ****************************************************************************
+// R U N   O N E   I N P U T
+//
+// Decode and check operations until the bytes run out, then walk and free
+// every array, and check that all the memory came back.
+
+static void
+RunInput(const uint8_t *Data, size_t Size)
+{
+    int ADT, Op;
+
+    FzData = Data;
+    FzSize = Size;
+    FzPos  = 0;
+
+    for (FzOp = 0; FzPos < FzSize; FzOp++)
+    {
+	ADT = Byte() % A_COUNT;
+	FzADT = ADTName[ADT];
+
+	if (ADT <= A_JUDYL)
+	{
+	    Op = WOps[Byte() % 32];
+	    FzName = WOpName[Op];
+	    WordOp(ADT, Op);
+	}
+	else
+	{
+	    Op = SOps[Byte() % 32];
+	    if (! StrCan(ADT, Op))
+		Op = S_GET;
+	    FzName = SOpName[Op];
+	    StrOp(ADT, Op);
+	}
+    }
+
+    for (ADT = 0; ADT < A_COUNT; ADT++)
+    {
+	FzADT = ADTName[ADT];
+	if (ADT <= A_JUDYL)
+	{
+	    FzName = WOpName[W_WALK];
+	    WordOp(ADT, W_WALK);
+	    FzName = WOpName[W_FREE];
+	    WordOp(ADT, W_FREE);
+	}
+	else
+	{
+	    FzName = SOpName[S_WALK];
+	    StrOp(ADT, S_WALK);
+	    FzName = SOpName[S_FREE];
+	    StrOp(ADT, S_FREE);
+	}
+    }
+    FzADT  = "all";
+    FzName = "FreeArray";
+    CHECK(FzWords == 0, "words not freed", FzWords, 0);
+}
+
+#ifdef JUDYFUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size);
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size)
+{
+    RunInput(Data, Size);
+    return(0);
+}
+
+#else // ! JUDYFUZZ_LIBFUZZER
+
+Word_t Seed = 0xc1fc;		// default beginning number
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+int
+main(int argc, char *argv[])
+{
+    Word_t   nInputs = 10000;	// random inputs to run
+    Word_t   MaxBytes = 2000;	// longest input
+    Word_t   input, ii, size, seed;
+    uint8_t *data;
+    FILE    *fp;
+    int      c;
+    extern char *optarg;
+    extern int   optind;
+
+    while ((c = getopt(argc, argv, "n:l:s:w:v")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of inputs
+	    nInputs = strtoul(optarg, NULL, 0);
+	    break;
+
+	case 'l':		// Longest input
+	    MaxBytes = strtoul(optarg, NULL, 0);
+	    if (MaxBytes == 0)
+		MaxBytes = 1;
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		Seed = 0xc1fc;
+	    break;
+
+	case 'w':		// Failing input file
+	    FailFile = optarg;
+	    break;
+
+	case 'v':		// Print each operation
+	    Verbose = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -l# -s# -w<file> -v [file ...]\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  random inputs to run (%lu)\n", nInputs);
+	    printf("-l <#>  longest input, in bytes (%lu)\n", MaxBytes);
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-w <..> file to write a failing input to (%s)\n",
+		   FailFile);
+	    printf("-v      print each operation\n");
+	    printf("\nWith files, run (replay) each of them instead of "
+		   "random inputs\n");
+	    exit(1);
+	}
+    }
+
+//  Replay files:
+
+    if (optind < argc)
+    {
+	FailFile = NULL;		// it is already in a file
+	for ( ; optind < argc; optind++)
+	{
+	    if ((fp = fopen(argv[optind], "rb")) == NULL)
+	    {
+		printf("JudyFuzz: cannot open %s\n", argv[optind]);
+		exit(1);
+	    }
+	    fseek(fp, 0L, SEEK_END);
+	    size = ftell(fp);
+	    rewind(fp);
+	    if (((data = (uint8_t *)malloc(size + 1)) == NULL)
+	     || (fread(data, 1, size, fp) != size))
+	    {
+		printf("JudyFuzz: cannot read %s\n", argv[optind]);
+		exit(1);
+	    }
+	    fclose(fp);
+
+	    printf("JudyFuzz: %s, %lu bytes\n", argv[optind], size);
+	    RunInput(data, size);
+	    printf("JudyFuzz: %s, %lu operations, all agree\n",
+		   argv[optind], FzOp);
+	    free(data);
+	}
+	exit(0);
+    }
+
+//  Random inputs, each from where the last left the seed:
+
+    if ((data = (uint8_t *)malloc(MaxBytes)) == NULL)
+    {
+	printf("JudyFuzz: out of memory\n");
+	exit(1);
+    }
+    seed = Seed;
+    for (input = 0; input < nInputs; input++)
+    {
+	size = 1 + Random() % MaxBytes;
+	for (ii = 0; ii < size; ii++)
+	    data[ii] = (uint8_t)(Random() >> 24);
+	if (Verbose)
+	    printf("JudyFuzz: input %lu, %lu bytes\n", input, size);
+	RunInput(data, size);
+    }
+    printf("JudyFuzz: %lu random inputs (-s 0x%lx) of up to %lu bytes, "
+	   "all agree\n", nInputs, seed, MaxBytes);
+    free(data);
+    exit(0);
+}
+
+#endif // ! JUDYFUZZ_LIBFUZZER
@@ -0,0 +1,416 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyHSCheck.c $
+//      This program tests JudyHS with strings of many lengths, checking the
+//      JudyHS array against a plain table of the strings it holds.
+
+#include <stdlib.h>		// malloc()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memcmp()
+#include <stdio.h>		// printf()
+
+#include <Judy.h>
+
+// Compile:
+// # cc -O JudyHSCheck.c -lJudy -o JudyHSCheck
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+// Specify prototypes for each test routine
+Word_t TestJudyHSIns(Pvoid_t *JH, Word_t Elements);
+
+Word_t TestJudyHSIter(Pvoid_t JH, Word_t Elements, Word_t Mask);
+
+Word_t TestJudyHSIterDel(Pvoid_t *JH, Word_t Step);
+
+Word_t TestJudyHSHash(Word_t Elements, Word_t Unique, Word_t Mask);
+
+Word_t TestJudyHSGetBatch(Pvoid_t JH, Word_t Elements);
+
+Word_t nElms = 100000;		// Default = 100K
+Word_t MaxLen = 64;		// Default longest ordinary string
+Word_t pFlag = 0;
+Word_t Seed = 0xc1fc;		// default beginning number
+
+// The strings, back to back in Strings[], string i at Offset[i] of Length[i]
+
+uint8_t *Strings;
+Word_t  *Offset;
+Word_t  *Length;
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    Pvoid_t JH = NULL;		// JudyHS
+    Word_t Unique, Count, Bytes;
+    Word_t elm, total = 0;
+    int    c;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:l:s:p")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of strings
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'l':		// Longest ordinary string
+	    MaxLen = strtoul(optarg, NULL, 0);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'p':		// Print results
+	    pFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -l# -s# -p\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  number of strings used in tests\n");
+	    printf("-l <#>  longest ordinary string, 1 in 64 is longer\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-p      print results\n");
+	    exit(1);
+	}
+    }
+
+//  Make the strings:  mostly short, with a few much longer, and random
+//  bytes (including \0s) so every length has a spread of hashes
+
+    Offset = (Word_t *)malloc(nElms * sizeof(Word_t));
+    Length = (Word_t *)malloc(nElms * sizeof(Word_t));
+    for (elm = 0; elm < nElms; elm++)
+    {
+	Length[elm] = Random() % (MaxLen + 1);
+	if ((Random() & 63) == 0)
+	    Length[elm] += Random() % (MaxLen * 8 + 1);
+	Offset[elm] = total;
+	total += Length[elm];
+    }
+    Strings = (uint8_t *)malloc(total + 1);
+    if ((Offset == NULL) || (Length == NULL) || (Strings == NULL))
+	FAILURE("Out of memory, bytes =", total);
+
+    for (elm = 0; elm < total; elm++)
+	Strings[elm] = (uint8_t)(Random() >> 17);
+
+    Unique = TestJudyHSIns(&JH, nElms);
+
+    Count = TestJudyHSIter(JH, Unique, ~0UL);
+
+    TestJudyHSGetBatch(JH, nElms);
+
+//  Delete every other string while iterating, then the rest
+
+    Count -= TestJudyHSIterDel(&JH, 2);
+    if (TestJudyHSIter(JH, Count, ~0UL) != Count)
+	FAILURE("JudyHSNext count after deletes wrong", Count);
+
+    Count -= TestJudyHSIterDel(&JH, 1);
+    if ((Count != 0) || (JH != NULL))
+	FAILURE("JudyHS array not empty after deleting all, count =", Count);
+
+//  The H functions, with JudyHashStr() and then with a hash so poor that
+//  nearly every string collides, to exercise the trees below hash buckets
+
+    TestJudyHSHash(nElms, Unique, ~0UL);
+    TestJudyHSHash(nElms, Unique, 3);
+
+//  And again, then free the whole array
+
+    Unique = TestJudyHSIns(&JH, nElms);
+    TestJudyHSIter(JH, Unique, ~0UL);
+
+    JHSFA(Bytes, JH);
+    if (pFlag)
+	printf("JudyHSFreeArray = %lu bytes for %lu strings\n", Bytes, Unique);
+
+    printf("Passed JudyHS tests for %lu strings of <= %lu bytes\n",
+	   nElms, MaxLen * 9);
+    exit(0);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyHSIns"
+
+// Store the strings, each with its number + 1 unless a duplicate; return the
+// number of unique strings.
+
+Word_t
+TestJudyHSIns(Pvoid_t *JH, Word_t Elements)
+{
+    Word_t elm, unique = 0;
+    PWord_t PValue, PValue1;
+
+    for (elm = 0; elm < Elements; elm++)
+    {
+	JHSI(PValue, *JH, Strings + Offset[elm], Length[elm]);
+	if (PValue == PJERR)
+	    FAILURE("JudyHSIns failed at", elm);
+
+	if (*PValue == 0)
+	{
+	    *PValue = elm + 1;
+	    unique++;
+	}
+	JHSG(PValue1, *JH, Strings + Offset[elm], Length[elm]);
+	if (PValue1 != PValue)
+	    FAILURE("JudyHSGet ret different PValue at", elm);
+    }
+    if (pFlag)
+	printf("JudyHSIns: %lu strings, %lu unique\n", Elements, unique);
+
+    return(unique);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyHSIter"
+
+// Visit every string with JudyHSFirst/Next, checking each is found once and
+// matches its Value and its hash (JudyHashStr() & Mask); return the number
+// visited.
+
+Word_t
+TestJudyHSIter(Pvoid_t JH, Word_t Elements, Word_t Mask)
+{
+    JHSIter_t Iter;
+    Pvoid_t   Seen = NULL;		// Judy1 of string numbers visited
+    PWord_t   PValue, PValue1;
+    Word_t    elm, count = 0;
+    Word_t    lastlen = 0;
+    int       Rc;
+
+    JHSITERINIT(&Iter);
+
+    JHSF(PValue, JH, Iter);
+    while (PValue != NULL)
+    {
+	count++;
+	elm = *PValue - 1;
+	if (elm >= nElms)
+	    FAILURE("JudyHSNext bad Value, count =", count);
+
+	if ((Iter.jhsi_Len != Length[elm])
+	 || memcmp(Iter.jhsi_String, Strings + Offset[elm], Iter.jhsi_Len))
+	    FAILURE("JudyHSNext string does not match its Value at", elm);
+
+	if (Iter.jhsi_Len < lastlen)
+	    FAILURE("JudyHSNext out of length order at", elm);
+	lastlen = Iter.jhsi_Len;
+
+	if ((Iter.jhsi_Len > sizeof(Word_t)) && (Iter.jhsi_Hash
+	    != (JudyHashStr(Iter.jhsi_String, Iter.jhsi_Len) & Mask)))
+	    FAILURE("JudyHSNext wrong hash at", elm);
+
+	PValue1 = (PWord_t)JudyHSGetH(JH, Iter.jhsi_String, Iter.jhsi_Len,
+				      Iter.jhsi_Hash);
+	if (PValue1 != PValue)
+	    FAILURE("JudyHSGetH ret different PValue at", elm);
+
+	J1S(Rc, Seen, elm);
+	if (Rc != 1)
+	    FAILURE("JudyHSNext returned a string twice at", elm);
+
+	JHSN(PValue, JH, Iter);
+    }
+    if (count != Elements)
+	FAILURE("JudyHSNext count wrong, count =", count);
+
+    JudyHSIterFree(&Iter);
+    J1FA(elm, Seen);
+
+    return(count);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyHSIterDel"
+
+// Visit every string, deleting every Step'th one (including the current one,
+// so the iterator must find its way on from a deleted string); return the
+// number deleted.
+
+Word_t
+TestJudyHSIterDel(Pvoid_t *JH, Word_t Step)
+{
+    JHSIter_t Iter;
+    PWord_t   PValue;
+    Word_t    count = 0, deleted = 0;
+    int       Rc;
+
+    JHSITERINIT(&Iter);
+
+    JHSF(PValue, *JH, Iter);
+    while (PValue != NULL)
+    {
+	if ((count++ % Step) == 0)
+	{
+	    JHSD(Rc, *JH, Iter.jhsi_String, Iter.jhsi_Len);
+	    if (Rc != 1)
+		FAILURE("JudyHSDel failed, count =", count);
+	    deleted++;
+	}
+	JHSN(PValue, *JH, Iter);
+    }
+    if ((JudyHSIterFree(&Iter) == 0) && count)
+	FAILURE("JudyHSIterFree freed nothing, count =", count);
+
+    if (pFlag)
+	printf("JudyHSDel: %lu of %lu strings\n", deleted, count);
+
+    return(deleted);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyHSHash"
+
+// Store, find and delete the strings with the H functions, hashing them with
+// JudyHashStr() & Mask; with the full hash, the functions without H must
+// agree.  Return the number of unique strings.
+
+Word_t
+TestJudyHSHash(Word_t Elements, Word_t Unique, Word_t Mask)
+{
+    Pvoid_t JH = NULL;
+    PWord_t PValue, PValue1;
+    Word_t  elm, hash, unique = 0;
+    int     Rc;
+
+    for (elm = 0; elm < Elements; elm++)
+    {
+	hash = JudyHashStr(Strings + Offset[elm], Length[elm]) & Mask;
+	PValue = (PWord_t)JudyHSInsH(&JH, Strings + Offset[elm], Length[elm],
+				     hash, PJE0);
+	if (PValue == PJERR)
+	    FAILURE("JudyHSInsH failed at", elm);
+
+	if (*PValue == 0)
+	{
+	    *PValue = elm + 1;
+	    unique++;
+	}
+	PValue1 = (PWord_t)JudyHSGetH(JH, Strings + Offset[elm], Length[elm],
+				      hash);
+	if (PValue1 != PValue)
+	    FAILURE("JudyHSGetH ret different PValue at", elm);
+
+	if (Mask == ~0UL)
+	{
+	    JHSG(PValue1, JH, Strings + Offset[elm], Length[elm]);
+	    if (PValue1 != PValue)
+		FAILURE("JudyHSGet ret different PValue from JudyHSInsH at",
+			elm);
+	}
+    }
+    if (unique != Unique)
+	FAILURE("JudyHSInsH unique count wrong, unique =", unique);
+
+    TestJudyHSIter(JH, Unique, Mask);
+
+    for (elm = 0; elm < Elements; elm++)
+    {
+	hash = JudyHashStr(Strings + Offset[elm], Length[elm]) & Mask;
+	Rc = JudyHSDelH(&JH, Strings + Offset[elm], Length[elm], hash, PJE0);
+	if (Rc == 1)
+	    unique--;
+	else if (Rc != 0)
+	    FAILURE("JudyHSDelH failed at", elm);
+    }
+    if ((unique != 0) || (JH != NULL))
+	FAILURE("JudyHS array not empty after JudyHSDelH, count =", unique);
+
+    if (pFlag)
+	printf("JudyHS*H: %lu unique strings, hash mask 0x%lx\n", Unique, Mask);
+
+    return(Unique);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudyHSGetBatch"
+
+// Look up the strings in uneven batches with JudyHSGetBatch(), half of them
+// altered in their last byte (so most are absent), and check it agrees with
+// JudyHSGet(); return the number found.
+
+#define BATCH 37
+
+Word_t
+TestJudyHSGetBatch(Pvoid_t JH, Word_t Elements)
+{
+    void    *Str[BATCH];
+    Word_t   Len[BATCH];
+    PPvoid_t PPValue[BATCH];
+    uint8_t *Copy;
+    PWord_t  PValue1;
+    Word_t   elm, ii, num, found, total = 0;
+
+    Copy = (uint8_t *)malloc(Offset[Elements - 1] + Length[Elements - 1] + 1);
+    if (Copy == NULL)
+	FAILURE("Out of memory, elements =", Elements);
+
+    for (elm = 0; elm < Elements; elm += num)
+    {
+	num = (elm % BATCH) + 1;		// 1 .. BATCH strings
+	if (num > Elements - elm)
+	    num = Elements - elm;
+
+	for (ii = 0; ii < num; ii++)
+	{
+	    Str[ii] = Strings + Offset[elm + ii];
+	    Len[ii] = Length[elm + ii];
+
+	    if ((ii & 1) && Len[ii])	// alter a copy of the string
+	    {
+		memcpy(Copy + Offset[elm + ii], Str[ii], Len[ii]);
+		Copy[Offset[elm + ii] + Len[ii] - 1] ^= 0x5a;
+		Str[ii] = Copy + Offset[elm + ii];
+	    }
+	}
+	found = JudyHSGetBatch(JH, num, Str, Len, PPValue);
+
+	for (ii = 0; ii < num; ii++)
+	{
+	    JHSG(PValue1, JH, Str[ii], Len[ii]);
+	    if ((PPvoid_t)PValue1 != PPValue[ii])
+		FAILURE("JudyHSGetBatch ret different PValue at", elm + ii);
+	    if (PValue1 != NULL)
+		found--;
+	}
+	if (found != 0)
+	    FAILURE("JudyHSGetBatch wrong count at", elm);
+	total += num;
+    }
+    free(Copy);
+
+    if (total != Elements)
+	FAILURE("JudyHSGetBatch missed strings, total =", total);
+
+    return(total);
+}
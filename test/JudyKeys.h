@@ -0,0 +1,388 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyKeys.h $
+//      Index (key) distributions for the Judy test and timing programs.
+//
+//      How fast a Judy array is depends on which kinds of branches and leaves
+//      its Indexes need, and that depends on how the Indexes are spread, not
+//      just how many there are.  Real keys are seldom as evenly random as an
+//      LFSR stream or as dense as a counter, so a program that includes this
+//      file after <Judy.h> can ask for:
+//
+//      random          uniformly random Words
+//      zipf[:S]        random Indexes under a few common prefixes and many
+//                      rare ones:  the number of Indexes under the prefix of
+//                      rank R falls off as 1/R^S (default S = 1.0)
+//      cluster[:M]     runs of about M Indexes 1..4 apart (default 64), each
+//                      run at a random place
+//      gauss[:G]       rising, like timestamps:  the gaps are about G apart
+//                      (default 1000), with a normal jitter of G/4
+//      stride[:K]      K, 2K, 3K, ... (default 64)
+//      pointer[:A]     like heap addresses:  A-byte aligned (default 16),
+//                      handed out from 4 arenas whose high bits are shared
+//      trace:FILE      the Indexes in FILE, one per line, in decimal or 0x
+//                      hex, in file order; blank and # lines are skipped
+//
+//      JudyKeys() returns an array of that many different Indexes, in the
+//      order to insert them; a repeated Index is drawn again (or, from a
+//      trace, dropped), so each one inserted adds to the population.
+//
+//      The module is all static functions, so each program compiles as one
+//      file, as Checkit expects.
+
+#include <stdio.h>		// fopen(), printf()
+#include <stdlib.h>		// malloc(), strtoul(), strtod()
+#include <string.h>		// strncmp(), strchr()
+#include <math.h>		// pow()
+
+#define JK_WORDBITS	(sizeof(Word_t) * 8)
+
+// zipf: the prefix ranks, and how many low bits are random under a prefix
+
+#define JK_ZIPFRANKS	65536
+#define JK_LOWBITS	(sizeof(Word_t) * 3)
+
+// Give up if the distribution cannot make enough different Indexes:
+
+#define JK_MAXTRIES(COUNT)	((COUNT) * 64 + 1000)
+
+// Small, portable random number generator (xorshift):
+
+static Word_t JKSeed = 0xc1fc;
+
+static Word_t
+JudyKeysRandom(void)
+{
+    JKSeed ^= JKSeed << 13;
+    JKSeed ^= JKSeed >> 7;
+    JKSeed ^= JKSeed << 17;
+    return(JKSeed);
+}
+
+// Uniform in [0, 1):
+
+static double
+JudyKeysUniform(void)
+{
+    return((double)(JudyKeysRandom() >> 8)
+	 / ((double)(~(Word_t)0 >> 8) + 1.0));
+}
+
+// Normal, mean 0 and deviation 1, as the sum of 12 uniforms less 6:
+
+static double
+JudyKeysNormal(void)
+{
+    double sum = -6.0;
+    int    ii;
+
+    for (ii = 0; ii < 12; ii++)
+	sum += JudyKeysUniform();
+    return(sum);
+}
+
+// Print the list of distributions, for a usage message:
+
+static void
+JudyKeysHelp(void)
+{
+    printf("        random     uniformly random Indexes\n");
+    printf("        zipf:S     under prefixes of rank R with 1/R^S "
+	   "frequency (1.0)\n");
+    printf("        cluster:M  runs of about M close Indexes (64)\n");
+    printf("        gauss:G    rising, gaps of G with normal jitter "
+	   "(1000)\n");
+    printf("        stride:K   K, 2K, 3K, ... (64)\n");
+    printf("        pointer:A  like heap addresses, A-byte aligned (16)\n");
+    printf("        trace:FILE the Indexes in FILE, one per line\n");
+}
+
+// THE SET OF INDEXES ALREADY DRAWN:
+//
+// An open addressed hash table twice as big as the Indexes wanted, plus a
+// flag for Index 0, which marks an empty slot.  (A Judy1 array would do, but
+// the timing programs count every JudyMalloc().)
+
+typedef struct JUDYKEYSSEEN
+{
+    Word_t *jks_Table;
+    Word_t  jks_Mask;
+    int     jks_Zero;
+} jks_t;
+
+static int
+JudyKeysSeenInit(jks_t *Pjks, Word_t Count)
+{
+    Word_t size = 16;
+
+    while (size < Count * 2)
+	size *= 2;
+
+    Pjks->jks_Table = (Word_t *)calloc(size, sizeof(Word_t));
+    Pjks->jks_Mask  = size - 1;
+    Pjks->jks_Zero  = 0;
+    return(Pjks->jks_Table != NULL);
+}
+
+// Return 1 if Index is new (and remember it), 0 if it was seen before:
+
+static int
+JudyKeysSeenAdd(jks_t *Pjks, Word_t Index)
+{
+    Word_t slot;
+
+    if (Index == 0)
+    {
+	if (Pjks->jks_Zero)
+	    return(0);
+	return(Pjks->jks_Zero = 1);
+    }
+
+    slot = Index * (Word_t)0x9e3779b97f4a7c15ULL;
+    slot = (slot ^ (slot >> (JK_WORDBITS / 2))) & Pjks->jks_Mask;
+
+    while (Pjks->jks_Table[slot] != 0)
+    {
+	if (Pjks->jks_Table[slot] == Index)
+	    return(0);
+	slot = (slot + 1) & Pjks->jks_Mask;
+    }
+    Pjks->jks_Table[slot] = Index;
+    return(1);
+}
+
+// Read a trace into Keys[], at most *PCount different Indexes:
+
+static int
+JudyKeysTrace(const char *File, Word_t *Keys, Word_t *PCount, jks_t *Pjks)
+{
+    FILE  *fp;
+    char   line[256];
+    char  *end;
+    Word_t index, count = 0;
+
+    if ((fp = fopen(File, "r")) == NULL)
+    {
+	printf("\nCannot open key trace \"%s\"\n", File);
+	return(0);
+    }
+
+    while ((count < *PCount) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+	index = strtoul(line, &end, 0);
+
+	if (end == line)		// blank, comment or junk
+	    continue;
+
+	if (JudyKeysSeenAdd(Pjks, index))
+	    Keys[count++] = index;
+    }
+    fclose(fp);
+
+    if (count == 0)
+    {
+	printf("\nNo Indexes in key trace \"%s\"\n", File);
+	return(0);
+    }
+    *PCount = count;
+    return(1);
+}
+
+// Return a malloc()ed array of *PCount different Indexes drawn from the
+// distribution named by Spec, starting from Seed (not 0).  For a trace shorter
+// than *PCount, *PCount is reduced to the number read.  On error, print why
+// and return NULL.
+
+static Word_t *
+JudyKeys(const char *Spec, Word_t *PCount, Word_t Seed)
+{
+    const char *param;
+    double     *cdf = NULL;		// zipf:  cumulative frequency by rank
+    double      exponent = 1.0;
+    Word_t      arg = 0;		// the parameter, else the default
+    Word_t      arena[4];		// pointer:  next address in each arena
+    Word_t     *Keys;
+    Word_t      count = *PCount;
+    Word_t      next = 0;		// cluster, gauss, stride:  next Index
+    Word_t      run = 0;		// cluster:  Indexes left in this run
+    Word_t      tries, index, ii;
+    jks_t       seen;
+    enum { JK_RANDOM, JK_ZIPF, JK_CLUSTER, JK_GAUSS, JK_STRIDE, JK_POINTER,
+	   JK_TRACE } dist;
+
+    JKSeed = Seed ? Seed : 0xc1fc;
+
+    if ((param = strchr(Spec, ':')) != NULL)
+    {
+	param++;
+	arg = strtoul(param, NULL, 0);
+    }
+
+#define JK_IS(NAME)  ((strncmp(Spec, NAME, sizeof(NAME) - 1) == 0)	\
+		   && ((Spec[sizeof(NAME) - 1] == '\0')			\
+		    || (Spec[sizeof(NAME) - 1] == ':')))
+
+    if      (JK_IS("random"))  dist = JK_RANDOM;
+    else if (JK_IS("zipf"))    dist = JK_ZIPF;
+    else if (JK_IS("cluster")) dist = JK_CLUSTER;
+    else if (JK_IS("gauss"))   dist = JK_GAUSS;
+    else if (JK_IS("stride"))  dist = JK_STRIDE;
+    else if (JK_IS("pointer")) dist = JK_POINTER;
+    else if (JK_IS("trace") && (param != NULL)) dist = JK_TRACE;
+    else
+    {
+	printf("\nUnknown key distribution \"%s\", use one of:\n", Spec);
+	JudyKeysHelp();
+	return(NULL);
+    }
+#undef JK_IS
+
+    if (count == 0)
+    {
+	printf("\nNo Indexes wanted from key distribution \"%s\"\n", Spec);
+	return(NULL);
+    }
+    Keys = (Word_t *)malloc(count * sizeof(Word_t));
+    if ((Keys == NULL) || ! JudyKeysSeenInit(&seen, count))
+    {
+	printf("\nOut of memory for %lu Indexes\n", count);
+	free(Keys);
+	return(NULL);
+    }
+
+//  Set up the distribution:
+
+    switch (dist)
+    {
+    case JK_ZIPF:
+	if (param != NULL)
+	    exponent = strtod(param, NULL);
+	if ((cdf = (double *)malloc(JK_ZIPFRANKS * sizeof(double))) == NULL)
+	{
+	    printf("\nOut of memory for zipf ranks\n");
+	    free(seen.jks_Table);
+	    free(Keys);
+	    return(NULL);
+	}
+	for (ii = 0; ii < JK_ZIPFRANKS; ii++)
+	    cdf[ii] = (ii ? cdf[ii - 1] : 0.0) + pow(ii + 1.0, -exponent);
+	break;
+
+    case JK_GAUSS:
+	next = JudyKeysRandom() >> 2;	// room to rise
+	break;
+
+    case JK_POINTER:
+	if ((arg == 0) || (arg & (arg - 1)))
+	    arg = 16;			// not a power of 2
+	for (ii = 0; ii < 4; ii++)
+#ifdef __LP64__
+	    arena[ii] = 0x0000555555550000UL + (ii << 32);
+#else  // not __LP64__
+	    arena[ii] = 0x08000000UL + (ii << 24);
+#endif // not __LP64__
+	break;
+
+    case JK_TRACE:
+	if (! JudyKeysTrace(param, Keys, PCount, &seen))
+	{
+	    free(seen.jks_Table);
+	    free(Keys);
+	    return(NULL);
+	}
+	free(seen.jks_Table);
+	return(Keys);
+
+    default:
+	break;
+    }
+
+//  Draw Indexes until there are enough different ones:
+
+    for (ii = tries = 0; ii < count; tries++)
+    {
+	if (tries > JK_MAXTRIES(count))
+	{
+	    printf("\nKey distribution \"%s\" made only %lu different "
+		   "Indexes\n", Spec, ii);
+	    free(cdf);
+	    free(seen.jks_Table);
+	    free(Keys);
+	    return(NULL);
+	}
+
+	switch (dist)
+	{
+	case JK_RANDOM:
+	    index = JudyKeysRandom();
+	    break;
+
+	case JK_ZIPF:
+	{
+	    double u = JudyKeysUniform() * cdf[JK_ZIPFRANKS - 1];
+	    Word_t low = 0, high = JK_ZIPFRANKS - 1, mid;
+
+	    while (low < high)		// first rank with cdf > u
+	    {
+		mid = (low + high) / 2;
+		if (cdf[mid] > u)
+		    high = mid;
+		else
+		    low = mid + 1;
+	    }
+//	    Multiplying by an odd number spreads the prefixes without
+//	    making two of them equal:
+	    index  = (low * 0x9e3779b1UL)
+		   & (~(Word_t)0 >> JK_LOWBITS);
+	    index  = index << JK_LOWBITS;
+	    index |= JudyKeysRandom() & ((1UL << JK_LOWBITS) - 1);
+	    break;
+	}
+
+	case JK_CLUSTER:
+	    if (run == 0)
+	    {
+		run  = arg ? arg : 64;
+		next = JudyKeysRandom();
+	    }
+	    run--;
+	    index = next;
+	    next += 1 + (JudyKeysRandom() & 3);
+	    break;
+
+	case JK_GAUSS:
+	{
+	    double gap = arg ? (double)arg : 1000.0;
+
+	    gap += gap / 4.0 * JudyKeysNormal();
+	    index = next;
+	    next += (gap < 1.0) ? 1 : (Word_t)gap;
+	    break;
+	}
+
+	case JK_STRIDE:
+	    next += arg ? arg : 64;
+	    index = next;
+	    break;
+
+	case JK_POINTER:
+	{
+	    Word_t which = JudyKeysRandom() & 3;
+
+	    index = arena[which];
+	    arena[which] += arg * (1 + JudyKeysRandom() % 8);
+	    break;
+	}
+
+	default:
+	    index = 0;
+	    break;
+	}
+
+	if (JudyKeysSeenAdd(&seen, index))
+	    Keys[ii++] = index;
+    }
+
+    free(cdf);
+    free(seen.jks_Table);
+    return(Keys);
+
+}  // JudyKeys()
@@ -0,0 +1,558 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyLatency.c $
+//      This program times every single insert, lookup and delete on Judy1,
+//      JudyL, JudySL and JudyHS arrays, and prints the latency percentiles
+//      of each operation as CSV.
+//
+//      An average per operation, as Judy1LHTime and JudyBench print, hides
+//      the few operations that are very slow:  the inserts that cascade a
+//      full leaf into a branch, convert a bitmap branch to an uncompressed
+//      one, or copy a big leaf to a bigger one, and the deletes that
+//      decascade.  Here each operation is timed with clock_gettime() (less
+//      the time of clock_gettime() itself) into a histogram of 32 buckets
+//      per power of 2, as HDR histograms do, so a percentile is good to about
+//      3%, from which p50, p90, p99, p99.9, p99.99 and the maximum are taken.
+//
+//      With -A each operation is also put down to what the library did
+//      during it, from the JudyStats counters (see JStats_t in Judy.h):  a
+//      cascade, a decascade, a BranchB to BranchU conversion, a leaf copied
+//      to insert, or none of these.  Then there is a line for each cause too,
+//      with how many of the operations at or above the p99 and p99.9 of all
+//      of them it caused.  Counting slows down every JP visit a little, so
+//      leave -A off for the plain latencies.
+
+#include <stdlib.h>		// malloc(), exit()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memset(), strchr()
+#include <stdio.h>		// printf()
+#include <time.h>		// clock_gettime()
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+
+// Compile:
+// # cc -O JudyLatency.c -lJudy -lm -o JudyLatency
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+// Specify prototypes for each latency routine
+void LatencyJudy1(void);
+
+void LatencyJudyL(void);
+
+void LatencyJudySL(void);
+
+void LatencyJudyHS(void);
+
+Word_t nElms = 1000000;		// Default = 1M
+Word_t MaxLen = 16;		// Default longest string
+Word_t Seed = 0xc1fc;		// default beginning number
+char  *Dist = "random";		// Judy1/JudyL Index distribution
+int    AFlag = 0;		// attribute each operation to a cause
+char  *ADTs = "1LSH";		// which arrays to measure
+
+Word_t  *Indexes;		// Judy1/JudyL Indexes
+uint8_t *Strings;		// JudySL/JudyHS Indexes, \0 terminated
+Word_t  *Offset;		// of each string in Strings
+Word_t  *Length;		// of each string
+Word_t   Overhead;		// ns that clock_gettime() itself takes
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+static Word_t
+Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((Word_t)ts.tv_sec * 1000000000 + (Word_t)ts.tv_nsec);
+}
+
+// THE HISTOGRAMS:
+//
+// Values below 2 * HSUB ns each have a bucket; above that, each power of 2
+// is split into HSUB buckets, so a bucket is never wider than 1/HSUB of the
+// values in it.
+
+#define HSUBBITS	5
+#define HSUB		(1 << HSUBBITS)
+#define HBUCKETS	((sizeof(Word_t) * 8 - HSUBBITS + 1) * HSUB)
+
+typedef struct HISTOGRAM
+{
+    Word_t h_Count[HBUCKETS];
+    Word_t h_Ops;
+    Word_t h_Sum;			// ns, for the mean
+    Word_t h_Max;
+} hist_t;
+
+static Word_t
+Bucket(Word_t Ns)
+{
+    Word_t shift = 0;
+
+    if (Ns < 2 * HSUB)
+	return(Ns);
+    while ((Ns >> shift) >= 2 * HSUB)
+	shift++;
+    return(shift * HSUB + (Ns >> shift));
+}
+
+// The least value in a bucket:
+
+static Word_t
+BucketValue(Word_t Bucket)
+{
+    Word_t shift;
+
+    if (Bucket < 2 * HSUB)
+	return(Bucket);
+    shift = Bucket / HSUB - 1;
+    return((Bucket - shift * HSUB) << shift);
+}
+
+// The bucket holding the Q quantile (0 < Q <= 1):
+
+static Word_t
+QuantileBucket(hist_t *Phist, double Q)
+{
+    Word_t want = (Word_t)(Q * Phist->h_Ops + 0.999999);
+    Word_t sum = 0, bucket;
+
+    if (want == 0)
+	want = 1;
+    for (bucket = 0; bucket < HBUCKETS; bucket++)
+	if ((sum += Phist->h_Count[bucket]) >= want)
+	    break;
+    return(bucket);
+}
+
+// Operations in buckets at or above Bucket:
+
+static Word_t
+TailOps(hist_t *Phist, Word_t Bucket)
+{
+    Word_t sum = 0;
+
+    for ( ; Bucket < HBUCKETS; Bucket++)
+	sum += Phist->h_Count[Bucket];
+    return(sum);
+}
+
+// THE CAUSES:
+//
+// What an operation did, from the JudyStats counters that changed during it;
+// the first of these that did is its cause.
+
+#define C_ALL		0
+#define C_CASCADE	1
+#define C_DECASCADE	2
+#define C_BRANCHBTOU	3
+#define C_LEAFREALLOC	4
+#define C_NONE		5
+#define CAUSES		6
+
+const char *CauseName[CAUSES] =
+{
+    "all", "cascade", "decascade", "branchb_to_u", "leaf_realloc", "none"
+};
+
+hist_t   Hist[CAUSES];
+JStats_t Stats;			// counters after the last operation
+
+static int
+Cause(void)
+{
+    JStats_t now;
+    int      cause;
+
+    JudyStatsGet(&now);
+
+    if      (now.js_Cascades   != Stats.js_Cascades)   cause = C_CASCADE;
+    else if (now.js_Decascades != Stats.js_Decascades) cause = C_DECASCADE;
+    else if (now.js_BranchBToU != Stats.js_BranchBToU) cause = C_BRANCHBTOU;
+    else if (now.js_LeafRealloc != Stats.js_LeafRealloc)
+	cause = C_LEAFREALLOC;
+    else
+	cause = C_NONE;
+
+    Stats = now;
+    return(cause);
+}
+
+static void
+Record(Word_t Ns)
+{
+    Word_t bucket;
+    int    cause, ii;
+
+    Ns = (Ns > Overhead) ? Ns - Overhead : 0;
+    bucket = Bucket(Ns);
+
+    for (ii = 0; ii < 2; ii++)
+    {
+	if (ii == 0)
+	    cause = C_ALL;
+	else if (AFlag)
+	    cause = Cause();
+	else
+	    break;
+
+	Hist[cause].h_Count[bucket]++;
+	Hist[cause].h_Ops++;
+	Hist[cause].h_Sum += Ns;
+	if (Ns > Hist[cause].h_Max)
+	    Hist[cause].h_Max = Ns;
+    }
+}
+
+// Time one operation:
+
+#define TIMED(CALL)							\
+{									\
+    Word_t begin_ = Now();						\
+    CALL;								\
+    Record(Now() - begin_);						\
+}
+
+// Start and finish a pass of one operation over the array:
+
+#define BEGIN								\
+{									\
+    memset(Hist, 0, sizeof(Hist));					\
+    JudyStatsGet(&Stats);						\
+}
+
+static void
+Report(const char *ADT, const char *Op)
+{
+    Word_t p99, p999;
+    int    cause;
+
+    p99  = QuantileBucket(Hist + C_ALL, 0.99);
+    p999 = QuantileBucket(Hist + C_ALL, 0.999);
+
+    for (cause = 0; cause < (AFlag ? CAUSES : 1); cause++)
+    {
+	hist_t *Phist = Hist + cause;
+
+	if (Phist->h_Ops == 0)
+	    continue;
+
+	printf("%s,%s,%s,%lu,%.1f,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+	       ADT, Op, CauseName[cause], Phist->h_Ops,
+	       (double)Phist->h_Sum / Phist->h_Ops,
+	       BucketValue(QuantileBucket(Phist, 0.50)),
+	       BucketValue(QuantileBucket(Phist, 0.90)),
+	       BucketValue(QuantileBucket(Phist, 0.99)),
+	       BucketValue(QuantileBucket(Phist, 0.999)),
+	       BucketValue(QuantileBucket(Phist, 0.9999)),
+	       Phist->h_Max, TailOps(Phist, p99), TailOps(Phist, p999));
+    }
+    fflush(stdout);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    Word_t elm, total = 0;
+    int    c;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:l:s:a:k:SA")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of Indexes
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'l':		// Longest string
+	    MaxLen = strtoul(optarg, NULL, 0);
+	    if (MaxLen == 0)
+		FAILURE("Strings must be longer than -l", MaxLen);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'a':		// Arrays to measure
+	    ADTs = optarg;
+	    break;
+
+	case 'k':		// Index distribution
+	    Dist = optarg;
+	    break;
+
+	case 'S':		// Sequential Indexes
+	    Dist = "stride:1";
+	    break;
+
+	case 'A':		// Attribute operations to causes
+	    AFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -l# -s# -a1LSH -k<dist> -S -A\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  number of Indexes in each array\n");
+	    printf("-l <#>  longest JudySL/JudyHS string, half are shorter\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-a <..> arrays to measure: 1 = Judy1, L = JudyL, "
+		   "S = JudySL, H = JudyHS\n");
+	    printf("-k <..> distribution of the Judy1/JudyL Indexes "
+		   "(random), one of:\n");
+	    JudyKeysHelp();
+	    printf("-S      sequential Judy1/JudyL Indexes, same as "
+		   "-k stride:1\n");
+	    printf("-A      put each operation down to a cascade, "
+		   "decascade, branch conversion\n");
+	    printf("        or leaf copy, with the JudyStats counters\n");
+	    printf("\nOne line per operation (and cause), with its latency "
+		   "percentiles in ns\n");
+	    exit(1);
+	}
+    }
+
+//  Make the Indexes (a short trace means fewer), and the strings:  random
+//  letters and digits, from half the longest up
+
+    if ((Indexes = JudyKeys(Dist, &nElms, Seed)) == NULL)
+	FAILURE("Cannot make Indexes, -n", nElms);
+
+    Offset  = (Word_t *)malloc(nElms * sizeof(Word_t));
+    Length  = (Word_t *)malloc(nElms * sizeof(Word_t));
+    if ((Offset == NULL) || (Length == NULL))
+	FAILURE("Out of memory, Indexes =", nElms);
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	Length[elm]  = (MaxLen + 1) / 2 + Random() % (MaxLen / 2 + 1);
+	Offset[elm]  = total;
+	total += Length[elm] + 1;
+    }
+    if ((Strings = (uint8_t *)malloc(total)) == NULL)
+	FAILURE("Out of memory, bytes =", total);
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	uint8_t *str = Strings + Offset[elm];
+	Word_t   ii;
+
+	for (ii = 0; ii < Length[elm]; ii++)
+	    str[ii] = "abcdefghijklmnopqrstuvwxyz0123456789"[Random() % 36];
+	str[ii] = '\0';
+    }
+
+//  The least time clock_gettime() takes, to take off every measurement
+
+    for (Overhead = ~(Word_t)0, elm = 0; elm < 1000; elm++)
+    {
+	Word_t begin = Now();
+	Word_t ns    = Now() - begin;
+
+	if (ns < Overhead)
+	    Overhead = ns;
+    }
+
+    if (AFlag)
+	JudyStatsEnable(1);
+
+    printf("# JudyLatency -n %lu -k %s%s, clock_gettime() takes %lu ns\n",
+	   nElms, Dist, AFlag ? " -A" : "", Overhead);
+    printf("adt,op,cause,ops,mean,p50,p90,p99,p999,p9999,max,"
+	   "tail_p99,tail_p999\n");
+
+    if (strchr(ADTs, '1')) LatencyJudy1();
+    if (strchr(ADTs, 'L')) LatencyJudyL();
+    if (strchr(ADTs, 'S')) LatencyJudySL();
+    if (strchr(ADTs, 'H')) LatencyJudyHS();
+
+    exit(0);
+}
+
+// EACH ARRAY:
+//
+// Insert every Index, then look up every one in the same order, then delete
+// every one.
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "LatencyJudy1"
+
+void
+LatencyJudy1(void)
+{
+    Pvoid_t J1 = NULL;
+    Word_t  elm;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+	TIMED(J1S(Rc, J1, Indexes[elm]));
+    Report("Judy1", "ins");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(J1T(Rc, J1, Indexes[elm]));
+	if (Rc != 1)
+	    FAILURE("Judy1Test did not find Index number", elm);
+    }
+    Report("Judy1", "get");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(J1U(Rc, J1, Indexes[elm]));
+	if (Rc != 1)
+	    FAILURE("Judy1Unset did not find Index number", elm);
+    }
+    Report("Judy1", "del");
+    if (J1 != NULL)
+	FAILURE("Judy1 array not empty, Indexes =", nElms);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "LatencyJudyL"
+
+void
+LatencyJudyL(void)
+{
+    Pvoid_t JL = NULL;
+    PWord_t PValue;
+    Word_t  elm;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JLI(PValue, JL, Indexes[elm]));
+	if (PValue == PJERR)
+	    FAILURE("JudyLIns failed at", elm);
+	*PValue = elm + 1;
+    }
+    Report("JudyL", "ins");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JLG(PValue, JL, Indexes[elm]));
+	if ((PValue == NULL) || (*PValue != elm + 1))
+	    FAILURE("JudyLGet did not find Index number", elm);
+    }
+    Report("JudyL", "get");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JLD(Rc, JL, Indexes[elm]));
+	if (Rc != 1)
+	    FAILURE("JudyLDel did not find Index number", elm);
+    }
+    Report("JudyL", "del");
+    if (JL != NULL)
+	FAILURE("JudyL array not empty, Indexes =", nElms);
+}
+
+// A random string may come twice; the lookups then find the value of the
+// last one, and only the first delete finds it.
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "LatencyJudySL"
+
+void
+LatencyJudySL(void)
+{
+    Pvoid_t JSL = NULL;
+    PWord_t PValue;
+    Word_t  elm;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JSLI(PValue, JSL, Strings + Offset[elm]));
+	if (PValue == PJERR)
+	    FAILURE("JudySLIns failed at", elm);
+	*PValue = elm + 1;
+    }
+    Report("JudySL", "ins");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JSLG(PValue, JSL, Strings + Offset[elm]));
+	if (PValue == NULL)
+	    FAILURE("JudySLGet did not find string number", elm);
+    }
+    Report("JudySL", "get");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+	TIMED(JSLD(Rc, JSL, Strings + Offset[elm]));
+    Report("JudySL", "del");
+    if (JSL != NULL)
+	FAILURE("JudySL array not empty, Indexes =", nElms);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "LatencyJudyHS"
+
+void
+LatencyJudyHS(void)
+{
+    Pvoid_t JH = NULL;
+    PWord_t PValue;
+    Word_t  elm;
+    int     Rc;
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JHSI(PValue, JH, Strings + Offset[elm], Length[elm]));
+	if (PValue == PJERR)
+	    FAILURE("JudyHSIns failed at", elm);
+	*PValue = elm + 1;
+    }
+    Report("JudyHS", "ins");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+    {
+	TIMED(JHSG(PValue, JH, Strings + Offset[elm], Length[elm]));
+	if (PValue == NULL)
+	    FAILURE("JudyHSGet did not find string number", elm);
+    }
+    Report("JudyHS", "get");
+
+    BEGIN;
+    for (elm = 0; elm < nElms; elm++)
+	TIMED(JHSD(Rc, JH, Strings + Offset[elm], Length[elm]));
+    Report("JudyHS", "del");
+    if (JH != NULL)
+	FAILURE("JudyHS array not empty, Indexes =", nElms);
+}
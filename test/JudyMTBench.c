@@ -0,0 +1,443 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyMTBench.c $
+//      This program measures the throughput of JudyL arrays used by many
+//      threads at once, with a given mix of JudyLGet(), JudyLIns(),
+//      JudyLDel() and JudyLNext(), from 1 thread up to -t threads.
+//
+//      A Judy array may not be changed by one thread while another uses it,
+//      and the library itself takes no locks, so the program measures the
+//      ways a caller can share Indexes among threads:
+//
+//      private         each thread has its own array (the upper bound)
+//      mutex           one array, one pthread mutex around every call
+//      rwlock          one array, a pthread rwlock, read locked for Get and
+//                      Next, write locked for Ins and Del
+//      sharded         -S arrays, each with its own mutex, chosen by a hash
+//                      of the Index (JudyLNext() then only sees one shard)
+//
+//      Every array starts with -n of the Indexes; each operation picks one
+//      of twice that many, so about half of the Ins and Del calls change the
+//      array.  One record is printed per mode and number of threads, as CSV
+//      or JSON, with the operations per second and the speedup over 1
+//      thread.
+
+#include <stdlib.h>		// malloc(), exit()
+#include <unistd.h>		// getopt()
+#include <string.h>		// strstr()
+#include <stdio.h>		// printf()
+#include <time.h>		// clock_gettime()
+#include <pthread.h>		// pthread_create()
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+
+// Compile:
+// # cc -O JudyMTBench.c -lJudy -lpthread -lm -o JudyMTBench
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+#define MAXTHREADS	1024
+#define MAXSHARDS	4096
+
+Word_t nElms = 100000;		// Default Indexes in each array
+Word_t nOps = 1000000;		// Default operations per thread
+Word_t MaxThreads = 64;		// Default most threads
+Word_t nShards = 64;		// Default arrays in sharded mode
+Word_t Seed = 0xc1fc;		// default beginning number
+int    jFlag = 0;		// JSON (not CSV) output
+char  *Dist = "random";		// Index distribution
+char  *Modes = "private,mutex,rwlock,sharded";
+
+// The mix, in percent:  Get, then Ins, then Del, the rest Next
+
+int    PctGet = 80;
+int    PctIns = 10;
+int    PctDel = 10;
+
+Word_t *Keys;			// 2 * nElms Indexes, the first nElms stored
+
+// THE SHARED STATE:
+//
+// Each shard is one array with its lock, on its own cache lines so the locks
+// of two shards do not share one.  Mode mutex and rwlock use shard 0 only.
+
+enum { MODE_PRIVATE, MODE_MUTEX, MODE_RWLOCK, MODE_SHARDED } Mode;
+
+typedef struct SHARD
+{
+    Pvoid_t          sh_PArray;
+    pthread_mutex_t  sh_Mutex;
+    pthread_rwlock_t sh_RWLock;
+    char             sh_Pad[64];
+} shard_t;
+
+shard_t *Shards;
+
+// Threads wait for Go, so they all start together:
+
+pthread_mutex_t GoMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  GoCond  = PTHREAD_COND_INITIALIZER;
+int             Go;
+
+typedef struct THREAD
+{
+    pthread_t th_Id;
+    Word_t    th_Seed;
+    Pvoid_t   th_PArray;		// MODE_PRIVATE
+    Word_t    th_Sum;			// so no call can be optimized away
+} thread_t;
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(Word_t *PSeed)
+{
+    Word_t seed = *PSeed;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return(*PSeed = seed);
+}
+
+// Which shard holds Index; a hash, so clustered Indexes spread too:
+
+static Word_t
+ShardOf(Word_t Index)
+{
+    Index *= (Word_t)0x9e3779b97f4a7c15ULL;
+    return((Index >> (sizeof(Word_t) * 4)) % nShards);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Fill"
+
+// Put the first nElms Indexes in an array:
+
+static Pvoid_t
+Fill(Pvoid_t PArray, Word_t Shard)
+{
+    PWord_t PValue;
+    Word_t  elm;
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	if ((Shard != ~0UL) && (ShardOf(Keys[elm]) != Shard))
+	    continue;
+
+	JLI(PValue, PArray, Keys[elm]);
+	if (PValue == PJERR)
+	    FAILURE("JudyLIns failed at", elm);
+	*PValue = elm + 1;
+    }
+    return(PArray);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Operate"
+
+// One operation on one array, with no locking:
+
+static Word_t
+Operate(Pvoid_t *PPArray, int Op, Word_t Index)
+{
+    PWord_t PValue;
+    int     Rc;
+
+    switch (Op)
+    {
+    case 0:
+	JLG(PValue, *PPArray, Index);
+	return(PValue ? *PValue : 0);
+
+    case 1:
+	JLI(PValue, *PPArray, Index);
+	if (PValue == PJERR)
+	    FAILURE("JudyLIns failed at", Index);
+	return(*PValue = Index);
+
+    case 2:
+	JLD(Rc, *PPArray, Index);
+	return(Rc);
+
+    default:
+	JLN(PValue, *PPArray, Index);
+	return(Index);
+    }
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Worker"
+
+static void *
+Worker(void *Arg)
+{
+    thread_t *Pth = (thread_t *)Arg;
+    shard_t  *Psh;
+    Word_t    op, rand, index, sum = 0;
+    int       kind, pct;
+
+    pthread_mutex_lock(&GoMutex);
+    while (! Go)
+	pthread_cond_wait(&GoCond, &GoMutex);
+    pthread_mutex_unlock(&GoMutex);
+
+    for (op = 0; op < nOps; op++)
+    {
+	rand  = Random(&Pth->th_Seed);
+	index = Keys[(rand >> 8) % (nElms * 2)];
+	pct   = (int)(rand & 0xff) % 100;
+
+	if      (pct < PctGet)			kind = 0;
+	else if (pct < PctGet + PctIns)		kind = 1;
+	else if (pct < PctGet + PctIns + PctDel) kind = 2;
+	else					kind = 3;
+
+	switch (Mode)
+	{
+	case MODE_PRIVATE:
+	    sum += Operate(&Pth->th_PArray, kind, index);
+	    break;
+
+	case MODE_MUTEX:
+	    Psh = Shards;
+	    pthread_mutex_lock(&Psh->sh_Mutex);
+	    sum += Operate(&Psh->sh_PArray, kind, index);
+	    pthread_mutex_unlock(&Psh->sh_Mutex);
+	    break;
+
+	case MODE_RWLOCK:
+	    Psh = Shards;
+	    if ((kind == 1) || (kind == 2))
+		pthread_rwlock_wrlock(&Psh->sh_RWLock);
+	    else
+		pthread_rwlock_rdlock(&Psh->sh_RWLock);
+	    sum += Operate(&Psh->sh_PArray, kind, index);
+	    pthread_rwlock_unlock(&Psh->sh_RWLock);
+	    break;
+
+	case MODE_SHARDED:
+	    Psh = Shards + ShardOf(index);
+	    pthread_mutex_lock(&Psh->sh_Mutex);
+	    sum += Operate(&Psh->sh_PArray, kind, index);
+	    pthread_mutex_unlock(&Psh->sh_Mutex);
+	    break;
+	}
+    }
+    Pth->th_Sum = sum;
+    return(NULL);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Run"
+
+// Run one mode with nThreads threads; return the seconds taken:
+
+static double
+Run(thread_t *Threads, Word_t nThreads)
+{
+    struct timespec TSBeg, TSEnd;
+    Word_t ii, bytes;
+
+//  Build the arrays, untimed
+
+    if (Mode == MODE_PRIVATE)
+    {
+	for (ii = 0; ii < nThreads; ii++)
+	    Threads[ii].th_PArray = Fill(NULL, ~0UL);
+    }
+    else if (Mode == MODE_SHARDED)
+    {
+	for (ii = 0; ii < nShards; ii++)
+	    Shards[ii].sh_PArray = Fill(NULL, ii);
+    }
+    else
+	Shards[0].sh_PArray = Fill(NULL, ~0UL);
+
+    Go = 0;
+    for (ii = 0; ii < nThreads; ii++)
+    {
+	Threads[ii].th_Seed = Seed + ii * 0x9e3779b9UL;
+	if (pthread_create(&Threads[ii].th_Id, NULL, Worker, Threads + ii))
+	    FAILURE("pthread_create failed, thread", ii);
+    }
+
+    pthread_mutex_lock(&GoMutex);
+    clock_gettime(CLOCK_MONOTONIC, &TSBeg);
+    Go = 1;
+    pthread_cond_broadcast(&GoCond);
+    pthread_mutex_unlock(&GoMutex);
+
+    for (ii = 0; ii < nThreads; ii++)
+	pthread_join(Threads[ii].th_Id, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &TSEnd);
+
+//  Free the arrays, untimed
+
+    for (ii = 0; ii < nThreads; ii++)
+	JLFA(bytes, Threads[ii].th_PArray);
+    for (ii = 0; ii < nShards; ii++)
+	JLFA(bytes, Shards[ii].sh_PArray);
+
+    return((double)(TSEnd.tv_sec - TSBeg.tv_sec)
+	 + (double)(TSEnd.tv_nsec - TSBeg.tv_nsec) / 1E9);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    static const char *ModeName[] =
+	{ "private", "mutex", "rwlock", "sharded" };
+    thread_t *Threads;
+    Word_t    nKeys, nThreads, ii;
+    double    secs, opsps, base = 0.0;
+    int       c, records = 0;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:o:t:S:s:m:M:k:j")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Indexes in each array
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No Indexes: -n", nElms);
+	    break;
+
+	case 'o':		// Operations per thread
+	    nOps = strtoul(optarg, NULL, 0);
+	    if (nOps == 0)
+		FAILURE("No operations: -o", nOps);
+	    break;
+
+	case 't':		// Most threads
+	    MaxThreads = strtoul(optarg, NULL, 0);
+	    if ((MaxThreads == 0) || (MaxThreads > MAXTHREADS))
+		FAILURE("Threads must be 1..1024, not -t", MaxThreads);
+	    break;
+
+	case 'S':		// Shards
+	    nShards = strtoul(optarg, NULL, 0);
+	    if ((nShards == 0) || (nShards > MAXSHARDS))
+		FAILURE("Shards must be 1..4096, not -S", nShards);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'm':		// Mix:  Get:Ins:Del percent, rest is Next
+	    if ((sscanf(optarg, "%d:%d:%d", &PctGet, &PctIns, &PctDel) != 3)
+	     || (PctGet < 0) || (PctIns < 0) || (PctDel < 0)
+	     || (PctGet + PctIns + PctDel > 100))
+		FAILURE("Mix must be get:ins:del percent, total <=", 100);
+	    break;
+
+	case 'M':		// Modes
+	    Modes = optarg;
+	    break;
+
+	case 'k':		// Index distribution
+	    Dist = optarg;
+	    break;
+
+	case 'j':		// JSON output
+	    jFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -o# -t# -S# -s# -mG:I:D -M<modes> -k<dist> -j"
+		   "\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  Indexes in each array to start (100000)\n");
+	    printf("-o <#>  operations per thread (1000000)\n");
+	    printf("-t <#>  most threads (64), run with 1, 2, 4, ... "
+		   "up to it\n");
+	    printf("-S <#>  arrays in sharded mode (64)\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-m G:I:D percent Get, Ins and Del (80:10:10), "
+		   "the rest Next\n");
+	    printf("-M <..> modes, any of private,mutex,rwlock,sharded\n");
+	    printf("-k <..> distribution of the Indexes (random), one of:\n");
+	    JudyKeysHelp();
+	    printf("-j      print JSON, not CSV\n");
+	    exit(1);
+	}
+    }
+
+    nKeys = nElms * 2;
+    if ((Keys = JudyKeys(Dist, &nKeys, Seed)) == NULL)
+	FAILURE("Cannot make Indexes, -n", nElms);
+    nElms = nKeys / 2;			// a short trace
+    if (nElms == 0)
+	FAILURE("Too few Indexes in trace, need at least", 2);
+
+    Threads = (thread_t *)calloc(MaxThreads, sizeof(thread_t));
+    Shards  = (shard_t *)calloc(nShards, sizeof(shard_t));
+    if ((Threads == NULL) || (Shards == NULL))
+	FAILURE("Out of memory, threads =", MaxThreads);
+
+    for (ii = 0; ii < nShards; ii++)
+    {
+	pthread_mutex_init(&Shards[ii].sh_Mutex, NULL);
+	pthread_rwlock_init(&Shards[ii].sh_RWLock, NULL);
+    }
+
+    if (jFlag)
+	printf("[\n");
+    else
+	printf("mode,threads,get,ins,del,next,ops,seconds,ops_per_sec,"
+	       "speedup\n");
+
+    for (Mode = MODE_PRIVATE; Mode <= MODE_SHARDED; Mode++)
+    {
+	if (strstr(Modes, ModeName[Mode]) == NULL)
+	    continue;
+
+	for (nThreads = 1; ; nThreads *= 2)
+	{
+	    if (nThreads > MaxThreads)
+		nThreads = MaxThreads;
+
+	    secs  = Run(Threads, nThreads);
+	    opsps = (double)(nOps * nThreads) / secs;
+	    if (nThreads == 1)
+		base = opsps;
+
+	    if (jFlag)
+		printf("%s  {\"mode\": \"%s\", \"threads\": %lu, "
+		       "\"get\": %d, \"ins\": %d, \"del\": %d, \"next\": %d, "
+		       "\"ops\": %lu, \"seconds\": %.4f, "
+		       "\"ops_per_sec\": %.0f, \"speedup\": %.2f}",
+		       records ? ",\n" : "", ModeName[Mode], nThreads,
+		       PctGet, PctIns, PctDel, 100 - PctGet - PctIns - PctDel,
+		       nOps * nThreads, secs, opsps, opsps / base);
+	    else
+		printf("%s,%lu,%d,%d,%d,%d,%lu,%.4f,%.0f,%.2f\n",
+		       ModeName[Mode], nThreads,
+		       PctGet, PctIns, PctDel, 100 - PctGet - PctIns - PctDel,
+		       nOps * nThreads, secs, opsps, opsps / base);
+	    records++;
+
+	    if (nThreads == MaxThreads)
+		break;
+	}
+    }
+
+    if (jFlag)
+	printf("\n]\n");
+
+    exit(0);
+}
@@ -0,0 +1,417 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyMemBench.c $
+//      This program measures the memory Judy1 and JudyL arrays take per
+//      Index, as the population grows, for each of several Index
+//      distributions (see JudyKeys.h), four ways:
+//
+//      MemUsed         Judy1MemUsed() or JudyLMemUsed()
+//      MemActive       Judy1MemActive() or JudyLMemActive()
+//      Malloc          what malloc(3) really holds for the array, with its
+//                      own overhead:  JudyMalloc() and JudyFree() are
+//                      replaced here to add up the chunk sizes (with glibc,
+//                      malloc_usable_size() plus the chunk header; elsewhere
+//                      2 words a chunk are assumed)
+//      RSS             the change in resident set size, from
+//                      /proc/self/statm (empty or 0 where there is none)
+//
+//      Each array is built in a child process, so the RSS of one is not
+//      muddied by the freed memory of another; the children leave their
+//      measurements in shared memory.
+//
+//      The output is CSV, one line per array, distribution and population;
+//      or with -g, in the format jbgraph reads:  one line per population,
+//      with a column for each array, distribution and measure, and
+//      "# COLHEAD" lines to name them.  For example:
+//
+//      JudyMemBench -g -k zipf,random > mem.plot; jbgraph -c3 -c11 mem.plot
+
+#include <stdlib.h>		// malloc(), exit()
+#include <unistd.h>		// getopt(), fork(), sysconf()
+#include <string.h>		// strtok(), strcmp()
+#include <stdio.h>		// printf()
+#include <math.h>		// pow()
+#include <sys/mman.h>		// mmap()
+#include <sys/wait.h>		// waitpid()
+#ifdef __GLIBC__
+#include <malloc.h>		// malloc_usable_size()
+#endif
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+
+// Compile:
+// # cc -O JudyMemBench.c -lJudy -lm -o JudyMemBench
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+#define MAXDISTS	16
+#define MAXPOINTS	1000
+
+Word_t nElms = 1000000;		// Default = 1M
+Word_t PtsPdec = 10;		// measurement points per decade
+Word_t Seed = 0xc1fc;		// default beginning number
+int    gFlag = 0;		// jbgraph (not CSV) output
+int    Profile = JT_DEFAULT;	// branch conversion (see JudyTuneSet())
+char  *ProfileName = "default";
+char   DistList[256] = "random,zipf,cluster,gauss,stride,pointer";
+
+char  *Dist[MAXDISTS];		// the distributions
+int    nDists;
+Word_t Pop[MAXPOINTS];		// the populations to measure at
+int    nPoints;
+
+const char *ADTName[2] = { "Judy1", "JudyL" };
+
+// One measurement, in bytes for the whole array:
+
+typedef struct MEASUREMENT
+{
+    Word_t mm_Used;
+    Word_t mm_Active;
+    Word_t mm_Malloc;
+    long   mm_RSS;			// -1 if not known
+} mm_t;
+
+// In shared memory, [(Dist * 2 + ADT) * nPoints + Point]:
+
+mm_t  *Results;
+
+#define RESULT(DIST, ADT, POINT)  (Results + ((DIST) * 2 + (ADT)) * nPoints \
+				   + (POINT))
+
+// J U D Y   M A L L O C
+//
+// Replace the library versions, to add up what malloc(3) holds.
+
+Word_t MallocBytes = 0;
+
+static Word_t
+ChunkBytes(void *PWord, Word_t Words)
+{
+#ifdef __GLIBC__
+    (void) Words;
+    return(malloc_usable_size(PWord) + sizeof(size_t));
+#else
+    (void) PWord;
+    return((Words + 2) * sizeof(Word_t));
+#endif
+}
+
+Word_t
+JudyMalloc(Word_t Words)
+{
+    void *PWord = malloc(Words * sizeof(Word_t));
+
+    if (PWord != NULL)
+	MallocBytes += ChunkBytes(PWord, Words);
+    return((Word_t)PWord);
+}
+
+void
+JudyFree(void *PWord, Word_t Words)
+{
+    MallocBytes -= ChunkBytes(PWord, Words);
+    free(PWord);
+}
+
+Word_t
+JudyMallocVirtual(Word_t Words)
+{
+    return(JudyMalloc(Words));
+}
+
+void
+JudyFreeVirtual(void *PWord, Word_t Words)
+{
+    JudyFree(PWord, Words);
+}
+
+// Resident set size in bytes, or -1:
+
+static long
+RSSBytes(void)
+{
+    FILE *fp;
+    long  size, resident;
+
+    if ((fp = fopen("/proc/self/statm", "r")) == NULL)
+	return(-1);
+    if (fscanf(fp, "%ld %ld", &size, &resident) != 2)
+	resident = -1;
+    fclose(fp);
+
+    return((resident < 0) ? -1 : resident * sysconf(_SC_PAGESIZE));
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Measure"
+
+// In a child:  insert Keys[] in order, and measure at each point:
+
+static void
+Measure(Word_t *Keys, int DistNum, int ADT)
+{
+    Pvoid_t PArray = NULL;
+    PWord_t PValue;
+    Word_t  elm = 0, bytes;
+    long    rss0;
+    int     point, Rc;
+
+//  Start stdio and malloc(3), and fault in the code for a small array, so
+//  none of them is counted
+
+    if (ADT == 0)
+    {
+	J1S(Rc, PArray, Keys[0]);
+	J1FA(bytes, PArray);
+    }
+    else
+    {
+	JLI(PValue, PArray, Keys[0]);
+	JLFA(bytes, PArray);
+    }
+    (void) RSSBytes();
+
+    MallocBytes = 0;
+    rss0 = RSSBytes();
+
+    for (point = 0; point < nPoints; point++)
+    {
+	mm_t *Pmm = RESULT(DistNum, ADT, point);
+
+	for ( ; elm < Pop[point]; elm++)
+	{
+	    if (ADT == 0)
+	    {
+		J1S(Rc, PArray, Keys[elm]);
+		if (Rc != 1)
+		    FAILURE("Judy1Set failed at", elm);
+	    }
+	    else
+	    {
+		JLI(PValue, PArray, Keys[elm]);
+		if (PValue == PJERR)
+		    FAILURE("JudyLIns failed at", elm);
+		*PValue = elm;
+	    }
+	}
+
+	if (ADT == 0)
+	{
+	    Pmm->mm_Used   = Judy1MemUsed(PArray);
+	    Pmm->mm_Active = Judy1MemActive(PArray);
+	}
+	else
+	{
+	    Pmm->mm_Used   = JudyLMemUsed(PArray);
+	    Pmm->mm_Active = JudyLMemActive(PArray);
+	}
+	Pmm->mm_Malloc = MallocBytes;
+	Pmm->mm_RSS    = (rss0 < 0) ? -1 : RSSBytes() - rss0;
+    }
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    static const char *MeasureName[4] = { "MemUsed", "MemActive", "Malloc",
+				       "RSS" };
+    Word_t *Keys;
+    Word_t  count;
+    JTune_t Tune;
+    double  mult, next;
+    int     c, dd, adt, point, col, status;
+    pid_t   pid;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:P:s:k:T:g")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Largest population
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'P':		// measurement points per decade
+	    PtsPdec = strtoul(optarg, NULL, 0);
+	    if ((PtsPdec == 0) || (PtsPdec > 100))
+		FAILURE("Points per decade must be 1..100, -P", PtsPdec);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'k':		// Index distributions
+	    strncpy(DistList, optarg, sizeof(DistList) - 1);
+	    break;
+
+	case 'T':		// Branch conversion profile
+	    if      (strcmp(optarg, "default") == 0) Profile = JT_DEFAULT;
+	    else if (strcmp(optarg, "speed")   == 0) Profile = JT_SPEED;
+	    else if (strcmp(optarg, "compact") == 0) Profile = JT_COMPACT;
+	    else FAILURE("Profile not default, speed or compact, -T", 0);
+	    ProfileName = optarg;
+	    break;
+
+	case 'g':		// jbgraph output
+	    gFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -P# -s# -k<dist,...> -T<profile> -g\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  largest population (1000000)\n");
+	    printf("-P <#>  measurement points per decade (10)\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-k <..> Index distributions, with commas, from:\n");
+	    JudyKeysHelp();
+	    printf("-T <..> branch conversion profile: default, speed or "
+		   "compact (JudyTuneSet)\n");
+	    printf("-g      print for jbgraph, not CSV\n");
+	    exit(1);
+	}
+    }
+
+//  Convert branches as the profile says
+
+    JudyTuneProfile(Profile, &Tune);
+    JudyTuneSet(&Tune);
+
+//  The distributions, and the populations to measure at:  PtsPdec per
+//  decade, and the last
+
+    for (dd = 0, Dist[0] = strtok(DistList, ","); Dist[dd] != NULL; )
+    {
+	if (++dd == MAXDISTS)
+	    FAILURE("Too many distributions, most are", MAXDISTS);
+	Dist[dd] = strtok(NULL, ",");
+    }
+    nDists = dd;
+    if (nDists == 0)
+	FAILURE("No distributions: -k", 0);
+
+    mult = pow(10.0, 1.0 / (double)PtsPdec);
+    for (nPoints = 0, next = 1.0; ; next *= mult)
+    {
+	Word_t pop = (Word_t)(next + 0.5);
+
+	if (pop > nElms)
+	    pop = nElms;
+	if ((nPoints > 0) && (pop <= Pop[nPoints - 1]))
+	    continue;			// too close to the last
+	if (nPoints == MAXPOINTS)
+	    FAILURE("Too many points, most are", MAXPOINTS);
+	Pop[nPoints++] = pop;
+	if (pop == nElms)
+	    break;
+    }
+
+    Results = (mm_t *)mmap(NULL, nDists * 2 * nPoints * sizeof(mm_t),
+			   PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+			   -1, 0);
+    if (Results == (mm_t *)MAP_FAILED)
+	FAILURE("Cannot mmap results, bytes =",
+		nDists * 2 * nPoints * sizeof(mm_t));
+
+//  Measure each array for each distribution, in a child
+
+    for (dd = 0; dd < nDists; dd++)
+    {
+	count = nElms;
+	if ((Keys = JudyKeys(Dist[dd], &count, Seed)) == NULL)
+	    FAILURE("Cannot make Indexes, -n", nElms);
+	if (count < nElms)
+	    FAILURE("Too few Indexes in trace, need -n", nElms);
+
+	for (adt = 0; adt < 2; adt++)
+	{
+	    fflush(stdout);
+	    if ((pid = fork()) < 0)
+		FAILURE("Cannot fork, distribution", dd);
+	    if (pid == 0)
+	    {
+		Measure(Keys, dd, adt);
+		_exit(0);
+	    }
+	    if ((waitpid(pid, &status, 0) != pid)
+	     || ! WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+		FAILURE("Measurement failed, distribution", dd);
+	}
+	free(Keys);
+    }
+
+//  Print them, in bytes per Index
+
+    if (! gFlag)
+    {
+	printf("adt,dist,population,memused,memactive,malloc,rss\n");
+	for (dd = 0; dd < nDists; dd++)
+	for (adt = 0; adt < 2; adt++)
+	for (point = 0; point < nPoints; point++)
+	{
+	    mm_t  *Pmm = RESULT(dd, adt, point);
+	    double pop = (double)Pop[point];
+
+	    printf("%s,%s,%lu,%.2f,%.2f,%.2f,", ADTName[adt], Dist[dd],
+		   Pop[point], Pmm->mm_Used / pop, Pmm->mm_Active / pop,
+		   Pmm->mm_Malloc / pop);
+	    if (Pmm->mm_RSS >= 0)
+		printf("%.2f", Pmm->mm_RSS / pop);
+	    printf("\n");
+	}
+	exit(0);
+    }
+
+    printf("# TITLE %s -n%lu -P%lu -s%lu -T%s -k", argv[0], nElms, PtsPdec,
+	   Seed, ProfileName);
+    for (dd = 0; dd < nDists; dd++)
+	printf("%s%s", dd ? "," : "", Dist[dd]);
+    printf("\n# This file is in a format to input to 'jbgraph'\n");
+    printf("# XLABEL Population\n");
+    printf("# YLABEL Bytes / Index\n");
+
+    col = 1;
+    printf("# COLHEAD %d Population\n", col++);
+    for (dd = 0; dd < nDists; dd++)
+    for (adt = 0; adt < 2; adt++)
+    for (c = 0; c < 4; c++)
+	printf("# COLHEAD %d %s %s %s/I\n", col++, ADTName[adt], Dist[dd],
+	       MeasureName[c]);
+    if (sizeof(Word_t) == 8)
+	printf("# %s 64 Bit version\n", argv[0]);
+    else
+	printf("# %s 32 Bit version\n", argv[0]);
+
+    for (point = 0; point < nPoints; point++)
+    {
+	double pop = (double)Pop[point];
+
+	printf("%10lu", Pop[point]);
+	for (dd = 0; dd < nDists; dd++)
+	for (adt = 0; adt < 2; adt++)
+	{
+	    mm_t *Pmm = RESULT(dd, adt, point);
+
+	    printf(" %7.2f %7.2f %7.2f %7.2f", Pmm->mm_Used / pop,
+		   Pmm->mm_Active / pop, Pmm->mm_Malloc / pop,
+		   (Pmm->mm_RSS < 0) ? 0.0 : Pmm->mm_RSS / pop);
+	}
+	printf("\n");
+    }
+    exit(0);
+}
@@ -0,0 +1,669 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudySLCheck.c $
+//      This program tests JudySL, and JudySLB with binary Indexes, checking
+//      each array against a sorted table of the Indexes it holds.
+
+#include <stdlib.h>		// malloc(), qsort()
+#include <unistd.h>		// getopt()
+#include <string.h>		// memcmp()
+#include <stdio.h>		// printf()
+
+#include <Judy.h>
+
+// Compile:
+// # cc -O JudySLCheck.c -lJudy -o JudySLCheck
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+// Specify prototypes for each test routine
+Word_t TestJudySLIns(Pvoid_t *JSL, Word_t Elements, Word_t CountAt);
+
+Word_t TestJudySLOrder(Pvoid_t JSL, Word_t Unique);
+
+Word_t TestJudySLDel(Pvoid_t *JSL, Word_t Unique, Word_t Step);
+
+Word_t TestJudySLPrefix(Pvoid_t JSL, Word_t Unique, Word_t Prefixes);
+
+Word_t TestJudySLCount(Pvoid_t JSL, Word_t Unique, Word_t Ranges, Word_t Step);
+
+Word_t nElms = 100000;		// Default = 100K
+Word_t MaxLen = 40;		// Default longest ordinary Index
+Word_t pFlag = 0;
+Word_t Seed = 0xc1fc;		// default beginning number
+
+// The Indexes, back to back in Strings[], Index i at Offset[i] of Length[i]
+// bytes, followed by a \0 so it can also be used as a JudySL string.  Binary
+// != 0 while testing JudySLB, when Indexes can contain \0s.
+
+uint8_t *Strings;
+Word_t  *Offset;
+Word_t  *Length;
+int      Binary;
+
+// The unique Indexes in Index order, as numbers, and a buffer big enough for
+// any Index returned
+
+Word_t  *Sorted;
+uint8_t *Buffer;
+
+// Small, portable random number generator (xorshift):
+
+static Word_t
+Random(void)
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+    return(Seed);
+}
+
+// Compare Indexes, as JudySL or JudySLB orders them:
+
+static int
+Compare(const uint8_t *Str1, Word_t Len1, const uint8_t *Str2, Word_t Len2)
+{
+    int cmp;
+
+    if (! Binary)
+	return(strcmp((const char *)Str1, (const char *)Str2));
+
+    cmp = memcmp(Str1, Str2, (Len1 < Len2) ? Len1 : Len2);
+    if (cmp)
+	return(cmp);
+    return((Len1 > Len2) - (Len1 < Len2));
+}
+
+static int
+CompareElm(const void *Elm1, const void *Elm2)
+{
+    Word_t e1 = *(const Word_t *)Elm1, e2 = *(const Word_t *)Elm2;
+
+    return(Compare(Strings + Offset[e1], Length[e1],
+		   Strings + Offset[e2], Length[e2]));
+}
+
+// Insert, get, and delete the Index of number elm, whichever flavor:
+
+static PWord_t
+Ins(Pvoid_t *JSL, Word_t elm)
+{
+    PWord_t PValue;
+
+    if (Binary) JSLBI(PValue, *JSL, Strings + Offset[elm], Length[elm])
+    else        JSLI(PValue, *JSL, Strings + Offset[elm])
+    return(PValue);
+}
+
+static PWord_t
+Get(Pvoid_t JSL, Word_t elm)
+{
+    PWord_t PValue;
+
+    if (Binary) JSLBG(PValue, JSL, Strings + Offset[elm], Length[elm])
+    else        JSLG(PValue, JSL, Strings + Offset[elm])
+    return(PValue);
+}
+
+static int
+Del(Pvoid_t *JSL, Word_t elm)
+{
+    int Rc;
+
+    if (Binary) JSLBD(Rc, *JSL, Strings + Offset[elm], Length[elm])
+    else        JSLD(Rc, *JSL, Strings + Offset[elm])
+    return(Rc);
+}
+
+// First/Next/Last/Prev from Buffer (of *PLen bytes if Binary):
+
+#define SEARCH(FUNCB, FUNC)						\
+    if (Binary) return((PWord_t)FUNCB(JSL, Buffer, PLen, PJE0));	\
+    *PLen = 0;								\
+    PValue = (PWord_t)FUNC(JSL, Buffer, PJE0);				\
+    if (PValue != NULL) *PLen = strlen((const char *)Buffer);		\
+    return(PValue)
+
+static PWord_t First(Pvoid_t JSL, PWord_t PLen)
+{ PWord_t PValue; SEARCH(JudySLBFirst, JudySLFirst); }
+
+static PWord_t Next(Pvoid_t JSL, PWord_t PLen)
+{ PWord_t PValue; SEARCH(JudySLBNext, JudySLNext); }
+
+static PWord_t Last(Pvoid_t JSL, PWord_t PLen)
+{ PWord_t PValue; SEARCH(JudySLBLast, JudySLLast); }
+
+static PWord_t Prev(Pvoid_t JSL, PWord_t PLen)
+{ PWord_t PValue; SEARCH(JudySLBPrev, JudySLPrev); }
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    Pvoid_t JSL = NULL;		// JudySL or JudySLB
+    Word_t Unique, Bytes;
+    int    Rc;
+    Word_t elm, total = 0, longest = 0;
+    int    c;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:l:s:p")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of Indexes
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'l':		// Longest ordinary Index
+	    MaxLen = strtoul(optarg, NULL, 0);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'p':		// Print results
+	    pFlag = 1;
+	    break;
+
+	default:
+	    printf("\n%s -n# -l# -s# -p\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  number of Indexes used in tests\n");
+	    printf("-l <#>  longest ordinary Index, 1 in 64 is longer\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-p      print results\n");
+	    exit(1);
+	}
+    }
+
+//  Make the Indexes:  mostly short, a few much longer, from only 4 different
+//  bytes so that many share long prefixes
+
+    Offset = (Word_t *)malloc(nElms * sizeof(Word_t));
+    Length = (Word_t *)malloc(nElms * sizeof(Word_t));
+    Sorted = (Word_t *)malloc(nElms * sizeof(Word_t));
+    for (elm = 0; elm < nElms; elm++)
+    {
+	Length[elm] = Random() % (MaxLen + 1);
+	if ((Random() & 63) == 0)
+	    Length[elm] += Random() % (MaxLen * 8 + 1);
+	if (Length[elm] > longest)
+	    longest = Length[elm];
+	Offset[elm] = total;
+	total += Length[elm] + 1;
+    }
+    Strings = (uint8_t *)malloc(total);
+    Buffer  = (uint8_t *)malloc(MaxLen * 9 + 2);
+    if ((Offset == NULL) || (Length == NULL) || (Sorted == NULL)
+     || (Strings == NULL) || (Buffer == NULL))
+	FAILURE("Out of memory, bytes =", total);
+
+//  First as JudySL strings, without \0s.  Half the Indexes start with some
+//  of an earlier one, so there are long shared prefixes of every length:
+
+    for (elm = 0; elm < nElms; elm++)
+    {
+	Word_t ii = 0;
+
+	if (elm && (Random() & 1))
+	{
+	    Word_t old = Random() % elm;
+
+	    ii = Random() % (Length[old] + 1);
+	    if (ii > Length[elm])
+		ii = Length[elm];
+	    memcpy(Strings + Offset[elm], Strings + Offset[old], ii);
+	}
+	for ( ; ii < Length[elm]; ii++)
+	    Strings[Offset[elm] + ii] = "\001ab\377"[(Random() >> 8) & 3];
+	Strings[Offset[elm] + ii] = '\0';
+    }
+
+    for (Binary = 0; Binary < 2; Binary++)
+    {
+	if (Binary)		// then with \0s in place of 'b's:
+	{
+	    for (elm = 0; elm < total; elm++)
+		if (Strings[elm] == 'b')
+		    Strings[elm] = '\0';
+	}
+
+	Unique = TestJudySLIns(&JSL, nElms, 0);
+
+	TestJudySLOrder(JSL, Unique);
+
+	if (! Binary)
+	    TestJudySLPrefix(JSL, Unique, 200);
+
+//      Delete every third Index and check again, then (JudySL) count a
+//      little without counts kept, which is slow, keep them, count, delete
+//      every other one, and count again
+
+	Unique -= TestJudySLDel(&JSL, Unique, 3);
+	TestJudySLOrder(JSL, Unique);
+
+	if (! Binary)
+	{
+	    TestJudySLCount(JSL, Unique, 10, Unique / 10 + 1);
+	    JSLCI(Rc, JSL);
+	    if (Rc != 1)
+		FAILURE("JudySLCountInit failed, Unique =", Unique);
+	    TestJudySLCount(JSL, Unique, 1000, 1);
+	    Unique -= TestJudySLDel(&JSL, Unique, 2);
+	    TestJudySLCount(JSL, Unique, 1000, 1);
+	    TestJudySLOrder(JSL, Unique);
+	}
+
+//      Then delete the rest; a counted JudySL array stays counted
+
+	TestJudySLDel(&JSL, Unique, 1);
+	TestJudySLOrder(JSL, 0);
+	if (! Binary)
+	    TestJudySLCount(JSL, 0, 0, 1);
+	else if (JSL != NULL)
+	    FAILURE("Array not empty after deleting all, Binary =", Binary);
+
+//      And again, (JudySL) counted from the start, then free the whole array
+
+	Unique = TestJudySLIns(&JSL, nElms, nElms / 2);
+
+	if (! Binary)
+	{
+	    TestJudySLCount(JSL, Unique, 1000, 1);
+	    TestJudySLOrder(JSL, Unique);
+	}
+
+	if (Binary) JSLBFA(Bytes, JSL)
+	else        JSLFA(Bytes, JSL)
+	if (pFlag)
+	    printf("%s = %lu bytes for %lu Indexes\n",
+		   Binary ? "JudySLBFreeArray" : "JudySLFreeArray",
+		   Bytes, Unique);
+    }
+
+    printf("Passed JudySL and JudySLB tests for %lu Indexes of <= %lu bytes\n",
+	   nElms, longest);
+    exit(0);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudySLIns"
+
+// Store the Indexes, each with its number + 1 unless a duplicate, and make
+// the sorted table of unique Indexes; return their number.  If CountAt, have
+// a JudySL array counted (see JudySLCountInit()) from that Index on.
+
+Word_t
+TestJudySLIns(Pvoid_t *JSL, Word_t Elements, Word_t CountAt)
+{
+    Word_t elm, unique = 0, count;
+    PWord_t PValue, PValue1;
+
+    for (elm = 0; elm < Elements; elm++)
+    {
+	if (CountAt && (elm == CountAt) && (! Binary))
+	{
+	    JSLCI(count, *JSL);
+	    if (count != 1)
+		FAILURE("JudySLCountInit failed at", elm);
+	    JSLC(count, *JSL, (uint8_t *)"", (uint8_t *)"\377");
+	    if (count > unique)
+		FAILURE("JudySLCount too many Indexes, unique =", unique);
+	}
+	PValue = Ins(JSL, elm);
+	if (PValue == PJERR)
+	    FAILURE("JudySL[B]Ins failed at", elm);
+
+	if (*PValue == 0)
+	{
+	    *PValue = elm + 1;
+	    Sorted[unique++] = elm;
+	}
+	PValue1 = Get(*JSL, elm);
+	if (PValue1 != PValue)
+	    FAILURE("JudySL[B]Get ret different PValue at", elm);
+    }
+    qsort(Sorted, unique, sizeof(Word_t), CompareElm);
+
+    for (elm = 1; elm < unique; elm++)
+	if (CompareElm(Sorted + elm - 1, Sorted + elm) >= 0)
+	    FAILURE("Duplicate Index stored twice at", Sorted[elm]);
+
+    if (pFlag)
+	printf("JudySL%sIns: %lu Indexes, %lu unique\n",
+	       Binary ? "B" : "", Elements, unique);
+
+    return(unique);
+}
+
+// Copy to Buffer the Index of number elm (not empty) with its last byte
+// changed, or if Shorten, without its last byte; return the new length.
+
+static Word_t
+NearMiss(Word_t elm, int Shorten)
+{
+    Word_t len = Length[elm];
+
+    memcpy(Buffer, Strings + Offset[elm], len + 1);
+    if (Shorten)
+	Buffer[--len] = '\0';
+    else
+	Buffer[len - 1] = (Buffer[len - 1] == 'a') ? '\001' : 'a';
+    return(len);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudySLOrder"
+
+// Check that First/Next and Last/Prev visit exactly the Indexes in Sorted[],
+// in order, and that First and Last from other Indexes (near misses of
+// stored ones) find the neighbors they should; return the number visited.
+
+Word_t
+TestJudySLOrder(Pvoid_t JSL, Word_t Unique)
+{
+    PWord_t PValue;
+    Word_t  len, count, elm, ii, lo, hi;
+
+//  Forward, from the empty Index
+
+    len = 0;
+    Buffer[0] = '\0';
+    for (count = 0, PValue = First(JSL, &len); PValue != NULL;
+	 count++, PValue = Next(JSL, &len))
+    {
+	if (PValue == PJERR)
+	    FAILURE("JudySL[B]Next failed, count =", count);
+	if (count >= Unique)
+	    FAILURE("JudySL[B]Next too many Indexes, count =", count);
+
+	elm = Sorted[count];
+	if ((*PValue != elm + 1) || (len != Length[elm])
+	 || memcmp(Buffer, Strings + Offset[elm], len))
+	    FAILURE("JudySL[B]Next wrong Index at", count);
+	if ((! Binary) && (Buffer[len] != '\0'))
+	    FAILURE("JudySLNext Index not terminated at", count);
+    }
+    if (count != Unique)
+	FAILURE("JudySL[B]Next count wrong, count =", count);
+
+//  Backward, from past the largest Index (\377s)
+
+    memset(Buffer, 0xff, len = MaxLen * 9 + 1);
+    Buffer[len] = '\0';
+    for (count = Unique, PValue = Last(JSL, &len); PValue != NULL;
+	 PValue = Prev(JSL, &len))
+    {
+	if ((PValue == PJERR) || (count == 0))
+	    FAILURE("JudySL[B]Prev failed or too many, count =", count);
+
+	elm = Sorted[--count];
+	if ((*PValue != elm + 1) || (len != Length[elm])
+	 || memcmp(Buffer, Strings + Offset[elm], len))
+	    FAILURE("JudySL[B]Prev wrong Index at", count);
+    }
+    if (count != 0)
+	FAILURE("JudySL[B]Prev missed Indexes, count =", count);
+
+//  From near misses:  each stored Index with its last byte changed, or
+//  shortened by one byte
+
+    for (ii = 0; ii < Unique; ii++)
+    {
+	elm = Sorted[ii];
+	if (Length[elm] == 0)
+	    continue;
+
+//      lo = number of stored Indexes < the near miss, hi = number <= it
+
+	len = NearMiss(elm, ii & 1);
+	for (lo = 0, hi = Unique; lo < hi; )
+	{
+	    Word_t mid = (lo + hi) / 2;
+
+	    if (Compare(Strings + Offset[Sorted[mid]], Length[Sorted[mid]],
+			Buffer, len) < 0) lo = mid + 1;
+	    else                          hi = mid;
+	}
+	hi = lo;
+	if ((hi < Unique) && (Compare(Strings + Offset[Sorted[hi]],
+				      Length[Sorted[hi]], Buffer, len) == 0))
+	    hi++;
+
+	PValue = First(JSL, &len);
+	if ((lo == Unique) ? (PValue != NULL)
+			   : ((PValue == NULL) || (*PValue != Sorted[lo] + 1)))
+	    FAILURE("JudySL[B]First wrong neighbor at", ii);
+
+	len = NearMiss(elm, ii & 1);
+	PValue = Last(JSL, &len);
+	if ((hi == 0) ? (PValue != NULL)
+		      : ((PValue == NULL) || (*PValue != Sorted[hi - 1] + 1)))
+	    FAILURE("JudySL[B]Last wrong neighbor at", ii);
+    }
+    return(Unique);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudySLDel"
+
+// Delete every Step'th Index in Sorted[] (compacting Sorted[] to those left),
+// checking that each goes and that deleting it again fails; return the
+// number deleted.
+
+Word_t
+TestJudySLDel(Pvoid_t *JSL, Word_t Unique, Word_t Step)
+{
+    Word_t ii, elm, kept = 0, deleted = 0;
+
+    for (ii = 0; ii < Unique; ii++)
+    {
+	elm = Sorted[ii];
+	if ((ii % Step) != 0)
+	{
+	    Sorted[kept++] = elm;
+	    continue;
+	}
+	if (Del(JSL, elm) != 1)
+	    FAILURE("JudySL[B]Del failed at", elm);
+	if (Get(*JSL, elm) != NULL)
+	    FAILURE("JudySL[B]Get found deleted Index at", elm);
+	if (Del(JSL, elm) != 0)
+	    FAILURE("JudySL[B]Del deleted twice at", elm);
+	deleted++;
+    }
+    for (ii = 0; ii < kept; ii++)
+	if (Get(*JSL, Sorted[ii]) == NULL)
+	    FAILURE("JudySL[B]Get lost an Index at", Sorted[ii]);
+
+    if (pFlag)
+	printf("JudySL%sDel: %lu of %lu Indexes\n",
+	       Binary ? "B" : "", deleted, Unique);
+
+    return(deleted);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudySLPrefix"
+
+// Scan with JudySLPrefixFirst/Next for prefixes of stored strings (some
+// altered in their last byte), checking that exactly the strings in Sorted[]
+// with each prefix are returned, in order; return the number returned.
+
+Word_t
+TestJudySLPrefix(Pvoid_t JSL, Word_t Unique, Word_t Prefixes)
+{
+    JSLCursor_t Cursor;
+    uint8_t *Prefix;
+    PWord_t  PValue;
+    Word_t   ii, elm, len, lo, hi, count, total = 0;
+
+    JSLCURSORINIT(&Cursor);
+    if (JudySLPrefixNext(&Cursor, Buffer, PJE0) != NULL)
+	FAILURE("JudySLPrefixNext before JudySLPrefixFirst, Unique =", Unique);
+
+    Prefix = (uint8_t *)malloc(MaxLen * 9 + 2);
+    if (Prefix == NULL)
+	FAILURE("Out of memory, Prefixes =", Prefixes);
+
+    for (ii = 0; ii < Prefixes; ii++)
+    {
+	elm = Sorted[Random() % Unique];
+	len = Random() % (Length[elm] + 1);
+	memcpy(Prefix, Strings + Offset[elm], len);
+	Prefix[len] = '\0';
+	if (len && (ii & 1))
+	    Prefix[len - 1] = (Prefix[len - 1] == 'a') ? '\001' : 'a';
+
+//      The strings with the prefix are Sorted[lo .. hi - 1]
+
+	for (lo = 0, hi = Unique; lo < hi; )
+	{
+	    Word_t mid = (lo + hi) / 2;
+
+	    if (strcmp((char *)Strings + Offset[Sorted[mid]],
+		       (char *)Prefix) < 0) lo = mid + 1;
+	    else                            hi = mid;
+	}
+	for (hi = lo; (hi < Unique) && (strncmp((char *)Strings
+		 + Offset[Sorted[hi]], (char *)Prefix, len) == 0); hi++)
+	    ;
+
+	count = 0;
+	PValue = (PWord_t)JudySLPrefixFirst(JSL, Prefix, &Cursor, Buffer, PJE0);
+	while (PValue != NULL)
+	{
+	    if (PValue == PJERR)
+		FAILURE("JudySLPrefixNext failed, count =", count);
+	    if (lo + count >= hi)
+		FAILURE("JudySLPrefixNext too many strings at", ii);
+
+	    elm = Sorted[lo + count];
+	    if ((*PValue != elm + 1)
+	     || strcmp((char *)Buffer, (char *)Strings + Offset[elm]))
+		FAILURE("JudySLPrefixNext wrong string at", lo + count);
+	    count++;
+	    PValue = (PWord_t)JudySLPrefixNext(&Cursor, Buffer, PJE0);
+	}
+	if (count != hi - lo)
+	    FAILURE("JudySLPrefixNext missed strings at", ii);
+	total += count;
+    }
+    if (JudySLCursorFree(&Cursor) == 0)
+	FAILURE("JudySLCursorFree freed nothing, total =", total);
+    free(Prefix);
+
+    if (pFlag)
+	printf("JudySLPrefixNext: %lu strings for %lu prefixes\n",
+	       total, Prefixes);
+
+    return(total);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "TestJudySLCount"
+
+// Return the number of strings in Sorted[] before Str, or if Inclusive, up to
+// and including it:
+
+static Word_t
+Before(Word_t Unique, const uint8_t *Str, int Inclusive)
+{
+    Word_t lo = 0, hi = Unique, mid;
+    int    cmp;
+
+    while (lo < hi)
+    {
+	mid = (lo + hi) / 2;
+	cmp = strcmp((char *)Strings + Offset[Sorted[mid]], (char *)Str);
+	if ((cmp < 0) || (Inclusive && (cmp == 0))) lo = mid + 1;
+	else                                         hi = mid;
+    }
+    return(lo);
+}
+
+// Check that JudySLByCount finds each Step-th string in Sorted[] by its
+// place, and that JudySLCount counts the strings between pairs of strings
+// (stored ones or near misses); return the number of strings counted.
+
+Word_t
+TestJudySLCount(Pvoid_t JSL, Word_t Unique, Word_t Ranges, Word_t Step)
+{
+    uint8_t *Lower;
+    PWord_t  PValue;
+    Word_t   ii, elm, count, expect, total = 0;
+
+    Lower = (uint8_t *)malloc(MaxLen * 9 + 2);
+    if (Lower == NULL)
+	FAILURE("Out of memory, Ranges =", Ranges);
+
+//  All of them, from the empty string through the largest (\377s)
+
+    memset(Buffer, 0xff, MaxLen * 9 + 1);
+    Buffer[MaxLen * 9 + 1] = '\0';
+    JSLC(count, JSL, (uint8_t *)"", Buffer);
+    if (count != Unique)
+	FAILURE("JudySLCount of all strings wrong, count =", count);
+
+    for (ii = 1; ii <= Unique; ii += Step)
+    {
+	elm = Sorted[ii - 1];
+	JSLBYC(PValue, JSL, ii, Buffer);
+	if ((PValue == NULL) || (PValue == PJERR) || (*PValue != elm + 1)
+	 || strcmp((char *)Buffer, (char *)Strings + Offset[elm]))
+	    FAILURE("JudySLByCount wrong string at", ii);
+    }
+    JSLBYC(PValue, JSL, Unique + 1, Buffer);
+    if (PValue != NULL)
+	FAILURE("JudySLByCount found too many strings, Unique =", Unique);
+    JSLBYC(PValue, JSL, 0, Buffer);
+    if (PValue != NULL)
+	FAILURE("JudySLByCount found string 0, Unique =", Unique);
+
+//  Between pairs of strings, each stored or altered in its last byte
+
+    for (ii = 0; (ii < Ranges) && Unique; ii++)
+    {
+	elm = Sorted[Random() % Unique];
+	if (Length[elm] && (ii & 1))
+	    NearMiss(elm, ii & 2);
+	else
+	    strcpy((char *)Buffer, (char *)Strings + Offset[elm]);
+	strcpy((char *)Lower, (char *)Buffer);
+
+	elm = Sorted[Random() % Unique];
+	if (Length[elm] && (ii & 4))
+	    NearMiss(elm, ii & 8);
+	else
+	    strcpy((char *)Buffer, (char *)Strings + Offset[elm]);
+
+	expect = Before(Unique, Buffer, 1) - Before(Unique, Lower, 0);
+	if (strcmp((char *)Lower, (char *)Buffer) > 0)
+	    expect = 0;
+
+	JSLC(count, JSL, Lower, Buffer);
+	if (count != expect)
+	    FAILURE("JudySLCount wrong count at", ii);
+	total += count;
+    }
+    free(Lower);
+
+    if (pFlag)
+	printf("JudySLCount: %lu strings in %lu ranges\n", total, Ranges);
+
+    return(total);
+}
@@ -0,0 +1,527 @@
+// @(#) $Revision: 4.1 $ $Source: /judy/test/JudyTransition.c $
+//      This program measures what each change of JP Type costs in Judy1 and
+//      JudyL arrays -- a leaf cascading into a branch or into a bigger leaf
+//      (JudyCascade.c), a BranchL or BranchB converting to a BranchU, an
+//      immediate growing into a leaf, and the decascades back on delete
+//      (JudyDecascade.c) -- in cycles, and in bytes allocated and freed.
+//
+//      The populations at which these happen (cJU_LEAF*_MAXPOP1,
+//      JU_BRANCHB_MAX_POP, JU_BTOU_POP_INCREMENT and so on) are private to
+//      the library, and which of them an array meets depends on its Indexes,
+//      so they are found here rather than assumed:  for each distribution
+//      (see JudyKeys.h) the Indexes are inserted one at a time, and then
+//      deleted in the opposite order, and after each operation the array is
+//      walked with Judy1Inspect() or JudyLInspect().  Wherever there are
+//      fewer nodes of some kind than before, a JP changed Type, and the
+//      change is named by the kinds of nodes that went and came:
+//
+//      LeafW -> BranchL8+Leaf7         the root leaf cascading
+//      Leaf2 -> LeafB1                 j__udyJLL2toJLB1() (JudyL)
+//      Immed_2_07 -> Leaf2             an immediate full (Judy1)
+//      BranchB2 -> BranchU2+Immed_1_01 a bitmap branch uncompressed, and the
+//                                      new Index put under it
+//      BranchB2+Immed_1_01 -> Leaf2    a branch decascading on delete
+//
+//      For the first time each change happens (the threshold), the array is
+//      built again just short of it, -r times, and only the one operation
+//      that crosses it is measured:  in cycles with the Linux
+//      perf_event_open(2) cycle counter, or else the x86 time stamp counter
+//      (see JudyCycles.h), and in ns with clock_gettime(), less what
+//      measuring nothing takes.
+//      JudyMalloc() and JudyFree() are replaced here to add up the bytes and
+//      calls the operation asks for and gives back.  The output is CSV, one
+//      line per array, distribution, operation and change, with the minimum
+//      and median of the -r measurements.  Each array is hot in the cache,
+//      as it is just built, so these are the costs of the work itself; to
+//      tune a threshold, compare them with the operations either side of it
+//      (JudyLatency) and with the memory saved (JudyMemBench).
+
+#include <stdlib.h>		// malloc(), qsort(), exit()
+#include <unistd.h>		// getopt(), read()
+#include <string.h>		// memset(), strtok(), strcmp()
+#include <stdio.h>		// printf(), snprintf()
+#include <time.h>		// clock_gettime()
+
+#include <Judy.h>
+#include "JudyKeys.h"		// JudyKeys()
+#include "JudyCycles.h"		// OpenCycles(), StartCycles(), StopCycles()
+
+// Compile:
+// # cc -O JudyTransition.c -lJudy -lm -o JudyTransition
+
+// Common macro to handle a failure
+#define FAILURE(STR, UL)						\
+{									\
+printf(         "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+fprintf(stderr, "Error: %s %lu, file='%s', 'function='%s', line %d\n",	\
+	STR, (Word_t)(UL), __FILE__, __FUNCTI0N__, __LINE__); 		\
+	exit(1);							\
+}
+
+#define MAXDISTS	16
+#define MAXREPS		1000
+#define MAXCHANGES	128		// different changes per array
+#define NAMELEN		160
+
+Word_t nElms = 4096;		// enough for a BranchB to BranchU
+Word_t Reps = 25;		// measurements of each change
+Word_t Seed = 0xc1fc;		// default beginning number
+char   DistList[256] = "stride:1,stride:256,stride:65536,cluster,random";
+char  *ADTs = "1L";		// which arrays to measure
+
+const char *ADTName[2] = { "Judy1", "JudyL" };
+const char *OpName[2]  = { "ins", "del" };
+
+// J U D Y   M A L L O C
+//
+// Replace the library versions, to add up what one operation asks for and
+// gives back, in the bytes Judy asks for (not what malloc(3) adds to them).
+
+Word_t AllocBytes, FreedBytes, Allocs, Frees;
+
+Word_t
+JudyMalloc(Word_t Words)
+{
+    Allocs++;
+    AllocBytes += Words * sizeof(Word_t);
+    return((Word_t)malloc(Words * sizeof(Word_t)));
+}
+
+void
+JudyFree(void *PWord, Word_t Words)
+{
+    Frees++;
+    FreedBytes += Words * sizeof(Word_t);
+    free(PWord);
+}
+
+Word_t
+JudyMallocVirtual(Word_t Words)
+{
+    return(JudyMalloc(Words));
+}
+
+void
+JudyFreeVirtual(void *PWord, Word_t Words)
+{
+    JudyFree(PWord, Words);
+}
+
+static Word_t
+Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((Word_t)ts.tv_sec * 1000000000 + (Word_t)ts.tv_nsec);
+}
+
+// THE ARRAYS:
+//
+// One operation on either kind of array, by number (0 = Judy1, 1 = JudyL):
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Operate"
+
+static void
+Insert(int ADT, PPvoid_t PPArray, Word_t Index)
+{
+    PPvoid_t PPValue;
+
+    if (ADT == 0)
+    {
+	if (Judy1Set(PPArray, Index, PJE0) != 1)
+	    FAILURE("Judy1Set did not add Index", Index);
+	return;
+    }
+    if ((PPValue = JudyLIns(PPArray, Index, PJE0)) == PPJERR)
+	FAILURE("JudyLIns failed, Index", Index);
+    *(PWord_t)PPValue = Index;
+}
+
+static void
+Delete(int ADT, PPvoid_t PPArray, Word_t Index)
+{
+    int Rc = (ADT == 0) ? Judy1Unset(PPArray, Index, PJE0)
+			: JudyLDel(PPArray, Index, PJE0);
+
+    if (Rc != 1)
+	FAILURE("Delete did not find Index", Index);
+}
+
+static void
+Inspect(int ADT, Pvoid_t PArray, PJInspect_t PInspect)
+{
+    Word_t Bytes = (ADT == 0) ? Judy1Inspect(PArray, PInspect, PJE0)
+			      : JudyLInspect(PArray, PInspect, PJE0);
+
+    if (Bytes == JERR)
+	FAILURE("Inspect failed, ADT", ADT);
+}
+
+static void
+FreeArray(int ADT, PPvoid_t PPArray)
+{
+    if (ADT == 0)
+	Judy1FreeArray(PPArray, PJE0);
+    else
+	JudyLFreeArray(PPArray, PJE0);
+}
+
+// THE CHANGES:
+//
+// Name the change between two walks of an array, as the kinds of nodes there
+// are fewer of, "->", and the kinds there are more of.  Return 0 if there
+// are fewer of none:  nothing changed Type, though JPs may have been added.
+
+#define KINDS	(JI_LEVELS * (4 + JI_MAXIMMED) + 2)
+
+static Word_t
+KindCount(PJInspect_t PInspect, int Kind, char *Name)
+{
+    int level = Kind % JI_LEVELS;
+    int pop;
+
+    switch (Kind / JI_LEVELS)
+    {
+    case 0:
+	sprintf(Name, "BranchL%d", level);
+	return(PInspect->ji_BranchL[level].jin_Count);
+    case 1:
+	sprintf(Name, "BranchB%d", level);
+	return(PInspect->ji_BranchB[level].jin_Count);
+    case 2:
+	sprintf(Name, "BranchU%d", level);
+	return(PInspect->ji_BranchU[level].jin_Count);
+    case 3:
+	if (level == sizeof(Word_t))
+	    strcpy(Name, "LeafW");
+	else
+	    sprintf(Name, "Leaf%d", level);
+	return(PInspect->ji_Leaf[level].jin_Count);
+    }
+
+    if (Kind == KINDS - 2)
+    {
+	strcpy(Name, "LeafB1");
+	return(PInspect->ji_LeafB1.jin_Count);
+    }
+    if (Kind == KINDS - 1)
+    {
+	strcpy(Name, "FullPopu1");
+	return(PInspect->ji_FullPopu1.jin_Count);
+    }
+
+    pop = Kind / JI_LEVELS - 4;
+    sprintf(Name, "Immed_%d_%02d", level, pop);
+    return(PInspect->ji_Immed[level][pop].jin_Count);
+}
+
+static int
+ChangeName(PJInspect_t PBefore, PJInspect_t PAfter, char *Name)
+{
+    char   went[NAMELEN], came[NAMELEN], kind[32];
+    size_t wentlen = 0, camelen = 0;
+    int    Kind;
+
+    went[0] = came[0] = '\0';
+
+    for (Kind = 0; Kind < KINDS; Kind++)
+    {
+	Word_t before = KindCount(PBefore, Kind, kind);
+	Word_t after  = KindCount(PAfter,  Kind, kind);
+
+	if (after < before)
+	    wentlen += snprintf(went + wentlen, NAMELEN - wentlen, "%s%s",
+				wentlen ? "+" : "", kind);
+	else if (after > before)
+	    camelen += snprintf(came + camelen, NAMELEN - camelen, "%s%s",
+				camelen ? "+" : "", kind);
+
+	if (wentlen >= NAMELEN) wentlen = NAMELEN - 1;
+	if (camelen >= NAMELEN) camelen = NAMELEN - 1;
+    }
+    if (wentlen == 0)
+	return(0);
+
+    snprintf(Name, NAMELEN, "%s -> %s", went, camelen ? came : "-");
+    return(1);
+}
+
+// Each different change met in an array, the first time (the threshold):
+
+typedef struct CHANGE
+{
+    int    ch_Op;			// 0 = insert, 1 = delete
+    char   ch_Name[NAMELEN];
+    Word_t ch_Step;			// Indexes inserted or deleted before
+    Word_t ch_Pop;			// population before the operation
+    Word_t ch_Seen;			// times met in the whole run
+} change_t;
+
+change_t Change[MAXCHANGES];
+int      nChanges;
+
+static void
+Note(int Op, char *Name, Word_t Step, Word_t Pop)
+{
+    int ch;
+
+    for (ch = 0; ch < nChanges; ch++)
+    {
+	if ((Change[ch].ch_Op == Op) && (strcmp(Change[ch].ch_Name, Name) == 0))
+	{
+	    Change[ch].ch_Seen++;
+	    return;
+	}
+    }
+    if (nChanges == MAXCHANGES)
+	return;				// keep the first ones
+
+    Change[nChanges].ch_Op   = Op;
+    strcpy(Change[nChanges].ch_Name, Name);
+    Change[nChanges].ch_Step = Step;
+    Change[nChanges].ch_Pop  = Pop;
+    Change[nChanges].ch_Seen = 1;
+    nChanges++;
+}
+
+// Insert all the Indexes, then delete them last first, walking the array
+// after each operation to find the changes:
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Discover"
+
+static void
+Discover(int ADT, Word_t *Keys)
+{
+    Pvoid_t    PArray = (Pvoid_t) NULL;
+    JInspect_t before, after;
+    char       name[NAMELEN];
+    Word_t     step;
+
+    nChanges = 0;
+    Inspect(ADT, PArray, &before);
+
+    for (step = 0; step < nElms; step++)
+    {
+	Insert(ADT, &PArray, Keys[step]);
+	Inspect(ADT, PArray, &after);
+	if (ChangeName(&before, &after, name))
+	    Note(0, name, step, step);
+	before = after;
+    }
+
+    for (step = 0; step < nElms; step++)
+    {
+	Delete(ADT, &PArray, Keys[nElms - 1 - step]);
+	Inspect(ADT, PArray, &after);
+	if (ChangeName(&before, &after, name))
+	    Note(1, name, step, nElms - step);
+	before = after;
+    }
+
+    if (PArray != (Pvoid_t) NULL)
+	FAILURE("Array not empty after deleting all, Indexes =", nElms);
+}
+
+// MEASURING ONE CHANGE:
+//
+// Build the array just short of the change, from nothing each time, then
+// measure the operation that makes it, and check it made the same change.
+
+Word_t CycleOverhead, NsOverhead;	// of measuring nothing
+
+static int
+CompareWord(const void *P1, const void *P2)
+{
+    Word_t w1 = *(const Word_t *)P1, w2 = *(const Word_t *)P2;
+
+    return((w1 > w2) - (w1 < w2));
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "Measure"
+
+static void
+Measure(int ADT, const char *Dist, Word_t *Keys, change_t *Pch)
+{
+    static Word_t cycles[MAXREPS], ns[MAXREPS];
+    Pvoid_t    PArray;
+    JInspect_t before, after;
+    char       name[NAMELEN];
+    Word_t     rep, step, index, start = 0, begin;
+    Word_t     alloc = 0, freed = 0, allocs = 0, frees = 0;
+
+    for (rep = 0; rep < Reps; rep++)
+    {
+	PArray = (Pvoid_t) NULL;
+	if (Pch->ch_Op == 0)
+	{
+	    for (step = 0; step < Pch->ch_Step; step++)
+		Insert(ADT, &PArray, Keys[step]);
+	    index = Keys[Pch->ch_Step];
+	}
+	else
+	{
+	    for (step = 0; step < nElms; step++)
+		Insert(ADT, &PArray, Keys[step]);
+	    for (step = 0; step < Pch->ch_Step; step++)
+		Delete(ADT, &PArray, Keys[nElms - 1 - step]);
+	    index = Keys[nElms - 1 - Pch->ch_Step];
+	}
+	Inspect(ADT, PArray, &before);
+
+	AllocBytes = FreedBytes = Allocs = Frees = 0;
+	begin = Now();
+	StartCycles(&start);
+	if (Pch->ch_Op == 0)
+	    Insert(ADT, &PArray, index);
+	else
+	    Delete(ADT, &PArray, index);
+	cycles[rep] = StopCycles(start);
+	ns[rep]     = Now() - begin;
+	alloc  = AllocBytes;
+	freed  = FreedBytes;
+	allocs = Allocs;
+	frees  = Frees;
+
+	cycles[rep] = (cycles[rep] > CycleOverhead)
+		    ? cycles[rep] - CycleOverhead : 0;
+	ns[rep]	    = (ns[rep] > NsOverhead) ? ns[rep] - NsOverhead : 0;
+
+	Inspect(ADT, PArray, &after);
+	if (! ChangeName(&before, &after, name) || strcmp(name, Pch->ch_Name))
+	    FAILURE("Rebuilt array made a different change, step",
+		    Pch->ch_Step);
+	FreeArray(ADT, &PArray);
+    }
+
+    qsort(cycles, Reps, sizeof(Word_t), CompareWord);
+    qsort(ns,	  Reps, sizeof(Word_t), CompareWord);
+
+    printf("%s,%s,%s,%s,%lu,%lu,%lu,", ADTName[ADT], Dist, OpName[Pch->ch_Op],
+	   Pch->ch_Name, Pch->ch_Pop, Pch->ch_Seen, Reps);
+    if (strcmp(CycleSource, "none"))
+	printf("%lu,%lu", cycles[0], cycles[Reps / 2]);
+    else
+	printf(",");
+    printf(",%lu,%lu,%lu,%lu,%lu,%lu\n", ns[0], ns[Reps / 2],
+	   alloc, freed, allocs, frees);
+}
+
+#undef __FUNCTI0N__
+#define __FUNCTI0N__ "main"
+
+int
+main(int argc, char *argv[])
+{
+    char   *Dist[MAXDISTS];
+    Word_t *Keys, count, rep, start = 0, begin, cycles, ns;
+    int     nDists, dd, adt, ch, c;
+    extern char *optarg;
+
+    while ((c = getopt(argc, argv, "n:r:s:a:k:")) != -1)
+    {
+	switch (c)
+	{
+	case 'n':		// Number of Indexes
+	    nElms = strtoul(optarg, NULL, 0);
+	    if (nElms == 0)
+		FAILURE("No tests: -n", nElms);
+	    break;
+
+	case 'r':		// Measurements of each change
+	    Reps = strtoul(optarg, NULL, 0);
+	    if ((Reps == 0) || (Reps > MAXREPS))
+		FAILURE("Measurements must be 1 to 1000, -r", Reps);
+	    break;
+
+	case 's':		// Random number seed
+	    Seed = strtoul(optarg, NULL, 0);
+	    if (Seed == 0)
+		FAILURE("Seed must not be", Seed);
+	    break;
+
+	case 'a':		// Arrays to measure
+	    ADTs = optarg;
+	    break;
+
+	case 'k':		// Index distributions
+	    if (strlen(optarg) >= sizeof(DistList))
+		FAILURE("Too long a list of distributions, bytes =",
+			strlen(optarg));
+	    strcpy(DistList, optarg);
+	    break;
+
+	default:
+	    printf("\n%s -n# -r# -s# -a1L -k<dist>,<dist>,...\n\n", argv[0]);
+	    printf("Where:\n");
+	    printf("-n <#>  Indexes to insert and delete (4096)\n");
+	    printf("-r <#>  measurements of each change (25)\n");
+	    printf("-s <#>  random number seed (not 0)\n");
+	    printf("-a <..> arrays to measure: 1 = Judy1, L = JudyL\n");
+	    printf("-k <..> distributions of the Indexes (%s), each one of:\n",
+		   DistList);
+	    JudyKeysHelp();
+	    printf("\nOne line per array, distribution, operation and change "
+		   "of JP Type, with\nthe population before it, the cycles "
+		   "and ns it took, and the bytes it\nallocated and freed\n");
+	    exit(1);
+	}
+    }
+
+    for (dd = 0, Dist[0] = strtok(DistList, ","); Dist[dd] != NULL; )
+    {
+	if (++dd == MAXDISTS)
+	    FAILURE("Too many distributions, most are", MAXDISTS);
+	Dist[dd] = strtok(NULL, ",");
+    }
+    nDists = dd;
+    if (nDists == 0)
+	FAILURE("No distributions: -k", 0);
+
+//  The least that measuring nothing takes, to take off every measurement
+
+    OpenCycles();
+    CycleOverhead = NsOverhead = ~(Word_t)0;
+    for (rep = 0; rep < 1000; rep++)
+    {
+	begin = Now();
+	StartCycles(&start);
+	cycles = StopCycles(start);
+	ns     = Now() - begin;
+
+	if (cycles < CycleOverhead) CycleOverhead = cycles;
+	if (ns     < NsOverhead)    NsOverhead    = ns;
+    }
+
+    printf("# JudyTransition -n %lu -r %lu -s %lu, cycles from %s, "
+	   "measuring nothing takes %lu cycles %lu ns\n", nElms, Reps, Seed,
+	   CycleSource, CycleOverhead, NsOverhead);
+    printf("adt,dist,op,change,pop,seen,reps,cycles_min,cycles_med,"
+	   "ns_min,ns_med,alloc_bytes,freed_bytes,allocs,frees\n");
+
+    for (dd = 0; dd < nDists; dd++)
+    {
+	count = nElms;
+	if ((Keys = JudyKeys(Dist[dd], &count, Seed)) == NULL)
+	    FAILURE("Cannot make Indexes, -n", nElms);
+	if (count < nElms)
+	    FAILURE("Too few Indexes in trace, need -n", nElms);
+
+	for (adt = 0; adt < 2; adt++)
+	{
+	    if (strchr(ADTs, "1L"[adt]) == NULL)
+		continue;
+
+	    Discover(adt, Keys);
+	    for (ch = 0; ch < nChanges; ch++)
+		Measure(adt, Dist[dd], Keys, Change + ch);
+	    fflush(stdout);
+	}
+	free(Keys);
+    }
+    exit(0);
+}
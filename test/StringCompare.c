@@ -503,6 +503,22 @@ HashStr(void *Str, Word_t Len)
     return (hashv);
 }
 
+//  The JudyHS string hash before JudyHashStr(), kept to time against it:
+//  byte at a time, (c * 31) + b.
+
+static uint32_t
+OldJudyHashStr(void *Str, Word_t Len)
+{
+    uint8_t  *p_ = (uint8_t *) Str;
+    uint8_t  *q_ = p_ + Len;
+    uint32_t  c_ = 0;
+
+    for (; p_ != q_; ++p_)
+        c_ = (c_ * 31) + *p_;
+
+    return (c_);
+}
+
 //=======================================================================
 //      S T O R E  and  R E T R I V E  R O U T I N E S
 //=======================================================================
@@ -2009,6 +2025,91 @@ main(int argc, char *argv[])
         ("# HashStr() Time = %6.3f uS average per string (mostly from Cache)\n",
          DeltaUSec / nStrg);
 
+//=======================================================================
+//  TIME OLD AND NEW JudyHS HASH from Cache, AND COUNT DISTINCT HASHES
+//=======================================================================
+//
+//  JudyHS hashes only strings longer than a word, and only compares hashes
+//  of strings of the same length, so count distinct (length, hash) pairs;
+//  the more, the fewer collisions (duplicate strings count only once).
+
+    {
+        Pvoid_t   PJOld = (Pvoid_t) NULL;       // JudyL of Len -> Judy1 of hashes
+        Pvoid_t   PJNew = (Pvoid_t) NULL;
+        PWord_t   PValue;
+        Word_t    Distinct, Bytes, Len;
+        uint32_t  hval;
+        int       Rc;
+
+        STARTTm(tm);                    // start timer
+        for (LineCnt = 0; LineCnt < nStrg; LineCnt++)
+        {
+            GETSTRING(PCurStr, Strlen);
+            PCurStr = Pdt[LineCnt].dt_string;
+            Strlen = Pdt[LineCnt].dt_strlen;
+            hval = OldJudyHashStr(PCurStr, Strlen);
+            if (foolflag)
+                printf("OOps foolflag is set, hval = %u\n", hval);
+        }
+        ENDTm(DeltaUSec, tm);           // end timer
+
+        printf
+            ("# Old JudyHS hash = %6.3f uS average per string (mostly from Cache)\n",
+             DeltaUSec / nStrg);
+
+        STARTTm(tm);                    // start timer
+        for (LineCnt = 0; LineCnt < nStrg; LineCnt++)
+        {
+            GETSTRING(PCurStr, Strlen);
+            PCurStr = Pdt[LineCnt].dt_string;
+            Strlen = Pdt[LineCnt].dt_strlen;
+            hval = JudyHashStr(PCurStr, Strlen);
+            if (foolflag)
+                printf("OOps foolflag is set, hval = %u\n", hval);
+        }
+        ENDTm(DeltaUSec, tm);           // end timer
+
+        printf
+            ("# JudyHashStr()   = %6.3f uS average per string (mostly from Cache)\n",
+             DeltaUSec / nStrg);
+
+        for (LineCnt = 0; LineCnt < nStrg; LineCnt++)
+        {
+            PCurStr = Pdt[LineCnt].dt_string;
+            Strlen = Pdt[LineCnt].dt_strlen;
+            if (Strlen <= (int) sizeof(Word_t))
+                continue;               // not hashed by JudyHS
+
+            JLI(PValue, PJOld, Strlen);
+            J1S(Rc, *(PPvoid_t) PValue, OldJudyHashStr(PCurStr, Strlen));
+            JLI(PValue, PJNew, Strlen);
+            J1S(Rc, *(PPvoid_t) PValue, JudyHashStr(PCurStr, Strlen));
+        }
+        Distinct = 0;
+        Len = 0;
+        JLF(PValue, PJOld, Len);
+        while (PValue != NULL)
+        {
+            Distinct += Judy1Count(*(PPvoid_t) PValue, 0, -1, PJE0);
+            J1FA(Bytes, *(PPvoid_t) PValue);
+            JLN(PValue, PJOld, Len);
+        }
+        JLFA(Bytes, PJOld);
+        printf("# Old JudyHS hash distinct (length, hash) = %lu\n", Distinct);
+
+        Distinct = 0;
+        Len = 0;
+        JLF(PValue, PJNew, Len);
+        while (PValue != NULL)
+        {
+            Distinct += Judy1Count(*(PPvoid_t) PValue, 0, -1, PJE0);
+            J1FA(Bytes, *(PPvoid_t) PValue);
+            JLN(PValue, PJNew, Len);
+        }
+        JLFA(Bytes, PJNew);
+        printf("# JudyHashStr()  distinct (length, hash) = %lu\n", Distinct);
+    }
+
 //  randomize the input strings (adjacent strings will not be on same page)
 
     if (rFlag == 0)
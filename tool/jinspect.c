@@ -0,0 +1,205 @@
+// Copyright (C) 2000 - 2002 Hewlett-Packard Company
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the term of the GNU Lesser General Public License as published by the
+// Free Software Foundation; either version 2 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+// _________________
+
+// @(#) $Revision: 4.1 $ $Source: /judy/tool/jinspect.c $
+//
+// JUDY ARRAY STRUCTURE REPORTER.
+//
+// USAGE:  <program> [-1] [file]
+//
+// Reads Indexes, one per line, in decimal or (with a leading "0x") hex, from
+// file or stdin; stores them in a JudyL array (or with -1, a Judy1 array);
+// and prints the Judy1Inspect() / JudyLInspect() report:  the number, memory,
+// and fill ratio of each kind of node at each level, then the totals.  Use it
+// to see how a real Index set will be stored before committing to Judy.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>             // for getopt().
+
+#include "Judy.h"
+
+static char * gc_myname;        // how program was invoked.
+
+static void PrintNode(const char * Name, Word_t Level, Word_t Pop,
+                      PJInspectNode_t Pjin);
+static void Usage(void);
+
+
+// ****************************************************************************
+// M A I N
+
+int main(
+        int     argc,
+        char ** argv)
+{
+        int     opt1 = 0;       // -1:  use Judy1.
+        FILE *  Pfile = stdin;
+        char    line[BUFSIZ];
+        Pvoid_t PArray = (Pvoid_t) NULL;
+        JInspect_t inspect;
+        Word_t  index;
+        Word_t  level;
+        Word_t  pop;
+        Word_t  bytes;
+        int     c;
+
+        gc_myname = argv[0];
+
+        while ((c = getopt(argc, argv, "1")) != -1)
+        {
+            switch (c)
+            {
+            case '1': opt1 = 1; break;
+            default:  Usage();
+            }
+        }
+
+        if (optind < argc - 1) Usage();
+
+        if ((optind == argc - 1)
+         && ((Pfile = fopen(argv[optind], "r")) == (FILE *) NULL))
+        {
+            (void) fprintf(stderr, "%s: cannot open file \"%s\": %s\n",
+                           gc_myname, argv[optind], strerror(errno));
+            exit(1);
+        }
+
+
+// READ AND STORE INDEXES:
+
+        while (fgets(line, sizeof(line), Pfile) != (char *) NULL)
+        {
+            char * Pend;
+
+            index = (Word_t) strtoul(line, &Pend, 0);
+            if (Pend == line) continue;         // blank or non-numeric line.
+
+            if (opt1)
+            {
+                if (Judy1Set(&PArray, index, PJE0) == JERR) goto NoMem;
+            }
+            else
+            {
+                PWord_t PValue = (PWord_t) JudyLIns(&PArray, index, PJE0);
+
+                if (PValue == PJERR) goto NoMem;
+                *PValue = index;
+            }
+        }
+
+        if (ferror(Pfile))
+        {
+            (void) fprintf(stderr, "%s: cannot read input: %s\n",
+                           gc_myname, strerror(errno));
+            exit(1);
+        }
+
+
+// REPORT:
+
+        bytes = opt1 ? Judy1Inspect(PArray, &inspect, PJE0)
+                     : JudyLInspect(PArray, &inspect, PJE0);
+
+        if (bytes == JERR)
+        {
+            (void) fprintf(stderr, "%s: inspect failed\n", gc_myname);
+            exit(1);
+        }
+
+        (void) printf("%-12s %5s %4s %12s %14s %6s\n",
+                      "node", "level", "pop", "count", "bytes", "fill%");
+
+        for (level = JI_LEVELS - 1; level > 0; --level)
+        {
+            PrintNode("BranchL", level, 0, &inspect.ji_BranchL[level]);
+            PrintNode("BranchB", level, 0, &inspect.ji_BranchB[level]);
+            PrintNode("BranchU", level, 0, &inspect.ji_BranchU[level]);
+        }
+        for (level = JI_LEVELS - 1; level > 0; --level)
+            PrintNode("Leaf", level, 0, &inspect.ji_Leaf[level]);
+
+        PrintNode("LeafB1",   1, 0, &inspect.ji_LeafB1);
+        PrintNode("FullPopu1", 1, 0, &inspect.ji_FullPopu1);
+
+        for (level = JI_LEVELS - 1; level > 0; --level)
+            for (pop = 1; pop < JI_MAXIMMED; ++pop)
+                PrintNode("Immed", level, pop, &inspect.ji_Immed[level][pop]);
+
+        PrintNode("Values", 0, 0, &inspect.ji_Values);
+
+        (void) printf("\nJPM bytes:    %lu\n", (unsigned long) inspect.ji_JPMBytes);
+        (void) printf("total bytes:  %lu (%.2f per Index)\n",
+                      (unsigned long) inspect.ji_TotalBytes,
+                      inspect.ji_Population ?
+                      (double) inspect.ji_TotalBytes / inspect.ji_Population
+                      : 0.0);
+        (void) printf("population:   %lu\n", (unsigned long) inspect.ji_Population);
+        (void) printf("max depth:    %lu\n", (unsigned long) inspect.ji_MaxDepth);
+
+        return(0);
+
+NoMem:
+        (void) fprintf(stderr, "%s: out of memory\n", gc_myname);
+        exit(1);
+        /*NOTREACHED*/
+
+} // main()
+
+
+// ****************************************************************************
+// P R I N T   N O D E
+//
+// Print one line of the report, if there are any nodes of this kind.
+
+static void PrintNode(
+        const char *    Name,
+        Word_t          Level,
+        Word_t          Pop,
+        PJInspectNode_t Pjin)
+{
+        if (Pjin->jin_Count == 0) return;
+
+        (void) printf("%-12s %5lu ", Name, (unsigned long) Level);
+
+        if (Pop) (void) printf("%4lu ", (unsigned long) Pop);
+        else     (void) printf("%4s ", "");
+
+        (void) printf("%12lu %14lu %6.1f\n",
+                      (unsigned long) Pjin->jin_Count,
+                      (unsigned long) Pjin->jin_Bytes,
+                      Pjin->jin_Slots ?
+                      100.0 * Pjin->jin_Pop1 / Pjin->jin_Slots : 0.0);
+
+} // PrintNode()
+
+
+// ****************************************************************************
+// U S A G E
+
+static void Usage(void)
+{
+        (void) fprintf(stderr, "Usage: %s [-1] [file]\n"
+                       "Reads Indexes, one per line, from file or stdin, "
+                       "stores them in a JudyL\n(-1:  Judy1) array, and "
+                       "reports its node types and memory use.\n",
+                       gc_myname);
+        exit(1);
+
+} // Usage()